@@ -54,6 +54,8 @@ typedef enum
     CAMERAQUEUE_LOCK_NONE = 0,  //No locking
     CAMERAQUEUE_LOCK_THREAD,    //Locking for non-ist
     CAMERAQUEUE_LOCK_IST,       //Locking for ist
+    CAMERAQUEUE_LOCK_FREE_SPSC, //Lock-free, exactly one producer and one consumer thread
+    CAMERAQUEUE_LOCK_FREE_MPMC, //Lock-free, any number of producers and consumers
     CAMERAQUEUE_LOCK_NUM,
     CAMERAQUEUE_LOCK_MAX = 0x7FFFFFFF
 } CameraQueueLockType;
@@ -142,6 +144,41 @@ CameraResult CameraQueueEnqueue(CameraQueue hQueue,
 CameraResult CameraQueueDequeue(CameraQueue hQueue,
     CameraQueueDataType dataOut);
 
+/**
+ * Remove up to nMaxElems elements from the head of a queue in one operation.
+ *
+ * @param[in] hQueue Queue handle.
+ * @param[out] dataOut Array of at least nMaxElems elements.
+ * @param[in] nMaxElems Max number of elements to remove.
+ * @param[out] pnDequeued Number of elements removed.
+ * @return CAMERA_SUCCESS - if at least one element was removed
+ *         CAMERA_ENOMORE - if hQueue is empty
+ *         CAMERA_EFAILED - if failed
+ */
+CameraResult CameraQueueDequeueBatch(CameraQueue hQueue,
+    CameraQueueDataType dataOut,
+    uint32 nMaxElems,
+    uint32* pnDequeued);
+
+/**
+ * Remove element from a queue at the head, waiting for one to be enqueued
+ * if the queue is empty. Only supported by the CAMERAQUEUE_LOCK_FREE_*
+ * queues.
+ *
+ * @param[in] hQueue Queue handle.
+ * @param[out] dataOut Element that will be removed.
+ * @param[in] nTimeoutMilliseconds Max time to wait, 0 to not wait or
+ *                                 CAM_SIGNAL_WAIT_NO_TIMEOUT to wait forever.
+ * @return CAMERA_SUCCESS - if successful
+ *         CAMERA_ENOMORE - if hQueue is empty and nTimeoutMilliseconds is 0
+ *         CAMERA_EEXPIRED - if timeout occured
+ *         CAMERA_EUNSUPPORTED - if hQueue is not a lock-free queue
+ *         CAMERA_EFAILED - if failed
+ */
+CameraResult CameraQueueDequeueWait(CameraQueue hQueue,
+    CameraQueueDataType dataOut,
+    uint32 nTimeoutMilliseconds);
+
 /**
  * Remove element from a queue at the head of the queue
  *
@@ -20,6 +20,10 @@
  * When N = M = 1, caller can may request CAMERA_LOCK_NONE with special
  *   optimization - It is thread safe without the needs of mutex nor spin lock.
  *
+ * CAMERAQUEUE_LOCK_FREE_SPSC and CAMERAQUEUE_LOCK_FREE_MPMC are served by
+ *   the ring buffers in CameraQueueLockFree.c; every public API below
+ *   forwards to them when the handle carries CAMERAQUEUE_LF_MAGIC.
+ *
  */
 
 #if defined(CAMERA_UNITTEST)
@@ -45,6 +49,7 @@
 #include "CameraOSServices.h"
 
 #include "CameraQueue.h"
+#include "CameraQueueLockFree.h"
 #include "CameraMemoryBarrier.h"
 
 /* 'camq' is the magic identifier
@@ -619,6 +624,12 @@ static CameraResult cameraQueueProtectedGetCounter(CameraQueue                *h
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = (CameraQueueCounterUsed == eCounter) ?
+                 cameraQueueLfGetLength(hQueue, pValue) :
+                 cameraQueueLfGetAvailableEntries(hQueue, pValue);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -656,7 +667,11 @@ CAM_API CameraResult CameraQueueCreate(CameraQueue* phQueue,
     CameraLogEvent(CAMERA_CORE_EVENT_CAMERAQUEUECREATE, 0, 0);
 
     /* input validation */
-    if ( phQueue && pCreateParams                         && /* check valid pointers    */
+    if (pCreateParams && cameraQueueLfIsLockType(pCreateParams->eLockType))
+    {
+        result = cameraQueueLfCreate(phQueue, pCreateParams);
+    }
+    else if ( phQueue && pCreateParams                         && /* check valid pointers    */
          (pCreateParams->nDataSizeInBytes > 0)            && /* check zero size element */
          (pCreateParams->nCapacity > 0)                   && /* minimal array element   */
          (pCreateParams->eLockType < CAMERAQUEUE_LOCK_NUM) ) /* valid locking type      */
@@ -731,6 +746,10 @@ CAM_API CameraResult CameraQueueDestroy(CameraQueue hQueue)
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfDestroy(hQueue);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -775,6 +794,10 @@ CAM_API CameraResult CameraQueueClear(CameraQueue hQueue)
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfClear(hQueue);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -813,6 +836,10 @@ CAM_API CameraResult CameraQueueEnqueue(CameraQueue               hQueue,
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfEnqueue(hQueue, dataIn);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -886,6 +913,10 @@ CAM_API CameraResult CameraQueueDequeue(CameraQueue         hQueue,
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfDequeue(hQueue, dataOut);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -944,6 +975,103 @@ CAM_API CameraResult CameraQueueDequeue(CameraQueue         hQueue,
     return result;
 }
 
+CAM_API CameraResult CameraQueueDequeueBatch(CameraQueue         hQueue,
+                                     CameraQueueDataType dataOut,
+                                     uint32              nMaxElems,
+                                     uint32*             pnDequeued)
+{
+    CameraResult result;
+    cameraQueueCtx_t *pCameraQueue = (cameraQueueCtx_t*) hQueue;
+
+    CameraLogEvent(CAMERA_CORE_EVENT_CAMERAQUEUEDEQUEUE, 0, 0);
+
+    if (!pCameraQueue || !dataOut || !pnDequeued || 0 == nMaxElems)
+    {
+        result = CAMERA_EBADPARM;
+    }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfDequeueBatch(hQueue, dataOut, nMaxElems, pnDequeued);
+    }
+    else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
+    {
+        CAM_MSG(ERROR, "invalid or destroyed queue handle");
+        result = CAMERA_EBADHANDLE;
+    }
+    else if (0 != pCameraQueue->pFcnLock(&pCameraQueue->sLock))
+    {
+        CAM_MSG(ERROR, "failed to lock hQueue=0x%p", hQueue);
+        result = CAMERA_EFAILED;
+    }
+    else
+    {
+        uint32 nDequeued = 0;
+
+        /* drain under a single lock hold */
+        while (nDequeued < nMaxElems && !cameraQueueIsEmpty(pCameraQueue))
+        {
+            volatile CameraQueueDataType pNode = cameraQueueGetNode(pCameraQueue, pCameraQueue->rdIndex);
+            void* pDst = ((char*)dataOut) + nDequeued * pCameraQueue->elemSize;
+
+            if (pCameraQueue->pFcnVCpyFrom)
+            {
+                pCameraQueue->pFcnVCpyFrom(pDst, pNode);
+            }
+            else
+            {
+                std_memmove(pDst, pNode, pCameraQueue->elemSize);
+            }
+            pCameraQueue->rdIndex = cameraQueueNextIndex(pCameraQueue, pCameraQueue->rdIndex);
+            nDequeued++;
+        }
+
+        /* multi-core only */
+        cameraQueueMemoryBarrier(pCameraQueue->eLockType);
+
+        *pnDequeued = nDequeued;
+        result      = (0 == nDequeued) ? CAMERA_ENOMORE : CAMERA_SUCCESS;
+
+        /* unlock queue context */
+        if (0 != pCameraQueue->pFcnUnLock(&pCameraQueue->sLock))
+        {
+            CAM_MSG(ERROR, "failed to unlock queue=0x%p", hQueue);
+            if (CAMERA_SUCCESS == result) { result = CAMERA_EFAILED; }
+        }
+    }
+
+    CameraLogEvent(CAMERA_CORE_EVENT_CAMERAQUEUEDEQUEUE, 0, 0);
+    return result;
+}
+
+CAM_API CameraResult CameraQueueDequeueWait(CameraQueue         hQueue,
+                                    CameraQueueDataType dataOut,
+                                    uint32              nTimeoutMilliseconds)
+{
+    CameraResult result;
+    cameraQueueCtx_t *pCameraQueue = (cameraQueueCtx_t*) hQueue;
+
+    if (!pCameraQueue || !dataOut)
+    {
+        result = CAMERA_EBADPARM;
+    }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfDequeueWait(hQueue, dataOut, nTimeoutMilliseconds);
+    }
+    else if (0 == nTimeoutMilliseconds)
+    {
+        result = CameraQueueDequeue(hQueue, dataOut);
+    }
+    else
+    {
+        /* the locked queues have no wait object, callers pair them with
+         * their own CameraSignal */
+        result = CAMERA_EUNSUPPORTED;
+    }
+
+    return result;
+}
+
 CAM_API CameraResult CameraQueueDropHead(CameraQueue hQueue)
 {
     CameraResult result;
@@ -955,6 +1083,10 @@ CAM_API CameraResult CameraQueueDropHead(CameraQueue hQueue)
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfDropHead(hQueue);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -1000,6 +1132,10 @@ CAM_API CameraResult CameraQueueGetCapacity(CameraQueue hQueue, uint32* pnCapaci
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfGetCapacity(hQueue, pnCapacityOut);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -1037,6 +1173,10 @@ CAM_API CameraResult CameraQueueIsEmpty(CameraQueue hQueue, boolean* pbIsEmptyOu
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfIsEmpty(hQueue, pbIsEmptyOut);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -1073,6 +1213,10 @@ CAM_API CameraResult CameraQueueIsFull(CameraQueue hQueue, boolean* pbIsFullOut)
     {
         result = CAMERA_EBADPARM;
     }
+    else if (CAMERAQUEUE_LF_MAGIC == pCameraQueue->magic)
+    {
+        result = cameraQueueLfIsFull(hQueue, pbIsFullOut);
+    }
     else if (CAMERAQUEUE_MAGIC != pCameraQueue->magic)
     {
         CAM_MSG(ERROR, "invalid or destroyed queue handle");
@@ -0,0 +1,763 @@
+/**
+ * @file CameraQueueLockFree.c
+ *
+ * @brief Lock-free variants of the CameraQueue.h implementation
+ *
+ * Copyright (c) 2019 Qualcomm Technologies, Inc.
+ * All Rights Reserved.
+ * Confidential and Proprietary - Qualcomm Technologies, Inc.
+ */
+
+/**
+ * Two bounded ring buffers selected through CameraQueueLockType:
+ *
+ * CAMERAQUEUE_LOCK_FREE_SPSC - exactly one producer and one consumer thread.
+ *   Free running read/write positions, each written by one side only and
+ *   published with release/acquire ordering.
+ *
+ * CAMERAQUEUE_LOCK_FREE_MPMC - any number of producers and consumers.
+ *   Every cell carries a sequence number telling whether it is ready to be
+ *   written (seq == pos) or read (seq == pos + 1) for a given position, so
+ *   a position is claimed with a single CAS and no thread ever waits on
+ *   another one inside the queue.
+ *
+ * The ring is rounded up to a power of two but the queue still reports and
+ *   enforces the capacity requested at creation.
+ *
+ * CameraQueueDequeueWait() parks the consumer on a condition variable.
+ *   Producers only touch that condition when a waiter is registered, so the
+ *   enqueue path stays lock-free when no one blocks.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "AEEstd.h"
+
+#include "CameraOSServices.h"
+
+#include "CameraQueue.h"
+#include "CameraQueueLockFree.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OSINLINE static inline
+
+#define CAMERAQUEUE_LF_CACHE_LINE 64
+
+typedef struct _cameraQueueLfCtx_t
+{
+    /* When set to CAMERAQUEUE_LF_MAGIC, it means the incoming
+     * handle points to a properly initialized lock-free queue.
+     * Must stay the first member, see CameraQueueLockFree.h */
+    volatile uint32         magic;
+
+    /* CAMERAQUEUE_LOCK_FREE_SPSC or CAMERAQUEUE_LOCK_FREE_MPMC */
+    CameraQueueLockType     eLockType;
+
+    /* size of each element in the managed pArray */
+    uint32                  elemSize;
+    /* max no. of elements allowed in the queue */
+    uint32                  capacity;
+    /* no. of cells in pArray minus 1; the no. of cells is a power of 2 */
+    uint32                  mask;
+
+    /* ring of (mask + 1) elements, each of size 'elemSize' bytes */
+    byte                   *pArray;
+    /* per cell sequence numbers, MPMC only */
+    uint32                 *pSeq;
+
+    /* optional customized copy to/from functions */
+    CameraQueueVCpyToFcn    pFcnVCpyTo;
+    CameraQueueVCpyFromFcn  pFcnVCpyFrom;
+
+    /* no. of consumers parked in CameraQueueDequeueWait */
+    uint32                  nWaiters;
+    pthread_mutex_t         waitMutex;
+    pthread_cond_t          waitCond;
+
+    /* producer and consumer positions live on separate cache lines so the
+     * two sides do not invalidate each other on every operation */
+    byte                    pad0[CAMERAQUEUE_LF_CACHE_LINE];
+    uint32                  enqPos;
+    byte                    pad1[CAMERAQUEUE_LF_CACHE_LINE - sizeof(uint32)];
+    uint32                  deqPos;
+    byte                    pad2[CAMERAQUEUE_LF_CACHE_LINE - sizeof(uint32)];
+
+} cameraQueueLfCtx_t;
+
+/*
+ * --------------------------------------------------------------------------
+ *                       Private Help Functions
+ * --------------------------------------------------------------------------
+ */
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfGetCtx()
+ *
+ */
+/**      \brief   The \b cameraQueueLfGetCtx validates a handle
+ *
+ *       \param   [IN] hQueue  queue handle
+ *
+ *       \retval  the lock-free queue context, or NULL if hQueue is not one
+ *
+ ***************************************************************************/
+OSINLINE cameraQueueLfCtx_t* cameraQueueLfGetCtx(CameraQueue hQueue)
+{
+    cameraQueueLfCtx_t* pCtx = (cameraQueueLfCtx_t*)hQueue;
+
+    return (pCtx && CAMERAQUEUE_LF_MAGIC == pCtx->magic) ? pCtx : NULL;
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfRoundPow2()
+ *
+ */
+/**      \brief   The \b cameraQueueLfRoundPow2 rounds n up to a power of 2
+ *
+ *       \param   [IN] n  value to round, must be > 0 and <= 2^31
+ *
+ *       \retval  smallest power of 2 >= n
+ *
+ ***************************************************************************/
+OSINLINE uint32 cameraQueueLfRoundPow2(uint32 n)
+{
+    n--;
+    n |= n >> 1;
+    n |= n >> 2;
+    n |= n >> 4;
+    n |= n >> 8;
+    n |= n >> 16;
+    return n + 1;
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfUsed()
+ *
+ */
+/**      \brief   The \b cameraQueueLfUsed returns a snapshot of the no. of
+ *                queued elements.
+ *
+ *       \param   [IN] pCtx  a lock-free queue context
+ *
+ *       \retval  no. of elements in the queue at the time of called
+ *
+ *       \remarks The read position is loaded first so the result can never
+ *                be negative; it is clamped to the capacity because producers
+ *                may have moved on after the snapshot.
+ *
+ ***************************************************************************/
+OSINLINE uint32 cameraQueueLfUsed(const cameraQueueLfCtx_t *pCtx)
+{
+    const uint32 deqPos = __atomic_load_n(&pCtx->deqPos, __ATOMIC_ACQUIRE);
+    const uint32 enqPos = __atomic_load_n(&pCtx->enqPos, __ATOMIC_ACQUIRE);
+    const uint32 used   = enqPos - deqPos;
+
+    return (used > pCtx->capacity) ? pCtx->capacity : used;
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfCopyIn() / cameraQueueLfCopyOut()
+ *
+ */
+/**      \brief   Copy an element into / out of the cell for position 'pos'
+ *
+ ***************************************************************************/
+OSINLINE void cameraQueueLfCopyIn(cameraQueueLfCtx_t *pCtx, uint32 pos, const void *pSrc)
+{
+    volatile void *pNode = pCtx->pArray + (pos & pCtx->mask) * pCtx->elemSize;
+
+    if (pCtx->pFcnVCpyTo)
+    {
+        pCtx->pFcnVCpyTo(pNode, pSrc);
+    }
+    else
+    {
+        memcpy((void*)pNode, pSrc, pCtx->elemSize);
+    }
+}
+
+OSINLINE void cameraQueueLfCopyOut(cameraQueueLfCtx_t *pCtx, uint32 pos, void *pDst)
+{
+    const volatile void *pNode = pCtx->pArray + (pos & pCtx->mask) * pCtx->elemSize;
+
+    if (pCtx->pFcnVCpyFrom)
+    {
+        pCtx->pFcnVCpyFrom(pDst, pNode);
+    }
+    else
+    {
+        memcpy(pDst, (const void*)pNode, pCtx->elemSize);
+    }
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfWakeWaiter()
+ *
+ */
+/**      \brief   The \b cameraQueueLfWakeWaiter wakes a consumer parked in
+ *                CameraQueueDequeueWait, if any.
+ *
+ *       \param   [IN] pCtx  a lock-free queue context
+ *
+ *       \remarks The fence orders the publish of the new element before the
+ *                load of nWaiters. A consumer registers itself before it
+ *                re-checks the queue, so either it sees the element or we
+ *                see the waiter.
+ *
+ ***************************************************************************/
+OSINLINE void cameraQueueLfWakeWaiter(cameraQueueLfCtx_t *pCtx)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (0 != __atomic_load_n(&pCtx->nWaiters, __ATOMIC_RELAXED))
+    {
+        pthread_mutex_lock(&pCtx->waitMutex);
+        pthread_cond_signal(&pCtx->waitCond);
+        pthread_mutex_unlock(&pCtx->waitMutex);
+    }
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfPush()
+ *
+ */
+/**      \brief   The \b cameraQueueLfPush appends one element
+ *
+ *       \param   [IN] pCtx    a lock-free queue context
+ *       \param   [IN] dataIn  element to copy in
+ *
+ *       \retval  CAMERA_SUCCESS, or CAMERA_ENOMORE if the queue is full
+ *
+ ***************************************************************************/
+static CameraResult cameraQueueLfPush(cameraQueueLfCtx_t *pCtx, const void *dataIn)
+{
+    uint32 pos;
+
+    if (CAMERAQUEUE_LOCK_FREE_SPSC == pCtx->eLockType)
+    {
+        pos = __atomic_load_n(&pCtx->enqPos, __ATOMIC_RELAXED);
+
+        if ((pos - __atomic_load_n(&pCtx->deqPos, __ATOMIC_ACQUIRE)) >= pCtx->capacity)
+        {
+            return CAMERA_ENOMORE;
+        }
+
+        cameraQueueLfCopyIn(pCtx, pos, dataIn);
+        __atomic_store_n(&pCtx->enqPos, pos + 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        pos = __atomic_load_n(&pCtx->enqPos, __ATOMIC_RELAXED);
+
+        for (;;)
+        {
+            const uint32 seq  = __atomic_load_n(&pCtx->pSeq[pos & pCtx->mask], __ATOMIC_ACQUIRE);
+            const int32  diff = (int32)(seq - pos);
+
+            if (0 == diff)
+            {
+                /* cell is free, but honour the requested capacity */
+                if ((int32)(pos - __atomic_load_n(&pCtx->deqPos, __ATOMIC_ACQUIRE)) >=
+                    (int32)pCtx->capacity)
+                {
+                    return CAMERA_ENOMORE;
+                }
+                if (__atomic_compare_exchange_n(&pCtx->enqPos, &pos, pos + 1, TRUE,
+                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    break;
+                }
+                /* pos was reloaded by the failed CAS */
+            }
+            else if (diff < 0)
+            {
+                /* cell still holds an element from the previous lap */
+                return CAMERA_ENOMORE;
+            }
+            else
+            {
+                /* another producer claimed this position */
+                pos = __atomic_load_n(&pCtx->enqPos, __ATOMIC_RELAXED);
+            }
+        }
+
+        cameraQueueLfCopyIn(pCtx, pos, dataIn);
+        __atomic_store_n(&pCtx->pSeq[pos & pCtx->mask], pos + 1, __ATOMIC_RELEASE);
+    }
+
+    cameraQueueLfWakeWaiter(pCtx);
+
+    return CAMERA_SUCCESS;
+}
+
+/******************************Internal*Routine******************************\
+ * cameraQueueLfPop()
+ *
+ */
+/**      \brief   The \b cameraQueueLfPop removes up to nMaxElems elements from
+ *                the head of the queue in one claim.
+ *
+ *       \param   [IN]  pCtx       a lock-free queue context
+ *       \param   [OUT] dataOut    array of nMaxElems elements, or NULL to drop
+ *       \param   [IN]  nMaxElems  max no. of elements to remove
+ *       \param   [OUT] pnPopped   no. of elements removed
+ *
+ *       \retval  CAMERA_SUCCESS, or CAMERA_ENOMORE if the queue is empty
+ *
+ ***************************************************************************/
+static CameraResult cameraQueueLfPop(cameraQueueLfCtx_t *pCtx, byte *dataOut,
+                                     uint32 nMaxElems, uint32 *pnPopped)
+{
+    uint32 pos;
+    uint32 n = 0;
+    uint32 i;
+
+    if (CAMERAQUEUE_LOCK_FREE_SPSC == pCtx->eLockType)
+    {
+        pos = __atomic_load_n(&pCtx->deqPos, __ATOMIC_RELAXED);
+        n   = __atomic_load_n(&pCtx->enqPos, __ATOMIC_ACQUIRE) - pos;
+        n   = STD_MIN(n, nMaxElems);
+
+        if (0 == n)
+        {
+            *pnPopped = 0;
+            return CAMERA_ENOMORE;
+        }
+
+        for (i = 0; i < n && dataOut; i++)
+        {
+            cameraQueueLfCopyOut(pCtx, pos + i, dataOut + i * pCtx->elemSize);
+        }
+        __atomic_store_n(&pCtx->deqPos, pos + n, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        pos = __atomic_load_n(&pCtx->deqPos, __ATOMIC_RELAXED);
+
+        for (;;)
+        {
+            int32 diff = 0;
+
+            /* count the run of published cells starting at pos */
+            for (n = 0; n < nMaxElems; n++)
+            {
+                const uint32 seq = __atomic_load_n(&pCtx->pSeq[(pos + n) & pCtx->mask],
+                                                   __ATOMIC_ACQUIRE);
+                diff = (int32)(seq - (pos + n + 1));
+                if (0 != diff)
+                {
+                    break;
+                }
+            }
+
+            if (0 < n)
+            {
+                if (__atomic_compare_exchange_n(&pCtx->deqPos, &pos, pos + n, TRUE,
+                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                {
+                    break;
+                }
+                /* pos was reloaded by the failed CAS */
+            }
+            else if (diff < 0)
+            {
+                *pnPopped = 0;
+                return CAMERA_ENOMORE;
+            }
+            else
+            {
+                /* another consumer took this position */
+                pos = __atomic_load_n(&pCtx->deqPos, __ATOMIC_RELAXED);
+            }
+        }
+
+        /* cells [pos, pos + n) are now owned by this consumer */
+        for (i = 0; i < n; i++)
+        {
+            if (dataOut)
+            {
+                cameraQueueLfCopyOut(pCtx, pos + i, dataOut + i * pCtx->elemSize);
+            }
+            __atomic_store_n(&pCtx->pSeq[(pos + i) & pCtx->mask],
+                             pos + i + pCtx->mask + 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    *pnPopped = n;
+
+    return CAMERA_SUCCESS;
+}
+
+/*
+ * --------------------------------------------------------------------------
+ *                       Internal API used by CameraQueue.c
+ * --------------------------------------------------------------------------
+ */
+int cameraQueueLfIsHandle(CameraQueue hQueue)
+{
+    return (NULL != cameraQueueLfGetCtx(hQueue)) ? 1 : 0;
+}
+
+int cameraQueueLfIsLockType(CameraQueueLockType eLockType)
+{
+    return (CAMERAQUEUE_LOCK_FREE_SPSC == eLockType ||
+            CAMERAQUEUE_LOCK_FREE_MPMC == eLockType) ? 1 : 0;
+}
+
+CameraResult cameraQueueLfCreate(CameraQueue* phQueue,
+    const CameraQueueCreateParamType* pCreateParams)
+{
+    CameraResult        result = CAMERA_SUCCESS;
+    cameraQueueLfCtx_t *pCtx;
+    pthread_condattr_t  condAttr;
+    uint32              nCells;
+    uint32              i;
+
+    if (!phQueue || !pCreateParams ||
+        !cameraQueueLfIsLockType(pCreateParams->eLockType) ||
+        0 == pCreateParams->nDataSizeInBytes ||
+        0 == pCreateParams->nCapacity || pCreateParams->nCapacity > 0x40000000)
+    {
+        return CAMERA_EBADPARM;
+    }
+
+    nCells = cameraQueueLfRoundPow2(pCreateParams->nCapacity);
+
+    pCtx = (cameraQueueLfCtx_t*)CameraAllocate(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_CTXT,
+                                               sizeof(cameraQueueLfCtx_t));
+    if (!pCtx)
+    {
+        CAM_MSG(ERROR, "failed to allocate memory for queue");
+        return CAMERA_ENOMEMORY;
+    }
+
+    STD_ZEROAT(pCtx);
+
+    pCtx->eLockType    = pCreateParams->eLockType;
+    pCtx->elemSize     = pCreateParams->nDataSizeInBytes;
+    pCtx->capacity     = pCreateParams->nCapacity;
+    pCtx->mask         = nCells - 1;
+    pCtx->pFcnVCpyTo   = pCreateParams->pFcnVCpyTo;
+    pCtx->pFcnVCpyFrom = pCreateParams->pFcnVCpyFrom;
+
+    pCtx->pArray = (byte*)CameraAllocate(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY,
+                                         nCells * pCtx->elemSize);
+    if (!pCtx->pArray)
+    {
+        CAM_MSG(ERROR, "failed to allocate memory for queue data array");
+        result = CAMERA_ENOMEMORY;
+    }
+    else
+    {
+        std_memset(pCtx->pArray, 0, nCells * pCtx->elemSize);
+    }
+
+    if (CAMERA_SUCCESS == result && CAMERAQUEUE_LOCK_FREE_MPMC == pCtx->eLockType)
+    {
+        pCtx->pSeq = (uint32*)CameraAllocate(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY,
+                                             nCells * sizeof(uint32));
+        if (!pCtx->pSeq)
+        {
+            CAM_MSG(ERROR, "failed to allocate memory for queue sequence array");
+            result = CAMERA_ENOMEMORY;
+        }
+        else
+        {
+            for (i = 0; i < nCells; i++)
+            {
+                pCtx->pSeq[i] = i;
+            }
+        }
+    }
+
+    if (CAMERA_SUCCESS == result)
+    {
+        if (0 != pthread_condattr_init(&condAttr))
+        {
+            result = CAMERA_EFAILED;
+        }
+        else
+        {
+            /* timed waits must not be affected by wall clock changes */
+            (void)pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+
+            if (0 != pthread_mutex_init(&pCtx->waitMutex, NULL))
+            {
+                result = CAMERA_EFAILED;
+            }
+            else if (0 != pthread_cond_init(&pCtx->waitCond, &condAttr))
+            {
+                pthread_mutex_destroy(&pCtx->waitMutex);
+                result = CAMERA_EFAILED;
+            }
+            pthread_condattr_destroy(&condAttr);
+        }
+
+        if (CAMERA_SUCCESS != result)
+        {
+            CAM_MSG(ERROR, "failed to init wait objects for queue");
+        }
+    }
+
+    if (CAMERA_SUCCESS == result)
+    {
+        pCtx->magic = CAMERAQUEUE_LF_MAGIC;
+        *phQueue    = (CameraQueue)pCtx;
+    }
+    else
+    {
+        if (pCtx->pSeq)
+        {
+            CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY, pCtx->pSeq);
+        }
+        if (pCtx->pArray)
+        {
+            CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY, pCtx->pArray);
+        }
+        CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_CTXT, pCtx);
+    }
+
+    return result;
+}
+
+CameraResult cameraQueueLfDestroy(CameraQueue hQueue)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    pCtx->magic = 0; /* mark queue handle invalid */
+
+    pthread_cond_destroy(&pCtx->waitCond);
+    pthread_mutex_destroy(&pCtx->waitMutex);
+
+    if (pCtx->pSeq)
+    {
+        CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY, pCtx->pSeq);
+    }
+    CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_ARRAY, pCtx->pArray);
+    CameraFree(CAMERA_ALLOCATE_ID_CAMERA_QUEUE_CTXT, pCtx);
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfClear(CameraQueue hQueue)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+    uint32 nPopped;
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    /* there is no lock to reset both positions under, so drain from the
+     * consumer side instead */
+    while (CAMERA_SUCCESS == cameraQueueLfPop(pCtx, NULL, pCtx->capacity, &nPopped))
+    {
+    }
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfEnqueue(CameraQueue hQueue, const CameraQueueDataType dataIn)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    return cameraQueueLfPush(pCtx, dataIn);
+}
+
+CameraResult cameraQueueLfDequeue(CameraQueue hQueue, CameraQueueDataType dataOut)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+    uint32 nPopped;
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    return cameraQueueLfPop(pCtx, (byte*)dataOut, 1, &nPopped);
+}
+
+CameraResult cameraQueueLfDequeueBatch(CameraQueue hQueue, CameraQueueDataType dataOut,
+    uint32 nMaxElems, uint32* pnDequeued)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    return cameraQueueLfPop(pCtx, (byte*)dataOut, nMaxElems, pnDequeued);
+}
+
+CameraResult cameraQueueLfDequeueWait(CameraQueue hQueue, CameraQueueDataType dataOut,
+    uint32 nTimeoutMilliseconds)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+    CameraResult        result;
+    struct timespec     absTime;
+    uint32              nPopped;
+    int                 rc = 0;
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    result = cameraQueueLfPop(pCtx, (byte*)dataOut, 1, &nPopped);
+    if (CAMERA_ENOMORE != result || 0 == nTimeoutMilliseconds)
+    {
+        return result;
+    }
+
+    if (CAM_SIGNAL_WAIT_NO_TIMEOUT != nTimeoutMilliseconds)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &absTime);
+        absTime.tv_sec  += nTimeoutMilliseconds / 1000;
+        absTime.tv_nsec += (long)(nTimeoutMilliseconds % 1000) * 1000000L;
+        if (absTime.tv_nsec >= 1000000000L)
+        {
+            absTime.tv_sec  += 1;
+            absTime.tv_nsec -= 1000000000L;
+        }
+    }
+
+    pthread_mutex_lock(&pCtx->waitMutex);
+    (void)__atomic_add_fetch(&pCtx->nWaiters, 1, __ATOMIC_SEQ_CST);
+
+    /* re-check after registering so a concurrent enqueue is never missed */
+    while (CAMERA_ENOMORE == (result = cameraQueueLfPop(pCtx, (byte*)dataOut, 1, &nPopped)))
+    {
+        if (ETIMEDOUT == rc)
+        {
+            result = CAMERA_EEXPIRED;
+            break;
+        }
+
+        if (CAM_SIGNAL_WAIT_NO_TIMEOUT == nTimeoutMilliseconds)
+        {
+            rc = pthread_cond_wait(&pCtx->waitCond, &pCtx->waitMutex);
+        }
+        else
+        {
+            rc = pthread_cond_timedwait(&pCtx->waitCond, &pCtx->waitMutex, &absTime);
+        }
+
+        if (0 != rc && ETIMEDOUT != rc)
+        {
+            CAM_MSG(ERROR, "wait on queue 0x%p failed : %s", hQueue, strerror(rc));
+            result = CAMERA_EFAILED;
+            break;
+        }
+    }
+
+    (void)__atomic_sub_fetch(&pCtx->nWaiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pCtx->waitMutex);
+
+    return result;
+}
+
+CameraResult cameraQueueLfDropHead(CameraQueue hQueue)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+    uint32 nPopped;
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    return cameraQueueLfPop(pCtx, NULL, 1, &nPopped);
+}
+
+CameraResult cameraQueueLfGetCapacity(CameraQueue hQueue, uint32* pnCapacityOut)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    *pnCapacityOut = pCtx->capacity;
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfGetLength(CameraQueue hQueue, uint32* pnLength)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    *pnLength = cameraQueueLfUsed(pCtx);
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfGetAvailableEntries(CameraQueue hQueue, uint32* pnAvailableEntriesOut)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    *pnAvailableEntriesOut = pCtx->capacity - cameraQueueLfUsed(pCtx);
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfIsEmpty(CameraQueue hQueue, boolean* pbIsEmptyOut)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    *pbIsEmptyOut = (0 == cameraQueueLfUsed(pCtx)) ? TRUE : FALSE;
+
+    return CAMERA_SUCCESS;
+}
+
+CameraResult cameraQueueLfIsFull(CameraQueue hQueue, boolean* pbIsFullOut)
+{
+    cameraQueueLfCtx_t *pCtx = cameraQueueLfGetCtx(hQueue);
+
+    if (!pCtx)
+    {
+        return CAMERA_EBADHANDLE;
+    }
+
+    *pbIsFullOut = (pCtx->capacity == cameraQueueLfUsed(pCtx)) ? TRUE : FALSE;
+
+    return CAMERA_SUCCESS;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,71 @@
+#ifndef __CAMERAQUEUELOCKFREE_H_
+#define __CAMERAQUEUELOCKFREE_H_
+
+/**
+ * @file CameraQueueLockFree.h
+ *
+ * @brief Internal declarations of the lock-free CameraQueue variants
+ *
+ * Copyright (c) 2019 Qualcomm Technologies, Inc.
+ * All Rights Reserved.
+ * Confidential and Proprietary - Qualcomm Technologies, Inc.
+ *
+ */
+
+/* ===========================================================================
+**                      INCLUDE FILES
+** ======================================================================== */
+#include "CameraTypes.h"
+#include "CameraResult.h"
+#include "CameraQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif // __cplusplus
+
+/* ---------------------------------------------------------------------------
+** Constant / Define Declarations
+** ------------------------------------------------------------------------ */
+
+/* 'camf' is the magic identifier of a lock-free queue handle.
+ * It occupies the same leading word as CAMERAQUEUE_MAGIC so the public
+ * API can tell both implementations apart from the handle alone. */
+#define CAMERAQUEUE_LF_MAGIC ((uint32)(('c' << 24)|('a' << 16)|('m' << 8)|('f')))
+
+/* ===========================================================================
+**                      FUNCTION DECLARATIONS
+** ======================================================================== */
+
+/**
+ * Returns 1 if hQueue was created by cameraQueueLfCreate, 0 otherwise.
+ */
+int cameraQueueLfIsHandle(CameraQueue hQueue);
+
+/**
+ * Returns 1 if eLockType selects one of the lock-free variants.
+ */
+int cameraQueueLfIsLockType(CameraQueueLockType eLockType);
+
+CameraResult cameraQueueLfCreate(CameraQueue* phQueue,
+    const CameraQueueCreateParamType* pCreateParams);
+CameraResult cameraQueueLfDestroy(CameraQueue hQueue);
+CameraResult cameraQueueLfClear(CameraQueue hQueue);
+CameraResult cameraQueueLfEnqueue(CameraQueue hQueue, const CameraQueueDataType dataIn);
+CameraResult cameraQueueLfDequeue(CameraQueue hQueue, CameraQueueDataType dataOut);
+CameraResult cameraQueueLfDequeueBatch(CameraQueue hQueue, CameraQueueDataType dataOut,
+    uint32 nMaxElems, uint32* pnDequeued);
+CameraResult cameraQueueLfDequeueWait(CameraQueue hQueue, CameraQueueDataType dataOut,
+    uint32 nTimeoutMilliseconds);
+CameraResult cameraQueueLfDropHead(CameraQueue hQueue);
+CameraResult cameraQueueLfGetCapacity(CameraQueue hQueue, uint32* pnCapacityOut);
+CameraResult cameraQueueLfGetLength(CameraQueue hQueue, uint32* pnLength);
+CameraResult cameraQueueLfGetAvailableEntries(CameraQueue hQueue, uint32* pnAvailableEntriesOut);
+CameraResult cameraQueueLfIsEmpty(CameraQueue hQueue, boolean* pbIsEmptyOut);
+CameraResult cameraQueueLfIsFull(CameraQueue hQueue, boolean* pbIsFullOut);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif  // __cplusplus
+
+#endif // __CAMERAQUEUELOCKFREE_H_
@@ -81,28 +81,38 @@ void AisEngine::Deinitialize(void)
 
     m_eventHandlerIsExit = TRUE;
 
-    for (i = 0; i < NUM_EVENT_HNDLR_POOL; i++)
+    for (i = 0; i < (int)m_numEventHandlers; i++)
     {
-        CameraSetSignal(m_eventHandlerSignal);
+        if (m_eventHandlers[i].signal)
+        {
+            CameraSetSignal(m_eventHandlers[i].signal);
+        }
     }
 
-    for (i = 0; i < NUM_EVENT_HNDLR_POOL; i++)
+    for (i = 0; i < (int)m_numEventHandlers; i++)
     {
-        if (m_eventHandlerThreadId[i])
+        if (m_eventHandlers[i].threadId)
+        {
+            CameraJoinThread(m_eventHandlers[i].threadId, NULL);
+            CameraReleaseThread(m_eventHandlers[i].threadId);
+            m_eventHandlers[i].threadId = NULL;
+        }
+
+        if (m_eventHandlers[i].signal)
         {
-            CameraJoinThread(m_eventHandlerThreadId[i], NULL);
-            CameraReleaseThread(m_eventHandlerThreadId[i]);
+            CameraDestroySignal(m_eventHandlers[i].signal);
+            m_eventHandlers[i].signal = NULL;
         }
     }
 
-    CameraDestroySignal(m_eventHandlerSignal);
-    m_eventHandlerSignal = NULL;
+    DumpEventQueueStats();
 
     for (i = 0; i < AIS_ENGINE_QUEUE_MAX; i++)
     {
         if (m_eventQ[i])
         {
             CameraQueueDestroy(m_eventQ[i]);
+            m_eventQ[i] = NULL;
         }
     }
 
@@ -155,6 +165,11 @@ AisEngine::AisEngine()
 
     m_ResourceManager = NULL;
     std_memset(mConfigurers, 0x0, sizeof(mConfigurers));
+
+    m_numEventHandlers = 0;
+    std_memset(m_eventHandlers, 0x0, sizeof(m_eventHandlers));
+    std_memset(m_eventQ, 0x0, sizeof(m_eventQ));
+    std_memset(m_eventQStats, 0x0, sizeof(m_eventQStats));
 }
 
 AisEngine::~AisEngine()
@@ -189,46 +204,57 @@ CameraResult AisEngine::Initialize(void)
         CameraQueueCreateParamType sCreateParams;
         int i;
 
-        /*create buffer done Q*/
+        /*create event Qs, one for control events and one per IFE core*/
         STD_ZEROAT(&sCreateParams);
         sCreateParams.nCapacity = EVENT_QUEUE_MAX_SIZE;
         sCreateParams.nDataSizeInBytes = sizeof(ais_engine_event_msg_t);
-        sCreateParams.eLockType = CAMERAQUEUE_LOCK_THREAD;
-        for (i = 0; i < AIS_ENGINE_QUEUE_MAX; i++)
+        /*events are posted from IFE/CSID callbacks and client threads*/
+        sCreateParams.eLockType = CAMERAQUEUE_LOCK_FREE_MPMC;
+        std_memset(m_eventQStats, 0x0, sizeof(m_eventQStats));
+        for (i = 0; i < AIS_ENGINE_QUEUE_MAX && CAMERA_SUCCESS == rc; i++)
         {
             rc = CameraQueueCreate(&m_eventQ[i], &sCreateParams);
             CAM_MSG_ON_ERR(rc, "Failed to create event queue: %d", rc);
         }
     }
 
-    if (CAMERA_SUCCESS == rc)
-    {
-        rc = CameraCreateSignal(&m_eventHandlerSignal);
-        CAM_MSG_ON_ERR(rc, "Failed to create signal: %d", rc);
-    }
-
     if (CAMERA_SUCCESS == rc)
     {
         m_eventHandlerIsExit = FALSE;
+        m_numEventHandlers = STD_MIN(NUM_EVENT_HNDLR_POOL, AIS_ENGINE_QUEUE_MAX);
+        std_memset(m_eventHandlers, 0x0, sizeof(m_eventHandlers));
 
-        for (i = 0; i < NUM_EVENT_HNDLR_POOL; i++)
+        for (i = 0; i < (int)m_numEventHandlers; i++)
         {
             char name[64];
             snprintf(name, sizeof(name), "engine_evnt_hndlr_%d", i);
 
+            m_eventHandlers[i].pEngine = this;
+            m_eventHandlers[i].idx = i;
+
+            rc = CameraCreateSignal(&m_eventHandlers[i].signal);
+            if (CAMERA_SUCCESS != rc)
+            {
+                CAM_MSG(ERROR, "Failed to create signal: %d", rc);
+                break;
+            }
+
             if (0 !=  CameraCreateThread(CAMERA_THREAD_PRIO_HIGH_REALTIME,
                     0,
                     AisEngine::EventHandler,
-                    this,
+                    &m_eventHandlers[i],
                     0x8000,
                     name,
-                    &m_eventHandlerThreadId[i]))
+                    &m_eventHandlers[i].threadId))
             {
                 CAM_MSG(ERROR, "CameraCreateThread failed");
                 rc = CAMERA_EFAILED;
                 break;
             }
         }
+
+        CAM_MSG(HIGH, "%d event handlers for %d event queues of %d entries",
+                m_numEventHandlers, AIS_ENGINE_QUEUE_MAX, EVENT_QUEUE_MAX_SIZE);
     }
 
     if (CAMERA_SUCCESS == rc)
@@ -2432,10 +2458,48 @@ static CameraResult ais_usr_ctxt_calc_field(AisUsrCtxt* pUsrCtxt, ais_frame_done
     return result;
 }
 
+/**
+ * GetEventQueueIdx
+ *
+ * @brief Selects the event queue for an event: IFE events go to the queue
+ *        of their IFE core, everything else to the control queue
+ *
+ * @param pMsg
+ *
+ * @return queue index
+ */
+uint32 AisEngine::GetEventQueueIdx(ais_engine_event_msg_t* pMsg)
+{
+    IfeCoreType ifeCore = IFE_CORE_MAX;
+
+    switch (pMsg->event_id)
+    {
+    case AIS_EVENT_RAW_FRAME_DONE:
+    case AIS_EVENT_FRAME_DONE:
+        ifeCore = pMsg->payload.ife_frame_done.ife_core;
+        break;
+    case AIS_EVENT_SOF:
+    case AIS_EVENT_SOF_FREEZE:
+        ifeCore = pMsg->payload.sof_info.ife_core;
+        break;
+    default:
+        break;
+    }
+
+    if (ifeCore >= IFE_CORE_0 && ifeCore < IFE_CORE_MAX)
+    {
+        return AIS_ENGINE_QUEUE_IFE_0 + ifeCore;
+    }
+
+    return AIS_ENGINE_QUEUE_CTRL;
+}
+
 /**
  * ais_engine_queue_event
  *
- * @brief Queues events for engine
+ * @brief Queues events for engine. Under back-pressure SOF events are shed
+ *        first so frame done events keep their room in the queue. SOF of
+ *        interlaced inputs carries the field info and is never shed.
  *
  * @param ais_ctxt
  * @param event_id
@@ -2446,32 +2510,106 @@ static CameraResult ais_usr_ctxt_calc_field(AisUsrCtxt* pUsrCtxt, ais_frame_done
 CameraResult AisEngine::QueueEvent(ais_engine_event_msg_t* pMsg)
 {
     CameraResult result;
+    uint32 queueIdx = GetEventQueueIdx(pMsg);
+    ais_engine_queue_stats_t* pStats = &m_eventQStats[queueIdx];
+    uint32 length = 0;
 
-    CAM_MSG(LOW, "q_event %d", pMsg->event_id);
+    CAM_MSG(LOW, "q_event %d to queue %d", pMsg->event_id, queueIdx);
 
-    result = CameraQueueEnqueue(m_eventQ[AIS_ENGINE_QUEUE_EVENTS], pMsg);
+    if (AIS_EVENT_SOF == pMsg->event_id)
+    {
+        boolean shed = FALSE;
+
+        (void)CameraQueueGetLength(m_eventQ[queueIdx], &length);
+        if (length >= EVENT_QUEUE_SOF_WATERMARK)
+        {
+            AisUsrCtxt* pUsrCtxt = FindUsrCtxt(ais_usr_ctxt_match_ifeid, &pMsg->payload.sof_info);
+
+            shed = TRUE;
+            if (pUsrCtxt)
+            {
+                if (pUsrCtxt->m_inputCfg.inputModeInfo.interlaced)
+                {
+                    shed = FALSE;
+                }
+                PutUsrCtxt(pUsrCtxt);
+            }
+        }
+
+        if (shed)
+        {
+            uint32 dropped = CameraAtomicIncrement(&pStats->droppedSof);
+            if (1 == dropped || 0 == (dropped % EVENT_QUEUE_MAX_SIZE))
+            {
+                CAM_MSG(ERROR, "event queue %d backed up (%d), shed %d SOF events",
+                        queueIdx, length, dropped);
+            }
+            return CAMERA_SUCCESS;
+        }
+    }
+
+    result = CameraQueueEnqueue(m_eventQ[queueIdx], pMsg);
     if (result == CAMERA_SUCCESS)
     {
-        result = CameraSetSignal(m_eventHandlerSignal);
+        CameraAtomicIncrement(&pStats->enqueued);
+
+        if (CAMERA_SUCCESS == CameraQueueGetLength(m_eventQ[queueIdx], &length) &&
+            length > pStats->highWaterMark)
+        {
+            pStats->highWaterMark = length;
+        }
+
+        result = CameraSetSignal(m_eventHandlers[queueIdx % m_numEventHandlers].signal);
+    }
+    else
+    {
+        uint32 dropped = CameraAtomicIncrement(&pStats->dropped);
+        CAM_MSG(ERROR, "event queue %d dropped event %d (%d dropped so far): %d",
+                queueIdx, pMsg->event_id, dropped, result);
     }
 
     return result;
 }
 
+/**
+ * DumpEventQueueStats
+ *
+ * @brief Logs per event queue accounting
+ *
+ * @return n/a
+ */
+void AisEngine::DumpEventQueueStats(void)
+{
+    uint32 i;
+
+    for (i = 0; i < AIS_ENGINE_QUEUE_MAX; i++)
+    {
+        ais_engine_queue_stats_t* pStats = &m_eventQStats[i];
+
+        if (pStats->enqueued || pStats->dropped || pStats->droppedSof)
+        {
+            CAM_MSG(HIGH, "event queue %d: enqueued %d dropped %d shed SOF %d max depth %d/%d",
+                    i, pStats->enqueued, pStats->dropped, pStats->droppedSof,
+                    pStats->highWaterMark, EVENT_QUEUE_MAX_SIZE);
+        }
+    }
+}
+
 /**
  * ProcessEvent
  *
- * @brief Dequeues event from event Q and processes it
+ * @brief Dequeues event from an event Q and processes it
  *
+ * @param queueIdx
  * @param pMsg
  *
- * @return int
+ * @return 1 if an event was processed, 0 if the queue was empty
  */
-int AisEngine::ProcessEvent(ais_engine_event_msg_t* pMsg)
+int AisEngine::ProcessEvent(uint32 queueIdx, ais_engine_event_msg_t* pMsg)
 {
     CameraResult result;
 
-    result = CameraQueueDequeue(m_eventQ[AIS_ENGINE_QUEUE_EVENTS], pMsg);
+    result = CameraQueueDequeue(m_eventQ[queueIdx], pMsg);
     if (CAMERA_SUCCESS != result)
     {
         if (CAMERA_ENOMORE != result)
@@ -2586,7 +2724,8 @@ int AisEngine::ProcessEvent(ais_engine_event_msg_t* pMsg)
 int AisEngine::EventHandler(void *arg)
 {
     CameraResult rc = CAMERA_SUCCESS;
-    AisEngine* ais_ctxt = (AisEngine*)arg;
+    ais_engine_event_hndlr_t* pHndlr = (ais_engine_event_hndlr_t*)arg;
+    AisEngine* ais_ctxt = pHndlr ? pHndlr->pEngine : NULL;
 
     if (ais_ctxt)
     {
@@ -2597,22 +2736,36 @@ int AisEngine::EventHandler(void *arg)
             {
                 // track if there is anything processed in this iteration
                 int serviced = 0;
+                uint32 queueIdx;
 
-                CAM_MSG(LOW, "%s: is awake; ready to work.",
-                    __FUNCTION__);
+                CAM_MSG(LOW, "%s %d: is awake; ready to work.",
+                    __FUNCTION__, pHndlr->idx);
 
                 //
-                // service IFE callback, parse the msg, and put filled buffers in filledQ.
+                // service owned queues round robin, a bounded batch from each
+                // so a busy IFE core cannot starve the others on this handler
                 //
-                serviced += ais_ctxt->ProcessEvent(pMsg);
+                for (queueIdx = pHndlr->idx; queueIdx < AIS_ENGINE_QUEUE_MAX;
+                     queueIdx += ais_ctxt->m_numEventHandlers)
+                {
+                    int count = 0;
+
+                    while (count < EVENT_QUEUE_SERVICE_BATCH &&
+                           ais_ctxt->ProcessEvent(queueIdx, pMsg))
+                    {
+                        count++;
+                    }
+
+                    serviced += count;
+                }
 
                 //
                 // If we woke up with nothing to do, we'll try to sleep again.
                 //
-                //if (!serviced)
+                if (!serviced)
                 {
-                    CAM_MSG(LOW, "%s: has nothing to do, going to sleep", __FUNCTION__);
-                    CameraWaitOnSignal(ais_ctxt->m_eventHandlerSignal, CAM_SIGNAL_WAIT_NO_TIMEOUT);
+                    CAM_MSG(LOW, "%s %d: has nothing to do, going to sleep", __FUNCTION__, pHndlr->idx);
+                    CameraWaitOnSignal(pHndlr->signal, CAM_SIGNAL_WAIT_NO_TIMEOUT);
                 }
             }
 
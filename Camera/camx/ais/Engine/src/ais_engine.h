@@ -16,9 +16,26 @@
 #include "ais_configurer.h"
 
 #define MAX_USR_CONTEXTS 32
-#define NUM_EVENT_HNDLR_POOL 2
 
+/**
+ * Event handler threads. Each event queue is owned by exactly one handler
+ * (queue % pool size) so events of an IFE core are processed in order.
+ * Defaults to one handler per event queue.
+ */
+#ifndef NUM_EVENT_HNDLR_POOL
+#define NUM_EVENT_HNDLR_POOL AIS_ENGINE_QUEUE_MAX
+#endif
+
+/** Capacity of each event queue */
+#ifndef EVENT_QUEUE_MAX_SIZE
 #define EVENT_QUEUE_MAX_SIZE 32
+#endif
+
+/** Queue depth past which SOF events are dropped to keep room for frame done */
+#define EVENT_QUEUE_SOF_WATERMARK ((EVENT_QUEUE_MAX_SIZE * 3) / 4)
+
+/** Max events a handler takes from one queue before servicing its next queue */
+#define EVENT_QUEUE_SERVICE_BATCH 8
 
 /**
  * Convert errno to CameraResult
@@ -327,14 +344,42 @@ typedef struct
 
 /**
  * AIS Event Queue Type
+ *
+ * Control events (CSI errors, input status) share one queue; IFE events
+ * (frame done, SOF) get a queue per IFE core so a slow consumer or a burst
+ * on one core does not hold up the others.
  */
 typedef enum
 {
-    AIS_ENGINE_QUEUE_EVENTS,
-    AIS_ENGINE_QUEUE_ERRORS,
-    AIS_ENGINE_QUEUE_MAX,
+    AIS_ENGINE_QUEUE_CTRL = 0,
+    AIS_ENGINE_QUEUE_IFE_0,
+    AIS_ENGINE_QUEUE_MAX = AIS_ENGINE_QUEUE_IFE_0 + IFE_CORE_MAX,
 }ais_engine_queue_t;
 
+/**
+ * AIS event queue accounting
+ */
+typedef struct
+{
+    uint32 enqueued;      /**< events accepted */
+    uint32 dropped;       /**< events lost because the queue was full */
+    uint32 droppedSof;    /**< SOF events shed above EVENT_QUEUE_SOF_WATERMARK */
+    uint32 highWaterMark; /**< deepest observed queue length */
+}ais_engine_queue_stats_t;
+
+class AisEngine;
+
+/**
+ * AIS event handler thread context
+ */
+typedef struct
+{
+    AisEngine*   pEngine;
+    uint32       idx;      /**< handler index; owns queues idx, idx + pool, ... */
+    CameraSignal signal;   /**< set when one of the owned queues is fed */
+    void*        threadId;
+}ais_engine_event_hndlr_t;
+
 
 
 /**
@@ -396,7 +441,9 @@ private:
     void Deinitialize(void);
 
 
-    int ProcessEvent(ais_engine_event_msg_t* msg);
+    uint32 GetEventQueueIdx(ais_engine_event_msg_t* msg);
+    int ProcessEvent(uint32 queueIdx, ais_engine_event_msg_t* msg);
+    void DumpEventQueueStats(void);
     static int EventHandler(void *arg);
 
     CameraResult PowerSuspend(void);
@@ -434,11 +481,12 @@ private:
     CameraMutex m_mutex;
 
     /*event handlers*/
-    CameraSignal m_eventHandlerSignal;
-    void        *m_eventHandlerThreadId[NUM_EVENT_HNDLR_POOL];
+    uint32 m_numEventHandlers;
+    ais_engine_event_hndlr_t m_eventHandlers[NUM_EVENT_HNDLR_POOL];
 
     volatile boolean m_eventHandlerIsExit;
     CameraQueue m_eventQ[AIS_ENGINE_QUEUE_MAX];
+    ais_engine_queue_stats_t m_eventQStats[AIS_ENGINE_QUEUE_MAX];
     CameraMutex m_usrCtxtMapMutex;
     ais_usr_ctxt_map_t m_usrCtxtMap[MAX_USR_CONTEXTS];
 
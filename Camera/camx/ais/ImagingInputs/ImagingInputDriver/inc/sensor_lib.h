@@ -466,6 +466,10 @@ typedef struct {
     /* input status callback */
     int (*input_status_cb)(void *ctrl,
             struct camera_input_status_t *status);
+    /* defer i2c_slave_write_array until i2c_batch_flush (optional) */
+    int (*i2c_batch_begin)(void *ctrl);
+    /* submit deferred writes in issue order (optional) */
+    int (*i2c_batch_flush)(void *ctrl);
 }sensor_platform_func_table_t;
 
 /** I2C Function table
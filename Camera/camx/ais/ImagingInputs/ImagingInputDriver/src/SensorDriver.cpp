@@ -68,6 +68,20 @@ static int SensorDriver_SlaveWriteRegisters(void* ctrl, unsigned short slave_add
     return result;
 }
 
+static int SensorDriver_I2cBatchBegin(void* ctrl)
+{
+    SensorDriver* pSensorDriver = (SensorDriver*)ctrl;
+
+    return pSensorDriver->m_pSensorPlatform->SensorI2cBatchBegin();
+}
+
+static int SensorDriver_I2cBatchFlush(void* ctrl)
+{
+    SensorDriver* pSensorDriver = (SensorDriver*)ctrl;
+
+    return pSensorDriver->m_pSensorPlatform->SensorI2cBatchFlush();
+}
+
 static int SensorDriver_ExecutePowerSetting(void* ctrl,
         struct camera_power_setting *power_settings, unsigned short nSize)
 {
@@ -379,7 +393,7 @@ CameraResult SensorDriver::InitializeRegisters()
     else
     {
         SlaveAddr = (byte)m_pSensorLib->sensor_slave_info.slave_addr;
-        result = CAMERA_SUCCESS;
+        result = m_pSensorPlatform->SensorI2cBatchBegin();
         for (iInitSettingCount = 0; iInitSettingCount < m_pSensorLib->init_settings_array.size; iInitSettingCount++)
         {
             SENSOR_DEBUG("Array[%d] ", iInitSettingCount);
@@ -389,6 +403,11 @@ CameraResult SensorDriver::InitializeRegisters()
                 result = CAMERA_EFAILED;
             }
         }
+
+        if (CAMERA_SUCCESS != m_pSensorPlatform->SensorI2cBatchFlush())
+        {
+            result = CAMERA_EFAILED;
+        }
     }
 
     SENSOR_FUNCTIONEXIT("");
@@ -647,12 +666,21 @@ CameraResult SensorDriver::ConfigExposure(Camera_Sensor_ParamConfigType* pParamC
 
     if (m_pSensorLib->exposure_func_table.sensor_exposure_config)
     {
+        // exposure registers of a frame go out together once the lib is done
+        (void)m_pSensorPlatform->SensorI2cBatchBegin();
+
         if (m_pSensorLib->exposure_func_table.sensor_exposure_config(
                 (void*) m_pSensorLib, pExposureConfig->src_id, &exposure_info))
         {
             SENSOR_ERROR("Failed to set exposure configuration");
             result = CAMERA_EFAILED;
         }
+
+        if (CAMERA_SUCCESS != m_pSensorPlatform->SensorI2cBatchFlush())
+        {
+            SENSOR_ERROR("Failed to write exposure configuration");
+            result = CAMERA_EFAILED;
+        }
     }
     else
     {
@@ -766,6 +794,8 @@ CameraResult SensorDriver::Initialize(CameraSensorDevice* pCameraSensorDevice,
                 .execute_power_setting = &SensorDriver_ExecutePowerSetting,
                 .setup_gpio_interrupt = &SensorDriver_SetupGpioInterrupt,
                 .input_status_cb = &SensorDriver_InputStatusCallback,
+                .i2c_batch_begin = &SensorDriver_I2cBatchBegin,
+                .i2c_batch_flush = &SensorDriver_I2cBatchFlush,
         };
         pSensorData->sensor_custom_func.sensor_set_platform_func_table(
                 pSensorData, &platform_func_table);
@@ -0,0 +1,405 @@
+/**
+ * @file SensorI2cBatch.cpp
+ *
+ * @brief Sensor I2C write batching layer
+ *
+ * Copyright (c) 2019 Qualcomm Technologies, Inc.
+ * All Rights Reserved.
+ * Confidential and Proprietary - Qualcomm Technologies, Inc.
+ *
+ */
+
+/* ===========================================================================
+                        INCLUDE FILES FOR MODULE
+=========================================================================== */
+#include "SensorI2cBatch.h"
+#include "SensorDebug.h"
+
+/* ===========================================================================
+**                          Internal Helper Functions
+** =========================================================================*/
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - sensor_i2c_batch_data_width -
+ *
+ * DESCRIPTION: Register stride for a data type, 0 for masked read-modify-write
+ *              operations which never form a burst
+ * ------------------------------------------------------------------------ */
+static unsigned int sensor_i2c_batch_data_width(enum camera_i2c_data_type data_type)
+{
+    switch (data_type)
+    {
+    case CAMERA_I2C_BYTE_DATA:
+        return 1;
+    case CAMERA_I2C_WORD_DATA:
+        return 2;
+    case CAMERA_I2C_DWORD_DATA:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+/* ===========================================================================
+**                          SensorI2cBatch
+** =========================================================================*/
+
+SensorI2cBatch::SensorI2cBatch()
+{
+    m_pfnSubmit = NULL;
+    m_pSubmitCtxt = NULL;
+    m_mutex = NULL;
+    m_stateMutex = NULL;
+    m_depth = 0;
+    m_numSettings = 0;
+    m_numRegs = 0;
+    std_memset(&m_owner, 0, sizeof(m_owner));
+    std_memset(&m_stats, 0, sizeof(m_stats));
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Init -
+ *
+ * DESCRIPTION: Bind the batch to the platform transaction function
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::Init(sensor_i2c_batch_submit_t pfnSubmit, void* pCtxt)
+{
+    CameraResult result;
+
+    if (NULL == pfnSubmit)
+    {
+        return CAMERA_EBADPARM;
+    }
+
+    m_pfnSubmit = pfnSubmit;
+    m_pSubmitCtxt = pCtxt;
+    m_depth = 0;
+    m_numSettings = 0;
+    m_numRegs = 0;
+    std_memset(&m_stats, 0, sizeof(m_stats));
+
+    result = CameraCreateMutex(&m_stateMutex);
+    if (CAMERA_SUCCESS == result)
+    {
+        result = CameraCreateMutex(&m_mutex);
+        if (CAMERA_SUCCESS != result)
+        {
+            CameraDestroyMutex(m_stateMutex);
+            m_stateMutex = NULL;
+            m_mutex = NULL;
+        }
+    }
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Deinit -
+ *
+ * DESCRIPTION: Submit anything left over and release the batch
+ * ------------------------------------------------------------------------ */
+void SensorI2cBatch::Deinit()
+{
+    if (m_mutex)
+    {
+        if (IsOwner())
+        {
+            CAM_MSG(ERROR, "i2c batch still open (depth %d), submitting", m_depth);
+            CameraLockMutex(m_stateMutex);
+            m_depth = 0;
+            CameraUnlockMutex(m_stateMutex);
+        }
+        else
+        {
+            /* waits out a batch open on another thread */
+            CameraLockMutex(m_mutex);
+        }
+        (void)SyncLocked();
+        CameraUnlockMutex(m_mutex);
+
+        DumpStats();
+
+        CameraDestroyMutex(m_mutex);
+        m_mutex = NULL;
+        CameraDestroyMutex(m_stateMutex);
+        m_stateMutex = NULL;
+    }
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Begin -
+ *
+ * DESCRIPTION: Open a batch. Calls nest; only the outermost Flush submits.
+ *              The outermost Begin takes the bus lock and holds it until
+ *              the matching Flush.
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::Begin()
+{
+    /* without a mutex every write goes straight to the bus */
+    if (!m_mutex)
+    {
+        return CAMERA_SUCCESS;
+    }
+
+    CameraLockMutex(m_stateMutex);
+    if (m_depth && pthread_equal(m_owner, pthread_self()))
+    {
+        m_depth++;
+        CameraUnlockMutex(m_stateMutex);
+        return CAMERA_SUCCESS;
+    }
+    CameraUnlockMutex(m_stateMutex);
+
+    CameraLockMutex(m_mutex);
+
+    CameraLockMutex(m_stateMutex);
+    m_owner = pthread_self();
+    m_depth = 1;
+    CameraUnlockMutex(m_stateMutex);
+
+    return CAMERA_SUCCESS;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Flush -
+ *
+ * DESCRIPTION: Close a batch and submit everything staged in it
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::Flush()
+{
+    CameraResult result = CAMERA_SUCCESS;
+    boolean bLast = FALSE;
+
+    if (!m_mutex)
+    {
+        return CAMERA_SUCCESS;
+    }
+
+    CameraLockMutex(m_stateMutex);
+    if (0 == m_depth || !pthread_equal(m_owner, pthread_self()))
+    {
+        CAM_MSG(ERROR, "i2c batch flush without begin");
+        result = CAMERA_EBADSTATE;
+    }
+    else if (0 == --m_depth)
+    {
+        bLast = TRUE;
+    }
+    CameraUnlockMutex(m_stateMutex);
+
+    if (bLast)
+    {
+        m_stats.numBatches++;
+        result = SyncLocked();
+        CameraUnlockMutex(m_mutex);
+    }
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Sync -
+ *
+ * DESCRIPTION: Submit staged writes without closing the batch
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::Sync()
+{
+    CameraResult result;
+
+    if (!m_mutex)
+    {
+        return CAMERA_SUCCESS;
+    }
+
+    if (IsOwner())
+    {
+        return SyncLocked();
+    }
+
+    CameraLockMutex(m_mutex);
+    result = SyncLocked();
+    CameraUnlockMutex(m_mutex);
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - Write -
+ *
+ * DESCRIPTION: Stage a setting if this thread has a batch open, otherwise
+ *              submit it. A setting too large to stage drains the batch
+ *              first so bus order is kept.
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::Write(unsigned short slave_addr, struct camera_i2c_reg_setting *setting)
+{
+    CameraResult result = CAMERA_SUCCESS;
+
+    if (!setting || !setting->reg_array)
+    {
+        return CAMERA_EBADPARM;
+    }
+
+    if (!m_mutex)
+    {
+        return m_pfnSubmit ? m_pfnSubmit(m_pSubmitCtxt, slave_addr, setting) : CAMERA_EBADSTATE;
+    }
+
+    if (!IsOwner())
+    {
+        CameraLockMutex(m_mutex);
+        result = SubmitLocked(slave_addr, setting);
+        CameraUnlockMutex(m_mutex);
+        return result;
+    }
+
+    m_stats.numRegsStaged += setting->size;
+
+    if (!StageLocked(slave_addr, setting))
+    {
+        /* out of staging space */
+        result = SyncLocked();
+        if (CAMERA_SUCCESS == result && !StageLocked(slave_addr, setting))
+        {
+            result = SubmitLocked(slave_addr, setting);
+        }
+    }
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - DumpStats -
+ *
+ * DESCRIPTION: Log bus counters
+ * ------------------------------------------------------------------------ */
+void SensorI2cBatch::DumpStats()
+{
+    CAM_MSG(HIGH, "i2c batch: %llu batches %llu transactions, regs staged %llu submitted %llu bursts %llu",
+        m_stats.numBatches, m_stats.numTransactions,
+        m_stats.numRegsStaged, m_stats.numRegsSubmitted, m_stats.numBursts);
+    CAM_MSG(HIGH, "i2c batch: bus time total %llu ns max %llu ns avg %llu ns",
+        m_stats.totalSubmitTimeNs, m_stats.maxSubmitTimeNs,
+        m_stats.numTransactions ? (m_stats.totalSubmitTimeNs / m_stats.numTransactions) : 0);
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - IsOwner -
+ *
+ * DESCRIPTION: Whether the calling thread has a batch open, and so holds
+ *              the bus lock
+ * ------------------------------------------------------------------------ */
+boolean SensorI2cBatch::IsOwner()
+{
+    boolean bOwner;
+
+    CameraLockMutex(m_stateMutex);
+    bOwner = (m_depth && pthread_equal(m_owner, pthread_self())) ? TRUE : FALSE;
+    CameraUnlockMutex(m_stateMutex);
+
+    return bOwner;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - StageLocked -
+ *
+ * DESCRIPTION: Append a setting verbatim after everything staged so far.
+ *              Returns FALSE if it does not fit.
+ * ------------------------------------------------------------------------ */
+boolean SensorI2cBatch::StageLocked(unsigned short slave_addr, struct camera_i2c_reg_setting *setting)
+{
+    sensor_i2c_batch_setting_t* pStaged;
+
+    if (m_numSettings >= SENSOR_I2C_BATCH_MAX_SETTINGS ||
+        (m_numRegs + setting->size) > SENSOR_I2C_BATCH_MAX_REGS)
+    {
+        return FALSE;
+    }
+
+    pStaged = &m_settings[m_numSettings++];
+    pStaged->slave_addr = slave_addr;
+    pStaged->addr_type = setting->addr_type;
+    pStaged->data_type = setting->data_type;
+    pStaged->delay = setting->delay;
+    pStaged->start = (unsigned short)m_numRegs;
+    pStaged->size = setting->size;
+
+    std_memmove(&m_regs[m_numRegs], setting->reg_array, setting->size * sizeof(m_regs[0]));
+    m_numRegs += setting->size;
+
+    return TRUE;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - SubmitLocked -
+ *
+ * DESCRIPTION: One bus transaction with timing accounting. Consecutive
+ *              register addresses within the setting go out as a burst.
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::SubmitLocked(unsigned short slave_addr, struct camera_i2c_reg_setting *setting)
+{
+    CameraResult result;
+    uint64 startTime = 0;
+    uint64 endTime = 0;
+    uint64 elapsed;
+    unsigned int width = sensor_i2c_batch_data_width(setting->data_type);
+    unsigned short i;
+
+    for (i = 0; i < setting->size; i++)
+    {
+        if (0 == i || 0 == width || setting->reg_array[i].reg_addr != setting->reg_array[i - 1].reg_addr + width)
+        {
+            m_stats.numBursts++;
+        }
+    }
+
+    (void)CameraGetTime(&startTime);
+    result = m_pfnSubmit(m_pSubmitCtxt, slave_addr, setting);
+    (void)CameraGetTime(&endTime);
+
+    elapsed = (endTime > startTime) ? (endTime - startTime) : 0;
+    m_stats.numTransactions++;
+    m_stats.numRegsSubmitted += setting->size;
+    m_stats.totalSubmitTimeNs += elapsed;
+    if (elapsed > m_stats.maxSubmitTimeNs)
+    {
+        m_stats.maxSubmitTimeNs = elapsed;
+    }
+
+    return result;
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - SyncLocked -
+ *
+ * DESCRIPTION: Submit all staged settings in issue order. Stops at the
+ *              first failure; later writes may depend on it.
+ * ------------------------------------------------------------------------ */
+CameraResult SensorI2cBatch::SyncLocked()
+{
+    CameraResult result = CAMERA_SUCCESS;
+    struct camera_i2c_reg_setting setting;
+    uint32 i;
+
+    for (i = 0; i < m_numSettings; i++)
+    {
+        sensor_i2c_batch_setting_t* pStaged = &m_settings[i];
+
+        setting.reg_array = &m_regs[pStaged->start];
+        setting.size = pStaged->size;
+        setting.addr_type = pStaged->addr_type;
+        setting.data_type = pStaged->data_type;
+        setting.delay = pStaged->delay;
+
+        result = SubmitLocked(pStaged->slave_addr, &setting);
+        if (CAMERA_SUCCESS != result)
+        {
+            CAM_MSG(ERROR, "i2c batch submit to 0x%x failed %d, dropping %u staged settings",
+                pStaged->slave_addr, result, m_numSettings - i - 1);
+            break;
+        }
+    }
+    m_numSettings = 0;
+    m_numRegs = 0;
+
+    return result;
+}
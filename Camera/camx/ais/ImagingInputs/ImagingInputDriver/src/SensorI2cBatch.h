@@ -0,0 +1,141 @@
+#ifndef __SENSORI2CBATCH_H_
+#define __SENSORI2CBATCH_H_
+
+/**
+ * @file SensorI2cBatch.h
+ *
+ * @brief Declaration of the sensor I2C write batching layer
+ *
+ * Copyright (c) 2019 Qualcomm Technologies, Inc.
+ * All Rights Reserved.
+ * Confidential and Proprietary - Qualcomm Technologies, Inc.
+ *
+ */
+
+/*============================================================================
+                        INCLUDE FILES
+=========================================================================== */
+#include <pthread.h>
+
+#include "AEEstd.h"
+#include "sensor_lib.h"
+#include "CameraOSServices.h"
+
+/* ===========================================================================
+                        DATA DECLARATIONS
+=========================================================================== */
+/* ---------------------------------------------------------------------------
+** Constant / Define Declarations
+** ------------------------------------------------------------------------ */
+#define SENSOR_I2C_BATCH_MAX_SETTINGS 32
+#define SENSOR_I2C_BATCH_MAX_REGS     256
+
+/* ---------------------------------------------------------------------------
+** Type Definitions
+** ------------------------------------------------------------------------ */
+/**
+ * Submits one register array to a slave as a single bus transaction.
+ * Implemented by the owning sensor platform.
+ */
+typedef CameraResult (*sensor_i2c_batch_submit_t)(void* pCtxt,
+        unsigned short slave_addr, struct camera_i2c_reg_setting *setting);
+
+/**
+ * Per bus timing and coalescing counters
+ */
+typedef struct
+{
+    uint64 numBatches;          /**< batches flushed */
+    uint64 numTransactions;     /**< register arrays submitted to the bus */
+    uint64 numRegsStaged;       /**< register writes handed to the batch */
+    uint64 numRegsSubmitted;    /**< register writes that reached the bus */
+    uint64 numBursts;           /**< runs of consecutive register addresses */
+    uint64 totalSubmitTimeNs;   /**< time spent in bus transactions */
+    uint64 maxSubmitTimeNs;     /**< slowest single transaction */
+} sensor_i2c_batch_stats_t;
+
+/**
+ * One staged setting
+ */
+typedef struct
+{
+    unsigned short slave_addr;
+    enum camera_i2c_reg_addr_type addr_type;
+    enum camera_i2c_data_type data_type;
+    unsigned short delay;       /**< setting level delay */
+    unsigned short start;       /**< first entry in the staged register array */
+    unsigned short size;        /**< number of registers */
+} sensor_i2c_batch_setting_t;
+
+/**
+ * SensorI2cBatch
+ *
+ * Defers register writes between Begin() and Flush() and submits them in the
+ * order they were issued, one transaction per setting, across all slaves.
+ * No write is dropped or reordered.
+ *
+ * The thread that opens the outermost batch owns the bus until its matching
+ * Flush; writes from other threads block until then and go straight out.
+ */
+class SensorI2cBatch
+{
+public:
+    SensorI2cBatch();
+
+    CameraResult Init(sensor_i2c_batch_submit_t pfnSubmit, void* pCtxt);
+    void Deinit();
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - Begin -
+     *
+     * DESCRIPTION: Open a batch. Calls nest; only the outermost Flush submits.
+     * ------------------------------------------------------------------------ */
+    CameraResult Begin();
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - Flush -
+     *
+     * DESCRIPTION: Close a batch and submit everything staged in it
+     * ------------------------------------------------------------------------ */
+    CameraResult Flush();
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - Sync -
+     *
+     * DESCRIPTION: Submit staged writes without closing the batch. Must be
+     *              called before reading back from the bus.
+     * ------------------------------------------------------------------------ */
+    CameraResult Sync();
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - Write -
+     *
+     * DESCRIPTION: Stage a setting if a batch is open, otherwise submit it
+     * ------------------------------------------------------------------------ */
+    CameraResult Write(unsigned short slave_addr, struct camera_i2c_reg_setting *setting);
+
+    void DumpStats();
+
+private:
+    boolean IsOwner();
+    boolean StageLocked(unsigned short slave_addr, struct camera_i2c_reg_setting *setting);
+    CameraResult SubmitLocked(unsigned short slave_addr, struct camera_i2c_reg_setting *setting);
+    CameraResult SyncLocked();
+
+    sensor_i2c_batch_submit_t m_pfnSubmit;
+    void* m_pSubmitCtxt;
+    CameraMutex m_mutex;        /**< bus lock, held by the owner across an open batch */
+    CameraMutex m_stateMutex;   /**< protects m_owner and m_depth */
+
+    pthread_t m_owner;          /**< thread that opened the batch */
+    uint32 m_depth;             /**< Begin nesting of the owner, 0 if no batch is open */
+
+    uint32 m_numSettings;
+    uint32 m_numRegs;
+    sensor_i2c_batch_setting_t m_settings[SENSOR_I2C_BATCH_MAX_SETTINGS];
+    struct camera_i2c_reg_array m_regs[SENSOR_I2C_BATCH_MAX_REGS];
+
+    sensor_i2c_batch_stats_t m_stats;
+};
+
+#endif /* __SENSORI2CBATCH_H_ */
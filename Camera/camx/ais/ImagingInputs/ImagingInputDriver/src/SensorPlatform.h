@@ -123,6 +123,21 @@ public:
      * DESCRIPTION: Executes power suspend sequence defined in sensor library
      * ------------------------------------------------------------------------ */
     virtual CameraResult SensorPowerSuspend() = 0;
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - SensorI2cBatchBegin -
+     *
+     * DESCRIPTION: Defer slave writes until SensorI2cBatchFlush. Platforms
+     *              without batching write through.
+     * ------------------------------------------------------------------------ */
+    virtual CameraResult SensorI2cBatchBegin() { return CAMERA_SUCCESS; }
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - SensorI2cBatchFlush -
+     *
+     * DESCRIPTION: Submit deferred writes in issue order
+     * ------------------------------------------------------------------------ */
+    virtual CameraResult SensorI2cBatchFlush() { return CAMERA_SUCCESS; }
 };
 
 #endif /* __SENSORPLATFORM_H_ */
@@ -29,6 +29,7 @@
 #include "CameraOSServices.h"
 #include "CameraPlatformLinux.h"
 #include "SensorPlatform.h"
+#include "SensorI2cBatch.h"
 #include "SensorDebug.h"
 
 /* ---------------------------------------------------------------------------
@@ -134,11 +135,28 @@ public:
      * ------------------------------------------------------------------------ */
     virtual CameraResult SensorPowerSuspend();
 
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - sensor_i2c_batch_begin -
+     *
+     * DESCRIPTION: Defer slave writes until flush
+     * ------------------------------------------------------------------------ */
+    virtual CameraResult SensorI2cBatchBegin();
+
+    /* ---------------------------------------------------------------------------
+     * FUNCTION    - sensor_i2c_batch_flush -
+     *
+     * DESCRIPTION: Submit deferred writes in issue order
+     * ------------------------------------------------------------------------ */
+    virtual CameraResult SensorI2cBatchFlush();
+
     void sensor_platform_process_event(sensor_platform_interrupt_t *pPlatformIntr);
 
     static int sensor_platform_intr_poll_thread(void* arg);
 
 private:
+    static CameraResult SensorSubmitI2cSetting(void* pCtxt, unsigned short slave_addr,
+        struct camera_i2c_reg_setting *setting);
+
     sensor_lib_t* m_pSensorLib;
 
     int fd;
@@ -156,6 +174,9 @@ private:
     /*power*/
     enum sensor_camera_id camera_id;
     struct ais_sensor_probe_cmd *probe_cmd;
+
+    // batched register writes on this bus
+    SensorI2cBatch m_i2cBatch;
 };
 
 typedef int (*sensor_platform_event_thread_t)(void *arg);
@@ -594,6 +615,8 @@ CameraResult SensorPlatformLinux::Init()
             {
                 pCtxt->interrupts[i].isUsed = FALSE;
             }
+
+            result = m_i2cBatch.Init(SensorSubmitI2cSetting, pCtxt);
         }
 
         if (CAMERA_SUCCESS != result)
@@ -642,6 +665,8 @@ void SensorPlatformLinux::Deinit()
         }
     }
 
+    m_i2cBatch.Deinit();
+
     {//Unsubscribe events
         int ret = 0;
         struct v4l2_event_subscription sub;
@@ -823,6 +848,8 @@ CameraResult SensorPlatformLinux::SensorWriteI2cSettingArray(
     SensorPlatformLinux* pCtxt = this;
     unsigned short slave_addr = m_pSensorLib->sensor_slave_info.slave_addr;
 
+    (void)m_i2cBatch.Sync();
+
     memset(&cam_cmd, 0x0, sizeof(cam_cmd));
     memset(&i2c_write, 0x0, sizeof(i2c_write));
 
@@ -859,15 +886,26 @@ CameraResult SensorPlatformLinux::SensorWriteI2cSettingArray(
 /* ---------------------------------------------------------------------------
  * FUNCTION    - sensor_slave_write_i2c_setting -
  *
- * DESCRIPTION: Slave Write I2C setting array
+ * DESCRIPTION: Slave Write I2C setting array. Deferred while a batch is open.
  * ------------------------------------------------------------------------ */
 CameraResult SensorPlatformLinux::SensorSlaveWriteI2cSetting(
     unsigned short slave_addr, struct camera_i2c_reg_setting *setting)
+{
+    return m_i2cBatch.Write(slave_addr, setting);
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - sensor_submit_i2c_setting -
+ *
+ * DESCRIPTION: Write I2C setting array to a slave as one transaction
+ * ------------------------------------------------------------------------ */
+CameraResult SensorPlatformLinux::SensorSubmitI2cSetting(void* pPlatformCtxt,
+    unsigned short slave_addr, struct camera_i2c_reg_setting *setting)
 {
     uint32_t i = 0;
     struct cam_control cam_cmd;
     struct ais_sensor_cmd_i2c_wr_array i2c_write;
-    SensorPlatformLinux* pCtxt = this;
+    SensorPlatformLinux* pCtxt = (SensorPlatformLinux*)pPlatformCtxt;
 
     memset(&cam_cmd, 0x0, sizeof(cam_cmd));
     memset(&i2c_write, 0x0, sizeof(i2c_write));
@@ -880,7 +918,7 @@ CameraResult SensorPlatformLinux::SensorSlaveWriteI2cSetting(
 
     translate_sensor_reg_setting(&i2c_write, setting);
     i2c_write.i2c_config.i2c_freq_mode = sensor_sdk_util_get_i2c_freq_mode(
-        m_pSensorLib->sensor_slave_info.i2c_freq_mode);
+        pCtxt->m_pSensorLib->sensor_slave_info.i2c_freq_mode);
     i2c_write.i2c_config.slave_addr = slave_addr;
 
     CAM_MSG(HIGH, "slave %x reg array size %d", slave_addr,
@@ -915,6 +953,9 @@ CameraResult SensorPlatformLinux::SensorSlaveI2cRead(unsigned short slave_addr,
     struct ais_sensor_cmd_i2c_read i2c_read;
     SensorPlatformLinux* pCtxt = this;
 
+    // reads must observe every write issued before them
+    (void)m_i2cBatch.Sync();
+
     memset(&cam_cmd, 0x0, sizeof(cam_cmd));
     memset(&i2c_read, 0x0, sizeof(i2c_read));
 
@@ -956,6 +997,26 @@ CameraResult SensorPlatformLinux::SensorWriteI2cSetting(
     return SensorSlaveWriteI2cSetting(m_pSensorLib->sensor_slave_info.slave_addr, setting);
 }
 
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - sensor_i2c_batch_begin -
+ *
+ * DESCRIPTION: Defer slave writes until flush
+ * ------------------------------------------------------------------------ */
+CameraResult SensorPlatformLinux::SensorI2cBatchBegin()
+{
+    return m_i2cBatch.Begin();
+}
+
+/* ---------------------------------------------------------------------------
+ * FUNCTION    - sensor_i2c_batch_flush -
+ *
+ * DESCRIPTION: Submit deferred writes in issue order
+ * ------------------------------------------------------------------------ */
+CameraResult SensorPlatformLinux::SensorI2cBatchFlush()
+{
+    return m_i2cBatch.Flush();
+}
+
 /* ---------------------------------------------------------------------------
  * FUNCTION    - sensor_power_resume -
  *
@@ -799,11 +799,23 @@ static int max9296_sensor_start_stream(void* ctxt, unsigned int src_id_mask)
     int rc = 0;
     unsigned int i = 0;
     unsigned int started_mask = 0;
+    boolean start_deser = FALSE;
 
     max9296_context_t* pCtxt = (max9296_context_t*)ctxt;
 
     SERR("max9296_sensor_start_stream()");
 
+    /* serializer, sensor and deserializer start settings are staged in
+       order and go out on flush. The mutex is held across the whole batch
+       so it is always taken before the bus. Nothing is marked streaming
+       until the flush succeeds. */
+    CameraLockMutex(pCtxt->mutex);
+
+    if (pCtxt->platform_fcn_tbl.i2c_batch_begin)
+    {
+        pCtxt->platform_fcn_tbl.i2c_batch_begin(pCtxt->ctrl);
+    }
+
     //Now start the cameras
     for (i = 0; i < pCtxt->num_supported_sensors; i++)
     {
@@ -812,19 +824,15 @@ static int max9296_sensor_start_stream(void* ctxt, unsigned int src_id_mask)
             if (SENSOR_STATE_INITIALIZED == pCtxt->max9296_sensors[i].state)
             {
                 SENSOR_WARN("starting slave %x", pCtxt->max9296_sensors[i].serializer_alias);
-                {
-                    CameraLockMutex(pCtxt->mutex);
-
-                    //Only write to camera if sender
-                    if (!pCtxt->max9296_config.opMode)
-                    {
-                        pCtxt->max9296_sensors[i].sensor->start_link(pCtxt, i);
-                    }
 
-                   CameraUnlockMutex(pCtxt->mutex);
+                //Only write to camera if sender
+                if (!pCtxt->max9296_config.opMode &&
+                    pCtxt->max9296_sensors[i].sensor->start_link(pCtxt, i))
+                {
+                    SERR("Failed to start slave 0x%x", pCtxt->max9296_sensors[i].serializer_alias);
+                    rc = -1;
                 }
 
-                pCtxt->max9296_sensors[i].state = SENSOR_STATE_STREAMING;
                 started_mask |= (1 << i);
             }
             else
@@ -847,7 +855,6 @@ static int max9296_sensor_start_stream(void* ctxt, unsigned int src_id_mask)
 
         SHIGH("starting deserializer");
 
-        CameraLockMutex(pCtxt->mutex);
         //Start the deserialzer
         if ((rc = pCtxt->platform_fcn_tbl.i2c_slave_write_array(
                     pCtxt->ctrl,
@@ -856,10 +863,65 @@ static int max9296_sensor_start_stream(void* ctxt, unsigned int src_id_mask)
         {
             SERR("Failed to start de-serializer(0x%x)", pCtxt->slave_addr);
         }
-        CameraUnlockMutex(pCtxt->mutex);
+        start_deser = TRUE;
+    }
+
+    if (pCtxt->platform_fcn_tbl.i2c_batch_flush &&
+        pCtxt->platform_fcn_tbl.i2c_batch_flush(pCtxt->ctrl))
+    {
+        SERR("Failed to write start settings of max9296(0x%x)", pCtxt->slave_addr);
+        rc = -1;
+    }
+
+    if (!rc)
+    {
+        for (i = 0; i < pCtxt->num_supported_sensors; i++)
+        {
+            if ((1 << i) & started_mask)
+            {
+                pCtxt->max9296_sensors[i].state = SENSOR_STATE_STREAMING;
+            }
+        }
 
         pCtxt->streaming_src_mask |= started_mask;
-        pCtxt->state = MAX9296_STATE_STREAMING;
+        if (start_deser)
+        {
+            pCtxt->state = MAX9296_STATE_STREAMING;
+        }
+    }
+    else
+    {
+        /* some of the batch may have reached the bus, put it back to stopped */
+        if (start_deser)
+        {
+            pCtxt->max9296_reg_setting.reg_array = max9296_stop_reg_array;
+            pCtxt->max9296_reg_setting.size = STD_ARRAY_SIZE(max9296_stop_reg_array);
+            (void)pCtxt->platform_fcn_tbl.i2c_slave_write_array(
+                    pCtxt->ctrl,
+                    pCtxt->slave_addr,
+                    &pCtxt->max9296_reg_setting);
+        }
+
+        for (i = 0; i < pCtxt->num_supported_sensors; i++)
+        {
+            if ((1 << i) & started_mask)
+            {
+                /* stop_link only acts on a streaming link */
+                if (!pCtxt->max9296_config.opMode)
+                {
+                    pCtxt->max9296_sensors[i].state = SENSOR_STATE_STREAMING;
+                    (void)pCtxt->max9296_sensors[i].sensor->stop_link(pCtxt, i);
+                }
+                pCtxt->max9296_sensors[i].state = SENSOR_STATE_INITIALIZED;
+            }
+        }
+    }
+
+    CameraUnlockMutex(pCtxt->mutex);
+
+    if (rc)
+    {
+        return rc;
     }
 
     CameraLogEvent(CAMERA_SENSOR_EVENT_STREAM_START, 0, 0);
@@ -0,0 +1,47 @@
+#
+# camera_queue_test
+#
+LOCAL_PATH := $(call my-dir)
+include $(CLEAR_VARS)
+
+
+LOCAL_LDFLAGS :=
+
+LOCAL_SRC_FILES:= \
+	src/camera_queue_test.c \
+	../../CameraQueue/CameraQueueSCQ/src/CameraQueue.c \
+	../../CameraQueue/CameraQueueSCQ/src/CameraQueueLockFree.c \
+	../../CameraOSServices/CameraOSServicesMMOSAL/src/CameraOSServices.c \
+	../../Common/src/ais_log.c
+
+LOCAL_C_INCLUDES:= \
+	$(LOCAL_PATH)/../../API/inc \
+	$(LOCAL_PATH)/../../Common/inc \
+	$(LOCAL_PATH)/../../CameraEventLog/inc \
+	$(LOCAL_PATH)/../../CameraQueue/CameraQueue/inc \
+	$(LOCAL_PATH)/../../CameraOSServices/CameraOSServices/inc \
+	$(LOCAL_PATH)/../../CameraOSServices/CameraOSServicesMMOSAL/inc \
+	$(TARGET_OUT_HEADERS)/mm-osal/include \
+	$(TARGET_OUT_HEADERS)/common/inc
+
+LOCAL_CFLAGS :=-Werror \
+	-D_ANDROID_ \
+	-Wno-unused-parameter
+
+ifeq ($(call is-platform-sdk-version-at-least,28),true)
+LOCAL_HEADER_LIBRARIES := libmmosal_proprietary_headers
+endif
+
+LOCAL_SHARED_LIBRARIES:= libmmosal_proprietary liblog libcutils
+
+LOCAL_MODULE:= camera_queue_test
+LOCAL_PROPRIETARY_MODULE := true
+LOCAL_MODULE_TAGS := optional
+
+LOCAL_PRELINK_MODULE:= false
+
+ifeq ($(AIS_32_BIT_FLAG), true)
+LOCAL_32_BIT_ONLY := true
+endif
+
+include $(BUILD_EXECUTABLE)
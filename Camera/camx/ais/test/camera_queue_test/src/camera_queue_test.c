@@ -0,0 +1,461 @@
+/* ===========================================================================
+ * Copyright (c) 2019 Qualcomm Technologies, Inc.
+ * All Rights Reserved.
+ * Confidential and Proprietary - Qualcomm Technologies, Inc.
+=========================================================================== */
+/**
+ * @file camera_queue_test.c
+ *
+ * @brief Functional checks and throughput comparison of the CameraQueue
+ *        lock types: the mutex based SCQ queue and the lock-free SPSC and
+ *        MPMC rings.
+ *
+ * Usage: camera_queue_test [-iter=N] [-nobench]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "CameraQueue.h"
+
+#define CQT_MAX_PRODUCERS       4
+#define CQT_MAX_CONSUMERS       2
+#define CQT_WRAP_CAPACITY       5    /* not a power of two, the ring rounds up */
+#define CQT_WRAP_ROUNDS         1000
+#define CQT_STRESS_CAPACITY     64
+#define CQT_STRESS_PER_PRODUCER 200000
+#define CQT_BENCH_CAPACITY      256
+#define CQT_BENCH_ITERATIONS    1000000
+#define CQT_BATCH_SIZE          16
+#define CQT_WAIT_TIMEOUT_MS     10
+
+#define CQT_CHECK(_cond, ...) \
+    do { \
+        if (!(_cond)) \
+        { \
+            printf("FAIL %s:%d: ", __func__, __LINE__); \
+            printf(__VA_ARGS__); \
+            printf("\n"); \
+            return -1; \
+        } \
+    } while (0)
+
+typedef struct
+{
+    uint32 producer;
+    uint32 seq;
+} cqt_elem_t;
+
+typedef struct
+{
+    CameraQueue hQueue;
+    CameraQueueLockType lockType;
+    uint32 numPerProducer;
+    uint32 numProducers;
+    uint32 numConsumers;
+    boolean useWait;            /* consumer 0 blocks in DequeueWait instead of polling */
+    volatile uint32 numConsumed;
+    volatile int error;
+    unsigned char* pSeen;
+} cqt_stress_t;
+
+typedef struct
+{
+    cqt_stress_t* pStress;
+    uint32 id;
+} cqt_thread_t;
+
+static const char* cqt_lock_name(CameraQueueLockType lockType)
+{
+    switch (lockType)
+    {
+    case CAMERAQUEUE_LOCK_THREAD:
+        return "SCQ";
+    case CAMERAQUEUE_LOCK_FREE_SPSC:
+        return "SPSC";
+    case CAMERAQUEUE_LOCK_FREE_MPMC:
+        return "MPMC";
+    default:
+        return "?";
+    }
+}
+
+static uint64 cqt_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000ULL + (uint64)ts.tv_nsec;
+}
+
+static CameraResult cqt_create(CameraQueue* phQueue, CameraQueueLockType lockType, uint32 capacity)
+{
+    CameraQueueCreateParamType createParam;
+
+    memset(&createParam, 0x0, sizeof(createParam));
+    createParam.nCapacity = capacity;
+    createParam.nDataSizeInBytes = sizeof(cqt_elem_t);
+    createParam.eLockType = lockType;
+
+    return CameraQueueCreate(phQueue, &createParam);
+}
+
+/**
+ * cqt_wraparound
+ *
+ * @brief Fill and drain a queue of odd capacity many times over so the read
+ *        and write positions wrap repeatedly. Checks FIFO order, capacity
+ *        enforcement, length and batch dequeue at every step.
+ */
+static int cqt_wraparound(CameraQueueLockType lockType)
+{
+    CameraQueue hQueue = NULL;
+    CameraResult result;
+    cqt_elem_t elem;
+    cqt_elem_t batch[CQT_WRAP_CAPACITY];
+    uint32 capacity = 0;
+    uint32 length = 0;
+    uint32 dequeued = 0;
+    uint32 nextIn = 0;
+    uint32 nextOut = 0;
+    uint32 round;
+    uint32 i;
+    boolean isEmpty = FALSE;
+    boolean isFull = FALSE;
+
+    result = cqt_create(&hQueue, lockType, CQT_WRAP_CAPACITY);
+    CQT_CHECK(CAMERA_SUCCESS == result, "create failed %d", result);
+
+    (void)CameraQueueGetCapacity(hQueue, &capacity);
+    CQT_CHECK(CQT_WRAP_CAPACITY == capacity, "capacity %u", capacity);
+
+    for (round = 0; round < CQT_WRAP_ROUNDS; round++)
+    {
+        /* vary the fill level so wrap happens at every offset */
+        uint32 fill = 1 + (round % CQT_WRAP_CAPACITY);
+
+        for (i = 0; i < fill; i++)
+        {
+            elem.producer = 0;
+            elem.seq = nextIn++;
+            result = CameraQueueEnqueue(hQueue, &elem);
+            CQT_CHECK(CAMERA_SUCCESS == result, "round %u enqueue %u failed %d", round, i, result);
+        }
+
+        (void)CameraQueueGetLength(hQueue, &length);
+        CQT_CHECK(fill == length, "round %u length %u expected %u", round, length, fill);
+
+        (void)CameraQueueIsFull(hQueue, &isFull);
+        CQT_CHECK((fill == CQT_WRAP_CAPACITY) == !!isFull, "round %u full %d", round, isFull);
+        if (isFull)
+        {
+            result = CameraQueueEnqueue(hQueue, &elem);
+            CQT_CHECK(CAMERA_ENOMORE == result, "round %u enqueue past capacity %d", round, result);
+        }
+
+        /* alternate single and batch dequeue */
+        if (round & 1)
+        {
+            result = CameraQueueDequeueBatch(hQueue, batch, CQT_WRAP_CAPACITY, &dequeued);
+            CQT_CHECK(CAMERA_SUCCESS == result && fill == dequeued,
+                    "round %u batch %d got %u expected %u", round, result, dequeued, fill);
+            for (i = 0; i < dequeued; i++)
+            {
+                CQT_CHECK(nextOut == batch[i].seq, "round %u got %u expected %u", round, batch[i].seq, nextOut);
+                nextOut++;
+            }
+        }
+        else
+        {
+            for (i = 0; i < fill; i++)
+            {
+                result = CameraQueueDequeue(hQueue, &elem);
+                CQT_CHECK(CAMERA_SUCCESS == result, "round %u dequeue %u failed %d", round, i, result);
+                CQT_CHECK(nextOut == elem.seq, "round %u got %u expected %u", round, elem.seq, nextOut);
+                nextOut++;
+            }
+        }
+
+        (void)CameraQueueIsEmpty(hQueue, &isEmpty);
+        CQT_CHECK(isEmpty, "round %u not empty after drain", round);
+        result = CameraQueueDequeue(hQueue, &elem);
+        CQT_CHECK(CAMERA_ENOMORE == result, "round %u dequeue from empty %d", round, result);
+    }
+
+    if (CAMERAQUEUE_LOCK_THREAD != lockType)
+    {
+        result = CameraQueueDequeueWait(hQueue, &elem, CQT_WAIT_TIMEOUT_MS);
+        CQT_CHECK(CAMERA_EEXPIRED == result, "wait on empty %d", result);
+    }
+
+    (void)CameraQueueDestroy(hQueue);
+
+    printf("PASS wraparound %s (%u elements)\n", cqt_lock_name(lockType), nextOut);
+
+    return 0;
+}
+
+static void* cqt_producer(void* pArg)
+{
+    cqt_thread_t* pThread = (cqt_thread_t*)pArg;
+    cqt_stress_t* pStress = pThread->pStress;
+    cqt_elem_t elem;
+    uint32 i;
+
+    elem.producer = pThread->id;
+    for (i = 0; i < pStress->numPerProducer && !pStress->error; i++)
+    {
+        elem.seq = i;
+        while (CAMERA_SUCCESS != CameraQueueEnqueue(pStress->hQueue, &elem))
+        {
+            if (pStress->error)
+            {
+                return NULL;
+            }
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+static void* cqt_consumer(void* pArg)
+{
+    cqt_thread_t* pThread = (cqt_thread_t*)pArg;
+    cqt_stress_t* pStress = pThread->pStress;
+    uint32 total = pStress->numPerProducer * pStress->numProducers;
+    uint32 lastSeq[CQT_MAX_PRODUCERS];
+    cqt_elem_t batch[CQT_BATCH_SIZE];
+    uint32 dequeued;
+    uint32 i;
+
+    for (i = 0; i < CQT_MAX_PRODUCERS; i++)
+    {
+        lastSeq[i] = (uint32)-1;
+    }
+
+    while (__sync_fetch_and_add(&pStress->numConsumed, 0) < total && !pStress->error)
+    {
+        dequeued = 0;
+
+        if (!pStress->useWait || 0 != pThread->id)
+        {
+            (void)CameraQueueDequeueBatch(pStress->hQueue, batch, CQT_BATCH_SIZE, &dequeued);
+        }
+        else if (CAMERA_SUCCESS == CameraQueueDequeueWait(pStress->hQueue, &batch[0], CQT_WAIT_TIMEOUT_MS))
+        {
+            dequeued = 1;
+        }
+
+        if (0 == dequeued)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (i = 0; i < dequeued; i++)
+        {
+            cqt_elem_t* pElem = &batch[i];
+            uint32 idx;
+
+            if (pElem->producer >= pStress->numProducers || pElem->seq >= pStress->numPerProducer)
+            {
+                printf("FAIL consumer %u: bad element %u/%u\n", pThread->id, pElem->producer, pElem->seq);
+                pStress->error = 1;
+                return NULL;
+            }
+
+            /* one producer's elements must reach any one consumer in order */
+            if (lastSeq[pElem->producer] != (uint32)-1 && pElem->seq <= lastSeq[pElem->producer])
+            {
+                printf("FAIL consumer %u: producer %u seq %u after %u\n",
+                        pThread->id, pElem->producer, pElem->seq, lastSeq[pElem->producer]);
+                pStress->error = 1;
+                return NULL;
+            }
+            lastSeq[pElem->producer] = pElem->seq;
+
+            idx = pElem->producer * pStress->numPerProducer + pElem->seq;
+            if (__sync_lock_test_and_set(&pStress->pSeen[idx], 1))
+            {
+                printf("FAIL consumer %u: producer %u seq %u delivered twice\n",
+                        pThread->id, pElem->producer, pElem->seq);
+                pStress->error = 1;
+                return NULL;
+            }
+        }
+
+        (void)__sync_fetch_and_add(&pStress->numConsumed, dequeued);
+    }
+
+    return NULL;
+}
+
+/**
+ * cqt_run
+ *
+ * @brief Run producers and consumers against one queue until every element
+ *        was consumed. Returns the elapsed time in ns, 0 on failure.
+ */
+static uint64 cqt_run(CameraQueueLockType lockType, uint32 capacity,
+        uint32 numProducers, uint32 numConsumers, uint32 numPerProducer, boolean useWait)
+{
+    cqt_stress_t stress;
+    cqt_thread_t producers[CQT_MAX_PRODUCERS];
+    cqt_thread_t consumers[CQT_MAX_CONSUMERS];
+    pthread_t producerThreads[CQT_MAX_PRODUCERS];
+    pthread_t consumerThreads[CQT_MAX_CONSUMERS];
+    uint64 startTime;
+    uint64 elapsed;
+    uint32 i;
+
+    memset(&stress, 0x0, sizeof(stress));
+    stress.lockType = lockType;
+    stress.numPerProducer = numPerProducer;
+    stress.numProducers = numProducers;
+    stress.numConsumers = numConsumers;
+    stress.useWait = useWait;
+    stress.pSeen = (unsigned char*)calloc(numProducers * numPerProducer, 1);
+    if (!stress.pSeen || CAMERA_SUCCESS != cqt_create(&stress.hQueue, lockType, capacity))
+    {
+        printf("FAIL %s: setup\n", cqt_lock_name(lockType));
+        free(stress.pSeen);
+        return 0;
+    }
+
+    startTime = cqt_now_ns();
+
+    for (i = 0; i < numConsumers; i++)
+    {
+        consumers[i].pStress = &stress;
+        consumers[i].id = i;
+        pthread_create(&consumerThreads[i], NULL, cqt_consumer, &consumers[i]);
+    }
+    for (i = 0; i < numProducers; i++)
+    {
+        producers[i].pStress = &stress;
+        producers[i].id = i;
+        pthread_create(&producerThreads[i], NULL, cqt_producer, &producers[i]);
+    }
+
+    for (i = 0; i < numProducers; i++)
+    {
+        pthread_join(producerThreads[i], NULL);
+    }
+    for (i = 0; i < numConsumers; i++)
+    {
+        pthread_join(consumerThreads[i], NULL);
+    }
+
+    elapsed = cqt_now_ns() - startTime;
+
+    if (!stress.error && stress.numConsumed != numProducers * numPerProducer)
+    {
+        printf("FAIL %s: consumed %u of %u\n", cqt_lock_name(lockType),
+                stress.numConsumed, numProducers * numPerProducer);
+        stress.error = 1;
+    }
+
+    (void)CameraQueueDestroy(stress.hQueue);
+    free(stress.pSeen);
+
+    return stress.error ? 0 : (elapsed ? elapsed : 1);
+}
+
+/**
+ * cqt_concurrent
+ *
+ * @brief Every element from every producer is delivered exactly once and in
+ *        per-producer order.
+ */
+static int cqt_concurrent(CameraQueueLockType lockType, uint32 numProducers, uint32 numConsumers)
+{
+    /* the locked queues only support a zero timeout wait */
+    boolean useWait = (CAMERAQUEUE_LOCK_THREAD != lockType) ? TRUE : FALSE;
+
+    if (0 == cqt_run(lockType, CQT_STRESS_CAPACITY, numProducers, numConsumers, CQT_STRESS_PER_PRODUCER, useWait))
+    {
+        printf("FAIL concurrent %s %uP/%uC\n", cqt_lock_name(lockType), numProducers, numConsumers);
+        return -1;
+    }
+
+    printf("PASS concurrent %s %uP/%uC (%u elements)\n", cqt_lock_name(lockType),
+            numProducers, numConsumers, numProducers * CQT_STRESS_PER_PRODUCER);
+
+    return 0;
+}
+
+/**
+ * cqt_bench
+ *
+ * @brief Throughput of one producer/consumer configuration for the SCQ queue
+ *        and a lock-free variant. Consumers poll with batch dequeue in both.
+ */
+static int cqt_bench(CameraQueueLockType lockType, uint32 numProducers, uint32 numConsumers, uint32 iterations)
+{
+    uint32 perProducer = iterations / numProducers;
+    uint64 scqNs = cqt_run(CAMERAQUEUE_LOCK_THREAD, CQT_BENCH_CAPACITY, numProducers, numConsumers, perProducer, FALSE);
+    uint64 lfNs = cqt_run(lockType, CQT_BENCH_CAPACITY, numProducers, numConsumers, perProducer, FALSE);
+    uint32 total = perProducer * numProducers;
+
+    if (0 == scqNs || 0 == lfNs)
+    {
+        return -1;
+    }
+
+    printf("BENCH %uP/%uC %u elements: SCQ %llu ns/elem, %s %llu ns/elem (%.2fx)\n",
+            numProducers, numConsumers, total,
+            (unsigned long long)(scqNs / total),
+            cqt_lock_name(lockType), (unsigned long long)(lfNs / total),
+            (double)scqNs / (double)lfNs);
+
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    int rc = 0;
+    int i;
+    uint32 iterations = CQT_BENCH_ITERATIONS;
+    int bench = 1;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strncmp(argv[i], "-iter=", strlen("-iter=")))
+        {
+            iterations = (uint32)strtoul(argv[i] + strlen("-iter="), NULL, 0);
+        }
+        else if (!strcmp(argv[i], "-nobench"))
+        {
+            bench = 0;
+        }
+        else
+        {
+            printf("usage: %s [-iter=N] [-nobench]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    rc |= cqt_wraparound(CAMERAQUEUE_LOCK_THREAD);
+    rc |= cqt_wraparound(CAMERAQUEUE_LOCK_FREE_SPSC);
+    rc |= cqt_wraparound(CAMERAQUEUE_LOCK_FREE_MPMC);
+
+    rc |= cqt_concurrent(CAMERAQUEUE_LOCK_FREE_SPSC, 1, 1);
+    rc |= cqt_concurrent(CAMERAQUEUE_LOCK_FREE_MPMC, 1, 1);
+    rc |= cqt_concurrent(CAMERAQUEUE_LOCK_FREE_MPMC, CQT_MAX_PRODUCERS, 1);
+    rc |= cqt_concurrent(CAMERAQUEUE_LOCK_FREE_MPMC, CQT_MAX_PRODUCERS, CQT_MAX_CONSUMERS);
+    rc |= cqt_concurrent(CAMERAQUEUE_LOCK_THREAD, CQT_MAX_PRODUCERS, CQT_MAX_CONSUMERS);
+
+    if (bench && !rc && iterations >= CQT_MAX_PRODUCERS)
+    {
+        rc |= cqt_bench(CAMERAQUEUE_LOCK_FREE_SPSC, 1, 1, iterations);
+        rc |= cqt_bench(CAMERAQUEUE_LOCK_FREE_MPMC, 1, 1, iterations);
+        rc |= cqt_bench(CAMERAQUEUE_LOCK_FREE_MPMC, CQT_MAX_PRODUCERS, 1, iterations);
+    }
+
+    printf("%s\n", rc ? "FAILED" : "ALL PASSED");
+
+    return rc ? 1 : 0;
+}
@@ -42,6 +42,7 @@ LOCAL_SRC_FILES :=                          \
     camxpacketresource.cpp                  \
     camxpdafdata.cpp                        \
     camxpipeline.cpp                        \
+    camxrequestarena.cpp                    \
     camxsession.cpp                         \
     camxsettingsmanager.cpp                 \
     camxstatsparser.cpp                     \
@@ -86,6 +87,7 @@ LOCAL_INC_FILES :=                      \
     camxpipeline.h                      \
     camxpropertyblob.h                  \
     camxpropertydefs.h                  \
+    camxrequestarena.h                  \
     camxsession.h                       \
     camxsettingsmanager.h               \
     camxstaticcaps.h                    \
@@ -119,10 +119,10 @@ DeferredRequestQueue::~DeferredRequestQueue()
     }
 
     // Free all remaining entries in m_deferredNodes, and the data they reference
-    m_deferredNodes.FreeAllNodesAndTheirClientData();
+    FreeDependencyList(&m_deferredNodes);
 
     // Free all the entries in ready queue
-    m_readyNodes.FreeAllNodesAndTheirClientData();
+    FreeDependencyList(&m_readyNodes);
 
     if (NULL != m_pDeferredQueueLock)
     {
@@ -137,6 +137,27 @@ DeferredRequestQueue::~DeferredRequestQueue()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// DeferredRequestQueue::FreeDependencyList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredRequestQueue::FreeDependencyList(
+    LightweightDoublyLinkedList* pList)
+{
+    LightweightDoublyLinkedListNode* pNode = pList->RemoveFromHead();
+
+    while (NULL != pNode)
+    {
+        if (NULL != pNode->pData)
+        {
+            CAMX_REQUEST_FREE(pNode->pData);
+            pNode->pData = NULL;
+        }
+
+        CAMX_REQUEST_FREE(pNode);
+        pNode = pList->RemoveFromHead();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// DeferredRequestQueue::FreeDependencyMapListData
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -156,7 +177,7 @@ VOID DeferredRequestQueue::FreeDependencyMapListData(
             {
                 LightweightDoublyLinkedListNode* pNext = LightweightDoublyLinkedList::NextNode(pNode);
                 pList->RemoveNode(pNode);
-                CAMX_FREE(pNode);
+                CAMX_REQUEST_FREE(pNode);
                 pNode = pNext;
             }
 
@@ -180,6 +201,7 @@ CamxResult DeferredRequestQueue::Initialize(
     m_logEnabled     = HwEnvironment::GetInstance()->GetStaticSettings()->logDRQEnable;
     m_pThreadManager = pCreateData->pThreadManager;
     m_numPipelines   = pCreateData->numPipelines;
+    m_pRequestArena  = pCreateData->pRequestArena;
 
     for (UINT32 i = 0; i < m_numPipelines; i++)
     {
@@ -362,7 +384,7 @@ VOID* DeferredRequestQueue::DeferredWorkerWrapper(
         result = pDeferredQueue->DeferredWorkerCore(pDependency);
 
         pDeferredQueue->LockForPublish();
-        CAMX_FREE(pDependency);
+        CAMX_REQUEST_FREE(pDependency);
         pDependency = NULL;
         pDeferredQueue->UnlockAfterPublish();
 
@@ -385,7 +407,8 @@ CamxResult DeferredRequestQueue::AddDependencyEntry(
     UINT64     requestId = pDependency->requestId;
 
     LightweightDoublyLinkedListNode* pNode =
-        reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+        reinterpret_cast<LightweightDoublyLinkedListNode*>(
+            CAMX_REQUEST_CALLOC(m_pRequestArena, requestId, sizeof(LightweightDoublyLinkedListNode)));
 
     if (NULL != pNode)
     {
@@ -473,7 +496,8 @@ CamxResult DeferredRequestQueue::AddDependencyEntry(
             {
                 // Allocate new node representing that the node has a dependency on prop i from requeustId
                 pNode =
-                    reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+                    reinterpret_cast<LightweightDoublyLinkedListNode*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, requestId, sizeof(LightweightDoublyLinkedListNode)));
 
                 CAMX_ASSERT(NULL != pNode);
 
@@ -538,7 +562,8 @@ CamxResult DeferredRequestQueue::AddDependencyEntry(
             {
                 // Allocate new node representing that the node has a dependency on fence i from requeustId
                 pNode =
-                    reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+                    reinterpret_cast<LightweightDoublyLinkedListNode*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, requestId, sizeof(LightweightDoublyLinkedListNode)));
 
                 CAMX_ASSERT(NULL != pNode);
 
@@ -592,7 +617,8 @@ CamxResult DeferredRequestQueue::AddDependencyEntry(
             {
                 // Allocate new node representing that the node has a dependency on fence i from requeustId
                 pNode =
-                    reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+                    reinterpret_cast<LightweightDoublyLinkedListNode*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, requestId, sizeof(LightweightDoublyLinkedListNode)));
 
                 CAMX_ASSERT(NULL != pNode);
 
@@ -615,7 +641,8 @@ CamxResult DeferredRequestQueue::AddDependencyEntry(
             if (ChiFenceTypeInternal == pDependency->pChiFences[i]->type)
             {
                 DeferredFenceCallbackData* pData =
-                    reinterpret_cast<DeferredFenceCallbackData*>(CAMX_CALLOC(sizeof(DeferredFenceCallbackData)));
+                    reinterpret_cast<DeferredFenceCallbackData*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, pDependency->requestId, sizeof(DeferredFenceCallbackData)));
 
                 if (NULL != pData)
                 {
@@ -659,7 +686,8 @@ CamxResult DeferredRequestQueue::AddDeferredNode(
     CamxResult  result      = CamxResultSuccess;
 
     // Freed by DeferredWorkerCore when all dependencies have been satisfied
-    Dependency* pDependency = reinterpret_cast<Dependency*>(CAMX_CALLOC(sizeof(Dependency)));
+    Dependency* pDependency = reinterpret_cast<Dependency*>(
+        CAMX_REQUEST_CALLOC(m_pRequestArena, requestId, sizeof(Dependency)));
 
     if (NULL != pDependency)
     {
@@ -729,7 +757,8 @@ CamxResult DeferredRequestQueue::WaitForFenceDependency(
 {
     CamxResult  result      = CamxResultSuccess;
     // Freed by DeferredWorkerCore when all dependencies have been satisfied
-    Dependency* pDependency = reinterpret_cast<Dependency*>(CAMX_CALLOC(sizeof(Dependency)));
+    Dependency* pDependency = reinterpret_cast<Dependency*>(
+        CAMX_REQUEST_CALLOC(m_pRequestArena, RequestArenaNoRequest, sizeof(Dependency)));
 
     if (NULL != pDependency)
     {
@@ -760,7 +789,8 @@ CamxResult DeferredRequestQueue::WaitForFenceDependency(
             if (ChiFenceTypeInternal == pDependency->pChiFences[i]->type)
             {
                 DeferredFenceCallbackData* pData =
-                    reinterpret_cast<DeferredFenceCallbackData*>(CAMX_CALLOC(sizeof(DeferredFenceCallbackData)));
+                    reinterpret_cast<DeferredFenceCallbackData*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, RequestArenaNoRequest, sizeof(DeferredFenceCallbackData)));
 
                 if (NULL != pData)
                 {
@@ -1068,7 +1098,7 @@ VOID DeferredRequestQueue::DispatchReadyNodes()
         // Dispatch and remove all completed subscribers from the deferred node subscription list
         if (NULL != pReady)
         {
-            CAMX_FREE(pReady);
+            CAMX_REQUEST_FREE(pReady);
             CAMX_ASSERT(NULL != pDependency);
 
             if (NULL != pDependency)
@@ -1366,7 +1396,7 @@ VOID DeferredRequestQueue::FenceCallbackCSL(
 
     pData->pDeferredRequestQueue->UpdateChiFenceDependency(pData->pChiFence, CSLFenceResultSuccess == result);
 
-    CAMX_FREE(pData);
+    CAMX_REQUEST_FREE(pData);
     pData = NULL;
 }
 
@@ -1391,7 +1421,7 @@ VOID DeferredRequestQueue::DependencyFenceCallbackCSL(
     {
         CAMX_LOG_ERROR(CamxLogGroupDRQ, "Fence failure, fence callback will not be called");
     }
-    CAMX_FREE(pData);
+    CAMX_REQUEST_FREE(pData);
     pData = NULL;
 }
 
@@ -1406,7 +1436,8 @@ CamxResult DeferredRequestQueue::AddChiDependencyEntry(
     CAMX_ASSERT(pDependency->chiFenceCount > 0);
 
     LightweightDoublyLinkedListNode* pNode =
-        reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+        reinterpret_cast<LightweightDoublyLinkedListNode*>(
+            CAMX_REQUEST_CALLOC(m_pRequestArena, RequestArenaNoRequest, sizeof(LightweightDoublyLinkedListNode)));
 
     if (NULL != pNode)
     {
@@ -1455,7 +1486,8 @@ CamxResult DeferredRequestQueue::AddChiDependencyEntry(
             {
                 // Allocate new node representing that the node has a dependency on fence i
                 pNode =
-                    reinterpret_cast<LightweightDoublyLinkedListNode*>(CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+                    reinterpret_cast<LightweightDoublyLinkedListNode*>(
+                        CAMX_REQUEST_CALLOC(m_pRequestArena, RequestArenaNoRequest, sizeof(LightweightDoublyLinkedListNode)));
 
                 CAMX_ASSERT(NULL != pNode);
 
@@ -1539,7 +1571,7 @@ VOID DeferredRequestQueue::UpdateChiFenceDependency(
             pList->RemoveNode(pNode);
 
             // No longer need the linked list entry. The data is associated finally with m_CHIFenceDependencies
-            CAMX_FREE(pNode);
+            CAMX_REQUEST_FREE(pNode);
 
             pNode = pNext;
         }
@@ -1579,14 +1611,14 @@ VOID DeferredRequestQueue::UpdateChiFenceDependency(
                     result          = m_pThreadManager->PostJob(m_hDeferredWorker, NULL, &pData[0], FALSE, FALSE);
 
                     m_CHIFenceDependencies.RemoveNode(pDependencyRef);
-                    CAMX_FREE(pDependencyRef);  // Free the linked list entry
+                    CAMX_REQUEST_FREE(pDependencyRef);  // Free the linked list entry
                 }
             }
             else
             {
                 // No data for the entry to exist to track
                 m_CHIFenceDependencies.RemoveNode(pDependencyRef);
-                CAMX_FREE(pDependencyRef);
+                CAMX_REQUEST_FREE(pDependencyRef);
             }
             pDependencyRef = pNext;
         }
@@ -1831,7 +1863,7 @@ VOID DeferredRequestQueue::UpdateOrRemoveDependency(
 
                     pList->RemoveNode(pNode);
                     // No longer need the linked list entry. The data is associated finally with m_deferrednodes
-                    CAMX_FREE(pNode);
+                    CAMX_REQUEST_FREE(pNode);
                 }
             }
             pNode = pNext;
@@ -1914,10 +1946,10 @@ VOID DeferredRequestQueue::Flush()
     CamxAtomicStoreU(&m_numErrorRequests, 0);
 
     // Free all remaining entries in m_deferredNodes, and the data they reference
-    m_deferredNodes.FreeAllNodesAndTheirClientData();
+    FreeDependencyList(&m_deferredNodes);
 
     // Free all the entries in ready queue
-    m_readyNodes.FreeAllNodesAndTheirClientData();
+    FreeDependencyList(&m_readyNodes);
 
     m_pDeferredQueueLock->Unlock();
     CAMX_LOG_VERBOSE(CamxLogGroupCore, "DRQ Flush is done.");
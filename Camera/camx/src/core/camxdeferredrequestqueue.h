@@ -20,6 +20,7 @@
 #include "camxmetadatapool.h"
 #include "camxosutils.h"
 #include "camxpropertydefs.h"
+#include "camxrequestarena.h"
 #include "camxthreadmanager.h"
 #include "camxtypes.h"
 #include "camxchi.h"
@@ -87,6 +88,7 @@ struct DeferredRequestQueueCreateData
     UINT            numPipelines;                           ///< Number of Pipelines
     MetadataPool*   pMainPools[MaxPipelinesPerSession];     ///< Main Property Pools
     UINT            requestQueueDepth;                      ///< Depth of the request queue
+    RequestArena*   pRequestArena;                          ///< Arena for per request DRQ bookkeeping, may be NULL
 };
 
 /// @brief Callback data to identify the fence and the deferred processing object
@@ -599,6 +601,18 @@ private:
     static VOID FreeDependencyMapListData(
         VOID* pData);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FreeDependencyList
+    ///
+    /// @brief  Free all nodes of a deferred or ready list and the dependencies they reference
+    ///
+    /// @param  pList   List to empty
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID FreeDependencyList(
+        LightweightDoublyLinkedList* pList);
+
     // Do not implement the copy constructor or assignment operator
     DeferredRequestQueue(const DeferredRequestQueue& rDeferredRequestQueue) = delete;
     DeferredRequestQueue& operator= (const DeferredRequestQueue& rDeferredRequestQueue) = delete;
@@ -609,6 +623,7 @@ private:
     Hashmap*                    m_pDependencyMap;       ///< Hashmap to store pending dependencies
     Hashmap*                    m_pFenceRequestMap;     ///< Hashmap to store mapping from fence to request
     ThreadManager*              m_pThreadManager;       ///< Pointer to Thread Manager
+    RequestArena*               m_pRequestArena;        ///< Arena the per request bookkeeping is allocated from
     JobHandle                   m_hDeferredWorker;      ///< Deferred worker handle
     Mutex*                      m_pDeferredQueueLock;   ///< Lock to secure access to dependency map
     Mutex*                      m_pReadyQueueLock;      ///< Lock to secure access to ready queue
@@ -252,6 +252,14 @@ CamxResult HwEnvironment::Initialize()
                              pStaticSettings->sensorEmulator,
                              sizeof(pStaticSettings->sensorEmulator));
 
+            params.IFHBenchmarkParams.enableBenchmark       = pStaticSettings->IFHBenchmarkEnable;
+            params.IFHBenchmarkParams.targetFPS             = pStaticSettings->IFHBenchmarkFPS;
+            params.IFHBenchmarkParams.reportIntervalFrames  = pStaticSettings->IFHBenchmarkReportIntervalFrames;
+
+            OsUtils::StrLCpy(params.IFHBenchmarkParams.replayFile,
+                             pStaticSettings->IFHBenchmarkReplayFile,
+                             sizeof(params.IFHBenchmarkParams.replayFile));
+
             result = CSLInitialize(&params);
 
             if (CamxResultSuccess == result)
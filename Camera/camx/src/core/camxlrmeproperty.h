@@ -34,6 +34,7 @@ typedef struct
     INT32 fullWidth;
     INT32 fullHeight;
     INT32 alternateSkipProcessing;
+    INT32 adaptiveSkip;              /// LRME skipped the request on the adaptive schedule
 } LRMEPropertyFrameSettings;
 
 /// @brief enum to describe LRME/RANSAC transform type mask
@@ -19,6 +19,9 @@
 
 CAMX_NAMESPACE_BEGIN
 
+/// @brief Offset of an internal property that is not part of the compact layout of its pool
+static const UINT32 InvalidPropertyOffset = 0xFFFFFFFF;
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Namespaces
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -175,6 +178,13 @@ MetadataPool::~MetadataPool()
                                               m_hThread);
     }
 
+    if (0 < m_numOverflowAllocations)
+    {
+        // Properties missing from the node publish lists; adding them there moves them into the compact blob
+        CAMX_LOG_INFO(CamxLogGroupMeta, "[%s] %u internal property buffers allocated on demand, %llu bytes",
+                      m_pipelineName, m_numOverflowAllocations, m_overflowBytes);
+    }
+
     for (UINT32 slotIndex = 0; slotIndex < m_numSlots; ++slotIndex)
     {
         if (NULL != m_pSlots[slotIndex])
@@ -183,6 +193,12 @@ MetadataPool::~MetadataPool()
         }
     }
 
+    if (NULL != m_pPropertyOffsets)
+    {
+        CAMX_FREE(m_pPropertyOffsets);
+        m_pPropertyOffsets = NULL;
+    }
+
     for (UINT32 clientIndex = 0; clientIndex < MaxMetadataTags; clientIndex++)
     {
         m_pMetadataClients[clientIndex].clear();
@@ -236,7 +252,11 @@ CamxResult MetadataPool::Initialize()
             break;
 
         case PoolType::PerFrameInternal:
-            m_slotMetadataDataSize = sizeof(InternalPropertyBlob);
+            // With a compact layout the slot storage is allocated by ConfigurePropertyLayout
+            if (FALSE == HwEnvironment::GetInstance()->GetStaticSettings()->enableCompactInternalMetadata)
+            {
+                m_slotMetadataDataSize = sizeof(InternalPropertyBlob);
+            }
             break;
 
         case PoolType::PerFrameDebugData:
@@ -798,6 +818,72 @@ CamxResult MetadataPool::UpdatePublishSet(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MetadataPool::ConfigurePropertyLayout
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult MetadataPool::ConfigurePropertyLayout(
+    const std::unordered_set<UINT32>& propertySet)
+{
+    CamxResult result = CamxResultSuccess;
+
+    if ((PoolType::PerFrameInternal == m_poolType) &&
+        (NULL == m_pPropertyOffsets)               &&
+        (TRUE == HwEnvironment::GetInstance()->GetStaticSettings()->enableCompactInternalMetadata))
+    {
+        UINT32 numProperties = CAMX_ARRAY_SIZE(InternalPropertySizes);
+        UINT32 numLaidOut    = 0;
+        SIZE_T dataSize      = 0;
+
+        m_pPropertyOffsets = static_cast<UINT32*>(CAMX_CALLOC(numProperties * sizeof(UINT32)));
+
+        if (NULL == m_pPropertyOffsets)
+        {
+            result = CamxResultENoMemory;
+        }
+        else
+        {
+            // Lay out in property order so offsets do not depend on the iteration order of the set
+            for (UINT32 index = 0; index < numProperties; index++)
+            {
+                if (propertySet.end() != propertySet.find(PropertyIDPerFrameInternalBegin + index))
+                {
+                    dataSize                  = Utils::ByteAlign(dataSize, alignof(MAXALIGN_T));
+                    m_pPropertyOffsets[index] = static_cast<UINT32>(dataSize);
+                    dataSize                 += InternalPropertySizes[index];
+                    numLaidOut++;
+                }
+                else
+                {
+                    m_pPropertyOffsets[index] = InvalidPropertyOffset;
+                }
+            }
+
+            m_numProperties        = numProperties;
+            m_slotMetadataDataSize = dataSize;
+
+            for (UINT32 slotIndex = 0; slotIndex < m_numSlots; slotIndex++)
+            {
+                result = m_pSlots[slotIndex]->InitializePropertyLayout(dataSize, numProperties);
+                if (CamxResultSuccess != result)
+                {
+                    break;
+                }
+            }
+
+            SIZE_T fullSlotSize    = sizeof(InternalPropertyBlob);
+            SIZE_T compactSlotSize = dataSize + (numProperties * sizeof(VOID*));
+
+            CAMX_LOG_INFO(CamxLogGroupMeta,
+                          "[%s] internal metadata: %u of %u properties laid out, per slot %zu -> %zu bytes, "
+                          "%u slots %zu -> %zu KB",
+                          m_pipelineName, numLaidOut, numProperties, fullSlotSize, compactSlotSize, m_numSlots,
+                          (fullSlotSize * m_numSlots) / 1024, (compactSlotSize * m_numSlots) / 1024);
+        }
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MetadataSlot Methods
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -851,6 +937,7 @@ MetadataSlot::MetadataSlot(
     , m_pPool(pPool)
     , m_pRWLock(NULL)
     , m_pMetaBuffer(NULL)
+    , m_ppPropertyOverflow(NULL)
 {
 }
 
@@ -879,6 +966,20 @@ MetadataSlot::~MetadataSlot()
         m_pMetadata = NULL;
     }
 
+    if (NULL != m_ppPropertyOverflow)
+    {
+        for (UINT32 index = 0; index < m_pPool->m_numProperties; index++)
+        {
+            if (NULL != m_ppPropertyOverflow[index])
+            {
+                CAMX_FREE(m_ppPropertyOverflow[index]);
+            }
+        }
+
+        CAMX_FREE(m_ppPropertyOverflow);
+        m_ppPropertyOverflow = NULL;
+    }
+
     if ((PoolType::PerUsecase == m_pPool->GetPoolType()) && (NULL != m_pMetaBuffer))
     {
         m_pMetaBuffer->Destroy();
@@ -920,19 +1021,50 @@ CamxResult MetadataSlot::InitializeInternalMetadata()
 {
     CamxResult result = CamxResultSuccess;
 
-    m_pMetadata = CAMX_CALLOC(m_dataSize);
-
-    if (NULL == m_pMetadata)
+    // A zero size means the pool sizes the slot later from its compact property layout
+    if (0 < m_dataSize)
     {
-        CAMX_LOG_ERROR(CamxLogGroupMeta,
-                       "Couldn't allocate memory for metadata slot for pool %d ",
-                       static_cast<UINT>(m_pPool->GetPoolType()));
+        m_pMetadata = CAMX_CALLOC(m_dataSize);
 
-        result = CamxResultEFailed;
+        if (NULL == m_pMetadata)
+        {
+            CAMX_LOG_ERROR(CamxLogGroupMeta,
+                           "Couldn't allocate memory for metadata slot for pool %d ",
+                           static_cast<UINT>(m_pPool->GetPoolType()));
+
+            result = CamxResultEFailed;
+        }
     }
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MetadataSlot::InitializePropertyLayout
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult MetadataSlot::InitializePropertyLayout(
+    SIZE_T dataSize,
+    UINT32 numProperties)
+{
+    CamxResult result = CamxResultSuccess;
+
+    CAMX_ASSERT(NULL == m_pMetadata);
+    CAMX_ASSERT(NULL == m_ppPropertyOverflow);
+
+    m_dataSize           = dataSize;
+    m_ppPropertyOverflow = static_cast<VOID**>(CAMX_CALLOC(numProperties * sizeof(VOID*)));
+
+    // Allocate at least one byte so the blob pointer is valid even if no node declared an internal property
+    m_pMetadata = CAMX_CALLOC(Utils::MaxSIZET(m_dataSize, 1));
+
+    if ((NULL == m_pMetadata) || (NULL == m_ppPropertyOverflow))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupMeta, "Couldn't allocate %zu bytes of compact internal metadata", m_dataSize);
+        result = CamxResultENoMemory;
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MetadataSlot::InitializeMetaBuffers
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1424,6 +1556,68 @@ CamxResult MetadataSlot::GetPropertyBlob(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// MetadataSlot::GetPropertyData
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* MetadataSlot::GetPropertyData(
+    UINT32  propertyId,
+    BOOL    allocate)
+{
+    VOID*  pData = NULL;
+    UINT32 index = (propertyId & ~DriverInternalGroupMask);
+
+    CAMX_ASSERT(PropertyIDPerFrameInternalBegin == (propertyId & DriverInternalGroupMask));
+
+    if (NULL == m_pPool->m_pPropertyOffsets)
+    {
+        if (NULL != m_pMetadata)
+        {
+            pData = Utils::VoidPtrInc(m_pMetadata, InternalPropertyOffsets[index]);
+        }
+    }
+    else if (index < m_pPool->m_numProperties)
+    {
+        UINT32 offset = m_pPool->m_pPropertyOffsets[index];
+
+        if (InvalidPropertyOffset != offset)
+        {
+            pData = Utils::VoidPtrInc(m_pMetadata, offset);
+        }
+        else
+        {
+            pData = m_ppPropertyOverflow[index];
+
+            if ((NULL == pData) && (TRUE == allocate))
+            {
+                // The storage stays with the slot, so this happens at most once per slot and property
+                m_pPool->m_pPoolLock->Lock();
+
+                pData = m_ppPropertyOverflow[index];
+                if (NULL == pData)
+                {
+                    SIZE_T size = InternalPropertySizes[index];
+
+                    pData = CAMX_CALLOC(size);
+                    if (NULL != pData)
+                    {
+                        m_ppPropertyOverflow[index] = pData;
+                        CamxAtomicAddU64(&m_pPool->m_overflowBytes, size);
+                        CamxAtomicIncU(&m_pPool->m_numOverflowAllocations);
+
+                        CAMX_LOG_VERBOSE(CamxLogGroupMeta, "[%s] property %08x %s is not in any publish list, %zu bytes",
+                                         m_pPool->m_pipelineName, propertyId,
+                                         HAL3MetadataUtil::GetPropertyName(propertyId), size);
+                    }
+                }
+
+                m_pPool->m_pPoolLock->Unlock();
+            }
+        }
+    }
+
+    return pData;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // MetadataSlot::PublishMetadata
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -332,6 +332,20 @@ public:
     CamxResult GetPropertyBlob(
         VOID** ppBlob);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetPropertyData
+    ///
+    /// @brief  Retrieve the storage of an internal property, honoring the compact layout of the pool
+    ///
+    /// @param  propertyId  Internal property ID
+    /// @param  allocate    TRUE to allocate storage on demand for a property outside the compact layout (writers)
+    ///
+    /// @return Pointer to the property storage, NULL if the property has none
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID* GetPropertyData(
+        UINT32  propertyId,
+        BOOL    allocate);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// PublishMetadataList
     ///
@@ -561,6 +575,20 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     CamxResult InitializeInternalMetadata();
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// InitializePropertyLayout
+    ///
+    /// @brief  Allocate the internal property storage once the pool has a compact layout
+    ///
+    /// @param  dataSize        Size of the compact property blob
+    /// @param  numProperties   Number of internal properties, for the on-demand storage table
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult InitializePropertyLayout(
+        SIZE_T dataSize,
+        UINT32 numProperties);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// ReadPublished
     ///
@@ -695,6 +723,8 @@ private:
     ReadWriteLock*                                      m_pRWLock;              ///< Read-write lock used by pool as
                                                                                 ///< well as clients
     MetaBuffer*                                         m_pMetaBuffer;          ///< pointer to the metabuffer
+    VOID**                                              m_ppPropertyOverflow;   ///< On-demand storage of internal
+                                                                                ///  properties outside the layout
     std::array<std::atomic<BOOL>, MaxMetadataTags>      m_metadataPublishCount; ///< Atomic array to
                                                                                 ///  check if metadata is published
 };
@@ -947,6 +977,20 @@ public:
     CamxResult UpdatePublishSet(
         const std::unordered_set<UINT32>& publishSet);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ConfigurePropertyLayout
+    ///
+    /// @brief  Size the slots of a per-frame internal pool for the properties the pipeline publishes instead of the full
+    ///         InternalPropertyBlob. Other properties get storage on demand when first written. Does nothing unless
+    ///         enableCompactInternalMetadata is set. Must be called before the first request.
+    ///
+    /// @param  propertySet Internal properties published by the nodes of the pipeline
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult ConfigurePropertyLayout(
+        const std::unordered_set<UINT32>& propertySet);
+
 private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// MetadataPool
@@ -1230,6 +1274,11 @@ private:
     UINT64                          m_lastFlushRequestId;                   ///< requestId since the last flush
     UINT                            m_numPrePublishedTags;                  ///< Number of pre-published tag. This is valid
                                                                             ///  for PoolType::PerFrameResult only.
+    UINT32*                         m_pPropertyOffsets;                     ///< Compact blob offset of each internal
+                                                                            ///  property, NULL when using the full blob
+    UINT32                          m_numProperties;                        ///< Entries in m_pPropertyOffsets
+    volatile UINT64                 m_overflowBytes;                        ///< Bytes allocated on demand by all slots
+    volatile UINT                   m_numOverflowAllocations;               ///< Allocations made on demand by all slots
 
     // NOWHINE CP039: Public access permitted for the metadataslot since the class is part of the metadatapool interface.
     friend class MetadataSlot;
@@ -1446,6 +1446,8 @@ CamxResult Node::SetupRequest(
     m_perRequestInfo[requestIdIndex].metadataComplete         = 0;
     m_perRequestInfo[requestIdIndex].requestComplete          = 0;
     m_perRequestInfo[requestIdIndex].partialPublishedSet.clear();
+    Utils::Memset(m_perRequestInfo[requestIdIndex].stageTimestampNs, 0,
+                  sizeof(m_perRequestInfo[requestIdIndex].stageTimestampNs));
     SetRequestStatus(requestId, PerRequestNodeStatus::Setup);
 
     // Set the CSL sync ID for this request ID
@@ -1617,7 +1619,19 @@ CamxResult Node::ProcessRequest(
                 SetNodeProcessingTime(requestId, NodeStage::DependenciesMet);
             }
 
-            result = ExecuteProcessRequest(&executeProcessData);
+            if (TRUE == GetStaticSettings()->enableLatencyHistograms)
+            {
+                UINT64 startNs = OsUtils::GetNanoSeconds();
+
+                result = ExecuteProcessRequest(&executeProcessData);
+
+                m_latencyHistograms[static_cast<UINT>(NodeLatencyStage::ProcessRequest)].RecordInterval(
+                    startNs, OsUtils::GetNanoSeconds());
+            }
+            else
+            {
+                result = ExecuteProcessRequest(&executeProcessData);
+            }
         }
 
         // Flush the request if it was cancelled or completely failed
@@ -1969,7 +1983,9 @@ CamxResult Node::SetupRequestInputPorts(
                             // here and inform DRQ in there.
                             NodeSourceInputPortChiFenceCallbackData* pData =
                                 reinterpret_cast<NodeSourceInputPortChiFenceCallbackData*>(
-                                CAMX_CALLOC(sizeof(NodeSourceInputPortChiFenceCallbackData)));
+                                CAMX_REQUEST_CALLOC(m_pPipeline->GetRequestArena(),
+                                                    m_tRequestId,
+                                                    sizeof(NodeSourceInputPortChiFenceCallbackData)));
 
                             CAMX_ASSERT(NULL != pData);
 
@@ -2719,6 +2735,23 @@ VOID Node::SetNodeProcessingTime(
     UINT32   stageIndex     = static_cast<UINT32>(stage);
     UINT64   requestIdIndex = requestId % MaxRequestQueueDepth;
 
+    if ((TRUE == GetStaticSettings()->enableLatencyHistograms) &&
+        (stageIndex < static_cast<UINT32>(NodeStage::MaxNodeStatuses)))
+    {
+        UINT64* pStageTimestampNs = &m_perRequestInfo[requestIdIndex].stageTimestampNs[stageIndex];
+
+        // Keep the first time a stage is reached; DependenciesMet can be reported for more than one sequenceId
+        if (0 == *pStageTimestampNs)
+        {
+            *pStageTimestampNs = OsUtils::GetNanoSeconds();
+        }
+
+        if (NodeStage::End == stage)
+        {
+            RecordNodeLatency(requestId);
+        }
+    }
+
     if ((TRUE == GetStaticSettings()->dumpNodeProcessingInfo) &&
         (stageIndex < static_cast<UINT32>(NodeStage::MaxNodeStatuses)))
     {
@@ -2810,6 +2843,44 @@ VOID Node::DumpNodeProcessingAverage(
                   NodeIdentifierString(), averageProcessingTime, minProcessingTime, maxProcessingTime);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Node::RecordNodeLatency
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Node::RecordNodeLatency(
+    UINT64 requestId)
+{
+    const UINT64* pStageTimestampNs = m_perRequestInfo[requestId % MaxRequestQueueDepth].stageTimestampNs;
+    UINT64        startNs           = pStageTimestampNs[static_cast<UINT>(NodeStage::Start)];
+    UINT64        depMetNs          = pStageTimestampNs[static_cast<UINT>(NodeStage::DependenciesMet)];
+    UINT64        endNs             = pStageTimestampNs[static_cast<UINT>(NodeStage::End)];
+
+    // Nodes without dependencies never report DependenciesMet, they could execute right at Start
+    if (0 == depMetNs)
+    {
+        depMetNs = startNs;
+    }
+
+    m_latencyHistograms[static_cast<UINT>(NodeLatencyStage::DependencyWait)].RecordInterval(startNs, depMetNs);
+    m_latencyHistograms[static_cast<UINT>(NodeLatencyStage::FenceSignal)].RecordInterval(depMetNs, endNs);
+    m_latencyHistograms[static_cast<UINT>(NodeLatencyStage::Total)].RecordInterval(startNs, endNs);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Node::DumpLatencyHistograms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Node::DumpLatencyHistograms(
+    INT     fd,
+    UINT32  indent) const
+{
+    CHAR name[MaxStringLength256];
+
+    for (UINT stage = 0; stage < static_cast<UINT>(NodeLatencyStage::MaxNodeLatencyStages); stage++)
+    {
+        OsUtils::SNPrintF(name, sizeof(name), "%s.%s", NodeIdentifierString(), NodeLatencyStageStrings[stage]);
+        m_latencyHistograms[stage].DumpState(fd, indent, name);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Node::GetDataCountFromPipeline
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3039,10 +3110,8 @@ CamxResult Node::GetDataListFromMetadataPool(
                 {
                     if (TRUE == pSlot->IsPublished(UnitType::Property, pDataList[i]))
                     {
-                        pSlot->GetPropertyBlob(&pBlob);
-                        CAMX_ASSERT(NULL != pBlob);
-                        ppData[i] = (pBlob == NULL ) ? NULL :
-                                    Utils::VoidPtrInc(pBlob, InternalPropertyOffsets[pDataList[i] & ~DriverInternalGroupMask]);
+                        ppData[i] = pSlot->GetPropertyData(pDataList[i], FALSE);
+                        CAMX_ASSERT(NULL != ppData[i]);
                     }
                     else
                     {
@@ -3304,7 +3373,6 @@ CAMX_INLINE CamxResult Node::WriteData(
     MetadataSlot* pSlot = NULL;
     UINT32        group = (dataId & DriverInternalGroupMask);
     UINT32        tagId = (dataId & ~DriverInternalGroupMask);
-    VOID*         pBlob = NULL;
     VOID*         pPoolData = NULL;
 
     switch (group)
@@ -3372,9 +3440,8 @@ CAMX_INLINE CamxResult Node::WriteData(
         case static_cast<UINT32>(PropertyGroup::Internal) << 16:
             CAMX_ASSERT(PropertyIDPerFrameInternalEnd >= dataId);
             pSlot = m_pInternalPool->GetSlot(requestId);
-            pSlot->GetPropertyBlob(&pBlob);
-            CAMX_ASSERT(NULL != pBlob);
-            pPoolData = Utils::VoidPtrInc(pBlob, InternalPropertyOffsets[dataId & ~DriverInternalGroupMask]);
+            pPoolData = pSlot->GetPropertyData(dataId, TRUE);
+            CAMX_ASSERT(NULL != pPoolData);
             break;
         case static_cast<UINT32>(PropertyGroup::Usecase) << 16:
             CAMX_ASSERT(PropertyIDUsecaseEnd >= dataId);
@@ -8039,7 +8106,7 @@ VOID Node::NodeSourceInputPortChiFenceCallback(
 
     if (NULL != pData)
     {
-        CAMX_FREE(pData);
+        CAMX_REQUEST_FREE(pData);
     }
 }
 
@@ -598,6 +598,28 @@ static const CHAR* NodeStageStrings[] =
 
 CAMX_STATIC_ASSERT(CAMX_ARRAY_SIZE(NodeStageStrings) == (static_cast<UINT>(NodeStage::MaxNodeStatuses) + 1));
 
+/// @brief Per request intervals of a node that are kept in latency histograms
+enum class NodeLatencyStage
+{
+    DependencyWait,         ///< First ProcessRequest call until the dependencies are met
+    ProcessRequest,         ///< One ExecuteProcessRequest call
+    FenceSignal,            ///< Dependencies met until ProcessRequestIdDone, i.e. until all output fences are signaled
+    Total,                  ///< First ProcessRequest call until ProcessRequestIdDone
+    MaxNodeLatencyStages    ///< Maximum node latency stages
+};
+
+static const CHAR* NodeLatencyStageStrings[] =
+{
+    "DependencyWait",
+    "ProcessRequest",
+    "FenceSignal",
+    "Total",
+    "MaxNodeLatencyStages"
+};
+
+CAMX_STATIC_ASSERT(CAMX_ARRAY_SIZE(NodeLatencyStageStrings) ==
+                   (static_cast<UINT>(NodeLatencyStage::MaxNodeLatencyStages) + 1));
+
 /// @brief NodeStage name and timestamp of NodeStage completion
 struct NodeProcessingInfo
 {
@@ -621,6 +643,8 @@ struct NodePerRequestInfo
 
     NodeProcessingInfo          nodeProcessingStages[static_cast<UINT>(NodeStage::MaxNodeStatuses)]; ///< Time related info
                                                                                                      /// for each NodeStage
+    UINT64                      stageTimestampNs[static_cast<UINT>(NodeStage::MaxNodeStatuses)];     ///< Time each NodeStage
+                                                                                                     ///  was reached, 0 if not
 };
 
 /// @brief Execute process request data to be passed to the derived nodes that implement request processing
@@ -2226,6 +2250,37 @@ public:
         UINT32  indent,
         UINT64  requestId);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpLatencyHistograms
+    ///
+    /// @brief  Dumps the latency histogram summaries of the node to a file
+    ///
+    /// @param  fd          file descriptor
+    /// @param  indent      indent spaces.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpLatencyHistograms(
+        INT     fd,
+        UINT32  indent) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetLatencyHistogram
+    ///
+    /// @brief  Get the latency histogram of one stage of the node
+    ///
+    /// @param  stage   Stage to query
+    ///
+    /// @return Histogram of the stage
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE const LatencyHistogram* GetLatencyHistogram(
+        NodeLatencyStage stage) const
+    {
+        CAMX_ASSERT(stage < NodeLatencyStage::MaxNodeLatencyStages);
+
+        return &m_latencyHistograms[static_cast<UINT>(stage)];
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// DumpNodeInfo
     ///
@@ -2599,6 +2654,18 @@ public:
     VOID DumpNodeProcessingAverage(
         UINT64 requestId);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RecordNodeLatency
+    ///
+    /// @brief  Add the stage intervals of a request that finished processing to the latency histograms
+    ///
+    /// @param  requestId   Request that finished processing
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID RecordNodeLatency(
+        UINT64 requestId);
+
 protected:
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -4479,6 +4546,8 @@ private:
     UINT                   m_numCmdBufferManagers;                     ///< Number of cmd managers in m_pCmdManagers
     UINT                   m_maxNumCmdBufferManagers;                  ///< Max require number of command buffer managers
     NodePerRequestInfo     m_perRequestInfo[MaxRequestQueueDepth];     ///< Per request info
+    LatencyHistogram       m_latencyHistograms[static_cast<UINT>(NodeLatencyStage::MaxNodeLatencyStages)]; ///< Latency
+                                                                                                           ///  per stage
     UINT                   m_maxOutputPorts;                           ///< Max output ports(provided by derived node class)
     UINT                   m_maxInputPorts;                            ///< Max input ports(provided by derived node class)
     UINT                   m_inputPortDisableMask;                     ///< Input port disabled by node override mask
@@ -58,6 +58,7 @@ static const UINT SingleMetadataResult           = 1;
 static const UINT DefaultFPS                     = 30;
 static const UINT DefaultMaxPipelineDelay        = 3;
 static const UINT DefaultNodesRequestDoneTimeout = 300;   ///< Default nodes request done time out in ms
+static const UINT NodeInitJobOrdered             = 0xFFFFFFFF; ///< Marks a node placed while checking the init graph
 static const UINT DefaultStreamOnTimeout         = (LivePendingRequestTimeoutDefault - 100);
 
 CAMX_STATIC_ASSERT(0 < (LivePendingRequestTimeoutDefault - 100));
@@ -263,6 +264,38 @@ VOID Pipeline::Destroy()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::UpdateUsecaseMetadata
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult Pipeline::UpdateUsecaseMetadata()
+{
+    CamxResult    result                    = CamxResultSuccess;
+    MetadataSlot* pMetadataSlot             = m_pUsecasePool->GetSlot(0);
+    MetaBuffer*   pInitializationMetaBuffer = m_pPipelineDescriptor->pSessionMetadata;
+    MetaBuffer*   pMetadataSlotDstBuffer    = NULL;
+
+    // Copy metadata published by the Chi Usecase to this pipeline's UsecasePool
+    if (NULL != pInitializationMetaBuffer)
+    {
+        result = pMetadataSlot->GetMetabuffer(&pMetadataSlotDstBuffer);
+
+        if (CamxResultSuccess == result)
+        {
+            pMetadataSlotDstBuffer->Copy(pInitializationMetaBuffer, TRUE);
+        }
+        else
+        {
+            CAMX_LOG_ERROR(CamxLogGroupMeta, "Cannot copy! Error Code: %u", result);
+        }
+    }
+    else
+    {
+        CAMX_LOG_WARN(CamxLogGroupMeta, "No init metadata found!");
+    }
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Pipeline::Initialize
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -368,28 +401,7 @@ CamxResult Pipeline::Initialize(
         m_perRequestInfo[i].request.pStreamBuffers = &m_pStreamBufferBlob[i * GetNumBatchedFrames()];
     }
 
-    MetadataSlot*    pMetadataSlot                = m_pUsecasePool->GetSlot(0);
-    MetaBuffer*      pInitializationMetaBuffer    = m_pPipelineDescriptor->pSessionMetadata;
-    MetaBuffer*      pMetadataSlotDstBuffer       = NULL;
-
-    // Copy metadata published by the Chi Usecase to this pipeline's UsecasePool
-    if (NULL != pInitializationMetaBuffer)
-    {
-        result = pMetadataSlot->GetMetabuffer(&pMetadataSlotDstBuffer);
-
-        if (CamxResultSuccess == result)
-        {
-            pMetadataSlotDstBuffer->Copy(pInitializationMetaBuffer, TRUE);
-        }
-        else
-        {
-            CAMX_LOG_ERROR(CamxLogGroupMeta, "Cannot copy! Error Code: %u", result);
-        }
-    }
-    else
-    {
-        CAMX_LOG_WARN(CamxLogGroupMeta, "No init metadata found!");
-    }
+    result = UpdateUsecaseMetadata();
 
     ConfigureMaxPipelineDelay(m_pPipelineDescriptor->maxFPSValue, DefaultMaxPipelineDelay);
     QueryEISCaps();
@@ -492,6 +504,12 @@ VOID Pipeline::InitializeMetadataPools(
     CAMX_ASSERT(NULL != m_pMainPool);
     CAMX_ASSERT(NULL != m_pInputPool);
     CAMX_ASSERT(NULL != m_pInternalPool);
+
+    // The node publish lists were gathered when the nodes were created
+    if ((NULL != m_pInternalPool) && (CamxResultSuccess != m_pInternalPool->ConfigurePropertyLayout(m_nodeInternalPublishSet)))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "%s failed to size the internal metadata pool", GetPipelineIdentifierString());
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -912,6 +930,8 @@ CamxResult Pipeline::ProcessRequest(
     m_perRequestInfo[perRequestIdIndex].bufferDone = 0;
     m_perRequestInfo[perRequestIdIndex].fences.FreeAllNodesAndTheirClientData();
     m_perRequestInfo[perRequestIdIndex].isSlowdownPresent = FALSE;
+    m_perRequestInfo[perRequestIdIndex].processStartNs =
+        (TRUE == m_pHwContext->GetStaticSettings()->enableLatencyHistograms) ? OsUtils::GetNanoSeconds() : 0;
 
     CAMX_ASSERT(m_perRequestInfo[perRequestIdIndex].request.pStreamBuffers ==
         &m_pStreamBufferBlob[perRequestIdIndex * GetNumBatchedFrames()]);
@@ -1143,11 +1163,13 @@ CamxResult Pipeline::CreateNodes(
     m_nodeCount                        = pPipelineInfo->numNodes;
     m_ppNodes                          = static_cast<Node**>(CAMX_CALLOC(sizeof(Node*) * m_nodeCount));
     m_ppNodesFinalizeNegotiationOutput = static_cast<Node**>(CAMX_CALLOC(sizeof(Node*) * m_nodeCount));
+    m_pNodeOpenLatency                 = static_cast<NodeOpenLatency*>(CAMX_CALLOC(sizeof(NodeOpenLatency) * m_nodeCount));
 
     CAMX_ASSERT(NULL != m_ppNodesFinalizeNegotiationOutput);
 
     if ((NULL != m_ppNodes) &&
-        (NULL != m_ppNodesFinalizeNegotiationOutput))
+        (NULL != m_ppNodesFinalizeNegotiationOutput) &&
+        (NULL != m_pNodeOpenLatency))
     {
         NodeCreateInputData createInputData  = { 0 };
 
@@ -1222,8 +1244,12 @@ CamxResult Pipeline::CreateNodes(
                 }
             }
 
+            UINT64 createStartNs = OsUtils::GetNanoSeconds();
+
             result = Node::Create(&createInputData, &createOutputData);
 
+            m_pNodeOpenLatency[numNodes].createNs = OsUtils::GetNanoSeconds() - createStartNs;
+
             if (CamxResultSuccess == result)
             {
                 CAMX_LOG_CONFIG(CamxLogGroupCore,
@@ -1372,7 +1398,7 @@ CamxResult Pipeline::CreateNodes(
     }
     else
     {
-        CAMX_LOG_ERROR(CamxLogGroupCore, "m_ppNodes or m_ppNodesFinalizeNegotiationOutput is Null");
+        CAMX_LOG_ERROR(CamxLogGroupCore, "m_ppNodes, m_ppNodesFinalizeNegotiationOutput or m_pNodeOpenLatency is Null");
         result = CamxResultENoMemory;
     }
 
@@ -1551,6 +1577,7 @@ CamxResult Pipeline::FinalizePipeline(
 {
     CamxResult                    result              = CamxResultSuccess;
     const ImageSensorModuleData*  pSensorModuleData;
+    UINT64                        finalizeStartNs     = OsUtils::GetNanoSeconds();
 
     CAMX_ASSERT(NULL != pFinalizeInitializationData);
 
@@ -1614,20 +1641,20 @@ CamxResult Pipeline::FinalizePipeline(
         }
     }
 
-    if (CamxResultSuccess == result)
+    if ((CamxResultSuccess == result) && (TRUE == m_pHwContext->GetStaticSettings()->enableParallelNodeInit))
     {
-        for (UINT i = 0; i < m_nodeCount; i++)
+        // Without a graph the nodes are simply initialized in pipeline order
+        if (CamxResultSuccess != CreateNodeInitGraph())
         {
-            result = m_ppNodes[i]->FinalizeInitialization(pFinalizeInitializationData);
-
-            if (CamxResultSuccess != result)
-            {
-                CAMX_ASSERT_ALWAYS_MESSAGE("Failed to finalize init of node: %d", i);
-                break;
-            }
+            DestroyNodeInitGraph();
         }
     }
 
+    if (CamxResultSuccess == result)
+    {
+        result = RunNodeInitPhase(NodeInitPhase::FinalizeInitialization, pFinalizeInitializationData);
+    }
+
     if (CamxResultSuccess == result)
     {
         /// @todo (CAMX-1797) Simplify the logic involving m_ppNodesFinalizeNegotiationOutput
@@ -1648,12 +1675,17 @@ CamxResult Pipeline::FinalizePipeline(
             m_ppNodesFinalizeNegotiationOutput = NULL;
         }
 
+        // Buffer managers follow the negotiated buffer properties of the links, so they stay in pipeline order
         if (CamxResultSuccess == result)
         {
             for (UINT i = 0; i < m_nodeCount; i++)
             {
+                UINT64 startNs = OsUtils::GetNanoSeconds();
+
                 result = m_ppNodes[i]->CreateBufferManagers();
 
+                m_pNodeOpenLatency[i].bufferManagersNs = OsUtils::GetNanoSeconds() - startNs;
+
                 if (CamxResultSuccess != result)
                 {
                     break;
@@ -1661,22 +1693,23 @@ CamxResult Pipeline::FinalizePipeline(
             }
         }
 
+        if (CamxResultSuccess == result)
+        {
+            result = RunNodeInitPhase(NodeInitPhase::NotifyPipelineCreated, pFinalizeInitializationData);
+        }
+
         if (CamxResultSuccess == result)
         {
             for (UINT i = 0; i < m_nodeCount; i++)
             {
-                result = m_ppNodes[i]->NotifyPipelineCreated();
+                result = FilterAndUpdatePublishSet(m_ppNodes[i]);
 
                 if (CamxResultSuccess != result)
                 {
-                    CAMX_LOG_ERROR(CamxLogGroupCore, "Pipeline[%s] Failed to initialize %s: ",
-                                   GetPipelineIdentifierString(), m_ppNodes[i]->NodeIdentifierString());
+                    CAMX_LOG_ERROR(CamxLogGroupCore, "Pipeline[%s] Failed to update the publish set of %s, result=%d",
+                                   GetPipelineIdentifierString(), m_ppNodes[i]->NodeIdentifierString(), result);
                     break;
                 }
-                else
-                {
-                    result = FilterAndUpdatePublishSet(m_ppNodes[i]);
-                }
             }
         }
 
@@ -1687,10 +1720,14 @@ CamxResult Pipeline::FinalizePipeline(
         }
         else
         {
+            LogNodeOpenLatency(OsUtils::GetNanoSeconds() - finalizeStartNs);
+
             result = PrepareStreamOn();
         }
     }
 
+    DestroyNodeInitGraph();
+
     if (CamxResultSuccess == result)
     {
         result = Link();
@@ -1760,6 +1797,396 @@ CamxResult Pipeline::FinalizePipeline(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::CreateNodeInitGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult Pipeline::CreateNodeInitGraph()
+{
+    CamxResult             result        = CamxResultSuccess;
+    const PerPipelineInfo* pPipelineInfo = &m_pPipelineDescriptor->pipelineInfo;
+    UINT                   numLinks      = 0;
+
+    CAMX_ASSERT(NULL == m_pNodeInitJobs);
+
+    m_pNodeInitJobs = static_cast<NodeInitJob*>(CAMX_CALLOC(sizeof(NodeInitJob) * m_nodeCount));
+
+    if (NULL == m_pNodeInitJobs)
+    {
+        result = CamxResultENoMemory;
+    }
+
+    // Count the links first so that the child lists of all nodes can share one allocation
+    for (UINT pass = 0; (CamxResultSuccess == result) && (pass < 2); pass++)
+    {
+        for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+        {
+            const PerNodeInfo* pNodeInfo = &pPipelineInfo->pNodeInfo[nodeIndex];
+
+            m_pNodeInitJobs[nodeIndex].pPipeline = this;
+            m_pNodeInitJobs[nodeIndex].nodeIndex = nodeIndex;
+
+            for (UINT inputPortIndex = 0; inputPortIndex < pNodeInfo->inputPorts.numPorts; inputPortIndex++)
+            {
+                UINT parentNodeIndex = pNodeInfo->inputPorts.pPortInfo[inputPortIndex].parentNodeIndex;
+
+                // Loopback links only carry buffers between requests of the same node
+                if ((FALSE == m_ppNodes[nodeIndex]->IsSourceBufferInputPort(inputPortIndex)) &&
+                    (parentNodeIndex != nodeIndex)                                         &&
+                    (parentNodeIndex < m_nodeCount))
+                {
+                    NodeInitJob* pParent = &m_pNodeInitJobs[parentNodeIndex];
+
+                    if (0 == pass)
+                    {
+                        m_pNodeInitJobs[nodeIndex].numParents++;
+                        pParent->numChildren++;
+                        numLinks++;
+                    }
+                    else
+                    {
+                        pParent->pChildren[pParent->numChildren++] = nodeIndex;
+                    }
+                }
+            }
+        }
+
+        if ((0 == pass) && (0 < numLinks))
+        {
+            m_pNodeInitChildren = static_cast<UINT*>(CAMX_CALLOC(sizeof(UINT) * numLinks));
+
+            if (NULL == m_pNodeInitChildren)
+            {
+                result = CamxResultENoMemory;
+            }
+            else
+            {
+                UINT* pChildren = m_pNodeInitChildren;
+
+                for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+                {
+                    m_pNodeInitJobs[nodeIndex].pChildren    = pChildren;
+                    pChildren                              += m_pNodeInitJobs[nodeIndex].numChildren;
+                    m_pNodeInitJobs[nodeIndex].numChildren  = 0;
+                }
+            }
+        }
+    }
+
+    // Any other cycle would never release its nodes, so every node must be reachable by walking down from the roots
+    if (CamxResultSuccess == result)
+    {
+        UINT numOrdered   = 0;
+        BOOL madeProgress = TRUE;
+
+        for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+        {
+            m_pNodeInitJobs[nodeIndex].numPendingParents = m_pNodeInitJobs[nodeIndex].numParents;
+        }
+
+        while ((numOrdered < m_nodeCount) && (TRUE == madeProgress))
+        {
+            madeProgress = FALSE;
+
+            for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+            {
+                NodeInitJob* pJob = &m_pNodeInitJobs[nodeIndex];
+
+                if (0 == pJob->numPendingParents)
+                {
+                    for (UINT childIndex = 0; childIndex < pJob->numChildren; childIndex++)
+                    {
+                        m_pNodeInitJobs[pJob->pChildren[childIndex]].numPendingParents--;
+                    }
+
+                    pJob->numPendingParents = NodeInitJobOrdered;
+                    madeProgress            = TRUE;
+                    numOrdered++;
+                }
+            }
+        }
+
+        if (numOrdered < m_nodeCount)
+        {
+            CAMX_LOG_WARN(CamxLogGroupCore, "Pipeline[%s] links have a cycle, initializing nodes sequentially",
+                          GetPipelineIdentifierString());
+            result = CamxResultEFailed;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        m_pNodeInitLock = Mutex::Create("PipelineNodeInitLock");
+        m_pNodeInitDone = Condition::Create("PipelineNodeInitDone");
+
+        if ((NULL == m_pNodeInitLock) || (NULL == m_pNodeInitDone))
+        {
+            result = CamxResultENoMemory;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        CHAR wrapperName[FILENAME_MAX];
+
+        OsUtils::SNPrintF(&wrapperName[0], sizeof(wrapperName), "NodeInitJobFamily%p", this);
+        result = m_pThreadManager->RegisterJobFamily(NodeInitJobCb,
+                                                     wrapperName,
+                                                     NULL,
+                                                     JobPriority::Normal,
+                                                     FALSE,
+                                                     &m_hNodeInitJobFamily);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::DestroyNodeInitGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Pipeline::DestroyNodeInitGraph()
+{
+    if (InvalidJobHandle != m_hNodeInitJobFamily)
+    {
+        CHAR wrapperName[FILENAME_MAX];
+
+        OsUtils::SNPrintF(&wrapperName[0], sizeof(wrapperName), "NodeInitJobFamily%p", this);
+        m_pThreadManager->UnregisterJobFamily(NodeInitJobCb, wrapperName, m_hNodeInitJobFamily);
+        m_hNodeInitJobFamily = InvalidJobHandle;
+    }
+
+    if (NULL != m_pNodeInitDone)
+    {
+        m_pNodeInitDone->Destroy();
+        m_pNodeInitDone = NULL;
+    }
+
+    if (NULL != m_pNodeInitLock)
+    {
+        m_pNodeInitLock->Destroy();
+        m_pNodeInitLock = NULL;
+    }
+
+    if (NULL != m_pNodeInitChildren)
+    {
+        CAMX_FREE(m_pNodeInitChildren);
+        m_pNodeInitChildren = NULL;
+    }
+
+    if (NULL != m_pNodeInitJobs)
+    {
+        CAMX_FREE(m_pNodeInitJobs);
+        m_pNodeInitJobs = NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::RunNodeInitPhase
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult Pipeline::RunNodeInitPhase(
+    NodeInitPhase               phase,
+    FinalizeInitializationData* pFinalizeInitializationData)
+{
+    CamxResult result = CamxResultSuccess;
+
+    m_nodeInitPhase         = phase;
+    m_pNodeInitFinalizeData = pFinalizeInitializationData;
+
+    if (InvalidJobHandle == m_hNodeInitJobFamily)
+    {
+        for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+        {
+            result = InitializeNode(nodeIndex);
+
+            if (CamxResultSuccess != result)
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        m_pNodeInitLock->Lock();
+
+        m_numNodeInitPending = m_nodeCount;
+        m_nodeInitResult     = CamxResultSuccess;
+
+        for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+        {
+            m_pNodeInitJobs[nodeIndex].numPendingParents = m_pNodeInitJobs[nodeIndex].numParents;
+        }
+
+        for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+        {
+            if (0 == m_pNodeInitJobs[nodeIndex].numParents)
+            {
+                ScheduleNodeInitJob(&m_pNodeInitJobs[nodeIndex]);
+            }
+        }
+
+        while (0 < m_numNodeInitPending)
+        {
+            m_pNodeInitDone->Wait(m_pNodeInitLock->GetNativeHandle());
+        }
+
+        result = m_nodeInitResult;
+
+        m_pNodeInitLock->Unlock();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::InitializeNode
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult Pipeline::InitializeNode(
+    UINT nodeIndex)
+{
+    CamxResult result  = CamxResultSuccess;
+    Node*      pNode   = m_ppNodes[nodeIndex];
+    UINT64     startNs = OsUtils::GetNanoSeconds();
+
+    if (NodeInitPhase::FinalizeInitialization == m_nodeInitPhase)
+    {
+        result = pNode->FinalizeInitialization(m_pNodeInitFinalizeData);
+
+        m_pNodeOpenLatency[nodeIndex].finalizeNs = OsUtils::GetNanoSeconds() - startNs;
+
+        if (CamxResultSuccess != result)
+        {
+            CAMX_ASSERT_ALWAYS_MESSAGE("Failed to finalize init of node: %d", nodeIndex);
+        }
+    }
+    else
+    {
+        result = pNode->NotifyPipelineCreated();
+
+        m_pNodeOpenLatency[nodeIndex].notifyCreatedNs = OsUtils::GetNanoSeconds() - startNs;
+
+        if (CamxResultSuccess != result)
+        {
+            CAMX_LOG_ERROR(CamxLogGroupCore, "Pipeline[%s] Failed to initialize %s: ",
+                           GetPipelineIdentifierString(), pNode->NodeIdentifierString());
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::ScheduleNodeInitJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Pipeline::ScheduleNodeInitJob(
+    NodeInitJob* pJob)
+{
+    VOID*      pData[] = { pJob, NULL };
+    CamxResult result  = m_pThreadManager->PostJob(m_hNodeInitJobFamily, NULL, &pData[0], FALSE, FALSE);
+
+    if (CamxResultSuccess != result)
+    {
+        CAMX_LOG_WARN(CamxLogGroupCore, "Pipeline[%s] Failed to post init of %s, running it inline",
+                      GetPipelineIdentifierString(), m_ppNodes[pJob->nodeIndex]->NodeIdentifierString());
+
+        // m_pNodeInitLock is recursive, so the node can run on this thread with the lock still held
+        ProcessNodeInitJob(pJob);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::ProcessNodeInitJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Pipeline::ProcessNodeInitJob(
+    NodeInitJob* pJob)
+{
+    CamxResult result    = CamxResultSuccess;
+    BOOL       isSkipped = FALSE;
+
+    m_pNodeInitLock->Lock();
+    isSkipped = (CamxResultSuccess != m_nodeInitResult) ? TRUE : FALSE;
+    m_pNodeInitLock->Unlock();
+
+    // After a failure the remaining nodes are still walked, so that the phase completes, but no longer initialized
+    if (FALSE == isSkipped)
+    {
+        result = InitializeNode(pJob->nodeIndex);
+    }
+
+    m_pNodeInitLock->Lock();
+
+    if ((CamxResultSuccess != result) && (CamxResultSuccess == m_nodeInitResult))
+    {
+        m_nodeInitResult = result;
+    }
+
+    for (UINT childIndex = 0; childIndex < pJob->numChildren; childIndex++)
+    {
+        NodeInitJob* pChild = &m_pNodeInitJobs[pJob->pChildren[childIndex]];
+
+        pChild->numPendingParents--;
+
+        if (0 == pChild->numPendingParents)
+        {
+            ScheduleNodeInitJob(pChild);
+        }
+    }
+
+    m_numNodeInitPending--;
+
+    if (0 == m_numNodeInitPending)
+    {
+        m_pNodeInitDone->Signal();
+    }
+
+    m_pNodeInitLock->Unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::NodeInitJobCb
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* Pipeline::NodeInitJobCb(
+    VOID* pData)
+{
+    NodeInitJob* pJob = static_cast<NodeInitJob*>(pData);
+
+    CAMX_ASSERT(NULL != pJob);
+
+    pJob->pPipeline->ProcessNodeInitJob(pJob);
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Pipeline::LogNodeOpenLatency
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Pipeline::LogNodeOpenLatency(
+    UINT64 finalizeNs)
+{
+    UINT64 nodeInitNs = 0;
+
+    for (UINT nodeIndex = 0; nodeIndex < m_nodeCount; nodeIndex++)
+    {
+        const NodeOpenLatency* pLatency = &m_pNodeOpenLatency[nodeIndex];
+
+        nodeInitNs += pLatency->finalizeNs + pLatency->bufferManagersNs + pLatency->notifyCreatedNs;
+
+        CAMX_LOG_CONFIG(CamxLogGroupCore,
+                        "Pipeline[%s] Node::%s open latency: create %llu us, finalize %llu us, buffer managers %llu us, "
+                        "notify created %llu us",
+                        GetPipelineIdentifierString(),
+                        m_ppNodes[nodeIndex]->NodeIdentifierString(),
+                        pLatency->createNs / 1000,
+                        pLatency->finalizeNs / 1000,
+                        pLatency->bufferManagersNs / 1000,
+                        pLatency->notifyCreatedNs / 1000);
+    }
+
+    CAMX_LOG_CONFIG(CamxLogGroupCore, "Pipeline[%s] finalized in %llu us, nodes took %llu us initializing %s",
+                    GetPipelineIdentifierString(),
+                    finalizeNs / 1000,
+                    nodeInitNs / 1000,
+                    (InvalidJobHandle != m_hNodeInitJobFamily) ? "in parallel" : "sequentially");
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ///  Pipeline::DestroyNodes
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1788,6 +2215,12 @@ VOID Pipeline::DestroyNodes()
         m_nodeCount = 0;
     }
 
+    if (NULL != m_pNodeOpenLatency)
+    {
+        CAMX_FREE(m_pNodeOpenLatency);
+        m_pNodeOpenLatency = NULL;
+    }
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3202,6 +3635,24 @@ VOID Pipeline::PublishSensorUsecaseProperties(
     FinalizeSensorModeInitalization(pSensorModuleData);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Pipeline::DumpLatencyHistograms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Pipeline::DumpLatencyHistograms(
+    INT     fd,
+    UINT32  indent)
+{
+    m_requestLatency.DumpState(fd, indent, GetPipelineIdentifierString());
+
+    for (UINT index = 0; index < m_nodeCount; index++)
+    {
+        if (NULL != m_ppNodes[index])
+        {
+            m_ppNodes[index]->DumpLatencyHistograms(fd, indent + 2);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Pipeline::DumpState
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3320,6 +3771,20 @@ VOID Pipeline::DumpState(
         m_ppNodes[i]->DumpLinkInfo(fd, indent + 2);
     }
 
+    if (NULL != m_pNodeOpenLatency)
+    {
+        CAMX_LOG_TO_FILE(fd, indent, "Open latency (us): create / finalize / buffer managers / notify created");
+        for (UINT i = 0; i < m_nodeCount; i++)
+        {
+            CAMX_LOG_TO_FILE(fd, indent + 2, "%s: %llu / %llu / %llu / %llu",
+                             m_ppNodes[i]->NodeIdentifierString(),
+                             m_pNodeOpenLatency[i].createNs / 1000,
+                             m_pNodeOpenLatency[i].finalizeNs / 1000,
+                             m_pNodeOpenLatency[i].bufferManagersNs / 1000,
+                             m_pNodeOpenLatency[i].notifyCreatedNs / 1000);
+        }
+    }
+
     CAMX_LOG_TO_FILE(fd, indent, "+------------------------------------------------------------------+");
 
 }
@@ -3499,10 +3964,13 @@ CamxResult Pipeline::FilterAndUpdatePublishSet(
         {
             switch (pPublishedTagArray[index] & PropertyGroupMask)
             {
-                case UsecaseMetadataSectionMask:
                 case PropertyIDPerFrameInternalBegin:
+                    // Internal properties only size the internal pool
+                    m_nodeInternalPublishSet.insert(pPublishedTagArray[index]);
+                    continue;
+                case UsecaseMetadataSectionMask:
                 case PropertyIDUsecaseBegin:
-                    // skip usecase and internal tags
+                    // skip usecase tags
                     continue;
                 default:;
             }
@@ -3667,6 +4135,8 @@ VOID Pipeline::NotifyNodeRequestIdDone(
             GetPipelineName(),
             requestId);
 
+        m_requestLatency.RecordInterval(pPerRequestInfo->processStartNs, OsUtils::GetNanoSeconds());
+
         if (requestId > m_lastCompletedRequestId)
         {
             m_lastCompletedRequestId = requestId;
@@ -23,6 +23,7 @@
 #include "camxdefs.h"
 #include "camxhal3types.h"
 #include "camximageformatutils.h"
+#include "camxlatencyhistogram.h"
 #include "camxsession.h"
 #include "camxsettingsmanager.h"
 #include "camxthreadmanager.h"
@@ -124,6 +125,33 @@ struct FinalizeInitializationData
     UINT32                   resourcePolicy;                 ///< Prefered resource vs power trade-off
 };
 
+/// @brief Per node step of FinalizePipeline that can run on the thread pool
+enum class NodeInitPhase
+{
+    FinalizeInitialization,     ///< Node::FinalizeInitialization
+    NotifyPipelineCreated,      ///< Node::NotifyPipelineCreated, where IQ modules and command buffers are created
+};
+
+/// @brief Time a node spent in each step of opening the pipeline
+struct NodeOpenLatency
+{
+    UINT64 createNs;            ///< Node::Create
+    UINT64 finalizeNs;          ///< Node::FinalizeInitialization
+    UINT64 bufferManagersNs;    ///< Node::CreateBufferManagers
+    UINT64 notifyCreatedNs;     ///< Node::NotifyPipelineCreated
+};
+
+/// @brief One node of the dependency graph used to initialize nodes in parallel
+struct NodeInitJob
+{
+    Pipeline*   pPipeline;          ///< Pipeline owning the node
+    UINT        nodeIndex;          ///< Index of the node in the pipeline
+    UINT        numParents;         ///< Links from parent nodes, loopback links excluded
+    UINT        numPendingParents;  ///< Parent links whose node has not finished the current phase
+    UINT        numChildren;        ///< Entries in pChildren
+    UINT*       pChildren;          ///< Indices of the nodes linked to an output port of this node
+};
+
 /// @brief Pipeline create input data
 struct PipelineCreateInputData
 {
@@ -176,6 +204,7 @@ struct PerRequestInfo
     LightweightDoublyLinkedList fences;                            ///< Fences registered for request
     std::atomic<UINT8>          bufferDone;                        ///< Atomic count to indicate whether the buffer is done
     BOOL                        isSlowdownPresent;                 ///< Did we try to send metadata but shutter was not ready
+    UINT64                      processStartNs;                    ///< Time ProcessRequest was called, 0 if not captured
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -221,6 +250,15 @@ public:
         CAMX_LOG_VERBOSE(CamxLogGroupCore, "%s_%u: Updated m_referenceCount=%u", GetPipelineName(), GetPipelineId(), refCount);
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// UpdateUsecaseMetadata
+    ///
+    /// @brief  Copy the metadata published by the Chi usecase in the pipeline descriptor to the usecase pool
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult UpdateUsecaseMetadata();
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// GetCSLDevices
     ///
@@ -1173,6 +1211,32 @@ public:
         INT     fd,
         UINT32  indent);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpLatencyHistograms
+    ///
+    /// @brief  Dumps the latency histogram summaries of the pipeline and its nodes to a file
+    ///
+    /// @param  fd      file descriptor
+    /// @param  indent  indent spaces.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpLatencyHistograms(
+        INT     fd,
+        UINT32  indent);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetRequestLatencyHistogram
+    ///
+    /// @brief  Get the histogram of the time from ProcessRequest until all nodes are done with the request
+    ///
+    /// @return Histogram of the pipeline
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE const LatencyHistogram* GetRequestLatencyHistogram() const
+    {
+        return &m_requestLatency;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// DumpDebugInfo
     ///
@@ -1412,6 +1476,18 @@ public:
         return (NULL == m_pSession) ? FALSE : m_pSession->GetFlushStatus();
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetRequestArena
+    ///
+    /// @brief  Get the request arena of the owning session
+    ///
+    /// @return Pointer to the request arena, may be NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE RequestArena* GetRequestArena() const
+    {
+        return (NULL == m_pSession) ? NULL : m_pSession->GetRequestArena();
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// SaveLastValidRequestId
     ///
@@ -1719,6 +1795,100 @@ private:
     VOID PublishSensorUsecaseProperties(
         const ImageSensorModuleData* pSensorModuleData);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// CreateNodeInitGraph
+    ///
+    /// @brief  Build the node dependency graph from the pipeline links and set up the job family that walks it
+    ///
+    /// @return CamxResultSuccess if successful, CamxResultEFailed if the links are not a DAG
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult CreateNodeInitGraph();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DestroyNodeInitGraph
+    ///
+    /// @brief  Release the node dependency graph and its job family
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DestroyNodeInitGraph();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RunNodeInitPhase
+    ///
+    /// @brief  Run one step of FinalizePipeline on every node. With a node dependency graph, a node is posted to the thread
+    ///         pool as soon as all of its parents are done; otherwise the nodes run one after another in pipeline order.
+    ///
+    /// @param  phase                       Step to run
+    /// @param  pFinalizeInitializationData Finalize data handed to Node::FinalizeInitialization
+    ///
+    /// @return CamxResultSuccess if every node succeeded, else the first failure
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult RunNodeInitPhase(
+        NodeInitPhase               phase,
+        FinalizeInitializationData* pFinalizeInitializationData);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// InitializeNode
+    ///
+    /// @brief  Run the current step of FinalizePipeline on one node and record its latency
+    ///
+    /// @param  nodeIndex   Index of the node
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult InitializeNode(
+        UINT nodeIndex);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ScheduleNodeInitJob
+    ///
+    /// @brief  Post a node whose parents are all done to the thread pool, running it inline if the post fails. Must be called
+    ///         with m_pNodeInitLock held.
+    ///
+    /// @param  pJob    Node to run
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID ScheduleNodeInitJob(
+        NodeInitJob* pJob);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ProcessNodeInitJob
+    ///
+    /// @brief  Run a node, then release the children that were only waiting for it
+    ///
+    /// @param  pJob    Node to run
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID ProcessNodeInitJob(
+        NodeInitJob* pJob);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// NodeInitJobCb
+    ///
+    /// @brief  Thread pool entry of a node initialization job
+    ///
+    /// @param  pData   NodeInitJob of the node
+    ///
+    /// @return NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* NodeInitJobCb(
+        VOID* pData);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// LogNodeOpenLatency
+    ///
+    /// @brief  Log the time every node spent in each step of opening the pipeline
+    ///
+    /// @param  finalizeNs  Wall time of FinalizePipeline
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID LogNodeOpenLatency(
+        UINT64 finalizeNs);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// FilterAndUpdatePublishSet
     ///
@@ -1939,6 +2109,7 @@ private:
 
     volatile PipelineStatus        m_currentPipelineStatus;             ///< Flag to indicate pipeline status
     std::unordered_set<UINT32>     m_nodePublishSet;                    ///< Publish list from the pipeline
+    std::unordered_set<UINT32>     m_nodeInternalPublishSet;            ///< Internal properties published by the nodes
     std::unordered_set<UINT32>     m_nodePartialPublishSet;             ///< Partial Publist list
     UINT32                         m_metaBufferDelay;                   ///< Delay for releasing metabuffers
     BOOL                           m_bPartialMetadataEnabled;           ///< if partial Metadata is enabled
@@ -1958,6 +2129,17 @@ private:
                                                                         ///  destroyed when both the Session and Usecase have
                                                                         ///  given up references.
     volatile BOOL                  m_bCurrentSyncStatus;                ///< Flag to indicate sync status
+    LatencyHistogram               m_requestLatency;                    ///< ProcessRequest until all nodes are done
+    NodeOpenLatency*               m_pNodeOpenLatency;                  ///< Open latency of each node, m_nodeCount entries
+    NodeInitJob*                   m_pNodeInitJobs;                     ///< Node dependency graph, only while finalizing
+    UINT*                          m_pNodeInitChildren;                 ///< Storage of NodeInitJob::pChildren
+    JobHandle                      m_hNodeInitJobFamily;                ///< Job family running the node init jobs
+    Mutex*                         m_pNodeInitLock;                     ///< Protects the node init state below
+    Condition*                     m_pNodeInitDone;                     ///< Signaled when the last node of a phase is done
+    NodeInitPhase                  m_nodeInitPhase;                     ///< Phase being run by RunNodeInitPhase
+    FinalizeInitializationData*    m_pNodeInitFinalizeData;             ///< Finalize data of the phase being run
+    UINT                           m_numNodeInitPending;                ///< Nodes that have not finished the phase
+    CamxResult                     m_nodeInitResult;                    ///< First failure of the phase
 
     CHAR                           m_pipelineIdentifierString[MaxStringLength256]; ///< Pipeline name and id
     Condition*                     m_pWaitAllNodesRequestDone;                     ///< Wait till all node requests are done
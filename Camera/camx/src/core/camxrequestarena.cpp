@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxrequestarena.cpp
+/// @brief Request scoped arena implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "camxdebugprint.h"
+#include "camxmem.h"
+#include "camxrequestarena.h"
+#include "camxutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+// Blocks are handed out on this boundary so every client type stays naturally aligned
+static const SIZE_T RequestArenaBlockAlignment = 16;
+
+CAMX_STATIC_ASSERT(sizeof(RequestArenaBlockHeader) <= RequestArenaBlockAlignment);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::Create
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+RequestArena* RequestArena::Create(
+    const CHAR* pName,
+    UINT32      numSlots,
+    SIZE_T      slotSize)
+{
+    RequestArena* pArena = NULL;
+
+    if ((0 == numSlots) || (RequestArenaBlockAlignment >= slotSize))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "Invalid arena geometry numSlots %u slotSize %zu", numSlots, slotSize);
+    }
+    else
+    {
+        pArena = CAMX_NEW RequestArena();
+
+        if (NULL != pArena)
+        {
+            if (CamxResultSuccess != pArena->Initialize(pName, numSlots, slotSize))
+            {
+                CAMX_DELETE pArena;
+                pArena = NULL;
+            }
+        }
+    }
+
+    return pArena;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::Initialize
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult RequestArena::Initialize(
+    const CHAR* pName,
+    UINT32      numSlots,
+    SIZE_T      slotSize)
+{
+    CamxResult result = CamxResultSuccess;
+
+    m_pLock          = NULL;
+    m_pMemory        = NULL;
+    m_pSlots         = NULL;
+    m_numOutstanding = 0;
+    m_destroyPending = FALSE;
+    m_numSlots       = numSlots;
+    m_slotSize       = Utils::ByteAlign(slotSize, RequestArenaBlockAlignment);
+
+    Utils::Memset(&m_stats, 0, sizeof(m_stats));
+    OsUtils::StrLCpy(m_name, (NULL != pName) ? pName : "RequestArena", sizeof(m_name));
+
+    m_pLock   = Mutex::Create("RequestArena");
+    m_pSlots  = static_cast<ArenaSlot*>(CAMX_CALLOC(sizeof(ArenaSlot) * m_numSlots));
+    m_pMemory = static_cast<BYTE*>(CAMX_CALLOC(m_slotSize * m_numSlots));
+
+    if ((NULL == m_pLock) || (NULL == m_pSlots) || (NULL == m_pMemory))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "%s: out of memory for %u slots of %zu bytes", m_name, m_numSlots, m_slotSize);
+        result = CamxResultENoMemory;
+    }
+    else
+    {
+        for (UINT32 slot = 0; slot < m_numSlots; slot++)
+        {
+            m_pSlots[slot].pBase     = m_pMemory + (m_slotSize * slot);
+            m_pSlots[slot].requestId = RequestArenaNoRequest;
+        }
+
+        CAMX_LOG_VERBOSE(CamxLogGroupCore, "%s: %u slots of %zu bytes", m_name, m_numSlots, m_slotSize);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::~RequestArena
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+RequestArena::~RequestArena()
+{
+    if (NULL != m_pMemory)
+    {
+        CAMX_FREE(m_pMemory);
+        m_pMemory = NULL;
+    }
+
+    if (NULL != m_pSlots)
+    {
+        CAMX_FREE(m_pSlots);
+        m_pSlots = NULL;
+    }
+
+    if (NULL != m_pLock)
+    {
+        m_pLock->Destroy();
+        m_pLock = NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::Destroy
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID RequestArena::Destroy()
+{
+    BOOL deleteNow;
+
+    m_pLock->Lock();
+    deleteNow        = (0 == m_numOutstanding) ? TRUE : FALSE;
+    m_destroyPending = TRUE;
+    m_pLock->Unlock();
+
+    if (TRUE == deleteNow)
+    {
+        CAMX_DELETE this;
+    }
+    else
+    {
+        // Requests still referenced by an in-flight fence callback keep the arena alive until their last free
+        CAMX_LOG_INFO(CamxLogGroupCore, "%s: deferring destroy, %llu blocks outstanding", m_name, m_numOutstanding);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::AllocateFromSlot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+RequestArenaBlockHeader* RequestArena::AllocateFromSlot(
+    UINT64 requestId,
+    SIZE_T blockSize)
+{
+    RequestArenaBlockHeader* pHeader = NULL;
+    UINT32                   slot    = static_cast<UINT32>(requestId % m_numSlots);
+    ArenaSlot*               pSlot   = &m_pSlots[slot];
+
+    if ((0 != pSlot->numLive) && (requestId != pSlot->requestId))
+    {
+        m_stats.numSlotBusyFallbacks++;
+    }
+    else if ((m_slotSize - pSlot->offset) < blockSize)
+    {
+        m_stats.numSlotFullFallbacks++;
+    }
+    else
+    {
+        if (requestId != pSlot->requestId)
+        {
+            // The slot is idle: claim it for this request. The offset was already rewound when its last block was freed.
+            pSlot->requestId = requestId;
+            pSlot->numAllocs = 0;
+        }
+
+        pHeader = reinterpret_cast<RequestArenaBlockHeader*>(pSlot->pBase + pSlot->offset);
+        Utils::Memset(pHeader, 0, blockSize);
+
+        pHeader->slot     = slot;
+        pSlot->offset    += blockSize;
+        pSlot->numLive++;
+        pSlot->numAllocs++;
+
+        m_stats.numArenaAllocs++;
+        m_stats.bytesArena += blockSize;
+        m_stats.maxAllocsPerRequest = Utils::MaxUINT32(m_stats.maxAllocsPerRequest, pSlot->numAllocs);
+        m_stats.maxBytesPerRequest  = (pSlot->offset > m_stats.maxBytesPerRequest) ? pSlot->offset :
+                                                                                       m_stats.maxBytesPerRequest;
+    }
+
+    return pHeader;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::Calloc
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* RequestArena::Calloc(
+    RequestArena*   pArena,
+    UINT64          requestId,
+    SIZE_T          numBytes)
+{
+    RequestArenaBlockHeader* pHeader   = NULL;
+    SIZE_T                   blockSize = Utils::ByteAlign(numBytes + RequestArenaBlockAlignment,
+                                                          RequestArenaBlockAlignment);
+    BOOL                     fromArena = FALSE;
+    BOOL                     timed     = FALSE;
+    UINT64                   startNs   = 0;
+
+    if (NULL != pArena)
+    {
+        pArena->m_pLock->Lock();
+
+        timed = (0 == ((pArena->m_stats.numArenaAllocs + pArena->m_stats.numHeapAllocs) & RequestArenaTimingSampleMask)) ?
+            TRUE : FALSE;
+
+        if (TRUE == timed)
+        {
+            startNs = OsUtils::GetNanoSeconds();
+        }
+
+        if (RequestArenaNoRequest != requestId)
+        {
+            pHeader = pArena->AllocateFromSlot(requestId, blockSize);
+        }
+
+        if (NULL != pHeader)
+        {
+            fromArena = TRUE;
+            pArena->m_numOutstanding++;
+        }
+        else
+        {
+            pArena->m_stats.numHeapAllocs++;
+        }
+
+        pArena->m_pLock->Unlock();
+    }
+
+    if (NULL == pHeader)
+    {
+        pHeader = static_cast<RequestArenaBlockHeader*>(CAMX_CALLOC(blockSize));
+
+        if (NULL != pHeader)
+        {
+            pHeader->slot = InvalidSlot;
+
+            if (NULL != pArena)
+            {
+                pArena->m_pLock->Lock();
+                pArena->m_numOutstanding++;
+                pArena->m_pLock->Unlock();
+            }
+        }
+    }
+
+    if (NULL != pHeader)
+    {
+        pHeader->pArena = pArena;
+        pHeader->size   = static_cast<UINT32>(numBytes);
+    }
+
+    if (TRUE == timed)
+    {
+        UINT64 elapsedNs = OsUtils::GetNanoSeconds() - startNs;
+
+        pArena->m_pLock->Lock();
+        if (TRUE == fromArena)
+        {
+            pArena->m_stats.numArenaTimed++;
+            pArena->m_stats.arenaTimeNs += elapsedNs;
+        }
+        else
+        {
+            pArena->m_stats.numHeapTimed++;
+            pArena->m_stats.heapTimeNs += elapsedNs;
+        }
+        pArena->m_pLock->Unlock();
+    }
+
+    return (NULL != pHeader) ? (reinterpret_cast<BYTE*>(pHeader) + RequestArenaBlockAlignment) : NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::ReleaseBlock
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL RequestArena::ReleaseBlock(
+    RequestArenaBlockHeader* pHeader)
+{
+    BOOL lastReference = FALSE;
+
+    m_pLock->Lock();
+
+    if (InvalidSlot != pHeader->slot)
+    {
+        ArenaSlot* pSlot = &m_pSlots[pHeader->slot];
+
+        CAMX_ASSERT(0 < pSlot->numLive);
+
+        pSlot->numLive--;
+
+        if (0 == pSlot->numLive)
+        {
+            // Bulk recycle: nothing of this request is live any more, so rewind the whole slot at once
+            pSlot->offset = 0;
+            m_stats.numRecycles++;
+        }
+    }
+
+    m_stats.numFrees++;
+    m_numOutstanding--;
+
+    lastReference = ((TRUE == m_destroyPending) && (0 == m_numOutstanding)) ? TRUE : FALSE;
+
+    m_pLock->Unlock();
+
+    return lastReference;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::Free
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID RequestArena::Free(
+    VOID* pMemory)
+{
+    if (NULL != pMemory)
+    {
+        RequestArenaBlockHeader* pHeader = reinterpret_cast<RequestArenaBlockHeader*>(
+            static_cast<BYTE*>(pMemory) - RequestArenaBlockAlignment);
+        RequestArena*            pArena  = pHeader->pArena;
+        BOOL                     isHeap  = (InvalidSlot == pHeader->slot) ? TRUE : FALSE;
+
+        if ((NULL != pArena) && (TRUE == pArena->ReleaseBlock(pHeader)))
+        {
+            if (TRUE == isHeap)
+            {
+                CAMX_FREE(pHeader);
+                isHeap = FALSE;
+            }
+
+            CAMX_DELETE pArena;
+        }
+
+        if (TRUE == isHeap)
+        {
+            CAMX_FREE(pHeader);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestArena::DumpStats
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID RequestArena::DumpStats()
+{
+    RequestArenaStats stats;
+    UINT64            numRequests;
+
+    m_pLock->Lock();
+    stats = m_stats;
+    m_pLock->Unlock();
+
+    numRequests = (0 != stats.numRecycles) ? stats.numRecycles : 1;
+
+    CAMX_LOG_PERF_INFO(CamxLogGroupCore,
+                       "%s: arena %llu heap %llu (busy %llu full %llu) frees %llu recycles %llu "
+                       "avg allocs/req %llu max allocs/req %u max bytes/req %zu",
+                       m_name,
+                       stats.numArenaAllocs,
+                       stats.numHeapAllocs,
+                       stats.numSlotBusyFallbacks,
+                       stats.numSlotFullFallbacks,
+                       stats.numFrees,
+                       stats.numRecycles,
+                       stats.numArenaAllocs / numRequests,
+                       stats.maxAllocsPerRequest,
+                       stats.maxBytesPerRequest);
+
+    CAMX_LOG_PERF_INFO(CamxLogGroupCore,
+                       "%s: sampled alloc cost arena %llu ns over %llu, heap %llu ns over %llu",
+                       m_name,
+                       (0 != stats.numArenaTimed) ? (stats.arenaTimeNs / stats.numArenaTimed) : 0,
+                       stats.numArenaTimed,
+                       (0 != stats.numHeapTimed) ? (stats.heapTimeNs / stats.numHeapTimed) : 0,
+                       stats.numHeapTimed);
+}
+
+CAMX_NAMESPACE_END
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxrequestarena.h
+/// @brief Request scoped arena for the small per request bookkeeping objects of Session, DRQ and Node
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXREQUESTARENA_H
+#define CAMXREQUESTARENA_H
+
+#include "camxdefs.h"
+#include "camxosutils.h"
+#include "camxtypes.h"
+
+CAMX_NAMESPACE_BEGIN
+
+class RequestArena;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT64 RequestArenaNoRequest          = 0xFFFFFFFFFFFFFFFF;    ///< Request id for allocations with no request
+static const UINT32 RequestArenaTimingSampleMask   = 0xF;                   ///< Time one out of every 16 allocations
+static const SIZE_T RequestArenaDefaultSlotHeadroom = 8 * 1024;             ///< Slot bytes reserved for DRQ and Node data
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// CAMX_REQUEST_CALLOC
+///
+/// @brief  Allocates and zero-initializes numBytes whose lifetime is bound to requestId. The memory must be released with
+///         CAMX_REQUEST_FREE. A NULL arena or RequestArenaNoRequest falls back to the heap.
+///
+/// @param  pArena      Arena to allocate from, may be NULL
+/// @param  requestId   Request the allocation belongs to
+/// @param  numBytes    Number of bytes to allocate
+///
+/// @return non-NULL pointer if successful
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define CAMX_REQUEST_CALLOC(pArena, requestId, numBytes) \
+    RequestArena::Calloc((pArena), (requestId), (numBytes))
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// CAMX_REQUEST_FREE
+///
+/// @brief  Frees memory returned by CAMX_REQUEST_CALLOC. Does not need the arena, so it is usable from static callbacks.
+///
+/// @param  ptr Memory pointer to free
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define CAMX_REQUEST_FREE(ptr) \
+    RequestArena::Free(ptr)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Allocation accounting of a request arena
+struct RequestArenaStats
+{
+    UINT64 numArenaAllocs;          ///< Allocations served from a request slot
+    UINT64 numHeapAllocs;           ///< Allocations that fell back to the heap
+    UINT64 numSlotBusyFallbacks;    ///< Heap fallbacks because the slot was held by another live request
+    UINT64 numSlotFullFallbacks;    ///< Heap fallbacks because the slot had no room left
+    UINT64 numFrees;                ///< Frees of either kind
+    UINT64 numRecycles;             ///< Slots recycled in bulk after their last allocation was freed
+    UINT64 bytesArena;              ///< Bytes handed out from request slots
+    UINT32 maxAllocsPerRequest;     ///< Largest number of allocations a single request made from its slot
+    SIZE_T maxBytesPerRequest;      ///< Largest slot usage of a single request
+    UINT64 numArenaTimed;           ///< Sampled arena allocations
+    UINT64 arenaTimeNs;             ///< Time spent in the sampled arena allocations
+    UINT64 numHeapTimed;            ///< Sampled heap allocations
+    UINT64 heapTimeNs;              ///< Time spent in the sampled heap allocations
+};
+
+/// @brief Header in front of every block handed out, so a block can be freed without knowing its arena
+struct RequestArenaBlockHeader
+{
+    RequestArena*   pArena;     ///< Owning arena, NULL if the block came from the heap without an arena
+    UINT32          slot;       ///< Slot index, InvalidSlot if the block came from the heap
+    UINT32          size;       ///< Size requested by the client
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Request scoped arena
+///
+/// The arena owns a fixed number of slots. A request id maps to slot (requestId % numSlots) and every allocation made for
+/// that request is carved out of the slot with a bump pointer. Frees only count down; once the last allocation of a slot is
+/// freed the whole slot is recycled in one step and can be claimed by the next request that maps to it. Allocations whose
+/// slot is still held by an older request, or that do not fit, transparently fall back to the heap so the arena never fails
+/// where CAMX_CALLOC would have succeeded.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class RequestArena
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Create
+    ///
+    /// @brief  Create a request arena
+    ///
+    /// @param  pName       Name used in logs
+    /// @param  numSlots    Number of request slots, should cover the number of requests in flight
+    /// @param  slotSize    Bytes per slot
+    ///
+    /// @return Pointer to the arena or NULL on failure
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static RequestArena* Create(
+        const CHAR* pName,
+        UINT32      numSlots,
+        SIZE_T      slotSize);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Destroy
+    ///
+    /// @brief  Destroy the arena. If blocks are still outstanding the arena is released by the last CAMX_REQUEST_FREE.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID Destroy();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Calloc
+    ///
+    /// @brief  Allocate zeroed memory bound to a request, see CAMX_REQUEST_CALLOC
+    ///
+    /// @param  pArena      Arena to allocate from, may be NULL
+    /// @param  requestId   Request the allocation belongs to
+    /// @param  numBytes    Number of bytes to allocate
+    ///
+    /// @return non-NULL pointer if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* Calloc(
+        RequestArena*   pArena,
+        UINT64          requestId,
+        SIZE_T          numBytes);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Free
+    ///
+    /// @brief  Free memory returned by Calloc, see CAMX_REQUEST_FREE
+    ///
+    /// @param  pMemory Memory to free, may be NULL
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID Free(
+        VOID* pMemory);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpStats
+    ///
+    /// @brief  Log allocations per request and the sampled allocator time of arena versus heap allocations
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpStats();
+
+private:
+    /// @brief One request slot
+    struct ArenaSlot
+    {
+        BYTE*   pBase;          ///< Start of the slot memory
+        UINT64  requestId;      ///< Request currently owning the slot
+        SIZE_T  offset;         ///< Bump pointer
+        UINT32  numLive;        ///< Allocations not yet freed
+        UINT32  numAllocs;      ///< Allocations since the slot was last recycled
+    };
+
+    static const UINT32 InvalidSlot = 0xFFFFFFFF;   ///< Slot index of heap blocks
+
+    RequestArena()                                     = default;
+    ~RequestArena();
+    RequestArena(const RequestArena&)                  = delete;
+    RequestArena& operator=(const RequestArena&)       = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Initialize
+    ///
+    /// @brief  Allocate the slot memory and the lock
+    ///
+    /// @param  pName       Name used in logs
+    /// @param  numSlots    Number of request slots
+    /// @param  slotSize    Bytes per slot
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult Initialize(
+        const CHAR* pName,
+        UINT32      numSlots,
+        SIZE_T      slotSize);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AllocateFromSlot
+    ///
+    /// @brief  Carve a block out of the slot of requestId
+    ///
+    /// @param  requestId   Request the allocation belongs to
+    /// @param  blockSize   Bytes including the header
+    ///
+    /// @return Header of the block or NULL if the slot cannot serve it
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    RequestArenaBlockHeader* AllocateFromSlot(
+        UINT64 requestId,
+        SIZE_T blockSize);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ReleaseBlock
+    ///
+    /// @brief  Account for a freed block and recycle its slot if it was the last one
+    ///
+    /// @param  pHeader Header of the block being freed
+    ///
+    /// @return TRUE if the arena has been destroyed and this was its last outstanding block
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    BOOL ReleaseBlock(
+        RequestArenaBlockHeader* pHeader);
+
+    CHAR                m_name[MaxStringLength64];  ///< Name used in logs
+    Mutex*              m_pLock;                    ///< Protects the slots and stats
+    BYTE*               m_pMemory;                  ///< Backing memory of all slots
+    ArenaSlot*          m_pSlots;                   ///< Slot table
+    UINT32              m_numSlots;                 ///< Number of slots
+    SIZE_T              m_slotSize;                 ///< Bytes per slot
+    UINT64              m_numOutstanding;           ///< Blocks of either kind not yet freed
+    BOOL                m_destroyPending;           ///< Destroy was called with blocks outstanding
+    RequestArenaStats   m_stats;                    ///< Allocation accounting
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXREQUESTARENA_H
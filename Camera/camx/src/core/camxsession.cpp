@@ -157,6 +157,12 @@ CamxResult Session::Flush()
         m_pFlushLock->Lock();
         CamxAtomicStoreU8(&m_aFlushStatus, TRUE);
 
+        // Errors held back until the flush, such as a pending metadata error, are dispatched only while flushing. Results
+        // that received nothing new would be skipped by ProcessResults, so have the next pass evaluate every live result.
+        m_pResultHolderListLock->Lock();
+        MarkAllResultHoldersUpdated();
+        m_pResultHolderListLock->Unlock();
+
         CAMX_LOG_VERBOSE(CamxLogGroupCore, "Flush called from session %p with pipelines %s", this, m_pipelineNames);
 
         // print nodes still processing, save last valid requestId
@@ -280,6 +286,8 @@ VOID Session::Destroy()
 
     Flush();
 
+    LogLatencyHistograms();
+
     this->FlushThreadJobCallback();
 
     // Due to drain logic we had better destroy anything that has a job registered first (including DRQ)
@@ -331,13 +339,19 @@ VOID Session::Destroy()
         CAMX_ASSERT(NULL != pNode->pData);
         if (NULL != pNode->pData)
         {
-            CAMX_FREE(pNode->pData);
+            CAMX_REQUEST_FREE(pNode->pData);
             pNode->pData = NULL;
         }
-        CAMX_FREE(pNode);
+        CAMX_REQUEST_FREE(pNode);
         pNode = m_resultHolderList.RemoveFromHead();
     }
 
+    if (NULL != m_pRequestArena)
+    {
+        m_pRequestArena->DumpStats();
+        m_pRequestArena->Destroy();
+        m_pRequestArena = NULL;
+    }
 
     if (NULL != m_pLivePendingRequestsLock)
     {
@@ -718,6 +732,11 @@ CamxResult Session::Initialize(
     m_syncSequenceId            = 1;
     m_numRealtimePipelines      = 0;
     m_numMetadataResults        = 1;
+    m_minResultSequenceId       = 0;
+    m_endResultSequenceId       = 0;
+    m_numResultHolderRingMisses = 0;
+
+    Utils::Memset(m_resultHolderRing, 0, sizeof(m_resultHolderRing));
 
     BOOL isRealtimePipeline = SetRealtimePipeline(pCreateData);
     BOOL isActiveSensor     = CheckActiveSensor(pCreateData);
@@ -751,6 +770,7 @@ CamxResult Session::Initialize(
     m_hNodeJobHandle                        = InvalidJobHandle;
     m_numInputSensors                       = GetNumInputSensors(pCreateData);
     m_numPipelines                          = pCreateData->numPipelines;
+    m_isNativeChi                           = pCreateData->isNativeChi;
     m_recordingEndOfStreamTagId             = 0;
     m_setVideoPerfModeFlag                  = FALSE;
     m_sesssionInitComplete                  = FALSE;
@@ -1044,6 +1064,19 @@ CamxResult Session::Initialize(
         m_PartialDataMessages.pLock         = Mutex::Create("PartialDataMessages.pLock");
         m_pPendingMBQueueLock               = Mutex::Create("PendingMBDoneLock");
 
+        // Every per request bookkeeping block of the session, its DRQ and its nodes is carved out of one slot per request.
+        // Twice the request depth of slots lets results of a request drain while the next requests are already queued.
+        m_pRequestArena                     = RequestArena::Create("SessionRequestArena",
+                                                                   currentRequestDepth * 2,
+                                                                   (m_usecaseNumBatchedFrames *
+                                                                   (sizeof(SessionResultHolder) +
+                                                                    sizeof(LightweightDoublyLinkedListNode) +
+                                                                    sizeof(PerBatchedFrameInfo) +
+                                                                    sizeof(SessionResultHolder*) +
+                                                                    sizeof(LightweightDoublyLinkedListNode*))) +
+                                                                   RequestArenaDefaultSlotHeadroom);
+        pDeferredCreateData.pRequestArena   = m_pRequestArena;
+
         m_pDeferredRequestQueue             = DeferredRequestQueue::Create(&pDeferredCreateData);
         m_pWaitAllResultsAvailable          = Condition::Create("SessionWaitAllResultsAvailable");
         m_pWaitAllResultsAvailableSignaled  = FALSE;
@@ -2427,112 +2460,126 @@ CamxResult Session::ProcessResults()
     // it should be in the inner lock if it is used with other lock such as m_pResultLock, m_pFlushLock.
     m_pResultHolderListLock->Lock();
 
-    LightweightDoublyLinkedListNode* pNode = m_resultHolderList.Head();
+    // Walk the ring in sequence order from the oldest live result. Only results that received something since the last pass
+    // are evaluated, unless an older result dispatched in this pass: that may have opened the in-order gate for the younger
+    // ones, so from then on every result is evaluated.
+    BOOL cascade = FALSE;
 
-    while (NULL != pNode)
+    for (UINT32 sequenceId = m_minResultSequenceId; sequenceId != m_endResultSequenceId; sequenceId++)
     {
-        BOOL earlyMetadataReady    = FALSE;
-        BOOL metadataReady         = FALSE;
-        BOOL bufferReady           = FALSE;
+        ResultHolderRingEntry* pEntry             = &m_resultHolderRing[sequenceId % MaxQueueDepth];
+        UINT32                 updateMask         = 0;
+        BOOL                   earlyMetadataReady = FALSE;
+        BOOL                   metadataReady      = FALSE;
+        BOOL                   bufferReady        = FALSE;
+        BOOL                   dispatched         = FALSE;
 
-        CAMX_ASSERT(NULL != pNode->pData);
+        pResultHolder = NULL;
 
-        if (NULL != pNode->pData)
+        if ((NULL != pEntry->pSessionResultHolder) && (sequenceId == pEntry->sequenceId))
         {
-            pSessionResultHolder = reinterpret_cast<SessionResultHolder*>(pNode->pData);
+            pSessionResultHolder = pEntry->pSessionResultHolder;
+            pResultHolder        = &(pSessionResultHolder->resultHolders[pEntry->resultIndex]);
+            updateMask           = pEntry->updateMask;
+            pEntry->updateMask   = 0;
+        }
+        else if (0 < m_numResultHolderRingMisses)
+        {
+            // No ring entry to carry update bits for this one, so always evaluate it
+            pResultHolder = FindResultHolderInList(sequenceId);
+            updateMask    = ResultHolderUpdateAll;
+        }
 
-            for (UINT32 index = 0; index < pSessionResultHolder->numResults; index++)
+        if ((NULL != pResultHolder) && ((0 != updateMask) || (TRUE == cascade)))
+        {
+            if (FALSE == pResultHolder->isCancelled)
             {
-                pResultHolder = &(pSessionResultHolder->resultHolders[index]);
-                if (NULL != pResultHolder)
+                // Only do partial metadata processing when the setting has defined the number of results greater than 1
+                if (1 < m_numMetadataResults)
                 {
-                    if (FALSE == pResultHolder->isCancelled)
-                    {
-                        // Only do partial metadata processing when the setting has defined the number of results greater than 1
-                        if (1 < m_numMetadataResults)
-                        {
-                            earlyMetadataReady = ProcessResultEarlyMetadata(pResultHolder, &numResults);
-                        }
-
-                        // If we ever have early metadata for a given result before anything else. Stop processing the rest
-                        // and just make sure we send back the early metadata.
-                        if ((FALSE == earlyMetadataReady))
-                        {
-                            metadataReady = ProcessResultMetadata(pResultHolder, &numResults);
-                            bufferReady   = ProcessResultBuffers(pResultHolder, metadataReady, &numResults);
-                        }
-                    }
-                    else
-                    {
-                        // process results without regards to metadata if the request was cancelled
-                        bufferReady = ProcessResultBuffers(pResultHolder, metadataReady, &numResults);
-                    }
-
-                    UINT totalBuffersSent =
-                        (NULL != pResultHolder) ? pResultHolder->numErrorBuffersSent + pResultHolder->numOkBuffersSent : 0;
-
-                    if ((TRUE == bufferReady) &&
-                        (TRUE == m_isRealTime) &&
-                        (pResultHolder->numOutBuffers == totalBuffersSent) &&
-                        (m_latestLongExposureFrame == pResultHolder->sequenceId))
-                    {
-                        m_longExposureTimeout = 0;
-                    }
+                    earlyMetadataReady = ProcessResultEarlyMetadata(pResultHolder, &numResults);
+                }
 
-                    CAMX_LOG_INFO(CamxLogGroupCore,
-                        "Processing Result - SequenceId %u Framenumber %llu - earlyMetadata %d metadataReady %d "
-                        "bufferReady %d isCancelled %d",
-                        pResultHolder->sequenceId, GetFrameworkFrameNumber(pResultHolder->sequenceId), earlyMetadataReady,
-                        metadataReady, bufferReady, pResultHolder->isCancelled);
+                // If we ever have early metadata for a given result before anything else. Stop processing the rest
+                // and just make sure we send back the early metadata.
+                if ((FALSE == earlyMetadataReady))
+                {
+                    metadataReady = ProcessResultMetadata(pResultHolder, &numResults);
+                    bufferReady   = ProcessResultBuffers(pResultHolder, metadataReady, &numResults);
+                }
+            }
+            else
+            {
+                // process results without regards to metadata if the request was cancelled
+                bufferReady = ProcessResultBuffers(pResultHolder, metadataReady, &numResults);
+            }
 
-                    if ((TRUE == metadataReady) || (TRUE == bufferReady) || (TRUE == earlyMetadataReady) ||
-                        (TRUE == pResultHolder->isCancelled))
-                    {
-                        m_pCaptureResult[numResults].pPrivData         = static_cast<CHIPRIVDATA *>(pResultHolder->pPrivData);
-                        m_pCaptureResult[numResults].frameworkFrameNum = GetFrameworkFrameNumber(pResultHolder->sequenceId);
+            UINT totalBuffersSent =
+                (NULL != pResultHolder) ? pResultHolder->numErrorBuffersSent + pResultHolder->numOkBuffersSent : 0;
 
-                        numResults++;
-                        bufferReady      = FALSE;
-                        metadataReady    = FALSE;
-                    }
+            if ((TRUE == bufferReady) &&
+                (TRUE == m_isRealTime) &&
+                (pResultHolder->numOutBuffers == totalBuffersSent) &&
+                (m_latestLongExposureFrame == pResultHolder->sequenceId))
+            {
+                m_longExposureTimeout = 0;
+            }
 
+            CAMX_LOG_INFO(CamxLogGroupCore,
+                "Processing Result - SequenceId %u Framenumber %llu - earlyMetadata %d metadataReady %d "
+                "bufferReady %d isCancelled %d",
+                pResultHolder->sequenceId, GetFrameworkFrameNumber(pResultHolder->sequenceId), earlyMetadataReady,
+                metadataReady, bufferReady, pResultHolder->isCancelled);
 
-                    if ((NULL != pResultHolder) &&
-                        (pResultHolder->numOutBuffers == totalBuffersSent) && (pResultHolder->numErrorBuffersSent > 0) &&
-                        (FALSE == pResultHolder->isCancelled) && (pResultHolder->pendingMetadataCount > 0))
-                    {
-                        CAMX_LOG_INFO(CamxLogGroupCore,
-                            "RequestId: %llu SequenceId: %llu Framenumber: %llu - All results were injected with buffer error,"
-                            " but an error notify has not been dispatched, dispatching now.",
-                            pResultHolder->requestId, pResultHolder->sequenceId,
-                            GetFrameworkFrameNumber(pResultHolder->sequenceId));
+            if ((TRUE == metadataReady) || (TRUE == bufferReady) || (TRUE == earlyMetadataReady) ||
+                (TRUE == pResultHolder->isCancelled))
+            {
+                m_pCaptureResult[numResults].pPrivData         = static_cast<CHIPRIVDATA *>(pResultHolder->pPrivData);
+                m_pCaptureResult[numResults].frameworkFrameNum = GetFrameworkFrameNumber(pResultHolder->sequenceId);
 
-                        ChiMessageDescriptor* pNotify = GetNotifyMessageDescriptor();
+                numResults++;
+                bufferReady      = FALSE;
+                metadataReady    = FALSE;
+                dispatched       = TRUE;
+            }
 
-                        pNotify->messageType                            = ChiMessageTypeError;
-                        pNotify->pPrivData                              = static_cast<CHIPRIVDATA*>(pResultHolder->pPrivData);
-                        pNotify->message.errorMessage.errorMessageCode  = static_cast<ChiErrorMessageCode>(MessageCodeResult);
-                        pNotify->message.errorMessage.frameworkFrameNum = GetFrameworkFrameNumber(pResultHolder->sequenceId);
-                        pNotify->message.errorMessage.pErrorStream      = NULL; // No stream applicable
 
-                        DispatchNotify(pNotify);
-                        pResultHolder->isCancelled          = TRUE;
-                        pResultHolder->pendingMetadataCount = 0;
+            if ((NULL != pResultHolder) &&
+                (pResultHolder->numOutBuffers == totalBuffersSent) && (pResultHolder->numErrorBuffersSent > 0) &&
+                (FALSE == pResultHolder->isCancelled) && (pResultHolder->pendingMetadataCount > 0))
+            {
+                CAMX_LOG_INFO(CamxLogGroupCore,
+                    "RequestId: %llu SequenceId: %llu Framenumber: %llu - All results were injected with buffer error,"
+                    " but an error notify has not been dispatched, dispatching now.",
+                    pResultHolder->requestId, pResultHolder->sequenceId,
+                    GetFrameworkFrameNumber(pResultHolder->sequenceId));
+
+                ChiMessageDescriptor* pNotify = GetNotifyMessageDescriptor();
+
+                pNotify->messageType                            = ChiMessageTypeError;
+                pNotify->pPrivData                              = static_cast<CHIPRIVDATA*>(pResultHolder->pPrivData);
+                pNotify->message.errorMessage.errorMessageCode  = static_cast<ChiErrorMessageCode>(MessageCodeResult);
+                pNotify->message.errorMessage.frameworkFrameNum = GetFrameworkFrameNumber(pResultHolder->sequenceId);
+                pNotify->message.errorMessage.pErrorStream      = NULL; // No stream applicable
+
+                DispatchNotify(pNotify);
+                pResultHolder->isCancelled          = TRUE;
+                pResultHolder->pendingMetadataCount = 0;
+                dispatched                          = TRUE;
+            }
 
-                    }
+            // If the request is complete, update the buffer to set processing end time
+            if ((NULL != pResultHolder) && (pResultHolder->numOutBuffers == totalBuffersSent) &&
+                (FALSE == pResultHolder->isCancelled) && (pResultHolder->pendingMetadataCount == 0))
+            {
+                UpdateSessionRequestTimingBuffer(pResultHolder);
+            }
 
-                    // If the request is complete, update the buffer to set processing end time
-                    if ((NULL != pResultHolder) && (pResultHolder->numOutBuffers == totalBuffersSent) &&
-                        (FALSE == pResultHolder->isCancelled) && (pResultHolder->pendingMetadataCount == 0))
-                    {
-                        UpdateSessionRequestTimingBuffer(pResultHolder);
-                    }
-                }
+            if (TRUE == dispatched)
+            {
+                cascade = TRUE;
             }
         }
-
-        // Get the next result holder and see what's going on with it
-        pNode = m_resultHolderList.NextNode(pNode);
     }
 
     m_pResultHolderListLock->Unlock();
@@ -2583,6 +2630,7 @@ CamxResult Session::ProcessRequest()
         // If session request contain multiple pipeline request, it means pipelines need to be sync
         // and the batch frame number must be same.
         UINT32 numBatchedFrames = pSessionRequest->requests[0].numBatchedFrames;
+        UINT64 arenaRequestId   = pSessionRequest->requests[0].requestId;
         for (UINT requestIndex = 1; requestIndex < pSessionRequest->numRequests; requestIndex++)
         {
             if (numBatchedFrames != pSessionRequest->requests[requestIndex].numBatchedFrames)
@@ -2613,7 +2661,9 @@ CamxResult Session::ProcessRequest()
             if (NULL == ppResultNodes)
             {
                 ppResultNodes = reinterpret_cast<LightweightDoublyLinkedListNode**>(
-                    CAMX_CALLOC(numBatchedFrames * sizeof(LightweightDoublyLinkedListNode*)));
+                    CAMX_REQUEST_CALLOC(m_pRequestArena,
+                                        arenaRequestId,
+                                        numBatchedFrames * sizeof(LightweightDoublyLinkedListNode*)));
 
                 if (NULL == ppResultNodes)
                 {
@@ -2627,7 +2677,7 @@ CamxResult Session::ProcessRequest()
             if (NULL == ppSessionResultHolder)
             {
                 ppSessionResultHolder = reinterpret_cast<SessionResultHolder**>(
-                    CAMX_CALLOC(numBatchedFrames * sizeof(SessionResultHolder*)));
+                    CAMX_REQUEST_CALLOC(m_pRequestArena, arenaRequestId, numBatchedFrames * sizeof(SessionResultHolder*)));
                 if (NULL == ppSessionResultHolder)
                 {
                     CAMX_LOG_ERROR(CamxLogGroupCore, "memory allocation failed for ppSessionResultHolder for request %llu",
@@ -2669,7 +2719,7 @@ CamxResult Session::ProcessRequest()
                     if (NULL == pNode)
                     {
                         pNode = reinterpret_cast<LightweightDoublyLinkedListNode*>
-                            (CAMX_CALLOC(sizeof(LightweightDoublyLinkedListNode)));
+                            (CAMX_REQUEST_CALLOC(m_pRequestArena, arenaRequestId, sizeof(LightweightDoublyLinkedListNode)));
                         ppResultNodes[batchIndex] = pNode;
                     }
 
@@ -2677,7 +2727,7 @@ CamxResult Session::ProcessRequest()
                     if (NULL == pSessionResultHolder)
                     {
                         pSessionResultHolder = reinterpret_cast<SessionResultHolder*>
-                            (CAMX_CALLOC(sizeof(SessionResultHolder)));
+                            (CAMX_REQUEST_CALLOC(m_pRequestArena, arenaRequestId, sizeof(SessionResultHolder)));
                         ppSessionResultHolder[batchIndex] = pSessionResultHolder;
                     }
 
@@ -2690,13 +2740,13 @@ CamxResult Session::ProcessRequest()
 
                         if (NULL != pNode)
                         {
-                            CAMX_FREE(pNode);
+                            CAMX_REQUEST_FREE(pNode);
                             pNode = NULL;
                         }
 
                         if (NULL != pSessionResultHolder)
                         {
-                            CAMX_FREE(pSessionResultHolder);
+                            CAMX_REQUEST_FREE(pSessionResultHolder);
                             pSessionResultHolder = NULL;
                         }
                     }
@@ -2711,6 +2761,9 @@ CamxResult Session::ProcessRequest()
                         pHolder->pendingMetadataCount = m_numMetadataResults;
                         pHolder->pPrivData            = pRequest->pPrivData;
                         pHolder->requestId            = static_cast<UINT32>(pRequest->requestId);
+                        pHolder->submitTimeNs         =
+                            (TRUE == m_pChiContext->GetStaticSettings()->enableLatencyHistograms) ?
+                            OsUtils::GetNanoSeconds() : 0;
 
                         // We may not get a result metadata for reprocess requests
                         // This logic may need to be expanded for multi-camera CHI override scenarios,
@@ -2825,7 +2878,10 @@ CamxResult Session::ProcessRequest()
                 pSessionResultHolder->numResults = pSessionRequest->numRequests;
                 pNode->pData = pSessionResultHolder;
                 m_pResultLock->Lock();
+                m_pResultHolderListLock->Lock();
                 m_resultHolderList.InsertToTail(pNode);
+                AddResultHoldersToRing(pSessionResultHolder);
+                m_pResultHolderListLock->Unlock();
                 m_pResultLock->Unlock();
             }
         }
@@ -2834,12 +2890,12 @@ CamxResult Session::ProcessRequest()
         // The actual node and session result holder will be free in processResult
         if (NULL != ppResultNodes)
         {
-            CAMX_FREE(ppResultNodes);
+            CAMX_REQUEST_FREE(ppResultNodes);
             ppResultNodes = NULL;
         }
         if (NULL != ppSessionResultHolder)
         {
-            CAMX_FREE(ppSessionResultHolder);
+            CAMX_REQUEST_FREE(ppSessionResultHolder);
             ppSessionResultHolder = NULL;
         }
     }
@@ -2897,7 +2953,7 @@ CamxResult Session::ProcessRequest()
                 CaptureRequest*            pRequest                   = &(pSessionRequest->requests[requestIndex]);
                 PipelineProcessRequestData pipelineProcessRequestData = {};
 
-                result = SetupRequestData(pRequest, &pipelineProcessRequestData);
+                result = SetupRequestData(pRequest, m_pRequestArena, &pipelineProcessRequestData);
 
                 // Set timestamp for start of request processing
                 PopulateSessionRequestTimingBuffer(pRequest);
@@ -2917,7 +2973,7 @@ CamxResult Session::ProcessRequest()
 
                 if (NULL != pipelineProcessRequestData.pPerBatchedFrameInfo)
                 {
-                    CAMX_FREE(pipelineProcessRequestData.pPerBatchedFrameInfo);
+                    CAMX_REQUEST_FREE(pipelineProcessRequestData.pPerBatchedFrameInfo);
                     pipelineProcessRequestData.pPerBatchedFrameInfo = NULL;
                 }
             }
@@ -2956,6 +3012,13 @@ VOID Session::UpdateSessionRequestTimingBuffer(
 {
     const StaticSettings* pStaticSettings = m_pChiContext->GetStaticSettings();
 
+    // ProcessResults can visit a completed result more than once, record it only the first time
+    if (0 != pResultHolder->submitTimeNs)
+    {
+        m_resultLatency.RecordInterval(pResultHolder->submitTimeNs, OsUtils::GetNanoSeconds());
+        pResultHolder->submitTimeNs = 0;
+    }
+
     if (TRUE == pStaticSettings->dumpSessionProcessingInfo)
     {
         CamxTime                pTime;
@@ -3041,6 +3104,38 @@ VOID Session::DumpSessionRequestProcessingTime()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::LogLatencyHistograms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Session::LogLatencyHistograms()
+{
+    LatencyHistogramSummary summary;
+    CHAR                    json[LatencyHistogramJSONLength];
+
+    m_resultLatency.GetSummary(&summary);
+
+    if (0 < summary.count)
+    {
+        LatencyHistogram::FormatJSON("Session", &summary, json, sizeof(json));
+        CAMX_LOG_CONFIG(CamxLogGroupCore, "Session %p latency: %s", this, json);
+    }
+
+    for (UINT i = 0; i < m_numPipelines; i++)
+    {
+        if (NULL != m_pipelineData[i].pPipeline)
+        {
+            m_pipelineData[i].pPipeline->GetRequestLatencyHistogram()->GetSummary(&summary);
+
+            if (0 < summary.count)
+            {
+                LatencyHistogram::FormatJSON(m_pipelineData[i].pPipeline->GetPipelineIdentifierString(),
+                                             &summary, json, sizeof(json));
+                CAMX_LOG_CONFIG(CamxLogGroupCore, "Session %p latency: %s", this, json);
+            }
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Session::HandleErrorCb
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3523,6 +3618,20 @@ CamxResult Session::InjectResult(
     // Make the result holder slot live, it's ok to write it more than once
     pHolder->isAlive = TRUE;
 
+    switch (resultType)
+    {
+        case ResultType::MetadataOK:
+        case ResultType::EarlyMetadataOK:
+            MarkResultHolderUpdated(sequenceId, ResultHolderUpdateMetadata);
+            break;
+        case ResultType::BufferOK:
+            MarkResultHolderUpdated(sequenceId, ResultHolderUpdateBuffer);
+            break;
+        default:
+            MarkResultHolderUpdated(sequenceId, ResultHolderUpdateError);
+            break;
+    }
+
     m_pResultHolderListLock->Unlock();
 
     if (TRUE == MeetFrameworkNotifyCriteria(pHolder))
@@ -3674,6 +3783,125 @@ VOID Session::CalculateResultFPS()
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::FindResultHolderInList
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+ResultHolder* Session::FindResultHolderInList(
+    UINT32 sequenceId)
+{
+    LightweightDoublyLinkedListNode* pNode   = m_resultHolderList.Head();
+    ResultHolder*                    pHolder = NULL;
+
+    while ((NULL != pNode) && (NULL == pHolder))
+    {
+        CAMX_ASSERT(NULL != pNode->pData);
+        if (NULL != pNode->pData)
+        {
+            SessionResultHolder* pSessionResultHolder = reinterpret_cast<SessionResultHolder*>(pNode->pData);
+
+            for (UINT32 i = 0 ; i < pSessionResultHolder->numResults; i++)
+            {
+                if (pSessionResultHolder->resultHolders[i].sequenceId == sequenceId)
+                {
+                    pHolder = &pSessionResultHolder->resultHolders[i];
+                    break;
+                }
+            }
+        }
+        pNode = m_resultHolderList.NextNode(pNode);
+    }
+
+    return pHolder;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::AddResultHoldersToRing
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Session::AddResultHoldersToRing(
+    SessionResultHolder* pSessionResultHolder)
+{
+    for (UINT32 index = 0; index < pSessionResultHolder->numResults; index++)
+    {
+        UINT32                 sequenceId = pSessionResultHolder->resultHolders[index].sequenceId;
+        ResultHolderRingEntry* pEntry     = &m_resultHolderRing[sequenceId % MaxQueueDepth];
+
+        if (m_minResultSequenceId == m_endResultSequenceId)
+        {
+            // Ring was empty, this is the oldest live result now
+            m_minResultSequenceId = sequenceId;
+            m_endResultSequenceId = sequenceId;
+        }
+
+        if (static_cast<INT32>((sequenceId + 1) - m_endResultSequenceId) > 0)
+        {
+            m_endResultSequenceId = sequenceId + 1;
+        }
+
+        if (NULL == pEntry->pSessionResultHolder)
+        {
+            pEntry->pSessionResultHolder = pSessionResultHolder;
+            pEntry->resultIndex          = index;
+            pEntry->sequenceId           = sequenceId;
+            pEntry->updateMask           = ResultHolderUpdateAll;
+        }
+        else
+        {
+            // More results in flight than MaxQueueDepth; this one is served by the list walk until it completes
+            CAMX_LOG_WARN(CamxLogGroupCore, "Result ring entry for sequenceId %u still held by sequenceId %u",
+                          sequenceId, pEntry->sequenceId);
+            m_numResultHolderRingMisses++;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::RemoveResultHoldersFromRing
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Session::RemoveResultHoldersFromRing(
+    SessionResultHolder* pSessionResultHolder)
+{
+    for (UINT32 index = 0; index < pSessionResultHolder->numResults; index++)
+    {
+        UINT32                 sequenceId = pSessionResultHolder->resultHolders[index].sequenceId;
+        ResultHolderRingEntry* pEntry     = &m_resultHolderRing[sequenceId % MaxQueueDepth];
+
+        if (pSessionResultHolder == pEntry->pSessionResultHolder)
+        {
+            Utils::Memset(pEntry, 0, sizeof(ResultHolderRingEntry));
+        }
+        else if (0 < m_numResultHolderRingMisses)
+        {
+            m_numResultHolderRingMisses--;
+        }
+    }
+
+    // Move the cursor to the new oldest result, whose in-order gating may just have opened
+    LightweightDoublyLinkedListNode* pHead = m_resultHolderList.Head();
+
+    if ((NULL != pHead) && (NULL != pHead->pData))
+    {
+        SessionResultHolder* pHeadHolder = reinterpret_cast<SessionResultHolder*>(pHead->pData);
+
+        m_minResultSequenceId = pHeadHolder->resultHolders[0].sequenceId;
+
+        for (UINT32 index = 0; index < pHeadHolder->numResults; index++)
+        {
+            UINT32 sequenceId = pHeadHolder->resultHolders[index].sequenceId;
+
+            if (static_cast<INT32>(sequenceId - m_minResultSequenceId) < 0)
+            {
+                m_minResultSequenceId = sequenceId;
+            }
+
+            MarkResultHolderUpdated(sequenceId, ResultHolderUpdateOrder);
+        }
+    }
+    else
+    {
+        m_minResultSequenceId = m_endResultSequenceId;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Session::AdvanceMinExpectedResult
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -3781,13 +4009,14 @@ VOID Session::AdvanceMinExpectedResult()
                               this, pHolder->sequenceId);
             }
 
-            CAMX_FREE(pNode->pData);
             pNode->pData = NULL;
 
             // Since we've finished the requeset, remove the node from the list
             m_resultHolderList.RemoveNode(pNode);
+            RemoveResultHoldersFromRing(pSessionResultHolder);
+            CAMX_REQUEST_FREE(pSessionResultHolder);
 
-            CAMX_FREE(pNode);
+            CAMX_REQUEST_FREE(pNode);
             pNode    = NULL;
             moveNext = FALSE;
 
@@ -4768,6 +4997,11 @@ VOID Session::DumpState(
         m_pipelineData[i].pPipeline->DumpState(fd, indent + 2);
     }
 
+    // Dump latency histograms of this session
+    CAMX_LOG_TO_FILE(fd, indent, "\n+---------------------------------------------------------------------------------------+");
+    CAMX_LOG_TO_FILE(fd, indent, "Latency histograms:");
+    DumpLatencyHistograms(fd, indent + 2);
+
     // Dump the session's request queue
     CAMX_LOG_TO_FILE(fd, indent, "\n+---------------------------------------------------------------------------------------+");
     CAMX_LOG_TO_FILE(fd, indent, "HAL3 RequestQueue");
@@ -4784,6 +5018,24 @@ VOID Session::DumpState(
     m_pThreadManager->DumpStateToFile(fd, indent + 2);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::DumpLatencyHistograms
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Session::DumpLatencyHistograms(
+    INT     fd,
+    UINT32  indent)
+{
+    m_resultLatency.DumpState(fd, indent, "Session");
+
+    for (UINT i = 0; i < m_numPipelines; i++)
+    {
+        if (NULL != m_pipelineData[i].pPipeline)
+        {
+            m_pipelineData[i].pPipeline->DumpLatencyHistograms(fd, indent + 2);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Session::DumpDebugInfo()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5049,6 +5301,19 @@ VOID Session::FlushHALQueue()
     m_pRequestLock->Unlock();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Session::SetChiCallBacks
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Session::SetChiCallBacks(
+    const ChiCallBacks* pChiAppCallBacks,
+    VOID*               pPrivateCbData)
+{
+    CAMX_ASSERT(NULL != pChiAppCallBacks);
+
+    Utils::Memcpy(&m_chiCallBacks, pChiAppCallBacks, sizeof(ChiCallBacks));
+    m_pPrivateCbData = pPrivateCbData;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Session::QueryMetadataInfo
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -5389,13 +5654,16 @@ UINT64 Session::GetFlushResponseTime()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult SetupRequestData(
     CaptureRequest* pRequest,
+    RequestArena* pRequestArena,
     PipelineProcessRequestData* pOutRequestData)
 {
     // Pipeline to process this Request
     CamxResult result                     = CamxResultSuccess;
     pOutRequestData->pCaptureRequest      = pRequest;
     pOutRequestData->pPerBatchedFrameInfo =
-        static_cast<PerBatchedFrameInfo*>(CAMX_CALLOC(sizeof(PerBatchedFrameInfo) * pRequest->numBatchedFrames));
+        static_cast<PerBatchedFrameInfo*>(CAMX_REQUEST_CALLOC(pRequestArena,
+                                                             pRequest->requestId,
+                                                             sizeof(PerBatchedFrameInfo) * pRequest->numBatchedFrames));
 
     if (NULL == pOutRequestData->pPerBatchedFrameInfo)
     {
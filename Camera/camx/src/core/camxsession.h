@@ -14,6 +14,8 @@
 #include "camxchicontext.h"
 #include "camxhwdefs.h"
 #include "camxdefs.h"
+#include "camxlatencyhistogram.h"
+#include "camxrequestarena.h"
 
 // NOWHINE FILE NC003a: Long existing structures. To be cleaned up at a later point
 // NOWHINE FILE NC008:  Long existing structures. To be cleaned up at a later point
@@ -489,6 +491,8 @@ struct PipelineDescriptor
     CHAR                    pipelineName[MaxStringLength256];           ///< Name of this pipeline
     VOID*                   pPrivData;                                  ///< Camx private data, carrying pipeline obj ptr.
     MetaBuffer*             pSessionMetadata;                           ///< Metadata buffer published by the Chi Usecase
+    UINT64                  cacheKey;                                   ///< Key of the create parameters, used to find the
+                                                                        ///  descriptor in the ChiContext session cache
 };
 
 /// @brief Pipeline finalization data needed for pipeline defer finalization
@@ -566,6 +570,8 @@ struct ResultHolder
     UINT32                  pipelineIndex;                           ///< Pipeline index
     UINT32                  requestId;                               ///< Request ID for the pipeline
     BOOL                    isShutterSentOut;                        ///< Did we dispatch a ShutterMessage to the framework
+    UINT64                  submitTimeNs;                            ///< Time the request was submitted, 0 once its latency
+                                                                     ///  has been recorded
     struct BufferResult
     {
         ChiStream*            pStream;                          ///< O/P Stream pointer to which this buffer belongs
@@ -589,6 +595,22 @@ struct SessionResultHolder
     UINT32          numResults;                             ///< NUmber of pipeline result holders
 };
 
+/// @brief Bits of ResultHolderRingEntry::updateMask, recording what arrived for a result since ProcessResults last visited it
+static const UINT32 ResultHolderUpdateMetadata = 0x1;   ///< Metadata or early metadata was injected
+static const UINT32 ResultHolderUpdateBuffer   = 0x2;   ///< An output buffer was injected
+static const UINT32 ResultHolderUpdateError    = 0x4;   ///< A request, metadata or buffer error was injected
+static const UINT32 ResultHolderUpdateOrder    = 0x8;   ///< The result became the oldest one, in-order gating may have cleared
+static const UINT32 ResultHolderUpdateAll      = 0xF;   ///< Treat the result as changed in every respect
+
+/// @brief Result holder ring entry, indexed by sequenceId % MaxQueueDepth
+struct ResultHolderRingEntry
+{
+    SessionResultHolder*    pSessionResultHolder;   ///< Session result holder tracking sequenceId, NULL if the entry is free
+    UINT32                  resultIndex;            ///< Index of the ResultHolder of sequenceId within pSessionResultHolder
+    UINT32                  sequenceId;             ///< Sequence id the entry currently tracks
+    UINT32                  updateMask;             ///< ResultHolderUpdate* bits pending for ProcessResults
+};
+
 /// @brief Holder structure to store timestamps for a session request
 struct PerResultHolderInfo
 {
@@ -722,12 +744,14 @@ VOID DetermineActiveStreams(
 /// @brief  Setup the necessary data for a result pipeline request
 ///
 /// @param  pRequest        The request whose results will be setup.
+/// @param  pRequestArena   Arena the per batched frame info of the request is allocated from, may be NULL
 /// @param  pOutRequestData The pipeline data for the request.
 ///
 /// @return None
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult SetupRequestData(
     CaptureRequest*             pRequest,
+    RequestArena*               pRequestArena,
     PipelineProcessRequestData* pOutRequestData);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -798,6 +822,18 @@ public:
         return static_cast<BOOL>(CamxAtomicLoadU8(&m_aFlushStatus) != FALSE);
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetRequestArena
+    ///
+    /// @brief  Get the arena the per request bookkeeping of this session is allocated from
+    ///
+    /// @return Pointer to the request arena, may be NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE RequestArena* GetRequestArena() const
+    {
+        return m_pRequestArena;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// UpdateLastFlushedRequestId
     ///
@@ -1104,6 +1140,32 @@ public:
     VOID DumpDebugInfo(
         SessionDumpFlag flag);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpLatencyHistograms
+    ///
+    /// @brief  Dumps the latency histogram summaries of the session, its pipelines and their nodes to a file
+    ///
+    /// @param  fd      file descriptor.
+    /// @param  indent  indent spaces.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpLatencyHistograms(
+        INT     fd,
+        UINT32  indent);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetResultLatencyHistogram
+    ///
+    /// @brief  Get the histogram of the time from request submission until its last result is dispatched
+    ///
+    /// @return Histogram of the session
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE const LatencyHistogram* GetResultLatencyHistogram() const
+    {
+        return &m_resultLatency;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// QueryMetadataInfo
     ///
@@ -1138,6 +1200,73 @@ public:
         return m_hCSLSession;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetNumPipelines
+    ///
+    /// @brief  Get the number of pipelines in the session
+    ///
+    /// @return Number of pipelines
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE UINT GetNumPipelines() const
+    {
+        return m_numPipelines;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetPipelineDescriptorByIndex
+    ///
+    /// @brief  Get the descriptor the session created a pipeline from
+    ///
+    /// @param  pipelineIndex   Index of the pipeline in the session
+    ///
+    /// @return Pipeline descriptor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE PipelineDescriptor* GetPipelineDescriptorByIndex(
+        UINT pipelineIndex) const
+    {
+        CAMX_ASSERT(pipelineIndex < m_numPipelines);
+
+        return m_pipelineData[pipelineIndex].pPipelineDescriptor;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsNativeChi
+    ///
+    /// @brief  Check if the session was created by a Native Chi client
+    ///
+    /// @return TRUE if created from Native Chi, FALSE otherwise
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE BOOL IsNativeChi() const
+    {
+        return m_isNativeChi;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetPipelineNames
+    ///
+    /// @brief  Get the names of the pipelines in the session
+    ///
+    /// @return Pipeline names
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE const CHAR* GetPipelineNames() const
+    {
+        return m_pipelineNames;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// SetChiCallBacks
+    ///
+    /// @brief  Redirect the app callbacks, used when a deactivated session is handed to a new Chi usecase
+    ///
+    /// @param  pChiAppCallBacks    Callbacks into the app
+    /// @param  pPrivateCbData      Private data passed back with the callbacks
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID SetChiCallBacks(
+        const ChiCallBacks* pChiAppCallBacks,
+        VOID*               pPrivateCbData);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// NotifyProcessingDone
     ///
@@ -1234,6 +1363,7 @@ protected:
     JobHandle               m_hJobFamilyHandle;                             ///< Job handle for HAL3 Worker
     ThreadManager*          m_pThreadManager;                               ///< Thread Manager
     UINT                    m_numPipelines;                                 ///< Number of pipelines in the Session
+    BOOL                    m_isNativeChi;                                  ///< Session is created from Native Chi
     SessionPerPipelineData  m_pipelineData[MaxPipelinesPerSession];         ///< Pipeline data
     UINT                    m_numRealtimePipelines;                         ///< Number of realtime pipelines in Session
     UINT                    m_numMetadataResults;                           ///< Max number of metadata results. More than 1
@@ -1602,45 +1732,103 @@ private:
     CAMX_INLINE ResultHolder* GetResultHolderBySequenceId(
         UINT32 sequenceId)
     {
-        LightweightDoublyLinkedListNode* pNode                = m_resultHolderList.Head();
-        SessionResultHolder*             pSessionResultHolder = NULL;
-        ResultHolder*                    pHolder              = NULL;
-        BOOL                             bFound               = FALSE;
+        const ResultHolderRingEntry* pEntry  = &m_resultHolderRing[sequenceId % MaxQueueDepth];
+        ResultHolder*                pHolder = NULL;
 
-        while (NULL != pNode)
+        if ((NULL != pEntry->pSessionResultHolder) && (sequenceId == pEntry->sequenceId))
         {
-            CAMX_ASSERT(NULL != pNode->pData);
-            if (NULL != pNode->pData)
-            {
-                pSessionResultHolder = reinterpret_cast<SessionResultHolder*>(pNode->pData);
-
-                for (UINT32 i = 0 ; i < pSessionResultHolder->numResults; i++)
-                {
-                    pHolder = &pSessionResultHolder->resultHolders[i];
-                    if (pHolder->sequenceId == sequenceId)
-                    {
-                        // Found the result holder at the sequence id we were looking for
-                        // so break out of the while loop
-                        bFound = TRUE;
-                        break;
-                    }
-
-                }
-            }
-            if (TRUE == bFound)
-            {
-                break;
-            }
-            else
-            {
-                pHolder = NULL;
-            }
-            pNode = m_resultHolderList.NextNode(pNode);
+            pHolder = &pEntry->pSessionResultHolder->resultHolders[pEntry->resultIndex];
+        }
+        else if (0 < m_numResultHolderRingMisses)
+        {
+            // Only results that could not get a ring entry need the list walk
+            pHolder = FindResultHolderInList(sequenceId);
         }
 
         return pHolder;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FindResultHolderInList
+    ///
+    /// @brief  Walk the result holder list for a specific sequence id
+    ///
+    /// @param  sequenceId  Specific id for which the result holder is sought
+    ///
+    /// @return Pointer to ResultHolder if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ResultHolder* FindResultHolderInList(
+        UINT32 sequenceId);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// MarkResultHolderUpdated
+    ///
+    /// @brief  Record in the result holder ring that something arrived for a result, so ProcessResults visits it
+    ///
+    /// @note   m_pResultHolderListLock must be held
+    ///
+    /// @param  sequenceId  Sequence id of the result
+    /// @param  updateMask  ResultHolderUpdate* bits to set
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE VOID MarkResultHolderUpdated(
+        UINT32 sequenceId,
+        UINT32 updateMask)
+    {
+        ResultHolderRingEntry* pEntry = &m_resultHolderRing[sequenceId % MaxQueueDepth];
+
+        if ((NULL != pEntry->pSessionResultHolder) && (sequenceId == pEntry->sequenceId))
+        {
+            pEntry->updateMask |= updateMask;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// MarkAllResultHoldersUpdated
+    ///
+    /// @brief  Record every live result in the result holder ring as changed, so the next ProcessResults pass visits them all
+    ///
+    /// @note   m_pResultHolderListLock must be held
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE VOID MarkAllResultHoldersUpdated()
+    {
+        for (UINT32 sequenceId = m_minResultSequenceId; sequenceId != m_endResultSequenceId; sequenceId++)
+        {
+            MarkResultHolderUpdated(sequenceId, ResultHolderUpdateAll);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AddResultHoldersToRing
+    ///
+    /// @brief  Index every result of a session result holder in the result holder ring
+    ///
+    /// @note   m_pResultHolderListLock must be held
+    ///
+    /// @param  pSessionResultHolder    Session result holder that was just added to m_resultHolderList
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID AddResultHoldersToRing(
+        SessionResultHolder* pSessionResultHolder);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RemoveResultHoldersFromRing
+    ///
+    /// @brief  Release the ring entries of a session result holder that is about to be freed
+    ///
+    /// @note   m_pResultHolderListLock must be held
+    ///
+    /// @param  pSessionResultHolder    Session result holder leaving m_resultHolderList
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID RemoveResultHoldersFromRing(
+        SessionResultHolder* pSessionResultHolder);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// GetFrameworkFrameNumber
     ///
@@ -2138,7 +2326,8 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// UpdateSessionRequestTimingBuffer
     ///
-    /// @brief  Updates session buffer that contains information about how long a request takes to process
+    /// @brief  Updates session buffer that contains information about how long a request takes to process, and the result
+    ///         latency histogram
     ///
     /// @param  pResultHolder   Session result holder
     ///
@@ -2156,6 +2345,15 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     VOID DumpSessionRequestProcessingTime();
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// LogLatencyHistograms
+    ///
+    /// @brief  Logs the latency summaries of the session and its pipelines as JSON
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID LogLatencyHistograms();
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// GetSessionRequestData
     ///
@@ -2232,6 +2430,7 @@ private:
     Condition*             m_pWaitAllResultsAvailable;                 ///< Wait till all results are available
     BOOL                   m_pWaitAllResultsAvailableSignaled;         ///< indicate that signal is sent.
     DeferredRequestQueue*  m_pDeferredRequestQueue;                    ///< Pointer to the deferred process handler
+    RequestArena*          m_pRequestArena;                            ///< Per request bookkeeping allocations
     UINT                   m_usecaseNumBatchedFrames;                  ///< Number of framework frames batched together if
                                                                        ///  batching is enabled
     Condition*             m_pWaitLivePendingRequests;                 ///< Wait if the number of live pending requests
@@ -2244,6 +2443,11 @@ private:
                                                                        ///  requests for non-batch mode.
 
     LightweightDoublyLinkedList m_resultHolderList;                    ///< Result Holder list
+    ResultHolderRingEntry  m_resultHolderRing[MaxQueueDepth];          ///< Result holders indexed by sequenceId, protected by
+                                                                       ///  m_pResultHolderListLock
+    UINT32                 m_minResultSequenceId;                      ///< Cursor: oldest sequence id with a live result holder
+    UINT32                 m_endResultSequenceId;                      ///< One past the newest sequence id in the ring
+    UINT32                 m_numResultHolderRingMisses;                ///< Live results whose ring entry was still taken
 
     ChiCaptureResult*      m_pCaptureResult;                           ///< Final results to send to the Android framework
     ResultStreamBuffers    m_resultStreamBuffers;                      ///< Result stream buffers
@@ -2303,6 +2507,8 @@ private:
     Mutex*                m_pPendingMBQueueLock;                       ///< Lock to serialize the pending metabuffer queue
     SessionPerRequestInfo m_perRequestInfo;                            ///< Hold final per request info
     SessionPerRequestInfo m_tempPerRequestInfo;                        ///< Hold temporary per request info
+    LatencyHistogram      m_resultLatency;                             ///< Request submission until its results are
+                                                                       ///  dispatched
 };
 
 CAMX_NAMESPACE_END
@@ -11,6 +11,7 @@
 
 // Common CamX Includes
 #include "camxincs.h"
+#include "camxlockprofiler.h"
 #include "camxmem.h"
 
 // Core CamX Includes
@@ -312,6 +313,8 @@ VOID SettingsManager::UpdateLogSettings()
         newLogInfo.groupsEnable[CamxLogMeta]      = (TRUE == m_pStaticSettings->logMetaEnable) ? CamxLogGroupMeta : 0;
         newLogInfo.groupsEnable[CamxLogReqMap]    = (TRUE == m_pStaticSettings->logRequestMapping) ? 0xFFFFFFFF : 0;
         newLogInfo.systemLogEnable                = m_pStaticSettings->systemLogEnable;
+        newLogInfo.deferredLogEnable              = m_pStaticSettings->deferredLogEnable;
+        newLogInfo.deferredLogRecordsPerThread    = m_pStaticSettings->deferredLogRecordsPerThread;
 
         if ('\0' != m_pStaticSettings->debugLogFilename[0])
         {
@@ -333,6 +336,12 @@ VOID SettingsManager::UpdateLogSettings()
         // Update trace
         g_traceInfo.groupsEnable        = m_pStaticSettings->traceGroupsEnable;
         g_traceInfo.traceErrorLogEnable = m_pStaticSettings->traceErrorEnable;
+
+        // Lock profiling only covers locks created after it is turned on, so it cannot be turned off again
+        if (TRUE == m_pStaticSettings->lockProfileEnable)
+        {
+            LockProfiler::Enable(m_pStaticSettings->lockProfileReportIntervalMs, m_pStaticSettings->lockProfileReportCount);
+        }
     }
 }
 
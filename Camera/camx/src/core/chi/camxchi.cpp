@@ -2273,12 +2273,10 @@ static VOID ChiDestroySession(
     CHIHANDLE hSession,
     BOOL      isForced)
 {
-    CAMX_UNREFERENCED_PARAM(isForced);
-
     ChiContext* pChiContext = GetChiContext(hChiContext);
     CHISession* pCHISession = GetChiSession(hSession);
 
-    pChiContext->DestroySession(pCHISession);
+    pChiContext->DestroySession(pCHISession, isForced);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2420,6 +2418,28 @@ VOID ChiOverrideBypass(
     CAMX_UNREFERENCED_PARAM(pBypassCallbacks);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiBeginCameraClose
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiBeginCameraClose()
+{
+    if (NULL != g_pChiContext)
+    {
+        g_pChiContext->BeginCameraClose();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEndCameraClose
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiEndCameraClose()
+{
+    if (NULL != g_pChiContext)
+    {
+        g_pChiContext->EndCameraClose();
+    }
+}
+
 CAMX_NAMESPACE_END
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
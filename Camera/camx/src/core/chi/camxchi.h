@@ -262,6 +262,24 @@ CHIBUFFERMANAGERHANDLE ChiBufferManagerCreate(
     const CHAR*                 pBufferManagerName,
     CHIBufferManagerCreateData* pCreateData);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiBeginCameraClose
+///
+/// @brief  Tell the Chi context the HAL is about to tear down the Chi usecase of a closing camera
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiBeginCameraClose();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEndCameraClose
+///
+/// @brief  Tell the Chi context the HAL tore down the Chi usecase of a closing camera
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiEndCameraClose();
+
 
 CAMX_NAMESPACE_END
 
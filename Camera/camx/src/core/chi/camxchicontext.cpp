@@ -52,6 +52,103 @@ struct ChiFenceCallbackData
     VOID*               pUserData;  ///< User data
 };
 
+static const UINT64 SessionCacheKeySeed  = 0xCBF29CE484222325ULL;   ///< FNV-1a offset basis
+static const UINT64 SessionCacheKeyPrime = 0x00000100000001B3ULL;   ///< FNV-1a prime
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// HashBytes
+///
+/// @brief  Fold a block of memory into an FNV-1a hash
+///
+/// @param  hash    Hash so far
+/// @param  pData   Data to add, may be NULL if size is 0
+/// @param  size    Size of the data in bytes
+///
+/// @return Updated hash
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static UINT64 HashBytes(
+    UINT64      hash,
+    const VOID* pData,
+    SIZE_T      size)
+{
+    const BYTE* pBytes = static_cast<const BYTE*>(pData);
+
+    for (SIZE_T i = 0; (NULL != pBytes) && (i < size); i++)
+    {
+        hash ^= pBytes[i];
+        hash *= SessionCacheKeyPrime;
+    }
+
+    return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// HashValue
+///
+/// @brief  Fold a scalar into an FNV-1a hash
+///
+/// @param  hash    Hash so far
+/// @param  value   Value to add
+///
+/// @return Updated hash
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static CAMX_INLINE UINT64 HashValue(
+    UINT64 hash,
+    UINT64 value)
+{
+    return HashBytes(hash, &value, sizeof(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// GetNodePropertyValueSize
+///
+/// @brief  Size of the value of a node property that the driver keeps a copy of
+///
+/// @param  pProperty   Node property from the Chi pipeline create descriptor
+///
+/// @return Size in bytes, 0 if the value is not used by the driver
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static SIZE_T GetNodePropertyValueSize(
+    const ChiNodeProperty* pProperty)
+{
+    SIZE_T length = 0;
+
+    switch (pProperty->id)
+    {
+        case NodePropertyCustomLib:
+        case NodePropertyProfileId:
+        case NodePropertyStabilizationType:
+        case NodePropertyProcessingType:
+        case NodePropertyIPEDownscale:
+        case NodePropertyIPEDownscaleWidth:
+        case NodePropertyIPEDownscaleHeight:
+        case NodePropertyIFECSIDHeight:
+        case NodePropertyIFECSIDWidth:
+        case NodePropertyIFECSIDTop:
+        case NodePropertyIFECSIDLeft:
+        case NodePropertyNodeClass:
+        case NodePropertyGPUCapsMaskType:
+        case NodePropertyForceSingleIFEOn:
+        case NodePropertyEnbaleIPECHICropDependency:
+        case NodePropertyStitchMaxJpegSize:
+            length = OsUtils::StrLen(static_cast<const CHAR*>(pProperty->pValue)) + 1;
+            break;
+        case NodePropertyStatsSkipPattern:
+        case NodePropertyEnableFOVC:
+            length = sizeof(UINT);
+            break;
+        default:
+            break;
+    }
+
+    if (NodePropertyVendorStart <= pProperty->id)
+    {
+        length = OsUtils::StrLen(static_cast<const CHAR*>(pProperty->pValue)) + 1;
+    }
+
+    return length;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ChiContext::Create
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -111,6 +208,7 @@ CamxResult ChiContext::Initialize()
         deferredCreateData.numPipelines      = 0;
         deferredCreateData.pThreadManager    = m_pThreadManager;
         deferredCreateData.requestQueueDepth = DefaultRequestQueueDepth;
+        deferredCreateData.pRequestArena     = NULL;
 
         m_pDeferredRequestQueue = DeferredRequestQueue::Create(&deferredCreateData);
         if (NULL == m_pDeferredRequestQueue)
@@ -174,6 +272,11 @@ ChiContext::~ChiContext()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 VOID ChiContext::Destroy()
 {
+    if (NULL != m_pLock)
+    {
+        EvictSessionCacheEntries(SessionCacheEviction::All, 0, NULL);
+    }
+
     for (UINT32 cameraId = 0; cameraId < MaxNumCameras; cameraId++)
     {
         MetadataPool* pStaticMetadataPool = m_perCameraInfo[cameraId].pStaticMetadataPool;
@@ -2870,6 +2973,9 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
     PipelineCreateInputData  pipelineCreateInputData   = { 0 };
     PipelineCreateOutputData pipelineCreateOutputData  = { 0 };
     PipelineDescriptor*      pPipelineDescriptor       = NULL;
+    OverrideOutputFormat     overrideImpDefinedFormat  = { {0} };
+    UINT64                   cacheKey                  = 0;
+    BOOL                     isCachedDescriptor        = FALSE;
 
     if ((NULL == pPipelineName)                                     ||
         (NULL == pPipelineCreateDescriptor)                         ||
@@ -2882,27 +2988,6 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
 
     if (CamxResultSuccess == result)
     {
-        pPipelineDescriptor = static_cast<PipelineDescriptor*>(CAMX_CALLOC(sizeof(PipelineDescriptor)));
-    }
-
-    if (NULL != pPipelineDescriptor)
-    {
-        pPipelineDescriptor->flags.isRealTime = pPipelineCreateDescriptor->isRealTime;
-
-        UINT                  numBatchedFrames           = pPipelineCreateDescriptor->numBatchedFrames;
-        UINT                  maxFPSValue                = pPipelineCreateDescriptor->maxFPSValue;
-        OverrideOutputFormat  overrideImpDefinedFormat   = { {0} };
-
-        CAMX_LOG_INFO(CamxLogGroupHAL, "numBatchedFrames:%d maxFPSValue:%d", numBatchedFrames, maxFPSValue);
-
-        pPipelineDescriptor->numBatchedFrames = numBatchedFrames;
-        pPipelineDescriptor->maxFPSValue      = maxFPSValue;
-        pPipelineDescriptor->cameraId         = pPipelineCreateDescriptor->cameraId;
-        pPipelineDescriptor->pPrivData        = NULL;
-        pPipelineDescriptor->pSessionMetadata = reinterpret_cast<MetaBuffer*>(pPipelineCreateDescriptor->hPipelineMetadata);
-
-        OsUtils::StrLCpy(pPipelineDescriptor->pipelineName, pPipelineName, MaxStringLength256);
-
         for (UINT streamId = 0; streamId < numOutputs; streamId++)
         {
             ChiStream*          pChiStream          = pOutputBufferDescriptor[streamId].pStream;
@@ -2923,6 +3008,56 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
             }
         }
 
+        if (0 < GetStaticSettings()->sessionCacheSize)
+        {
+            cacheKey            = GetPipelineDescriptorKey(pPipelineName,
+                                                           pPipelineCreateDescriptor,
+                                                           numOutputs,
+                                                           pOutputBufferDescriptor,
+                                                           overrideImpDefinedFormat);
+            pPipelineDescriptor = ReuseCachedPipelineDescriptor(cacheKey,
+                                                                pPipelineCreateDescriptor,
+                                                                numOutputs,
+                                                                pOutputBufferDescriptor,
+                                                                overrideImpDefinedFormat,
+                                                                pPipelineInputOptions);
+            isCachedDescriptor  = (NULL != pPipelineDescriptor);
+
+            if (FALSE == isCachedDescriptor)
+            {
+                // Cached sessions this usecase does not reuse must not keep holding the hardware it is about to acquire
+                EvictSessionCacheEntries(SessionCacheEviction::Unused, 0, NULL);
+            }
+        }
+
+        if (FALSE == isCachedDescriptor)
+        {
+            pPipelineDescriptor = static_cast<PipelineDescriptor*>(CAMX_CALLOC(sizeof(PipelineDescriptor)));
+        }
+    }
+
+    if (TRUE == isCachedDescriptor)
+    {
+        CAMX_LOG_CONFIG(CamxLogGroupChi, "Reusing cached pipeline descriptor %p for %s", pPipelineDescriptor, pPipelineName);
+    }
+    else if (NULL != pPipelineDescriptor)
+    {
+        pPipelineDescriptor->flags.isRealTime = pPipelineCreateDescriptor->isRealTime;
+
+        UINT                  numBatchedFrames           = pPipelineCreateDescriptor->numBatchedFrames;
+        UINT                  maxFPSValue                = pPipelineCreateDescriptor->maxFPSValue;
+
+        CAMX_LOG_INFO(CamxLogGroupHAL, "numBatchedFrames:%d maxFPSValue:%d", numBatchedFrames, maxFPSValue);
+
+        pPipelineDescriptor->numBatchedFrames = numBatchedFrames;
+        pPipelineDescriptor->maxFPSValue      = maxFPSValue;
+        pPipelineDescriptor->cameraId         = pPipelineCreateDescriptor->cameraId;
+        pPipelineDescriptor->pPrivData        = NULL;
+        pPipelineDescriptor->pSessionMetadata = reinterpret_cast<MetaBuffer*>(pPipelineCreateDescriptor->hPipelineMetadata);
+        pPipelineDescriptor->cacheKey         = cacheKey;
+
+        OsUtils::StrLCpy(pPipelineDescriptor->pipelineName, pPipelineName, MaxStringLength256);
+
         for (UINT streamId = 0; streamId < numOutputs; streamId++)
         {
             if (NULL == pOutputBufferDescriptor[streamId].pStream)
@@ -2995,7 +3130,7 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
         result = CamxResultENoMemory;
     }
 
-    if (CamxResultSuccess == result)
+    if ((CamxResultSuccess == result) && (FALSE == isCachedDescriptor))
     {
         // Unfortunately, we don't know the lifetime of the objects being pointed to, so we have to assume they will not
         // exist after this function call, and certainly not by the call to CamX::Session::Initialize, so we might as well
@@ -3006,7 +3141,7 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
                                            pPipelineDescriptor);
     }
 
-    if (result == CamxResultSuccess)
+    if ((result == CamxResultSuccess) && (FALSE == isCachedDescriptor))
     {
         SetPipelineDescriptorOutput(pPipelineDescriptor, numOutputs, pOutputBufferDescriptor);
 
@@ -3030,7 +3165,11 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
         }
     }
 
-    if (CamxResultSuccess == result)
+    if (TRUE == isCachedDescriptor)
+    {
+        // ReuseCachedPipelineDescriptor already filled in the input options and tracks the descriptor again
+    }
+    else if (CamxResultSuccess == result)
     {
         if ((FALSE == pPipelineCreateDescriptor->isRealTime) && (numInputs < pipelineCreateOutputData.numInputs))
         {
@@ -3067,7 +3206,36 @@ PipelineDescriptor* ChiContext::CreatePipelineDescriptor(
 VOID ChiContext::DestroyPipelineDescriptor(
     PipelineDescriptor* pPipelineDescriptor)
 {
+    BOOL isCachedDescriptor = FALSE;
+
     if (NULL != pPipelineDescriptor)
+    {
+        // Descriptors of a cached session stay alive with it, the usecase may get them back from CreatePipelineDescriptor
+        m_pLock->Lock();
+
+        for (UINT entry = 0; entry < MaxSessionCacheEntries; entry++)
+        {
+            SessionCacheEntry* pEntry = &m_sessionCache[entry];
+
+            for (UINT i = 0; (NULL != pEntry->pChiSession) && (i < pEntry->numPipelines); i++)
+            {
+                if (pPipelineDescriptor == pEntry->pPipelineDescriptors[i])
+                {
+                    pEntry->isDescriptorParked[i] = TRUE;
+                    isCachedDescriptor            = TRUE;
+                }
+            }
+        }
+
+        if (TRUE == isCachedDescriptor)
+        {
+            m_pipelineTracking.RemoveByValue(pPipelineDescriptor);
+        }
+
+        m_pLock->Unlock();
+    }
+
+    if ((NULL != pPipelineDescriptor) && (FALSE == isCachedDescriptor))
     {
         if (NULL != pPipelineDescriptor->pipelineInfo.pNodeInfo)
         {
@@ -3553,7 +3721,26 @@ CHISession* ChiContext::CreateSession(
     createData.sessionCreateData.pPrivateCbData          = pPrivateCallbackData;
     createData.sessionCreateData.isNativeChi             = sessionCreateflags.u.isNativeChi;
 
-    pChiSession = CHISession::Create(&createData);
+    if (0 < GetStaticSettings()->sessionCacheSize)
+    {
+        pChiSession = ReuseCachedSession(numPipelines,
+                                         pPipelineInfo,
+                                         pCallbacks,
+                                         pPrivateCallbackData,
+                                         sessionCreateflags.u.isNativeChi);
+
+        if (NULL == pChiSession)
+        {
+            EvictSessionCacheEntries(SessionCacheEviction::Unused, numPipelines, pPipelineInfo);
+        }
+    }
+
+    BOOL isCachedSession = (NULL != pChiSession);
+
+    if (FALSE == isCachedSession)
+    {
+        pChiSession = CHISession::Create(&createData);
+    }
 
     if (NULL != pChiSession)
     {
@@ -3563,6 +3750,13 @@ CHISession* ChiContext::CreateSession(
             m_pLock->Lock();
             pNode->pData = pChiSession;
             m_sessionTracking.InsertToTail(pNode);
+
+            if ((0 != m_switchStartNs) && (NULL == m_pSwitchSession))
+            {
+                m_pSwitchSession = pChiSession;
+                m_isWarmSwitch   = isCachedSession;
+            }
+
             m_pLock->Unlock();
         }
         else
@@ -4115,50 +4309,10 @@ VOID ChiContext::CloneNodeProperties(
     {
         pPerNodeInfo->pNodeProperties[i].id = pChiNode->pNodeProperties[i].id;
 
-        switch (pChiNode->pNodeProperties[i].id)
-        {
-            case NodePropertyCustomLib:
-            case NodePropertyProfileId:
-            case NodePropertyStabilizationType:
-            case NodePropertyProcessingType:
-            case NodePropertyIPEDownscale:
-            case NodePropertyIPEDownscaleWidth:
-            case NodePropertyIPEDownscaleHeight:
-            case NodePropertyIFECSIDHeight:
-            case NodePropertyIFECSIDWidth:
-            case NodePropertyIFECSIDTop:
-            case NodePropertyIFECSIDLeft:
-            case NodePropertyNodeClass:
-            case NodePropertyGPUCapsMaskType:
-            case NodePropertyForceSingleIFEOn:
-            case NodePropertyEnbaleIPECHICropDependency:
-                length = OsUtils::StrLen(static_cast<const CHAR*>(pChiNode->pNodeProperties[i].pValue)) + 1;
-                pPerNodeInfo->pNodeProperties[i].pValue = CAMX_CALLOC(length);
-                Utils::Memcpy(pPerNodeInfo->pNodeProperties[i].pValue, pChiNode->pNodeProperties[i].pValue, length);
-                break;
-            case NodePropertyStatsSkipPattern:
-                length = sizeof(UINT);
-                pPerNodeInfo->pNodeProperties[i].pValue = CAMX_CALLOC(length);
-                Utils::Memcpy(pPerNodeInfo->pNodeProperties[i].pValue, pChiNode->pNodeProperties[i].pValue, length);
-                break;
-            case NodePropertyEnableFOVC:
-                length = sizeof(UINT);
-                pPerNodeInfo->pNodeProperties[i].pValue = CAMX_CALLOC(length);
-                Utils::Memcpy(pPerNodeInfo->pNodeProperties[i].pValue, pChiNode->pNodeProperties[i].pValue, length);
-                break;
-            case NodePropertyStitchMaxJpegSize:
-                length = OsUtils::StrLen(static_cast<const CHAR*>(pChiNode->pNodeProperties[i].pValue)) + 1;
-                pPerNodeInfo->pNodeProperties[i].pValue = CAMX_CALLOC(length);
-                Utils::Memcpy(pPerNodeInfo->pNodeProperties[i].pValue, pChiNode->pNodeProperties[i].pValue, length);
-                break;
+        length = GetNodePropertyValueSize(&pChiNode->pNodeProperties[i]);
 
-            default:
-                break;
-        }
-
-        if (NodePropertyVendorStart <= pChiNode->pNodeProperties[i].id)
+        if (0 < length)
         {
-            length = OsUtils::StrLen(static_cast<const CHAR*>(pChiNode->pNodeProperties[i].pValue)) + 1;
             pPerNodeInfo->pNodeProperties[i].pValue = CAMX_CALLOC(length);
             Utils::Memcpy(pPerNodeInfo->pNodeProperties[i].pValue, pChiNode->pNodeProperties[i].pValue, length);
         }
@@ -4563,6 +4717,37 @@ CamxResult ChiContext::ActivatePipeline(
     CamxResult result = CamxResultSuccess;
     result = pChiSession->StreamOn(hPipelineDescriptor);
 
+    if (CamxResultSuccess == result)
+    {
+        m_pLock->Lock();
+
+        // The usecase switch ends when the first session created after the previous one was destroyed is streaming
+        if ((0 != m_switchStartNs) && (pChiSession == m_pSwitchSession))
+        {
+            UINT64 switchNs = OsUtils::GetNanoSeconds() - m_switchStartNs;
+
+            if (TRUE == m_isWarmSwitch)
+            {
+                m_warmSwitchLatency.Record(switchNs);
+            }
+            else
+            {
+                m_coldSwitchLatency.Record(switchNs);
+            }
+
+            CAMX_LOG_CONFIG(CamxLogGroupChi, "Usecase switch %s -> %s: %llu us (%s)",
+                            m_switchFromNames,
+                            pChiSession->GetPipelineNames(),
+                            switchNs / 1000,
+                            (TRUE == m_isWarmSwitch) ? "warm" : "cold");
+
+            m_switchStartNs  = 0;
+            m_pSwitchSession = NULL;
+        }
+
+        m_pLock->Unlock();
+    }
+
     return result;
 }
 
@@ -4588,15 +4773,28 @@ CamxResult ChiContext::DeactivatePipeline(
 // ChiContext::DestroySession
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 VOID ChiContext::DestroySession(
-    CHISession* pChiSession)
+    CHISession* pChiSession,
+    BOOL        isForced)
 {
     if (NULL != pChiSession)
     {
         m_pLock->Lock();
         m_sessionTracking.RemoveByValue(pChiSession);
+
+        // Sessions a closing camera tears down are neither followed by a usecase switch nor worth caching
+        BOOL isCameraClosing = (0 < m_numClosingCameras);
+
+        m_switchStartNs  = (FALSE == isCameraClosing) ? OsUtils::GetNanoSeconds() : 0;
+        m_pSwitchSession = NULL;
+        OsUtils::StrLCpy(m_switchFromNames, pChiSession->GetPipelineNames(), sizeof(m_switchFromNames));
+
         m_pLock->Unlock();
 
-        pChiSession->Destroy();
+        if ((TRUE == isForced) || (TRUE == isCameraClosing) || (FALSE == CacheSession(pChiSession)))
+        {
+            pChiSession->Destroy();
+        }
+
         pChiSession = NULL;
     }
     else
@@ -4605,6 +4803,487 @@ VOID ChiContext::DestroySession(
     }
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::GetPipelineDescriptorKey
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT64 ChiContext::GetPipelineDescriptorKey(
+    const CHAR*                        pPipelineName,
+    const ChiPipelineCreateDescriptor* pPipelineCreateDescriptor,
+    UINT32                             numOutputs,
+    const ChiPortBufferDescriptor*     pOutputBufferDescriptor,
+    OverrideOutputFormat               overrideImpDefinedFormat)
+{
+    UINT64 key = HashBytes(SessionCacheKeySeed, pPipelineName, OsUtils::StrLen(pPipelineName));
+
+    key = HashValue(key, pPipelineCreateDescriptor->isRealTime);
+    key = HashValue(key, pPipelineCreateDescriptor->cameraId);
+    key = HashValue(key, pPipelineCreateDescriptor->numBatchedFrames);
+    key = HashValue(key, pPipelineCreateDescriptor->maxFPSValue);
+    key = HashValue(key, pPipelineCreateDescriptor->numNodes);
+    key = HashValue(key, pPipelineCreateDescriptor->numLinks);
+
+    for (UINT node = 0; node < pPipelineCreateDescriptor->numNodes; node++)
+    {
+        const ChiNode*      pChiNode  = &pPipelineCreateDescriptor->pNodes[node];
+        const ChiNodePorts* pChiPorts = &pChiNode->nodeAllPorts;
+
+        key = HashValue(key, pChiNode->nodeId);
+        key = HashValue(key, pChiNode->nodeInstanceId);
+        key = HashValue(key, pChiNode->numProperties);
+
+        for (UINT i = 0; i < pChiNode->numProperties; i++)
+        {
+            key = HashValue(key, pChiNode->pNodeProperties[i].id);
+            key = HashBytes(key,
+                            pChiNode->pNodeProperties[i].pValue,
+                            GetNodePropertyValueSize(&pChiNode->pNodeProperties[i]));
+        }
+
+        key = HashValue(key, pChiPorts->numInputPorts);
+        key = HashBytes(key, pChiPorts->pInputPorts, sizeof(ChiInputPortDescriptor) * pChiPorts->numInputPorts);
+        key = HashValue(key, pChiPorts->numOutputPorts);
+        key = HashBytes(key, pChiPorts->pOutputPorts, sizeof(ChiOutputPortDescriptor) * pChiPorts->numOutputPorts);
+    }
+
+    for (UINT link = 0; link < pPipelineCreateDescriptor->numLinks; link++)
+    {
+        const ChiNodeLink* pChiNodeLink = &pPipelineCreateDescriptor->pLinks[link];
+
+        key = HashBytes(key, &pChiNodeLink->srcNode, sizeof(ChiLinkNodeDescriptor));
+        key = HashValue(key, pChiNodeLink->numDestNodes);
+        key = HashBytes(key, pChiNodeLink->pDestNodes, sizeof(ChiLinkNodeDescriptor) * pChiNodeLink->numDestNodes);
+        key = HashBytes(key, &pChiNodeLink->bufferProperties, sizeof(ChiLinkBufferProperties));
+        key = HashBytes(key, &pChiNodeLink->linkProperties, sizeof(ChiLinkProperties));
+    }
+
+    for (UINT streamId = 0; streamId < numOutputs; streamId++)
+    {
+        const ChiStream* pChiStream = pOutputBufferDescriptor[streamId].pStream;
+
+        // The stream itself is part of the key, a cached descriptor keeps wrappers of the streams it was created for
+        key = HashValue(key, static_cast<UINT64>(reinterpret_cast<UINTPTR_T>(pChiStream)));
+
+        if (NULL != pChiStream)
+        {
+            UINT64 dataspace = static_cast<UINT64>(pChiStream->dataspace);
+
+            // The HDR preview override writes BT2020_PQ back into the stream, so a usecase recreating the pipeline passes the
+            // overridden dataspace. Key such streams by what the override maps them to, the same before and after it ran.
+            if ((GrallocUsageHwComposer == (GetGrallocUsage(pChiStream) & GrallocUsageHwComposer)) &&
+                (TRUE == overrideImpDefinedFormat.isHDR))
+            {
+                dataspace = static_cast<UINT64>(DataspaceStandardBT2020_PQ);
+            }
+
+            key = HashValue(key, pChiStream->streamType);
+            key = HashValue(key, pChiStream->width);
+            key = HashValue(key, pChiStream->height);
+            key = HashValue(key, pChiStream->format);
+            key = HashValue(key, dataspace);
+            key = HashValue(key, pChiStream->rotation);
+            key = HashValue(key, GetGrallocUsage(pChiStream));
+        }
+
+        key = HashBytes(key, &pOutputBufferDescriptor[streamId].nodePort, sizeof(ChiLinkNodeDescriptor));
+        key = HashValue(key, pOutputBufferDescriptor[streamId].bIsOverrideImplDefinedWithRaw);
+    }
+
+    return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::ReuseCachedPipelineDescriptor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+PipelineDescriptor* ChiContext::ReuseCachedPipelineDescriptor(
+    UINT64                             key,
+    const ChiPipelineCreateDescriptor* pPipelineCreateDescriptor,
+    UINT32                             numOutputs,
+    ChiPortBufferDescriptor*           pOutputBufferDescriptor,
+    OverrideOutputFormat               overrideImpDefinedFormat,
+    CHIPIPELINEINPUTOPTIONS*           pPipelineInputOptions)
+{
+    PipelineDescriptor* pPipelineDescriptor = NULL;
+
+    m_pLock->Lock();
+
+    for (UINT entry = 0; (entry < MaxSessionCacheEntries) && (NULL == pPipelineDescriptor); entry++)
+    {
+        SessionCacheEntry* pEntry = &m_sessionCache[entry];
+
+        for (UINT i = 0; (NULL != pEntry->pChiSession) && (i < pEntry->numPipelines); i++)
+        {
+            if ((TRUE == pEntry->isDescriptorParked[i]) && (key == pEntry->pPipelineDescriptors[i]->cacheKey))
+            {
+                pPipelineDescriptor           = pEntry->pPipelineDescriptors[i];
+                pEntry->isDescriptorParked[i] = FALSE;
+                break;
+            }
+        }
+    }
+
+    if (NULL != pPipelineDescriptor)
+    {
+        LDLLNode* pNode = static_cast<LDLLNode*>(CAMX_CALLOC(sizeof(LDLLNode)));
+
+        if (NULL != pNode)
+        {
+            pNode->pData = pPipelineDescriptor;
+            m_pipelineTracking.InsertToTail(pNode);
+        }
+    }
+
+    m_pLock->Unlock();
+
+    if (NULL != pPipelineDescriptor)
+    {
+        Pipeline* pPipeline = static_cast<Pipeline*>(pPipelineDescriptor->pPrivData);
+
+        // Point the usecase's streams at the wrappers of the descriptor, as CreatePipelineDescriptor does for new ones
+        for (UINT streamId = 0; streamId < numOutputs; streamId++)
+        {
+            ChiStream*        pChiStream        = pOutputBufferDescriptor[streamId].pStream;
+            ChiStreamWrapper* pChiStreamWrapper = pPipelineDescriptor->outputData[streamId].pOutputStreamWrapper;
+
+            pChiStream->pHalStream = NULL;
+
+            if ((GrallocUsageHwComposer == (GetGrallocUsage(pChiStream) & GrallocUsageHwComposer)) &&
+                (TRUE == overrideImpDefinedFormat.isHDR))
+            {
+                pChiStream->dataspace = DataspaceStandardBT2020_PQ;
+            }
+
+            SetChiStreamInfo(pChiStreamWrapper,
+                             pPipelineDescriptor->numBatchedFrames,
+                             (ChiExternalNode == pOutputBufferDescriptor[streamId].nodePort.nodeId));
+
+            pChiStream->pPrivateInfo = pChiStreamWrapper;
+        }
+
+        pPipelineDescriptor->pSessionMetadata = reinterpret_cast<MetaBuffer*>(pPipelineCreateDescriptor->hPipelineMetadata);
+        pPipeline->UpdateUsecaseMetadata();
+
+        for (UINT i = 0; i < pPipelineDescriptor->numInputs; i++)
+        {
+            Utils::Memcpy(&(pPipelineInputOptions[i].nodePort),
+                          &(pPipelineDescriptor->inputData[i].nodePort),
+                          sizeof(ChiLinkNodeDescriptor));
+
+            Utils::Memcpy(&(pPipelineInputOptions[i].bufferOptions),
+                          &(pPipelineDescriptor->inputData[i].bufferOptions),
+                          sizeof(ChiBufferOptions));
+        }
+    }
+
+    return pPipelineDescriptor;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::ReuseCachedSession
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CHISession* ChiContext::ReuseCachedSession(
+    UINT             numPipelines,
+    ChiPipelineInfo* pPipelineInfo,
+    ChiCallBacks*    pCallbacks,
+    VOID*            pPrivateCallbackData,
+    BOOL             isNativeChi)
+{
+    CHISession*       pChiSession = NULL;
+    SessionCacheEntry entry       = {};
+
+    m_pLock->Lock();
+
+    for (UINT index = 0; (index < MaxSessionCacheEntries) && (NULL == pChiSession); index++)
+    {
+        SessionCacheEntry* pEntry  = &m_sessionCache[index];
+        BOOL               isMatch = ((NULL         != pEntry->pChiSession)                 &&
+                                      (numPipelines == pEntry->numPipelines)                &&
+                                      (isNativeChi  == pEntry->pChiSession->IsNativeChi()));
+
+        // The session was finalized for its pipelines in this order and for these sensor modes
+        for (UINT i = 0; (TRUE == isMatch) && (i < numPipelines); i++)
+        {
+            const PipelineDescriptor* pPipelineDescriptor = pEntry->pPipelineDescriptors[i];
+            const SensorInfo*         pSensorInfo         = &pPipelineDescriptor->inputData[0].sensorInfo;
+
+            isMatch = ((pPipelineDescriptor == GetPipelineDescriptor(pPipelineInfo[i].hPipelineDescriptor))         &&
+                       (FALSE               == pEntry->isDescriptorParked[i])                                        &&
+                       (TRUE                == pPipelineInfo[i].pipelineInputInfo.isInputSensor)                     &&
+                       (pSensorInfo->cameraId == pPipelineInfo[i].pipelineInputInfo.sensorInfo.cameraId)             &&
+                       (pSensorInfo->sensorMode.modeIndex ==
+                        pPipelineInfo[i].pipelineInputInfo.sensorInfo.pSensorModeInfo->modeIndex));
+        }
+
+        if (TRUE == isMatch)
+        {
+            pChiSession = pEntry->pChiSession;
+            entry       = *pEntry;
+
+            Utils::Memset(pEntry, 0, sizeof(SessionCacheEntry));
+        }
+    }
+
+    m_pLock->Unlock();
+
+    if (NULL != pChiSession)
+    {
+        pChiSession->SetChiCallBacks(pCallbacks, pPrivateCallbackData);
+
+        for (UINT i = 0; i < numPipelines; i++)
+        {
+            pPipelineInfo[i].pipelineOutputInfo.hPipelineHandle =
+                static_cast<Pipeline*>(entry.pPipelineDescriptors[i]->pPrivData);
+        }
+
+        CAMX_LOG_CONFIG(CamxLogGroupChi, "Reusing cached session %p %s", pChiSession, pChiSession->GetPipelineNames());
+    }
+
+    return pChiSession;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::CacheSession
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL ChiContext::CacheSession(
+    CHISession* pChiSession)
+{
+    const StaticSettings* pStaticSettings = GetStaticSettings();
+    UINT                  cacheSize       = Utils::MinUINT32(pStaticSettings->sessionCacheSize, MaxSessionCacheEntries);
+    UINT                  numPipelines    = pChiSession->GetNumPipelines();
+    BOOL                  isCached        = ((0    <  cacheSize)                          &&
+                                             (TRUE == pStaticSettings->enableSensorCaching) &&
+                                             (0    <  numPipelines));
+    SessionCacheEntry     evicted         = {};
+
+    if (TRUE == isCached)
+    {
+        m_pLock->Lock();
+
+        // Offline pipelines hold wrappers of the usecase's input streams, and a descriptor the usecase already destroyed
+        // cannot be handed back, so only sessions of live realtime descriptors are kept
+        for (UINT i = 0; (TRUE == isCached) && (i < numPipelines); i++)
+        {
+            PipelineDescriptor* pPipelineDescriptor = pChiSession->GetPipelineDescriptorByIndex(i);
+
+            isCached = ((NULL  != pPipelineDescriptor)                                        &&
+                        (TRUE  == pPipelineDescriptor->flags.isRealTime)                      &&
+                        (NULL  != pPipelineDescriptor->pPrivData)                             &&
+                        (NULL  != m_pipelineTracking.FindByValue(pPipelineDescriptor)));
+        }
+
+        m_pLock->Unlock();
+    }
+
+    if (TRUE == isCached)
+    {
+        EvictSessionCacheEntries(SessionCacheEviction::Expired, 0, NULL);
+
+        // Deactivate as for a usecase switch, the nodes keep their IQ modules, command buffers and tuning data
+        pChiSession->Flush();
+
+        for (UINT i = 0; (TRUE == isCached) && (i < numPipelines); i++)
+        {
+            CamxResult result = pChiSession->StreamOff(pChiSession->GetPipelineDescriptorByIndex(i),
+                                                       CHIDeactivateModeDefault | CHIDeactivateModeReleaseBuffer);
+
+            isCached = (CamxResultSuccess == result);
+        }
+    }
+
+    if (TRUE == isCached)
+    {
+        SessionCacheEntry* pEntry    = NULL;
+        SessionCacheEntry* pOldest   = NULL;
+        UINT               numCached = 0;
+
+        m_pLock->Lock();
+
+        for (UINT index = 0; index < MaxSessionCacheEntries; index++)
+        {
+            SessionCacheEntry* pCurrent = &m_sessionCache[index];
+
+            if (NULL == pCurrent->pChiSession)
+            {
+                pEntry = (NULL == pEntry) ? pCurrent : pEntry;
+            }
+            else
+            {
+                numCached++;
+
+                if ((NULL == pOldest) || (pCurrent->parkedNs < pOldest->parkedNs))
+                {
+                    pOldest = pCurrent;
+                }
+            }
+        }
+
+        if (numCached >= cacheSize)
+        {
+            evicted = *pOldest;
+            pEntry  = pOldest;
+        }
+
+        Utils::Memset(pEntry, 0, sizeof(SessionCacheEntry));
+
+        pEntry->pChiSession  = pChiSession;
+        pEntry->numPipelines = numPipelines;
+        pEntry->parkedNs     = OsUtils::GetNanoSeconds();
+
+        for (UINT i = 0; i < numPipelines; i++)
+        {
+            pEntry->pPipelineDescriptors[i] = pChiSession->GetPipelineDescriptorByIndex(i);
+        }
+
+        m_pLock->Unlock();
+
+        if (NULL != evicted.pChiSession)
+        {
+            DestroySessionCacheEntry(&evicted);
+        }
+
+        CAMX_LOG_CONFIG(CamxLogGroupChi, "Cached session %p %s", pChiSession, pChiSession->GetPipelineNames());
+    }
+
+    return isCached;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::EvictSessionCacheEntries
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiContext::EvictSessionCacheEntries(
+    SessionCacheEviction   eviction,
+    UINT                   numPipelines,
+    const ChiPipelineInfo* pPipelineInfo)
+{
+    SessionCacheEntry evicted[MaxSessionCacheEntries];
+    UINT              numEvicted = 0;
+    UINT64            timeoutNs  = static_cast<UINT64>(GetStaticSettings()->sessionCacheTimeoutMs) * 1000000;
+    UINT64            currentNs  = OsUtils::GetNanoSeconds();
+
+    m_pLock->Lock();
+
+    for (UINT index = 0; index < MaxSessionCacheEntries; index++)
+    {
+        SessionCacheEntry* pEntry    = &m_sessionCache[index];
+        BOOL               isEvicted = FALSE;
+
+        if (NULL != pEntry->pChiSession)
+        {
+            isEvicted = ((SessionCacheEviction::All == eviction) ||
+                         ((0 != timeoutNs) && ((currentNs - pEntry->parkedNs) >= timeoutNs)));
+
+            if ((FALSE == isEvicted) && (SessionCacheEviction::Unused == eviction))
+            {
+                BOOL isReused   = FALSE;
+                BOOL isReplaced = FALSE;
+
+                for (UINT i = 0; i < pEntry->numPipelines; i++)
+                {
+                    if (FALSE == pEntry->isDescriptorParked[i])
+                    {
+                        isReused = TRUE;
+                    }
+
+                    for (UINT pipeline = 0; (NULL != pPipelineInfo) && (pipeline < numPipelines); pipeline++)
+                    {
+                        if (pEntry->pPipelineDescriptors[i] ==
+                            GetPipelineDescriptor(pPipelineInfo[pipeline].hPipelineDescriptor))
+                        {
+                            isReplaced = TRUE;
+                        }
+                    }
+                }
+
+                // A new session being created from some of the descriptors means the cached one did not match
+                isEvicted = ((FALSE == isReused) || (TRUE == isReplaced));
+            }
+        }
+
+        if (TRUE == isEvicted)
+        {
+            evicted[numEvicted++] = *pEntry;
+            Utils::Memset(pEntry, 0, sizeof(SessionCacheEntry));
+        }
+    }
+
+    m_pLock->Unlock();
+
+    for (UINT index = 0; index < numEvicted; index++)
+    {
+        DestroySessionCacheEntry(&evicted[index]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::DestroySessionCacheEntry
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiContext::DestroySessionCacheEntry(
+    SessionCacheEntry* pEntry)
+{
+    CAMX_LOG_CONFIG(CamxLogGroupChi, "Destroying cached session %p %s",
+                    pEntry->pChiSession,
+                    pEntry->pChiSession->GetPipelineNames());
+
+    pEntry->pChiSession->Destroy();
+    pEntry->pChiSession = NULL;
+
+    for (UINT i = 0; i < pEntry->numPipelines; i++)
+    {
+        PipelineDescriptor* pPipelineDescriptor = pEntry->pPipelineDescriptors[i];
+
+        if (TRUE == pEntry->isDescriptorParked[i])
+        {
+            DestroyPipelineDescriptor(pPipelineDescriptor);
+        }
+        else
+        {
+            // The usecase owns the descriptor again, but its pipeline was finalized for the destroyed session. Drop it, the
+            // next session created from the descriptor gets a new one from CreatePipelineFromDesc, which also reports a
+            // failure to create it.
+            Pipeline* pPipeline = static_cast<Pipeline*>(pPipelineDescriptor->pPrivData);
+
+            pPipelineDescriptor->pPrivData = NULL;
+            pPipeline->Destroy();
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::BeginCameraClose
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiContext::BeginCameraClose()
+{
+    m_pLock->Lock();
+    m_numClosingCameras++;
+    m_switchStartNs = 0;
+    m_pLock->Unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ChiContext::EndCameraClose
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiContext::EndCameraClose()
+{
+    BOOL isLastUsecase = FALSE;
+
+    m_pLock->Lock();
+
+    CAMX_ASSERT(0 < m_numClosingCameras);
+
+    if (0 < m_numClosingCameras)
+    {
+        m_numClosingCameras--;
+    }
+
+    isLastUsecase = ((0 == m_numClosingCameras) && (0 == m_sessionTracking.NumNodes()));
+
+    m_pLock->Unlock();
+
+    if (TRUE == isLastUsecase)
+    {
+        EvictSessionCacheEntries(SessionCacheEviction::All, 0, NULL);
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // ChiContext::FlushSession
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -4659,6 +5338,19 @@ VOID ChiContext::DumpState(
     CAMX_LOG_TO_FILE(fd, Indent, "+------------------------------------------------------------------+");
     CAMX_LOG_TO_FILE(fd, Indent, "+ Number of open sessions: %d", m_sessionTracking.NumNodes());
     CAMX_LOG_TO_FILE(fd, Indent, "+ Number of open pipeline descriptors: %d", m_pipelineTracking.NumNodes());
+
+    for (UINT entry = 0; entry < MaxSessionCacheEntries; entry++)
+    {
+        if (NULL != m_sessionCache[entry].pChiSession)
+        {
+            CAMX_LOG_TO_FILE(fd, Indent, "+ Cached session: %p %s",
+                             m_sessionCache[entry].pChiSession,
+                             m_sessionCache[entry].pChiSession->GetPipelineNames());
+        }
+    }
+
+    m_coldSwitchLatency.DumpState(fd, Indent, "ColdUsecaseSwitch");
+    m_warmSwitchLatency.DumpState(fd, Indent, "WarmUsecaseSwitch");
     CAMX_LOG_TO_FILE(fd, Indent, "+------------------------------------------------------------------+");
     CAMX_LOG_TO_FILE(fd, Indent, "+------------------------------------------------------------------+");
 
@@ -17,6 +17,7 @@
 #include "camxhal3stream.h"
 #include "camxhwcontext.h"
 #include "camxhwenvironment.h"
+#include "camxlatencyhistogram.h"
 #include "chi.h"
 
 CAMX_NAMESPACE_BEGIN
@@ -48,6 +49,28 @@ struct PerCameraInfo
     BOOL          isCameraOpened;           ///< Is camera opened or not indicator
 };
 
+static const UINT32 MaxSessionCacheEntries = 4;   ///< Upper bound of the sessionCacheSize setting
+
+/// @brief Which cached sessions EvictSessionCacheEntries destroys
+enum class SessionCacheEviction
+{
+    Expired,    ///< Sessions cached for longer than sessionCacheTimeoutMs
+    Unused,     ///< Expired sessions and sessions the current usecase did not get any descriptor back of
+    All,        ///< Every cached session
+};
+
+/// @brief A destroyed realtime session kept deactivated, with its pipelines, for a later usecase creating the same pipelines
+struct SessionCacheEntry
+{
+    CHISession*         pChiSession;                                    ///< Deactivated session, NULL if the entry is free
+    UINT                numPipelines;                                   ///< Number of pipelines in the session
+    PipelineDescriptor* pPipelineDescriptors[MaxPipelinesPerSession];   ///< Descriptors of the pipelines, in session order
+    BOOL                isDescriptorParked[MaxPipelinesPerSession];     ///< The usecase destroyed the descriptor, FALSE once a
+                                                                        ///  new usecase got it back from
+                                                                        ///  CreatePipelineDescriptor
+    UINT64              parkedNs;                                       ///< Time the session was added to the cache
+};
+
 /// @brief OverrideOutputFormat flags used to override implimentation defined formats
 union OverrideOutputFormat
 {
@@ -171,6 +194,26 @@ public:
     CamxResult ProcessCameraClose(
         UINT32 cameraId);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// BeginCameraClose
+    ///
+    /// @brief  Called before the HAL tears down the Chi usecase of a closing camera, so the sessions it destroys are not
+    ///         taken for a usecase switch
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID BeginCameraClose();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// EndCameraClose
+    ///
+    /// @brief  Called once the HAL tore down the Chi usecase of a closing camera. Destroys the session cache if it was the
+    ///         last usecase, as there is no switch left to serve.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID EndCameraClose();
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// CreatePipelineDescriptor
     ///
@@ -277,14 +320,16 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// DestroySession
     ///
-    /// @brief  Destroys a session
+    /// @brief  Destroys a session, or keeps it deactivated in the session cache if enabled
     ///
     /// @param  pCHISession    Session to destroy
+    /// @param  isForced       Destroy the session even if it could be cached
     ///
     /// @return None
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     VOID DestroySession(
-        CHISession* pCHISession);
+        CHISession* pCHISession,
+        BOOL        isForced);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// FlushSession
@@ -675,6 +720,113 @@ private:
         ChiNode*      pChiNode,
         PerNodeInfo*  pPerNodeInfo);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetPipelineDescriptorKey
+    ///
+    /// @brief  Hash everything CreatePipelineDescriptor takes from the Chi usecase, so that a descriptor created from equal
+    ///         parameters on the same streams can be found in the session cache
+    ///
+    /// @param  pPipelineName               Name of the pipeline
+    /// @param  pPipelineCreateDescriptor   Pipeline create descriptor
+    /// @param  numOutputs                  Number of outputs of the pipeline
+    /// @param  pOutputBufferDescriptor     Output buffer descriptors
+    /// @param  overrideImpDefinedFormat    Format overrides of the outputs
+    ///
+    /// @return Key of the descriptor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    UINT64 GetPipelineDescriptorKey(
+        const CHAR*                        pPipelineName,
+        const ChiPipelineCreateDescriptor* pPipelineCreateDescriptor,
+        UINT32                             numOutputs,
+        const ChiPortBufferDescriptor*     pOutputBufferDescriptor,
+        OverrideOutputFormat               overrideImpDefinedFormat);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ReuseCachedPipelineDescriptor
+    ///
+    /// @brief  Hand a descriptor of a cached session back to the Chi usecase if its key matches, rebinding the output streams
+    ///         to the stream wrappers of the descriptor
+    ///
+    /// @param  key                         Key of the descriptor to create
+    /// @param  pPipelineCreateDescriptor   Pipeline create descriptor
+    /// @param  numOutputs                  Number of outputs of the pipeline
+    /// @param  pOutputBufferDescriptor     Output buffer descriptors
+    /// @param  overrideImpDefinedFormat    Format overrides of the outputs
+    /// @param  pPipelineInputOptions       Filled in with the input options of the pipeline
+    ///
+    /// @return Cached descriptor, or NULL if none matches
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    PipelineDescriptor* ReuseCachedPipelineDescriptor(
+        UINT64                             key,
+        const ChiPipelineCreateDescriptor* pPipelineCreateDescriptor,
+        UINT32                             numOutputs,
+        ChiPortBufferDescriptor*           pOutputBufferDescriptor,
+        OverrideOutputFormat               overrideImpDefinedFormat,
+        CHIPIPELINEINPUTOPTIONS*           pPipelineInputOptions);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ReuseCachedSession
+    ///
+    /// @brief  Hand a cached session back to the Chi usecase if it is being created from exactly the descriptors it was
+    ///         cached with, on the same sensor modes
+    ///
+    /// @param  numPipelines            Number of pipelines
+    /// @param  pPipelineInfo           Pipelines of the session to create
+    /// @param  pCallbacks              Callbacks into the app
+    /// @param  pPrivateCallbackData    Private data passed back with the callbacks
+    /// @param  isNativeChi             The session is created from Native Chi
+    ///
+    /// @return Cached session, or NULL if none matches
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CHISession* ReuseCachedSession(
+        UINT             numPipelines,
+        ChiPipelineInfo* pPipelineInfo,
+        ChiCallBacks*    pCallbacks,
+        VOID*            pPrivateCallbackData,
+        BOOL             isNativeChi);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// CacheSession
+    ///
+    /// @brief  Deactivate a session the Chi usecase destroys and keep it in the session cache. Only realtime sessions whose
+    ///         descriptors are still alive are cached, with the oldest entry evicted if the cache is full.
+    ///
+    /// @param  pChiSession     Session to cache
+    ///
+    /// @return TRUE if the session was cached, FALSE if the caller should destroy it
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    BOOL CacheSession(
+        CHISession* pChiSession);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// EvictSessionCacheEntries
+    ///
+    /// @brief  Destroy cached sessions selected by the eviction mode, plus those that own one of the given pipelines
+    ///
+    /// @param  eviction        Which sessions to destroy
+    /// @param  numPipelines    Number of pipelines in pPipelineInfo
+    /// @param  pPipelineInfo   Pipelines of a session that is created without the cache, may be NULL
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID EvictSessionCacheEntries(
+        SessionCacheEviction   eviction,
+        UINT                   numPipelines,
+        const ChiPipelineInfo* pPipelineInfo);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DestroySessionCacheEntry
+    ///
+    /// @brief  Destroy an evicted session. Descriptors the usecase already destroyed are freed, descriptors it got back lose
+    ///         their pipeline since it was finalized for the destroyed session; the next session creates a new one.
+    ///
+    /// @param  pEntry  Entry removed from the cache
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DestroySessionCacheEntry(
+        SessionCacheEntry* pEntry);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// IsUBWCLossySupported
     ///
@@ -725,6 +877,16 @@ private:
     DeferredRequestQueue*       m_pDeferredRequestQueue;                  ///< Pointer to the deferred process handler
     LightweightDoublyLinkedList m_sessionTracking;                        ///< collection of all active sessions
     LightweightDoublyLinkedList m_pipelineTracking;                       ///< collection of all active pipelines
+    SessionCacheEntry           m_sessionCache[MaxSessionCacheEntries];   ///< Deactivated sessions kept for reuse
+    LatencyHistogram            m_coldSwitchLatency;                      ///< Usecase switches that created a new session
+    LatencyHistogram            m_warmSwitchLatency;                      ///< Usecase switches served by the session cache
+    UINT64                      m_switchStartNs;                          ///< Time the last session was destroyed, 0 once
+                                                                          ///  the switch was measured
+    CHISession*                 m_pSwitchSession;                         ///< First session created after m_switchStartNs
+    BOOL                        m_isWarmSwitch;                           ///< m_pSwitchSession came from the session cache
+    CHAR                        m_switchFromNames[MaxStringLength256];    ///< Pipelines of the last destroyed session
+    UINT32                      m_numClosingCameras;                      ///< Cameras between BeginCameraClose and
+                                                                          ///  EndCameraClose
 };
 
 CAMX_NAMESPACE_END
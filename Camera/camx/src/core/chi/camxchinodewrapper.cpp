@@ -599,6 +599,13 @@ VOID* ChiNodeWrapper::FNGetDataNCS(
                     {
                         pSensorDataObject->SetIndex(pDataRequest->index);
                         pData = pSensorDataObject->GetCurrent();
+
+                        // The sample is read in place from the lock-free ring; once the producer has lapped the window
+                        // report the end of data instead of handing out a torn sample
+                        if ((NULL != pData) && (FALSE == pSensorDataObject->IsValid()))
+                        {
+                            pData = NULL;
+                        }
                     }
                     else
                     {
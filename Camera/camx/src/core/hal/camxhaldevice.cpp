@@ -1030,7 +1030,10 @@ CamxResult HALDevice::Close()
     if (TRUE == IsCHIModuleInitialized())
     {
         m_bCHIModuleInitialized = FALSE;
+
+        ChiBeginCameraClose();
         pCHIAppCallbacks->chi_teardown_override_session(reinterpret_cast<camera3_device*>(&m_camera3Device), 0, NULL);
+        ChiEndCameraClose();
     }
 
     // Move torch release to post Session Destroy as we might set error conditions accordingly.
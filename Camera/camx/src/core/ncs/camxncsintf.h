@@ -307,6 +307,20 @@ public:
     virtual NCSIntfState UpdateIntfState(
         VOID* pPayload) = 0;
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DeliverData
+    ///
+    /// @brief  Deliver newly published samples to the clients waiting on a connection, called from the NCS poll thread
+    ///
+    /// @param  connIndex  Connection index
+    /// @param  timestamp  Timestamp of the latest published sample
+    ///
+    /// @return CamxResultSuccess on success
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    virtual CamxResult DeliverData(
+        INT    connIndex,
+        UINT64 timestamp) = 0;
+
 private:
     INCSIntfBase(const INCSIntfBase&)                  = delete;     ///< Disallow the copy constructor.
     INCSIntfBase& operator= (const INCSIntfBase&)      = delete;     ///< Disallow assignment operator
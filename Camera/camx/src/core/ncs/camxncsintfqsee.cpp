@@ -14,6 +14,7 @@
 // NOWHINE FILE CP010: QSEE Sensor interface
 // NOWHINE FILE GR004: Need to get the const variables within this scope
 
+#include "camxatomic.h"
 #include "camxncsintfqsee.h"
 #include "camxncssensor.h"
 #include "camxncssensordata.h"
@@ -152,8 +153,9 @@ NCSIntfQSEE::NCSIntfQSEE()
     m_intfState        = NCSIntfInvalid;
 
     m_pQSEEIntfMutex     = Mutex::Create("QSEEIntfMutex");
+    m_pAccessorPoolMutex = Mutex::Create("QSEEAccessorPoolMutex");
     m_pQSEELinkUpdateCond   = Condition::Create("QSEELinkUpdateCondition");
-    if (NULL == m_pQSEEIntfMutex || NULL == m_pQSEELinkUpdateCond)
+    if (NULL == m_pQSEEIntfMutex || NULL == m_pAccessorPoolMutex || NULL == m_pQSEELinkUpdateCond)
     {
         result = CamxResultENoMemory;
 
@@ -163,6 +165,12 @@ NCSIntfQSEE::NCSIntfQSEE()
             m_pQSEEIntfMutex = NULL;
         }
 
+        if (NULL != m_pAccessorPoolMutex)
+        {
+            m_pAccessorPoolMutex->Destroy();
+            m_pAccessorPoolMutex = NULL;
+        }
+
         if (NULL != m_pQSEELinkUpdateCond)
         {
             m_pQSEELinkUpdateCond->Destroy();
@@ -192,6 +200,12 @@ NCSIntfQSEE::~NCSIntfQSEE()
         m_pQSEEIntfMutex = NULL;
     }
 
+    if (NULL != m_pAccessorPoolMutex)
+    {
+        m_pAccessorPoolMutex->Destroy();
+        m_pAccessorPoolMutex = NULL;
+    }
+
     if (NULL != m_pQSEELinkUpdateCond)
     {
         m_pQSEELinkUpdateCond->Destroy();
@@ -619,61 +633,6 @@ CamxResult NCSIntfQSEE::RequestSensorCaps(
     return result;
 }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSIntfQSEE::SetBufferLock
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-BOOL NCSIntfQSEE::SetBufferLock(
-    INT connIndex,
-    INT start,
-    INT end)
-{
-    INT  curPos;
-    BOOL result = FALSE;
-    // current position is the location where the sensor would write to in the next callback
-    curPos = m_sensorConnList[connIndex].bufferHandles.currentPos;
-
-    if (end >= start)
-    {
-        // Positions: 0...start...curPos...end...(N-1)
-        if ((curPos <= end) && (curPos >= start))
-        {
-            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "bufLocked start %d end %d curPos %d", start, end, curPos);
-            m_sensorConnList[connIndex].bufferHandles.curPosLocked += 1;
-            result =  TRUE;
-        }
-    }
-    // If the start and end positions warp around the ring buffer
-    else
-    {
-        // Positions: 0...curPos..end ...start....(N - 1)
-        // Positions: 0...end.....start..curPos...(N - 1)
-        if ((curPos <= end) || (curPos >= start))
-        {
-            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "bufLocked start %d end %d curPos %d", start, end, curPos);
-            m_sensorConnList[connIndex].bufferHandles.curPosLocked += 1;
-            result = TRUE;
-        }
-    }
-
-    return result;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSIntfQSEE::ClearBufferLock
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-CamxResult NCSIntfQSEE::ClearBufferLock(
-    INT connIndex)
-{
-    CamxResult result = CamxResultSuccess;
-
-    if (0 != m_sensorConnList[connIndex].bufferHandles.curPosLocked)
-    {
-        m_sensorConnList[connIndex].bufferHandles.curPosLocked -= 1;
-    }
-
-    return result;
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// NCSIntfQSEE::RateMatch
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -874,11 +833,9 @@ CamxResult NCSIntfQSEE::CreateQSEEConnHandle(
         if (NULL != m_sensorConnList[connIndex].bufferHandles.phBufferHandle)
         {
             m_sensorConnList[connIndex].bufferHandles.bufferSize      = bufferSize;
-            m_sensorConnList[connIndex].bufferHandles.currentPos      = 0;
+            m_sensorConnList[connIndex].bufferHandles.writeSeq        = 0;
             m_sensorConnList[connIndex].bufferHandles.bufferStride    = bufferStride;
             m_sensorConnList[connIndex].bufferHandles.totalSamples    = bufferSize/bufferStride;
-            m_sensorConnList[connIndex].bufferHandles.curPosLocked    = 0;
-            m_sensorConnList[connIndex].bufferHandles.isBufferWrapped = FALSE;
         }
         else
         {
@@ -1068,6 +1025,32 @@ CamxResult NCSIntfQSEE::GetDataAsync(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSIntfQSEE::DeliverData
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult NCSIntfQSEE::DeliverData(
+    INT    connIndex,
+    UINT64 timestamp)
+{
+    CamxResult result = CamxResultSuccess;
+    QSEEJob    qseeJob;
+
+    CAMX_ASSERT((connIndex >= 0) && (connIndex < static_cast<INT>(NCSMaxSupportedConns)));
+
+    qseeJob.connIndex    = connIndex;
+    qseeJob.resultStatus = CamxResultSuccess;
+    qseeJob.timestamp    = timestamp;
+
+    m_pQSEEIntfMutex->Lock();
+    if ((m_intfState == NCSIntfRunning) && (QSEEConnRunning == m_sensorConnList[connIndex].connectionState))
+    {
+        result = TriggerClientFence(&qseeJob);
+    }
+    m_pQSEEIntfMutex->Unlock();
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// NCSIntfQSEE::TriggerClientFence
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1186,112 +1169,136 @@ CamxResult NCSIntfQSEE::GetSampleTimestamp(
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSIntfQSEE::GetDataSync
+/// NCSIntfQSEE::FindSampleWindow
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-NCSSensorDataHandle NCSIntfQSEE::GetDataSync(
-    UINT64 tStart,
-    UINT64 tEnd,
-    INT    connIndex)
+CamxResult NCSIntfQSEE::FindSampleWindow(
+    INT     connIndex,
+    UINT64  tStart,
+    UINT64  tEnd,
+    UINT64* pFirstSeq,
+    UINT64* pLastSeq)
 {
-    INT                currentPos            = 0;
-    INT                prevLocation          = 0;
-    INT                endLocation           = 0;
-    INT                startLocation         = 0;
-    UINT               bufferSize            = 0;
-    UINT               bufferStride          = 0;
-    UINT8*             phSensorBufferHandle  = NULL;
-    NCSSensorData*     phNCSDataHandle       = NULL;
-    CamxResult         result                = CamxResultSuccess;
-    INT                bufferQLength         = 0;
-    UINT64             tCurrent              = 0;
-    UINT64             tDiff                 = 0;
-    INT                startOffset           = 0;
-    INT                loop;
+    CamxResult  result        = CamxResultSuccess;
+    RingBuffer* pBuffer       = &m_sensorConnList[connIndex].bufferHandles;
+    UINT64      totalSamples  = pBuffer->totalSamples;
+    UINT64      writeSeq      = CamxAtomicLoadU64(&pBuffer->writeSeq);
+    UINT64      oldestSeq     = 0;
+    UINT64      tCurrent      = 0;
+    UINT64      low           = 0;
+    UINT64      high          = 0;
+
+    // Pairs with the fence of the producer, samples below writeSeq are read only after it
+    CamxFence();
+
+    if (writeSeq > (totalSamples - QSEERingGuardSamples))
+    {
+        oldestSeq = writeSeq - (totalSamples - QSEERingGuardSamples);
+    }
 
-    CAMX_ASSERT((tStart <= tEnd) && (connIndex >= 0) && (connIndex < static_cast<INT>(NCSMaxSupportedConns)));
+    // Samples are published in timestamp order, so [oldestSeq, writeSeq) is sorted. Find the first sample after tEnd.
+    low  = oldestSeq;
+    high = writeSeq;
+    while (low < high)
+    {
+        UINT64 mid = low + ((high - low) / 2);
+        GetSampleTimestamp(connIndex, static_cast<INT>(mid % totalSamples), &tCurrent);
+        if (tCurrent <= tEnd)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
 
-    m_pQSEEIntfMutex->Lock();
-    if (m_intfState == NCSIntfRunning)
+    if (low == oldestSeq)
     {
-        // Intialize buffer parameters
-        bufferSize           = static_cast<UINT>(m_sensorConnList[connIndex].bufferHandles.bufferSize);
-        bufferStride         = m_sensorConnList[connIndex].bufferHandles.bufferStride;
-        currentPos           = m_sensorConnList[connIndex].bufferHandles.currentPos;
-        bufferQLength        = static_cast<INT>(m_sensorConnList[connIndex].bufferHandles.totalSamples);
-        phSensorBufferHandle = static_cast<UINT8*>(m_sensorConnList[connIndex].bufferHandles.phBufferHandle);
+        CAMX_LOG_ERROR(CamxLogGroupNCS, "No sample matches required timestamp %llu!", tEnd);
+        result = CamxResultENoMore;
+    }
+    else
+    {
+        *pLastSeq = (low < writeSeq) ? low : (writeSeq - 1);
 
-        // Fetch a accessor object from the pool
-        phNCSDataHandle = static_cast<NCSSensorData*>(GetAccessorObject());
-        if ((NULL != phNCSDataHandle) &&
-            (QSEEConnRunning == m_sensorConnList[connIndex].connectionState))
+        // Then the last sample before tStart
+        low  = oldestSeq;
+        high = *pLastSeq;
+        while (low < high)
         {
-            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Current Queue size %d pNCSDataHandle %p",
-                           m_sensorDataObjectList.NumNodes(), phNCSDataHandle);
-
-            if (CamxResultSuccess == result)
+            UINT64 mid = low + ((high - low) / 2);
+            GetSampleTimestamp(connIndex, static_cast<INT>(mid % totalSamples), &tCurrent);
+            if (tCurrent < tStart)
             {
-                prevLocation = currentPos;
-                for (loop = 0; loop < bufferQLength; loop++)
-                {
-                    prevLocation--;
-                    if (prevLocation < 0)
-                    {
-                        prevLocation = bufferQLength -1;
-                    }
-                    result = GetSampleTimestamp(connIndex, prevLocation, &tCurrent);
-                    if (tCurrent > tEnd)
-                    {
-                        continue;
-                    }
-                    endLocation = prevLocation + 1;
-                    break;
-                }
-
-                if ( loop < bufferQLength)
-                {
-                    tDiff         = tEnd - tStart;
-                    startOffset     = static_cast<UINT>(tDiff / m_sensorConnList[connIndex].bufferHandles.tickPeriod);
-                    startOffset++;
-                    startLocation = ((endLocation - startOffset) + bufferQLength) % bufferQLength;
-                }
-                else
-                {
-                    CAMX_LOG_ERROR(CamxLogGroupNCS, "No sample matches required timestamp %llu!", tEnd);
-                    result = CamxResultENoMore;
-                }
+                low = mid + 1;
             }
-
-            if (CamxResultSuccess == result)
+            else
             {
-                result = phNCSDataHandle->SetDataLimits(startLocation, endLocation,
-                                                        reinterpret_cast<VOID*>
-                                                        (m_sensorConnList[connIndex].bufferHandles.phBufferHandle),
-                                                        bufferQLength);
-                if (CamxResultSuccess == result)
-                {
-                    phNCSDataHandle->SetBufferStride(
-                        m_sensorConnList[connIndex].bufferHandles.bufferStride);
-                    SetBufferLock(
-                        m_sensorConnList[connIndex].sensorType, startLocation, endLocation);
-                    CAMX_LOG_VERBOSE(CamxLogGroupNCS,
-                        "Sensor %d: bufferQlength %d, tStart %llu, tEnd %llu, startLocation %d, endLocation %d",
-                        m_sensorConnList[connIndex].sensorType,
-                        bufferQLength, tStart, tEnd, startLocation, endLocation);
-                }
-                else
-                {
-                    CAMX_LOG_ERROR(CamxLogGroupNCS, "Unable to set data limits");
-                }
+                high = mid;
             }
         }
+        *pFirstSeq = (low > oldestSeq) ? (low - 1) : oldestSeq;
+    }
 
-        if (CamxResultSuccess != result)
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSIntfQSEE::SetupAccessor
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+NCSSensorData* NCSIntfQSEE::SetupAccessor(
+    INT    connIndex,
+    UINT64 firstSeq,
+    UINT64 lastSeq)
+{
+    RingBuffer*    pBuffer         = &m_sensorConnList[connIndex].bufferHandles;
+    INT            bufferQLength   = static_cast<INT>(pBuffer->totalSamples);
+    NCSSensorData* phNCSDataHandle = static_cast<NCSSensorData*>(GetAccessorObject());
+
+    if (NULL != phNCSDataHandle)
+    {
+        phNCSDataHandle->SetDataLimits(static_cast<INT>(firstSeq % bufferQLength),
+                                       static_cast<INT>(lastSeq % bufferQLength),
+                                       pBuffer->phBufferHandle,
+                                       bufferQLength);
+        phNCSDataHandle->SetBufferStride(pBuffer->bufferStride);
+        phNCSDataHandle->SetSequence(firstSeq, &pBuffer->writeSeq);
+    }
+    else
+    {
+        CAMX_LOG_ERROR(CamxLogGroupNCS, "No more free data objects");
+    }
+
+    return phNCSDataHandle;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSIntfQSEE::GetDataSync
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+NCSSensorDataHandle NCSIntfQSEE::GetDataSync(
+    UINT64 tStart,
+    UINT64 tEnd,
+    INT    connIndex)
+{
+    NCSSensorData*     phNCSDataHandle       = NULL;
+    CamxResult         result                = CamxResultSuccess;
+    UINT64             firstSeq              = 0;
+    UINT64             lastSeq               = 0;
+
+    CAMX_ASSERT((tStart <= tEnd) && (connIndex >= 0) && (connIndex < static_cast<INT>(NCSMaxSupportedConns)));
+
+    // No interface lock here: the window is located against a snapshot of the producer sequence, and the sensor
+    // callback keeps filling the ring buffer concurrently.
+    if ((m_intfState == NCSIntfRunning) &&
+        (QSEEConnRunning == m_sensorConnList[connIndex].connectionState))
+    {
+        result = FindSampleWindow(connIndex, tStart, tEnd, &firstSeq, &lastSeq);
+        if (CamxResultSuccess == result)
         {
-            if (CamxResultSuccess !=  PutAccessorObject(phNCSDataHandle))
-            {
-                CAMX_LOG_ERROR(CamxLogGroupNCS, "Memory Leak, can not put back sesnor data object");
-            }
-            phNCSDataHandle = NULL;
+            phNCSDataHandle = SetupAccessor(connIndex, firstSeq, lastSeq);
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS,
+                             "Sensor %d: tStart %llu, tEnd %llu, firstSeq %llu, lastSeq %llu",
+                             m_sensorConnList[connIndex].sensorType, tStart, tEnd, firstSeq, lastSeq);
         }
     }
 
@@ -1299,7 +1306,6 @@ NCSSensorDataHandle NCSIntfQSEE::GetDataSync(
     {
         CAMX_LOG_ERROR(CamxLogGroupNCS, "Can not get sensor data for sensor %d!", connIndex);
     }
-    m_pQSEEIntfMutex->Unlock();
 
     return phNCSDataHandle;
 }
@@ -1311,117 +1317,44 @@ NCSSensorDataHandle NCSIntfQSEE::GetLastNSamples(
     UINT  numOfSamples,
     INT   connIndex)
 {
-    INT                currentPos           = 0;
-    INT                startLocation        = 0;
-    INT                endLocation          = 0;
-    UINT               bufferSize           = 0;
-    UINT               bufferStride         = 0;
-    UINT8*             phSensorBufferHandle = NULL;
     NCSSensorData*     phNCSDataHandle      = NULL;
-    CamxResult         result               = CamxResultEFailed;
-    INT                bufferQLength        = 0;
+    UINT64             writeSeq             = 0;
 
-    m_pQSEEIntfMutex->Lock();
     if (m_intfState == NCSIntfRunning)
     {
         CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Enter......");
 
-        phSensorBufferHandle = static_cast<UINT8*>(m_sensorConnList[connIndex].bufferHandles.phBufferHandle);
-        bufferSize           = static_cast<UINT>(m_sensorConnList[connIndex].bufferHandles.bufferSize);
-        bufferStride         = m_sensorConnList[connIndex].bufferHandles.bufferStride;
-        currentPos           = m_sensorConnList[connIndex].bufferHandles.currentPos;
-        bufferQLength        = static_cast<INT>(m_sensorConnList[connIndex].bufferHandles.totalSamples);
-
-        CAMX_ASSERT_MESSAGE((NULL != phSensorBufferHandle) && (0 != bufferSize) && (0 != bufferStride),
+        CAMX_ASSERT_MESSAGE((NULL != m_sensorConnList[connIndex].bufferHandles.phBufferHandle) &&
+                            (0 != m_sensorConnList[connIndex].bufferHandles.bufferSize) &&
+                            (0 != m_sensorConnList[connIndex].bufferHandles.bufferStride),
                             "Unable to save data, invalid state !!");
 
-        phNCSDataHandle = static_cast<NCSSensorData*>(GetAccessorObject());
-        if ((NULL != phNCSDataHandle) &&
-            (QSEEConnRunning == m_sensorConnList[connIndex].connectionState))
+        if (QSEEConnRunning == m_sensorConnList[connIndex].connectionState)
         {
-            if (TRUE == m_sensorConnList[connIndex].bufferHandles.isBufferWrapped)
+            writeSeq = CamxAtomicLoadU64(&m_sensorConnList[connIndex].bufferHandles.writeSeq);
+            CamxFence();
+
+            if ((0 < numOfSamples) &&
+                (numOfSamples <= writeSeq) &&
+                (numOfSamples <= (m_sensorConnList[connIndex].bufferHandles.totalSamples - QSEERingGuardSamples)))
             {
-                if (numOfSamples <= static_cast<UINT>(currentPos))
-                {
-                    endLocation   = currentPos - 1;
-                    startLocation = currentPos - numOfSamples;
-                }
-                else
-                {
-                    startLocation = bufferQLength - (numOfSamples - currentPos);
-                    if (currentPos == 0)
-                    {
-                        endLocation = bufferQLength - 1;
-                    }
-                    else
-                    {
-                        endLocation = currentPos - 1;
-                    }
-                }
-                result = CamxResultSuccess;
+                phNCSDataHandle = SetupAccessor(connIndex, writeSeq - numOfSamples, writeSeq - 1);
+                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Sensor %d: writeSeq %llu numOfSamples %d, accessor %p",
+                                 m_sensorConnList[connIndex].sensorType, writeSeq, numOfSamples, phNCSDataHandle);
             }
             else
             {
-                if (numOfSamples <= static_cast<UINT>(currentPos))
-                {
-                    endLocation   = currentPos - 1;
-                    startLocation = currentPos - numOfSamples;
-                    result        = CamxResultSuccess;
-                }
-                else
-                {
-                    result = CamxResultENoSuch;
-                    CAMX_LOG_VERBOSE(CamxLogGroupNCS, "sensor %d: Not enough sample data: numOfSamples %d, currentPos %d",
-                        connIndex, numOfSamples, currentPos);
-                }
-            }
-
-            if (CamxResultSuccess == result)
-            {
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Sensor %d: startLocation %d, endLocation %d numOfSamples %d",
-                    m_sensorConnList[connIndex].sensorType, startLocation, endLocation, numOfSamples)
-                result  = phNCSDataHandle->SetDataLimits(startLocation,
-                                                         endLocation,
-                                                         reinterpret_cast<VOID*>(
-                                                            m_sensorConnList[connIndex].bufferHandles.phBufferHandle),
-                                                         bufferQLength);
-                if (CamxResultSuccess == result)
-                {
-                    CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Return access object %p", phNCSDataHandle);
-                    phNCSDataHandle->SetBufferStride(m_sensorConnList[connIndex].bufferHandles.bufferStride);
-                    // todo (CAMX-2393) readlock/write lock instead of counter to lock the access.
-                    // Set the lock flag in case the current cursor position where data would be queued is in the acessed range
-                    if (TRUE == SetBufferLock(m_sensorConnList[connIndex].sensorType, startLocation, endLocation))
-                    {
-                        phNCSDataHandle->SetHaveBufLocked();
-                    }
-                }
-                else
-                {
-                    CAMX_LOG_ERROR(CamxLogGroupNCS, "Unable to set data limits");
-                }
+                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "sensor %d: Not enough sample data: numOfSamples %d, writeSeq %llu",
+                                 connIndex, numOfSamples, writeSeq);
             }
         }
         else
         {
-            CAMX_LOG_ERROR(CamxLogGroupNCS, "No more free data objects or connection in invalid state %d",
+            CAMX_LOG_ERROR(CamxLogGroupNCS, "Connection in invalid state %d",
                            m_sensorConnList[connIndex].connectionState);
-            result = CamxResultEFailed;
-        }
-
-        if (CamxResultSuccess != result && NULL != phNCSDataHandle)
-        {
-            result = PutAccessorObject(phNCSDataHandle);
-            if (CamxResultSuccess != result)
-            {
-                CAMX_LOG_ERROR(CamxLogGroupNCS, "Fatal: Unable to push back the accessor !!");
-            }
-            phNCSDataHandle =  NULL;
         }
     }
 
-    m_pQSEEIntfMutex->Unlock();
-
     return phNCSDataHandle;
 }
 
@@ -1582,13 +1515,17 @@ CamxResult NCSIntfQSEE::ReconfigSession(
                 SendDisableRequest(connIndex);
                 m_sensorConnList[connIndex].connectionState = QSEEConnStopped;
 
-                // Reset state variables of the ring buffer
-                pBuffer->curPosLocked    = 0;
-                pBuffer->currentPos      = 0;
-                pBuffer->isBufferWrapped = FALSE;
+                // Reset ring buffer data to '0'. Readers are lock-free, so quiesce them first: advancing writeSeq by a full
+                // lap makes every accessor still held by a client fail IsValid(). Advance it again once cleared, so an
+                // accessor set up while the Memset was in flight is invalidated as well. Zeroed timestamps then fall
+                // outside every requested window.
+                UINT64 writeSeq = CamxAtomicLoadU64(&pBuffer->writeSeq);
 
-                // Reset ring buffer data to '0'
+                CamxAtomicStoreU64(&pBuffer->writeSeq, writeSeq + pBuffer->totalSamples);
+                CamxFence();
                 Utils::Memset(pBuffer->phBufferHandle, 0, pBuffer->bufferSize);
+                CamxFence();
+                CamxAtomicStoreU64(&pBuffer->writeSeq, writeSeq + (2 * static_cast<UINT64>(pBuffer->totalSamples)));
 
                 // Send reconfig request
                 SendConfigRequest(connIndex, pConfig);
@@ -1964,6 +1901,7 @@ CamxResult NCSIntfQSEE::FillSensorData(
     NCSDataAccel*        pAccelData     = NULL;
     NCSDataGravity*      pGravityData   = NULL;
     INT                  currentPos     = -1;
+    UINT64               writeSeq       = 0;
     UINT                 bufferSize     = 0;
     UINT                 bufferStride   = 0;
     NCSSensorType        sensorType     = NCSMaxType;
@@ -1992,120 +1930,105 @@ CamxResult NCSIntfQSEE::FillSensorData(
     phBufferHandle = m_sensorConnList[connIndex].bufferHandles.phBufferHandle;
     bufferSize     = static_cast<UINT>(m_sensorConnList[connIndex].bufferHandles.bufferSize);
     bufferStride   = m_sensorConnList[connIndex].bufferHandles.bufferStride;
-    currentPos     = m_sensorConnList[connIndex].bufferHandles.currentPos;
+    writeSeq       = m_sensorConnList[connIndex].bufferHandles.writeSeq;
     bufferSamples  = m_sensorConnList[connIndex].bufferHandles.totalSamples;
+    currentPos     = static_cast<INT>(writeSeq % bufferSamples);
 
     CAMX_ASSERT((NULL != phBufferHandle) && (0 != bufferSize) && (0 != bufferStride));
 
-    if (m_sensorConnList[connIndex].bufferHandles.curPosLocked <= 0)
+    sensorType = m_sensorConnList[connIndex].sensorType;
+    switch (sensorType)
     {
-        sensorType = m_sensorConnList[connIndex].sensorType;
-        switch (sensorType)
+        case NCSGyroType:
         {
-            case NCSGyroType:
+            pGyroData =
+                reinterpret_cast<NCSDataGyro*>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS,
+                             "GYRO: Current Pos %d base addr %p computed addr %p, stride %d",
+                             currentPos,
+                             phBufferHandle,
+                             pGyroData,
+                             bufferStride);
+            if (TRUE == m_sensorConnList[connIndex].bufferHandles.calibData.isValid)
             {
-                pGyroData =
-                    reinterpret_cast<NCSDataGyro*>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS,
-                                 "GYRO: Current Pos %d base addr %p computed addr %p, stride %d",
-                                 currentPos,
-                                 phBufferHandle,
-                                 pGyroData,
-                                 bufferStride);
-                if (TRUE == m_sensorConnList[connIndex].bufferHandles.calibData.isValid)
-                {
-                    calibData = m_sensorConnList[connIndex].bufferHandles.calibData;
-                }
-                pGyroData->x         = event.data(0) - calibData.bias[0];
-                pGyroData->y         = event.data(1) - calibData.bias[1];
-                pGyroData->z         = event.data(2) - calibData.bias[2];
-                pGyroData->timestamp = pb_event.timestamp();
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "POS %d: Received Gyro sample <%f, %f, %f> time %llu bias < %f %f %f>",
-                            currentPos,
-                            pGyroData->x, pGyroData->y, pGyroData->z, pGyroData->timestamp,
-                            calibData.bias[0],
-                            calibData.bias[1],
-                            calibData.bias[2]);
-
-                if (NULL != m_sensorConnList[connIndex].bufferHandles.pFileBuffer)
-                {
-                    OsUtils::FPrintF(m_sensorConnList[connIndex].bufferHandles.pFileBuffer,
-                                     "x %f y %f z %f ts %llu\n",
-                                     pGyroData->x, pGyroData->y, pGyroData->z, pGyroData->timestamp);
-                }
-                break;
+                calibData = m_sensorConnList[connIndex].bufferHandles.calibData;
             }
-            case NCSAccelerometerType:
-            {
-                pAccelData =
-                    reinterpret_cast<NCSDataAccel *>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "ACCEL: Current Pos %d base addr %p computed addr %p bufferStride %d",
-                                 currentPos, phBufferHandle, pAccelData, bufferStride);
-                pAccelData->x         = event.data(0);
-                pAccelData->y         = event.data(1);
-                pAccelData->z         = event.data(2);
-                pAccelData->timestamp = pb_event.timestamp();
-
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Received Accel sample <%f, %f, %f> time %llu, bias <%f %f %f>",
-                                 event.data(0), event.data(1), event.data(2), pAccelData->timestamp,
-                                 calibData.bias[0],
-                                 calibData.bias[1],
-                                 calibData.bias[2]);
-                break;
-            }
-            case NCSGravityType:
+            pGyroData->x         = event.data(0) - calibData.bias[0];
+            pGyroData->y         = event.data(1) - calibData.bias[1];
+            pGyroData->z         = event.data(2) - calibData.bias[2];
+            pGyroData->timestamp = pb_event.timestamp();
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "POS %d: Received Gyro sample <%f, %f, %f> time %llu bias < %f %f %f>",
+                        currentPos,
+                        pGyroData->x, pGyroData->y, pGyroData->z, pGyroData->timestamp,
+                        calibData.bias[0],
+                        calibData.bias[1],
+                        calibData.bias[2]);
+
+            if (NULL != m_sensorConnList[connIndex].bufferHandles.pFileBuffer)
             {
-                pGravityData =
-                    reinterpret_cast<NCSDataGravity *>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "GRAVITY: Current Pos %d base addr %p computed addr %p bufferStride %d",
-                    currentPos, phBufferHandle, pGravityData, bufferStride);
-                pGravityData->x = event.data(0);
-                pGravityData->y = event.data(1);
-                pGravityData->z = event.data(2);
-                pGravityData->lx = event.data(3);
-                pGravityData->ly = event.data(4);
-                pGravityData->lz = event.data(5);
-                pGravityData->timestamp = pb_event.timestamp();
-
-                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Received GRAVITY sample <%f, %f, %f> time %llu, bias <%f %f %f>",
-                    pGravityData->x, pGravityData->y, pGravityData->z, pGravityData->timestamp,
-                    calibData.bias[0],
-                    calibData.bias[1],
-                    calibData.bias[2]);
-                break;
-            }
-            default:
-            {
-                CAMX_LOG_ERROR(CamxLogGroupNCS, "Unsupported sensor event, tossing away the data");
-                result = CamxResultEUnsupported;
-                break;
+                OsUtils::FPrintF(m_sensorConnList[connIndex].bufferHandles.pFileBuffer,
+                                 "x %f y %f z %f ts %llu\n",
+                                 pGyroData->x, pGyroData->y, pGyroData->z, pGyroData->timestamp);
             }
+            break;
         }
-
-        if (CamxResultSuccess == result)
+        case NCSAccelerometerType:
         {
-            currentPos++;
-            if (static_cast<UINT>(currentPos) >= bufferSamples)
-            {
-                currentPos %= bufferSamples;
-                m_sensorConnList[connIndex].bufferHandles.isBufferWrapped = TRUE;
-            }
-            m_sensorConnList[connIndex].bufferHandles.currentPos = currentPos;
-
-            // trigger fence
-            QSEEJob newQSEEJob;
-            newQSEEJob.connIndex = connIndex;
-            newQSEEJob.resultStatus = result;
-            newQSEEJob.timestamp = pb_event.timestamp();
-            TriggerClientFence(&newQSEEJob);
-      }
+            pAccelData =
+                reinterpret_cast<NCSDataAccel *>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "ACCEL: Current Pos %d base addr %p computed addr %p bufferStride %d",
+                             currentPos, phBufferHandle, pAccelData, bufferStride);
+            pAccelData->x         = event.data(0);
+            pAccelData->y         = event.data(1);
+            pAccelData->z         = event.data(2);
+            pAccelData->timestamp = pb_event.timestamp();
+
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Received Accel sample <%f, %f, %f> time %llu, bias <%f %f %f>",
+                             event.data(0), event.data(1), event.data(2), pAccelData->timestamp,
+                             calibData.bias[0],
+                             calibData.bias[1],
+                             calibData.bias[2]);
+            break;
+        }
+        case NCSGravityType:
+        {
+            pGravityData =
+                reinterpret_cast<NCSDataGravity *>(reinterpret_cast<CHAR *>(phBufferHandle) + bufferStride*currentPos);
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "GRAVITY: Current Pos %d base addr %p computed addr %p bufferStride %d",
+                currentPos, phBufferHandle, pGravityData, bufferStride);
+            pGravityData->x = event.data(0);
+            pGravityData->y = event.data(1);
+            pGravityData->z = event.data(2);
+            pGravityData->lx = event.data(3);
+            pGravityData->ly = event.data(4);
+            pGravityData->lz = event.data(5);
+            pGravityData->timestamp = pb_event.timestamp();
+
+            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Received GRAVITY sample <%f, %f, %f> time %llu, bias <%f %f %f>",
+                pGravityData->x, pGravityData->y, pGravityData->z, pGravityData->timestamp,
+                calibData.bias[0],
+                calibData.bias[1],
+                calibData.bias[2]);
+            break;
+        }
+        default:
+        {
+            CAMX_LOG_ERROR(CamxLogGroupNCS, "Unsupported sensor event, tossing away the data");
+            result = CamxResultEUnsupported;
+            break;
+        }
     }
-    else
+
+    if (CamxResultSuccess == result)
     {
-        CAMX_LOG_WARN(CamxLogGroupNCS, "Current position is locked for access by clients, dropping this data");
-        result = CamxResultEReadOnly;
+        // Publish the sample only after it is fully written; readers never look past writeSeq. The atomic store is only an
+        // acquire barrier, so fence the sample stores ahead of it.
+        CamxFence();
+        CamxAtomicStoreU64(&m_sensorConnList[connIndex].bufferHandles.writeSeq, writeSeq + 1);
+
+        // Fences are signalled from the NCS poll thread, so a burst of samples costs one delivery
+        m_pServiceObject->NotifyDataReady(connIndex, pb_event.timestamp());
     }
-    m_pServiceObject->EnqueueJob(NULL);
 
     return result;
 }
@@ -2321,29 +2244,16 @@ CamxResult NCSIntfQSEE::EnqueueAccessor(
     NCSSensorDataHandle hAccesorObj)
 {
     CamxResult     result = CamxResultSuccess;
-    NCSSensorType  sensorType;
-    NCSSensorData* pNCSDataObject;
-    NCSSensor*     pNCSSensorObj;
-
-    m_pQSEEIntfMutex->Lock();
 
-    // Unlock the buffer current position if it has locked it.
-    pNCSSensorObj = static_cast<NCSSensor*>(hSensorObj);
-    sensorType = pNCSSensorObj->GetSensorType();
-    ClearBufferLock(sensorType);
-
-    // Clear the flag that this acessor has lockd the buffer
-    pNCSDataObject = static_cast<NCSSensorData*>(hAccesorObj);
-    pNCSDataObject->ClearHaveBufLocked();
+    CAMX_UNREFERENCED_PARAM(hSensorObj);
 
+    // Accessors hold no lock on the ring buffer, returning one only recycles it to the pool
     result = PutAccessorObject(hAccesorObj);
     if (CamxResultSuccess != result)
     {
         CAMX_LOG_ERROR(CamxLogGroupNCS, "AccessorObject is NULL");
     }
 
-    m_pQSEEIntfMutex->Unlock();
-
     return result;
 }
 
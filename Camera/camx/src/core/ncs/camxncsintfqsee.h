@@ -31,6 +31,8 @@ static const UINT QSEEAsyncQSize        = 30;       ///< Async request Q size
 static const UINT QSEEAccessorPoolLen   = 10;       ///< Async request Q size
 static const UINT QSEEBiasCompN         = 3;        ///< N - degrees of freedom for the bias comp vector.
 static const UINT QSEECallbacksTimeout  = 500;      ///< QSEE connection timeout period in ms
+static const UINT QSEERingGuardSamples  = 8;        ///< Oldest ring buffer samples withheld from readers, so the producer
+                                                    ///  can keep writing without tearing a window handed out to a client
 
 class NCSService;
 
@@ -42,17 +44,17 @@ struct NCSCalib
 
 struct RingBuffer
 {
-    VOID*     phBufferHandle;  ///< Ring buffer pointer
-    SIZE_T    bufferSize;      ///< Size in bytes of the total ring buffer
-    INT       currentPos;      ///< Current position where the new data would be copied
-    UINT      bufferStride;    ///< Stride in bytes (size of each sample)
-    UINT      totalSamples;    ///< total number of samples
-    INT       curPosLocked;    ///< Counting lock to indicate this region is locked
-    BOOL      isBufferWrapped; ///< Indicates if the buffer have been wrapped around
-    INT       tickPeriod;      ///< QTimer tick period for 19.2MHz frequency and a given sensor
-                               ///  sample rate.
-    FILE*     pFileBuffer;     ///< File buffer for debugging;
-    NCSCalib  calibData;       ///< Calibration data,less frequently updated/static
+    VOID*           phBufferHandle;  ///< Ring buffer pointer
+    SIZE_T          bufferSize;      ///< Size in bytes of the total ring buffer
+    volatile UINT64 writeSeq;        ///< Number of samples published so far, never reset while the buffer lives. The next
+                                     ///  sample goes to slot (writeSeq % totalSamples); readers load it atomically
+                                     ///  instead of locking the buffer.
+    UINT            bufferStride;    ///< Stride in bytes (size of each sample)
+    UINT            totalSamples;    ///< total number of samples
+    INT             tickPeriod;      ///< QTimer tick period for 19.2MHz frequency and a given sensor
+                                     ///  sample rate.
+    FILE*           pFileBuffer;     ///< File buffer for debugging;
+    NCSCalib        calibData;       ///< Calibration data,less frequently updated/static
 };
 
 struct NCSAsyncRequest
@@ -268,6 +270,20 @@ public:
     NCSIntfState UpdateIntfState(
         VOID* pPayload);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DeliverData
+    ///
+    /// @brief  Signal the async requests of a connection satisfied by the samples published so far
+    ///
+    /// @param  connIndex  Connection index
+    /// @param  timestamp  Timestamp of the latest published sample
+    ///
+    /// @return CamxResultSuccess on success
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult DeliverData(
+        INT    connIndex,
+        UINT64 timestamp);
+
 
 private:
 
@@ -320,32 +336,41 @@ private:
         BOOL             recreateSSCConn);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// SetBufferLock
+    /// FindSampleWindow
     ///
-    /// @brief  Lock the ring buffer and keep from writing into it
+    /// @brief  Binary search the published samples of a ring buffer for the window covering [tStart, tEnd]. The window is
+    ///         widened by one sample on each side when available so clients can interpolate at the boundaries.
     ///
     /// @param  connIndex  Connection index
-    /// @param  start      Start point of lock
-    /// @param  end        End point of lock
+    /// @param  tStart     Start timestamp of the window
+    /// @param  tEnd       End timestamp of the window
+    /// @param  pFirstSeq  Returned sequence number of the first sample of the window
+    /// @param  pLastSeq   Returned sequence number of the last sample of the window
     ///
-    /// @return state of the lock set
+    /// @return CamxResultSuccess if a window was found, CamxResultENoMore if no sample is old enough
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    BOOL SetBufferLock(
-        INT connIndex,
-        INT start,
-        INT end);
+    CamxResult FindSampleWindow(
+        INT     connIndex,
+        UINT64  tStart,
+        UINT64  tEnd,
+        UINT64* pFirstSeq,
+        UINT64* pLastSeq);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// ClearBufferLock
+    /// SetupAccessor
     ///
-    /// @brief  Clear the buffer lock
+    /// @brief  Bind a pooled accessor object to a run of published ring buffer samples
     ///
-    /// @param  connIndex connection index
+    /// @param  connIndex  Connection index
+    /// @param  firstSeq   Sequence number of the first sample
+    /// @param  lastSeq    Sequence number of the last sample
     ///
-    /// @return CamxResultSuccess on successful clearing of the lock
+    /// @return Accessor object, NULL if the pool is exhausted
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    CamxResult ClearBufferLock(
-        INT connIndex);
+    NCSSensorData* SetupAccessor(
+        INT    connIndex,
+        UINT64 firstSeq,
+        UINT64 lastSeq);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// Release
@@ -717,7 +742,9 @@ private:
     {
         NCSSensorDataHandle hSensorData = NULL;
 
+        m_pAccessorPoolMutex->Lock();
         LDLLNode* pNode = m_sensorDataObjectList.RemoveFromHead();
+        m_pAccessorPoolMutex->Unlock();
         if (NULL != pNode)
         {
             hSensorData = static_cast<NCSSensorData*>(pNode->pData);
@@ -748,7 +775,9 @@ private:
             if (NULL != pNode)
             {
                 pNode->pData = static_cast<VOID*>(hSensorData);
+                m_pAccessorPoolMutex->Lock();
                 m_sensorDataObjectList.InsertToHead(pNode);
+                m_pAccessorPoolMutex->Unlock();
             }
             else
             {
@@ -787,6 +816,8 @@ private:
 
     NCSIntfState                 m_intfState;                                 ///< NCS Interface status
     Mutex*                       m_pQSEEIntfMutex;                            ///< Mutex for QSEE interface APIs
+    Mutex*                       m_pAccessorPoolMutex;                        ///< Mutex for the accessor object pool only, so
+                                                                              ///  data reads never wait on sensor callbacks
     Condition*                   m_pQSEELinkUpdateCond;                       ///< QSEE link updation cond variable
 
     ChiContext*                  m_pChiContext;                               ///< Pointer to the chi context
@@ -106,6 +106,8 @@ CamxResult NCSSensorData::SetDataLimits(
     m_endIndexOrig    = end;
     m_currentIndex    = 0;
     m_totalNumSamples = bufferQLength;
+    m_firstSeq        = 0;
+    m_pWriteSeq       = NULL;
     if (m_startIndexOrig <= m_endIndexOrig)
     {
         m_numSamples = (m_endIndexOrig - m_startIndexOrig + 1);
@@ -120,29 +122,48 @@ CamxResult NCSSensorData::SetDataLimits(
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSSensorData::SetHaveBufLocked
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-VOID NCSSensorData::SetHaveBufLocked()
+/// NCSSensorData::SetBufferStride
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID NCSSensorData::SetBufferStride(
+    UINT bufferStride)
 {
-    m_haveLockedBuffer = TRUE;
+    m_bufferStride = bufferStride;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSSensorData::SetBufferStride
+/// NCSSensorData::SetSequence
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-VOID NCSSensorData::SetBufferStride(
-    UINT bufferStride)
+VOID NCSSensorData::SetSequence(
+    UINT64           firstSeq,
+    volatile UINT64* pWriteSeq)
 {
-    m_bufferStride = bufferStride;
+    m_firstSeq  = firstSeq;
+    m_pWriteSeq = pWriteSeq;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-/// NCSSensorData::ClearHaveBufLocked
+/// NCSSensorData::IsValid
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-VOID NCSSensorData::ClearHaveBufLocked()
+BOOL NCSSensorData::IsValid()
 {
-    m_haveLockedBuffer = FALSE;
-    return;
+    BOOL isValid = TRUE;
+
+    if (NULL != m_pWriteSeq)
+    {
+        // The producer fills the slot of sequence writeSeq before publishing it, so the first sample of the window is
+        // being overwritten as soon as writeSeq reaches firstSeq + totalSamples - 1. The fence keeps the sample reads of the
+        // caller ahead of the load.
+        CamxFence();
+        UINT64 writeSeq = CamxAtomicLoadU64(m_pWriteSeq);
+
+        if ((writeSeq - m_firstSeq) >= static_cast<UINT64>(m_totalNumSamples - 1))
+        {
+            CAMX_LOG_WARN(CamxLogGroupNCS, "Window at seq %llu overrun by producer at seq %llu", m_firstSeq, writeSeq);
+            isValid = FALSE;
+        }
+    }
+
+    return isValid;
 }
 
 CAMX_NAMESPACE_END
@@ -99,15 +99,6 @@ public:
         VOID* pBaseAddress,
         INT   bufferQLength);
 
-    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// SetHaveBufLocked
-    ///
-    /// @brief  Set the have locked the buffer variable to true, done in case this acessor object has locked the buffer Q
-    ///
-    /// @return None
-    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    CAMX_VISIBILITY_PUBLIC VOID SetHaveBufLocked();
-
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// SetBufferStride
     ///
@@ -121,23 +112,38 @@ public:
         UINT stride);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    /// ClearHaveBufLocked
+    /// SetSequence
     ///
-    /// @brief  Clear the buffer lock
+    /// @brief  Bind the window to the producer sequence of the ring buffer, used to detect an overrun of the window
+    ///
+    /// @param  firstSeq   Ring buffer sequence number of the first sample in the window
+    /// @param  pWriteSeq  Pointer to the producer sequence counter of the ring buffer
     ///
     /// @return None
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    CAMX_VISIBILITY_PUBLIC VOID ClearHaveBufLocked();
+    CAMX_VISIBILITY_PUBLIC VOID SetSequence(
+        UINT64           firstSeq,
+        volatile UINT64* pWriteSeq);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsValid
+    ///
+    /// @brief  Check whether the producer has lapped the ring buffer and overwritten samples of this window
+    ///
+    /// @return TRUE if all samples of the window are still intact
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_VISIBILITY_PUBLIC BOOL IsValid();
 
 private:
-    INT   m_startIndexOrig;   ///< Index of the start point w.r.t to the original buffer.
-    INT   m_endIndexOrig;     ///< Index of the end point with repect to the original buffer.
-    UINT8* m_pBaseAddress;    ///< Base address of original sensor data buffer.
-    INT   m_numSamples;       ///< Number of samples in this data object.
-    INT   m_totalNumSamples;  ///< Total number of samples in the sensor buffer.
-    INT   m_currentIndex;     ///< Offset from start index.
-    BOOL  m_haveLockedBuffer; ///< Flag to indicate this accessor has locked buffer q for its access
-    UINT  m_bufferStride;     ///< Sensor type
+    INT              m_startIndexOrig;   ///< Index of the start point w.r.t to the original buffer.
+    INT              m_endIndexOrig;     ///< Index of the end point with repect to the original buffer.
+    UINT8*           m_pBaseAddress;     ///< Base address of original sensor data buffer.
+    INT              m_numSamples;       ///< Number of samples in this data object.
+    INT              m_totalNumSamples;  ///< Total number of samples in the sensor buffer.
+    INT              m_currentIndex;     ///< Offset from start index.
+    UINT             m_bufferStride;     ///< Sensor type
+    UINT64           m_firstSeq;         ///< Ring buffer sequence number of the first sample
+    volatile UINT64* m_pWriteSeq;        ///< Producer sequence counter of the ring buffer, NULL if not bound
 
     NCSSensorData(const NCSSensorData&) = delete;    ///< Disallow the copy constructor
     NCSSensorData& operator=(const NCSSensorData&) = delete;    ///< Disallow assignment operator
@@ -310,6 +310,11 @@ CamxResult NCSService::StartNCSService()
         {
             CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Starting the NCS Service thread");
 
+            m_hNCSPollThHandle.pNCSQMutex->Lock();
+            Utils::Memset(m_hNCSPollThHandle.pendingDelivery, 0, sizeof(m_hNCSPollThHandle.pendingDelivery));
+            Utils::Memset(m_hNCSPollThHandle.deliveryStats, 0, sizeof(m_hNCSPollThHandle.deliveryStats));
+            m_hNCSPollThHandle.pNCSQMutex->Unlock();
+
             m_hNCSPollThHandle.isRunning    = TRUE;
             m_pThreadData->pJob             = NULL;
             m_pThreadData->pThreadContext   = &m_hNCSPollThHandle;
@@ -353,6 +358,8 @@ CamxResult NCSService::StopNCSService()
         CAMX_LOG_ERROR(CamxLogGroupNCS, "Flush failed !!");
     }
 
+    DumpDeliveryStats();
+
     m_hNCSPollThHandle.isRunning = FALSE;
     result = m_hNCSPollThHandle.pThreadManager->UnregisterJobFamily(NULL,
                                                                     "NonCameraSensors",
@@ -462,6 +469,42 @@ CamxResult NCSService::EnqueueJob(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSService::NotifyDataReady
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult NCSService::NotifyDataReady(
+    INT    connIndex,
+    UINT64 timestamp)
+{
+    CamxResult result = CamxResultSuccess;
+
+    CAMX_ASSERT((connIndex >= 0) && (connIndex < static_cast<INT>(NCSMaxSupportedConns)));
+
+    m_hNCSPollThHandle.pNCSQMutex->Lock();
+    if (InvalidJobHandle != m_hNCSPollThHandle.hJobHandle && TRUE == m_hNCSPollThHandle.isRunning)
+    {
+        NCSPendingDelivery* pPending = &m_hNCSPollThHandle.pendingDelivery[connIndex];
+
+        pPending->timestamp = timestamp;
+        pPending->numIndications++;
+
+        // Only the first indication of a batch needs to wake the poll thread
+        if (FALSE == pPending->isPending)
+        {
+            pPending->isPending        = TRUE;
+            pPending->indicationTimeNs = OsUtils::GetNanoSeconds();
+            m_hNCSPollThHandle.pNCSQCondVar->Signal();
+        }
+    }
+    else
+    {
+        result = CamxResultEInvalidState;
+    }
+    m_hNCSPollThHandle.pNCSQMutex->Unlock();
+
+    return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// NCSService::~NCSService
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -532,8 +575,9 @@ NCSService::~NCSService()
 VOID* NCSService::NCSServicePollThread(
     VOID* pPayload)
 {
-    NCSThreadContext* pNCSThreadContext = NULL;
-    CamxResult        result            = CamxResultSuccess;
+    NCSThreadContext*  pNCSThreadContext = NULL;
+    CamxResult         result            = CamxResultSuccess;
+    NCSPendingDelivery deliveries[NCSMaxSupportedConns];
 
     CAMX_LOG_INFO(CamxLogGroupNCS, "Starting NCS poll thread");
 
@@ -545,15 +589,34 @@ VOID* NCSService::NCSServicePollThread(
             // Wait for data to be pushed to Q
             pNCSThreadContext->pNCSQMutex->Lock();
 
-            CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Before wait");
-            result = pNCSThreadContext->pNCSQCondVar->TimedWait(
-                pNCSThreadContext->pNCSQMutex->GetNativeHandle(), QSEECallbacksTimeout);
+            result = CamxResultSuccess;
+            if (FALSE == HasPendingWork(pNCSThreadContext))
+            {
+                CAMX_LOG_VERBOSE(CamxLogGroupNCS, "Before wait");
+                result = pNCSThreadContext->pNCSQCondVar->TimedWait(
+                    pNCSThreadContext->pNCSQMutex->GetNativeHandle(), QSEECallbacksTimeout);
+
+                // A producer may have queued work just as the wait timed out, deliver it rather than drop the snapshot
+                if ((CamxResultETimeout == result) && (TRUE == HasPendingWork(pNCSThreadContext)))
+                {
+                    result = CamxResultSuccess;
+                }
+            }
+
+            // Take the whole batch of data indications, new ones keep coalescing while this one is delivered
+            Utils::Memcpy(deliveries, pNCSThreadContext->pendingDelivery, sizeof(deliveries));
+            Utils::Memset(pNCSThreadContext->pendingDelivery, 0, sizeof(pNCSThreadContext->pendingDelivery));
+            pNCSThreadContext->pNCSQMutex->Unlock();
 
-            // Process jobs only when somone has signalled on the queue
             if (CamxResultETimeout != result)
             {
+                // Data path first, outside the queue lock so sensor callbacks are never blocked by a delivery
+                pNCSThreadContext->pServiceObject->DeliverPendingData(pNCSThreadContext, deliveries);
 
+                pNCSThreadContext->pNCSQMutex->Lock();
                 result = pNCSThreadContext->pServiceObject->ProcessPendingJobs(pNCSThreadContext);
+                pNCSThreadContext->pNCSQMutex->Unlock();
+
                 if (CamxResultSuccess != result)
                 {
                     CAMX_LOG_ERROR(CamxLogGroupNCS, "Unable to process jobs %s", Utils::CamxResultToString(result));
@@ -564,7 +627,6 @@ VOID* NCSService::NCSServicePollThread(
                 CAMX_LOG_ERROR(CamxLogGroupNCS, "No incoming sensor data, Try again!");
                 // Maybe do the reconfig the session here
             }
-            pNCSThreadContext->pNCSQMutex->Unlock();
 
             // if flush is is triggered then exit this thread loop.
             if (FALSE == pNCSThreadContext->isRunning)
@@ -582,6 +644,75 @@ VOID* NCSService::NCSServicePollThread(
     return NULL;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSService::HasPendingWork
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL NCSService::HasPendingWork(
+    NCSThreadContext* pNCSThreadContext)
+{
+    BOOL hasWork = (0 < pNCSThreadContext->NCSJobQueue.NumNodes()) ? TRUE : FALSE;
+
+    for (UINT i = 0; (FALSE == hasWork) && (i < NCSMaxSupportedConns); i++)
+    {
+        hasWork = pNCSThreadContext->pendingDelivery[i].isPending;
+    }
+
+    return hasWork;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSService::DeliverPendingData
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID NCSService::DeliverPendingData(
+    NCSThreadContext*   pNCSThreadContext,
+    NCSPendingDelivery* pDeliveries)
+{
+    /// todo (CAMX-2393) remove hardcode of QSEE
+    INCSIntfBase* pNCSIntfObject = m_pNCSIntfObject[QSEE];
+
+    for (UINT i = 0; (NULL != pNCSIntfObject) && (i < NCSMaxSupportedConns); i++)
+    {
+        if (TRUE == pDeliveries[i].isPending)
+        {
+            CamxResult result = pNCSIntfObject->DeliverData(static_cast<INT>(i), pDeliveries[i].timestamp);
+            if (CamxResultSuccess != result)
+            {
+                CAMX_LOG_WARN(CamxLogGroupNCS, "Delivery failed for connection %u: %s", i, Utils::CamxResultToString(result));
+            }
+
+            NCSDeliveryStats* pStats   = &pNCSThreadContext->deliveryStats[i];
+            UINT64            latency  = OsUtils::GetNanoSeconds() - pDeliveries[i].indicationTimeNs;
+
+            pStats->numDeliveries++;
+            pStats->numIndications += pDeliveries[i].numIndications;
+            pStats->totalLatencyNs += latency;
+            pStats->maxLatencyNs    = Utils::MaxUINT64(pStats->maxLatencyNs, latency);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// NCSService::DumpDeliveryStats
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID NCSService::DumpDeliveryStats()
+{
+    for (UINT i = 0; i < NCSMaxSupportedConns; i++)
+    {
+        const NCSDeliveryStats* pStats = &m_hNCSPollThHandle.deliveryStats[i];
+
+        if (0 < pStats->numDeliveries)
+        {
+            CAMX_LOG_INFO(CamxLogGroupNCS,
+                          "Connection %u: deliveries %llu, samples %llu, latency avg %llu ns max %llu ns",
+                          i,
+                          pStats->numDeliveries,
+                          pStats->numIndications,
+                          pStats->totalLatencyNs / pStats->numDeliveries,
+                          pStats->maxLatencyNs);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// NCSService::ProcessPendingJobs
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -596,8 +727,9 @@ CamxResult NCSService::ProcessPendingJobs(
     if (NULL != pNCSServiceObject)
     {
         CAMX_LOG_VERBOSE(CamxLogGroupNCS, "JobQ signalled, Pending Jobs %d", pNCSThreadContext->NCSJobQueue.NumNodes());
+        // Only one control job per wakeup, the remaining ones wait behind the data indications received meanwhile
         LDLLNode* pNode = pNCSThreadContext->NCSJobQueue.RemoveFromHead();
-        while (NULL != pNode)
+        if (NULL != pNode)
         {
             pJob = static_cast<NCSJob*>(pNode->pData);
             CAMX_FREE(pNode);
@@ -629,8 +761,6 @@ CamxResult NCSService::ProcessPendingJobs(
                 CAMX_LOG_VERBOSE(CamxLogGroupNCS, "After processing Pending Jobs %d",
                                  pNCSThreadContext->NCSJobQueue.NumNodes());
             }
-
-            pNode = pNCSThreadContext->NCSJobQueue.RemoveFromHead();
         }
     }
     else
@@ -27,12 +27,32 @@ struct NCSJob
     VOID*      pPayload; ///< Pointer to the payload data.
 };
 
+/// @brief Coalesced data-ready indication of one sensor connection, drained by the poll thread ahead of control jobs
+struct NCSPendingDelivery
+{
+    BOOL       isPending;          ///< Flag to indicate new samples are waiting to be delivered
+    UINT64     timestamp;          ///< Timestamp of the latest sample indicated
+    UINT64     indicationTimeNs;   ///< Monotonic time of the first indication since the last delivery
+    UINT       numIndications;     ///< Number of samples indicated since the last delivery
+};
+
+/// @brief Per sensor connection delivery latency metrics
+struct NCSDeliveryStats
+{
+    UINT64     numDeliveries;      ///< Number of batched deliveries
+    UINT64     numIndications;     ///< Number of samples indicated, numIndications / numDeliveries is the batching ratio
+    UINT64     totalLatencyNs;     ///< Sum of indication to delivery latencies
+    UINT64     maxLatencyNs;       ///< Worst indication to delivery latency
+};
+
 class NCSService;
 struct NCSThreadContext
 {
     JobHandle                   hJobHandle;         ///< Job family handle
     ThreadManager*              pThreadManager;     ///< Thread manager pointer
-    LightweightDoublyLinkedList NCSJobQueue;        ///< NCS Job queue
+    LightweightDoublyLinkedList NCSJobQueue;        ///< NCS control job queue
+    NCSPendingDelivery          pendingDelivery[NCSMaxSupportedConns]; ///< Data path indications, one slot per connection
+    NCSDeliveryStats            deliveryStats[NCSMaxSupportedConns];   ///< Delivery metrics, only written by the poll thread
     Mutex*                      pNCSQMutex;         ///< NCS Queue mutex variable
     Condition*                  pNCSQCondVar;       ///< NCS Queue condition variable
     Semaphore*                  pNCSFlushVar;       ///< NCS Flush semaphore variable
@@ -136,6 +156,21 @@ public:
     CamxResult EnqueueJob(
         NCSJob* pJob);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// NotifyDataReady
+    ///
+    /// @brief  Indicate that new samples were published for a sensor connection. Indications arriving before the poll thread
+    ///         wakes up are coalesced into a single delivery, and deliveries are always processed before control jobs.
+    ///
+    /// @param  connIndex  Connection index of the sensor
+    /// @param  timestamp  Timestamp of the latest published sample
+    ///
+    /// @return CamxResultSuccess if the indication was recorded
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult NotifyDataReady(
+        INT    connIndex,
+        UINT64 timestamp);
+
 private:
 
     INCSIntfBase*  m_pNCSIntfObject[MaxNCSIntfType];            ///< Array of NCS interface objects
@@ -197,6 +232,41 @@ private:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     CamxResult ProcessPendingJobs(
         NCSThreadContext* pThreadContext);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// HasPendingWork
+    ///
+    /// @brief  Check for pending deliveries or control jobs, must be called with the job queue mutex held
+    ///
+    /// @param  pThreadContext NCS thread context
+    ///
+    /// @return TRUE if there is work for the poll thread
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static BOOL HasPendingWork(
+        NCSThreadContext* pThreadContext);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DeliverPendingData
+    ///
+    /// @brief  Deliver a snapshot of the coalesced data indications to the sensor interface and update delivery metrics
+    ///
+    /// @param  pThreadContext NCS thread context
+    /// @param  pDeliveries    Snapshot of the pending deliveries, one entry per connection
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DeliverPendingData(
+        NCSThreadContext*   pThreadContext,
+        NCSPendingDelivery* pDeliveries);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpDeliveryStats
+    ///
+    /// @brief  Log the per sensor delivery latency and batching metrics
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpDeliveryStats();
 };
 
 CAMX_NAMESPACE_END
@@ -342,10 +342,20 @@ typedef struct
     CHAR  sensorEmulator[512];              ///< Emulated sensor application name
 } CSLEmulatedSensorParams;
 
+/// @brief CSL IFH benchmark parameters
+typedef struct
+{
+    BIT     enableBenchmark : 1;                ///< Pace the IFH realtime devices like a sensor and report the CPU cost
+    UINT32  targetFPS;                          ///< Frame rate each realtime device completes frames at
+    UINT32  reportIntervalFrames;               ///< Frames between reports, 0 to report at stream off only
+    CHAR    replayFile[512];                    ///< Recorded frame intervals in microseconds, empty for a fixed rate
+} CSLIFHBenchmarkParams;
+
 typedef struct
 {
     UINT                    mode;                   ///< CSL Mode
     CSLEmulatedSensorParams emulatedSensorParams;   ///< Emulated Sensor Parameter
+    CSLIFHBenchmarkParams   IFHBenchmarkParams;     ///< IFH benchmark Parameter
 } CSLInitializeParams;
 
 /// @brief  Helper object to initialize and expose the right CSL implementation.
@@ -59,6 +59,7 @@ CSLModeManager::CSLModeManager(
     const CSLInitializeParams* pInitParams)
 {
     m_emulatedSensorParams = pInitParams->emulatedSensorParams;
+    m_IFHBenchmarkParams   = pInitParams->IFHBenchmarkParams;
 
     switch (pInitParams->mode)
     {
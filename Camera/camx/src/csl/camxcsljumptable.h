@@ -347,10 +347,23 @@ public:
         return m_emulatedSensorParams.sensorEmulatorPath;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IFHBenchmarkParams
+    ///
+    /// @brief  Returns the IFH benchmark parameters
+    ///
+    /// @return Pointer to the IFH benchmark parameters
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    inline const CSLIFHBenchmarkParams* IFHBenchmarkParams() const
+    {
+        return &m_IFHBenchmarkParams;
+    }
+
 private:
     CSLJumpTable*           m_pJumpTable;                       ///< Current jump table for CSL
     CSLMode                 m_mode;                             ///< Current mode
     CSLEmulatedSensorParams m_emulatedSensorParams;             ///< Current sensor emulation mode
+    CSLIFHBenchmarkParams   m_IFHBenchmarkParams;               ///< IFH benchmark parameters
 
     CSLModeManager(const CSLModeManager&) = delete;             ///< Disable copy constructor
     CSLModeManager& operator=(const CSLModeManager&) = delete;  ///< Disable assignment
@@ -129,6 +129,552 @@ CAMX_STATIC_ASSERT(8 == CSLSensorDeviceIndex);
 /// @brief  Global CSL state
 static CSLState g_CSLState = { 0 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// IFH benchmark
+//
+// With the benchmark enabled, packets to the realtime devices (IFE/VFE) no longer complete inside CSLSubmit. Each realtime
+// device gets a frame clock running at the configured rate (or at the recorded intervals of the replay file) and the frame
+// thread signals the output fences and sends the frame message when the packet's slot comes up, like a sensor would. All
+// other devices still complete synchronously. The CPU time of the process is sampled against the number of completed
+// frames so the CamX cost per frame can be compared across changes; per node latencies come from the latency histograms.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 IFHBenchmarkMaxClocks           = 8;        ///< Realtime devices paced at the same time
+static const UINT32 IFHBenchmarkMaxPendingFrames    = 64;       ///< Frames waiting for their slot
+static const UINT32 IFHBenchmarkMaxFences           = 32;       ///< Output fences per frame
+static const UINT32 IFHBenchmarkMaxReplayIntervals  = 4096;     ///< Intervals kept from the replay file
+static const UINT32 IFHBenchmarkDefaultFPS          = 30;       ///< Frame rate when not configured
+
+/// @brief Frame clock of one realtime device
+struct IFHBenchmarkClock
+{
+    CSLDeviceState* pDevice;        ///< Device paced by this clock, NULL if the slot is free
+    UINT64          startNs;        ///< Time of the first frame
+    UINT64          nextFrameNs;    ///< Time the next frame is due
+    UINT64          sensorTimeNs;   ///< Frame timestamp offset, advances by exactly one interval per frame
+    UINT32          replayIndex;    ///< Next interval of the replay sequence
+};
+
+/// @brief Frame waiting for its slot
+struct IFHBenchmarkFrame
+{
+    CSLSession* pSession;                           ///< Session the frame message goes to
+    UINT64      requestId;                          ///< Request of the packet
+    UINT64      dueNs;                              ///< Time to complete the frame
+    UINT64      timestampNs;                        ///< Frame timestamp reported in the frame message
+    UINT32      numFences;                          ///< Valid entries in hFences
+    CSLFence    hFences[IFHBenchmarkMaxFences];     ///< Output fences to signal
+};
+
+/// @brief IFH benchmark state
+struct IFHBenchmarkState
+{
+    BOOL                    enabled;                                            ///< Benchmark is running
+    UINT32                  reportIntervalFrames;                               ///< Frames between reports
+    UINT64                  framePeriodNs;                                      ///< Frame period without a replay file
+    UINT32                  numReplayIntervals;                                 ///< Valid entries in replayIntervalsNs
+    UINT64                  replayIntervalsNs[IFHBenchmarkMaxReplayIntervals];  ///< Recorded frame intervals, looped
+    CamX::Mutex*            pLock;                                              ///< Protects everything below
+    CamX::Condition*        pFrameQueued;                                       ///< Signaled when a frame is queued or on stop
+    CamX::Condition*        pFrameSlotFree;                                     ///< Signaled when a pending frame is removed
+    CamX::OSThreadHandle    hFrameThread;                                       ///< Frame thread
+    BOOL                    stopFrameThread;                                    ///< Frame thread should exit
+    IFHBenchmarkClock       clocks[IFHBenchmarkMaxClocks];                      ///< Frame clocks
+    UINT32                  numPendingFrames;                                   ///< Valid entries in pendingFrames
+    IFHBenchmarkFrame       pendingFrames[IFHBenchmarkMaxPendingFrames];        ///< Frames waiting for their slot, unordered
+    UINT64                  windowStartNs;                                      ///< Start of the report window
+    clock_t                 windowStartCPU;                                     ///< Process CPU time at the window start
+    UINT64                  numFrames;                                          ///< Frames completed in the window
+    UINT64                  numOfflinePackets;                                  ///< Synchronous packets in the window
+    UINT64                  numLateFrames;                                      ///< Frames submitted past their slot
+    UINT64                  maxLateNs;                                          ///< Largest slot miss in the window
+    UINT64                  numAllocs;                                          ///< CSL buffer allocations in the window
+    UINT64                  allocBytes;                                         ///< CSL buffer bytes allocated in the window
+};
+
+/// @brief  IFH benchmark state
+static IFHBenchmarkState g_IFHBenchmark;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkLoadReplayFile
+///
+/// @brief  Read the recorded frame intervals, one value in microseconds per line; lines starting with '#' are skipped
+///
+/// @param  pFileName   Replay file
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkLoadReplayFile(
+    const CHAR* pFileName)
+{
+    FILE* pFile = CamX::OsUtils::FOpen(pFileName, "r");
+
+    g_IFHBenchmark.numReplayIntervals = 0;
+
+    if (NULL == pFile)
+    {
+        CAMX_LOG_WARN(CamxLogGroupCSL, "IFH benchmark: cannot open replay file %s, using a fixed frame rate", pFileName);
+    }
+    else
+    {
+        CHAR line[64];
+
+        while ((g_IFHBenchmark.numReplayIntervals < IFHBenchmarkMaxReplayIntervals) &&
+               (NULL != CamX::OsUtils::FGetS(line, sizeof(line), pFile)))
+        {
+            if ('#' != line[0])
+            {
+                UINT64 intervalUs = CamX::OsUtils::StrToUL(line, NULL, 10);
+
+                if (0 != intervalUs)
+                {
+                    g_IFHBenchmark.replayIntervalsNs[g_IFHBenchmark.numReplayIntervals++] = intervalUs * 1000;
+                }
+            }
+        }
+
+        CamX::OsUtils::FClose(pFile);
+
+        CAMX_LOG_CONFIG(CamxLogGroupCSL, "IFH benchmark: replaying %u frame intervals from %s",
+                        g_IFHBenchmark.numReplayIntervals, pFileName);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkReport
+///
+/// @brief  Log the cost of the current window and start a new one. Called with the benchmark lock held.
+///
+/// @param  pReason     Why the report is made
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkReport(
+    const CHAR* pReason)
+{
+    UINT64  nowNs     = CamX::OsUtils::GetNanoSeconds();
+    clock_t nowCPU    = clock();
+    UINT64  elapsedUs = (nowNs - g_IFHBenchmark.windowStartNs) / 1000;
+    UINT64  cpuUs     = static_cast<UINT64>(nowCPU - g_IFHBenchmark.windowStartCPU) * 1000000 / CLOCKS_PER_SEC;
+
+    if ((0 < g_IFHBenchmark.numFrames) && (0 < elapsedUs))
+    {
+        CAMX_LOG_CONFIG(CamxLogGroupCSL,
+                        "IFH benchmark (%s): frames %llu in %llu ms = %.2f fps, CPU %llu ms = %llu us/frame "
+                        "(%.1f%% of a core), offline packets %llu, late frames %llu (max %llu us), "
+                        "CSL allocs %llu (%llu bytes)",
+                        pReason,
+                        g_IFHBenchmark.numFrames,
+                        elapsedUs / 1000,
+                        static_cast<DOUBLE>(g_IFHBenchmark.numFrames) * 1000000.0 / elapsedUs,
+                        cpuUs / 1000,
+                        cpuUs / g_IFHBenchmark.numFrames,
+                        static_cast<DOUBLE>(cpuUs) * 100.0 / elapsedUs,
+                        g_IFHBenchmark.numOfflinePackets,
+                        g_IFHBenchmark.numLateFrames,
+                        g_IFHBenchmark.maxLateNs / 1000,
+                        g_IFHBenchmark.numAllocs,
+                        g_IFHBenchmark.allocBytes);
+    }
+
+    g_IFHBenchmark.windowStartNs     = nowNs;
+    g_IFHBenchmark.windowStartCPU    = nowCPU;
+    g_IFHBenchmark.numFrames         = 0;
+    g_IFHBenchmark.numOfflinePackets = 0;
+    g_IFHBenchmark.numLateFrames     = 0;
+    g_IFHBenchmark.maxLateNs         = 0;
+    g_IFHBenchmark.numAllocs         = 0;
+    g_IFHBenchmark.allocBytes        = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkCompleteFrame
+///
+/// @brief  Signal the output fences of a frame and send its frame message
+///
+/// @param  pFrame  Frame to complete
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkCompleteFrame(
+    const IFHBenchmarkFrame* pFrame)
+{
+    for (UINT32 i = 0; i < pFrame->numFences; i++)
+    {
+        CSLFenceSignal(pFrame->hFences[i], CSLFenceResultSuccess);
+    }
+
+    if (NULL != pFrame->pSession->messageHandler)
+    {
+        CSLMessage message = {};
+
+        message.type                                = CSLMessageTypeFrame;
+        message.message.frameMessage.frameCount     = pFrame->requestId;
+        message.message.frameMessage.requestID      = pFrame->requestId;
+        message.message.frameMessage.timestamp      = pFrame->timestampNs;
+
+        pFrame->pSession->messageHandler(pFrame->pSession->pMessageHandlerUserData, &message);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkFrameThread
+///
+/// @brief  Complete pending frames when they are due
+///
+/// @param  pArg    Unused
+///
+/// @return NULL
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID* IFHBenchmarkFrameThread(
+    VOID* pArg)
+{
+    CAMX_UNREFERENCED_PARAM(pArg);
+
+    g_IFHBenchmark.pLock->Lock();
+
+    while (FALSE == g_IFHBenchmark.stopFrameThread)
+    {
+        if (0 == g_IFHBenchmark.numPendingFrames)
+        {
+            g_IFHBenchmark.pFrameQueued->Wait(g_IFHBenchmark.pLock->GetNativeHandle());
+            continue;
+        }
+
+        UINT32 earliest = 0;
+
+        for (UINT32 i = 1; i < g_IFHBenchmark.numPendingFrames; i++)
+        {
+            if (g_IFHBenchmark.pendingFrames[i].dueNs < g_IFHBenchmark.pendingFrames[earliest].dueNs)
+            {
+                earliest = i;
+            }
+        }
+
+        UINT64 nowNs = CamX::OsUtils::GetNanoSeconds();
+
+        if (g_IFHBenchmark.pendingFrames[earliest].dueNs > nowNs)
+        {
+            // A newly queued frame may be due earlier, so never sleep past the next millisecond
+            g_IFHBenchmark.pFrameQueued->TimedWait(g_IFHBenchmark.pLock->GetNativeHandle(), 1);
+            continue;
+        }
+
+        IFHBenchmarkFrame frame = g_IFHBenchmark.pendingFrames[earliest];
+
+        g_IFHBenchmark.pendingFrames[earliest] = g_IFHBenchmark.pendingFrames[--g_IFHBenchmark.numPendingFrames];
+        g_IFHBenchmark.pFrameSlotFree->Broadcast();
+        g_IFHBenchmark.pLock->Unlock();
+
+        IFHBenchmarkCompleteFrame(&frame);
+
+        g_IFHBenchmark.pLock->Lock();
+        g_IFHBenchmark.numFrames++;
+
+        if ((0 != g_IFHBenchmark.reportIntervalFrames) && (g_IFHBenchmark.numFrames >= g_IFHBenchmark.reportIntervalFrames))
+        {
+            IFHBenchmarkReport("interval");
+        }
+    }
+
+    g_IFHBenchmark.pLock->Unlock();
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkInitialize
+///
+/// @brief  Start the benchmark if enabled in the CSL mode parameters
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkInitialize()
+{
+    const CSLIFHBenchmarkParams* pParams = (NULL != g_pCSLModeManager) ? g_pCSLModeManager->IFHBenchmarkParams() : NULL;
+
+    CamX::Utils::Memset(&g_IFHBenchmark, 0, sizeof(g_IFHBenchmark));
+
+    if ((NULL != pParams) && (TRUE == pParams->enableBenchmark))
+    {
+        UINT32 targetFPS = (0 != pParams->targetFPS) ? pParams->targetFPS : IFHBenchmarkDefaultFPS;
+
+        g_IFHBenchmark.framePeriodNs        = 1000000000ULL / targetFPS;
+        g_IFHBenchmark.reportIntervalFrames = pParams->reportIntervalFrames;
+
+        if ('\0' != pParams->replayFile[0])
+        {
+            IFHBenchmarkLoadReplayFile(pParams->replayFile);
+        }
+
+        g_IFHBenchmark.pLock          = CamX::Mutex::Create("IFHBenchmarkLock");
+        g_IFHBenchmark.pFrameQueued   = CamX::Condition::Create("IFHBenchmarkFrameQueued");
+        g_IFHBenchmark.pFrameSlotFree = CamX::Condition::Create("IFHBenchmarkFrameSlotFree");
+
+        if ((NULL != g_IFHBenchmark.pLock)        &&
+            (NULL != g_IFHBenchmark.pFrameQueued) &&
+            (NULL != g_IFHBenchmark.pFrameSlotFree) &&
+            (CamxResultSuccess == CamX::OsUtils::ThreadCreate(IFHBenchmarkFrameThread, NULL, &g_IFHBenchmark.hFrameThread)))
+        {
+            g_IFHBenchmark.windowStartNs  = CamX::OsUtils::GetNanoSeconds();
+            g_IFHBenchmark.windowStartCPU = clock();
+            g_IFHBenchmark.enabled        = TRUE;
+
+            CAMX_LOG_CONFIG(CamxLogGroupCSL, "IFH benchmark enabled: %u fps, report every %u frames",
+                            targetFPS, g_IFHBenchmark.reportIntervalFrames);
+        }
+        else
+        {
+            CAMX_LOG_ERROR(CamxLogGroupCSL, "IFH benchmark: failed to start, packets complete synchronously");
+
+            if (NULL != g_IFHBenchmark.pFrameSlotFree)
+            {
+                g_IFHBenchmark.pFrameSlotFree->Destroy();
+                g_IFHBenchmark.pFrameSlotFree = NULL;
+            }
+            if (NULL != g_IFHBenchmark.pFrameQueued)
+            {
+                g_IFHBenchmark.pFrameQueued->Destroy();
+                g_IFHBenchmark.pFrameQueued = NULL;
+            }
+            if (NULL != g_IFHBenchmark.pLock)
+            {
+                g_IFHBenchmark.pLock->Destroy();
+                g_IFHBenchmark.pLock = NULL;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkUninitialize
+///
+/// @brief  Complete any pending frames, report and stop the frame thread
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkUninitialize()
+{
+    if (TRUE == g_IFHBenchmark.enabled)
+    {
+        g_IFHBenchmark.pLock->Lock();
+        g_IFHBenchmark.stopFrameThread = TRUE;
+        g_IFHBenchmark.pFrameQueued->Signal();
+        g_IFHBenchmark.pLock->Unlock();
+
+        CamX::OsUtils::ThreadWait(g_IFHBenchmark.hFrameThread);
+
+        for (UINT32 i = 0; i < g_IFHBenchmark.numPendingFrames; i++)
+        {
+            IFHBenchmarkCompleteFrame(&g_IFHBenchmark.pendingFrames[i]);
+        }
+
+        IFHBenchmarkReport("uninitialize");
+
+        g_IFHBenchmark.enabled = FALSE;
+        g_IFHBenchmark.pFrameSlotFree->Destroy();
+        g_IFHBenchmark.pFrameQueued->Destroy();
+        g_IFHBenchmark.pLock->Destroy();
+        g_IFHBenchmark.pFrameSlotFree = NULL;
+        g_IFHBenchmark.pFrameQueued   = NULL;
+        g_IFHBenchmark.pLock          = NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkQueueFrame
+///
+/// @brief  Give a realtime packet the next slot of its device's frame clock and queue its output fences for the frame thread
+///
+/// @param  pSession    Session of the packet
+/// @param  pDevice     Realtime device the packet targets
+/// @param  pPacket     Packet
+/// @param  pIOConfig   IO configs of the packet
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkQueueFrame(
+    CSLSession*                 pSession,
+    CSLDeviceState*             pDevice,
+    const CSLPacket*            pPacket,
+    const CSLBufferIOConfig*    pIOConfig)
+{
+    IFHBenchmarkClock* pClock = NULL;
+
+    g_IFHBenchmark.pLock->Lock();
+
+    while ((IFHBenchmarkMaxPendingFrames == g_IFHBenchmark.numPendingFrames) && (FALSE == g_IFHBenchmark.stopFrameThread))
+    {
+        // More requests in flight than a real sensor would buffer; hold the submitter like a full HW queue would
+        g_IFHBenchmark.pFrameSlotFree->Wait(g_IFHBenchmark.pLock->GetNativeHandle());
+    }
+
+    for (UINT32 i = 0; i < IFHBenchmarkMaxClocks; i++)
+    {
+        if (pDevice == g_IFHBenchmark.clocks[i].pDevice)
+        {
+            pClock = &g_IFHBenchmark.clocks[i];
+            break;
+        }
+        else if ((NULL == pClock) && (NULL == g_IFHBenchmark.clocks[i].pDevice))
+        {
+            pClock = &g_IFHBenchmark.clocks[i];
+        }
+    }
+
+    IFHBenchmarkFrame frame = {};
+
+    for (UINT i = 0; (i < pPacket->numBufferIOConfigs) && (frame.numFences < IFHBenchmarkMaxFences); i++)
+    {
+        if ((CSLIODirectionOutput == pIOConfig[i].direction) && (CSLInvalidHandle != pIOConfig[i].hSync))
+        {
+            frame.hFences[frame.numFences++] = pIOConfig[i].hSync;
+        }
+    }
+
+    UINT64 nowNs = CamX::OsUtils::GetNanoSeconds();
+
+    frame.pSession  = pSession;
+    frame.requestId = pPacket->header.requestId;
+    frame.dueNs     = nowNs;
+
+    if (NULL == pClock)
+    {
+        CAMX_LOG_WARN(CamxLogGroupCSL, "IFH benchmark: more than %u realtime devices, completing immediately",
+                      IFHBenchmarkMaxClocks);
+        frame.timestampNs = nowNs;
+    }
+    else
+    {
+        if (NULL == pClock->pDevice)
+        {
+            pClock->pDevice      = pDevice;
+            pClock->startNs      = nowNs;
+            pClock->nextFrameNs  = nowNs;
+            pClock->sensorTimeNs = 0;
+            pClock->replayIndex  = 0;
+        }
+
+        UINT64 intervalNs = g_IFHBenchmark.framePeriodNs;
+
+        if (0 < g_IFHBenchmark.numReplayIntervals)
+        {
+            intervalNs          = g_IFHBenchmark.replayIntervalsNs[pClock->replayIndex];
+            pClock->replayIndex = (pClock->replayIndex + 1) % g_IFHBenchmark.numReplayIntervals;
+        }
+
+        if (nowNs > (pClock->nextFrameNs + intervalNs))
+        {
+            // The slot went by before CamX submitted the request; a real sensor would have dropped the frame
+            g_IFHBenchmark.numLateFrames++;
+            g_IFHBenchmark.maxLateNs = CamX::Utils::MaxUINT64(g_IFHBenchmark.maxLateNs, nowNs - pClock->nextFrameNs);
+            pClock->nextFrameNs      = nowNs;
+        }
+
+        frame.dueNs          = CamX::Utils::MaxUINT64(pClock->nextFrameNs, nowNs);
+        frame.timestampNs    = pClock->startNs + pClock->sensorTimeNs;
+        pClock->nextFrameNs += intervalNs;
+        pClock->sensorTimeNs += intervalNs;
+    }
+
+    g_IFHBenchmark.pendingFrames[g_IFHBenchmark.numPendingFrames++] = frame;
+    g_IFHBenchmark.pFrameQueued->Signal();
+    g_IFHBenchmark.pLock->Unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkStreamOff
+///
+/// @brief  Complete the pending frames of a session, restart its frame clocks and report
+///
+/// @param  pSession    Session being streamed off
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkStreamOff(
+    CSLSession* pSession)
+{
+    if ((TRUE == g_IFHBenchmark.enabled) && (NULL != pSession))
+    {
+        IFHBenchmarkFrame flushed[IFHBenchmarkMaxPendingFrames];
+        UINT32            numFlushed = 0;
+
+        g_IFHBenchmark.pLock->Lock();
+
+        for (UINT32 i = 0; i < g_IFHBenchmark.numPendingFrames;)
+        {
+            if (pSession == g_IFHBenchmark.pendingFrames[i].pSession)
+            {
+                flushed[numFlushed++]           = g_IFHBenchmark.pendingFrames[i];
+                g_IFHBenchmark.pendingFrames[i] = g_IFHBenchmark.pendingFrames[--g_IFHBenchmark.numPendingFrames];
+            }
+            else
+            {
+                i++;
+            }
+        }
+
+        for (UINT32 i = 0; i < IFHBenchmarkMaxClocks; i++)
+        {
+            if ((NULL != g_IFHBenchmark.clocks[i].pDevice) && (pSession == g_IFHBenchmark.clocks[i].pDevice->pSession))
+            {
+                g_IFHBenchmark.clocks[i].pDevice = NULL;
+            }
+        }
+
+        g_IFHBenchmark.pFrameSlotFree->Broadcast();
+        g_IFHBenchmark.pLock->Unlock();
+
+        for (UINT32 i = 0; i < numFlushed; i++)
+        {
+            IFHBenchmarkCompleteFrame(&flushed[i]);
+        }
+
+        g_IFHBenchmark.pLock->Lock();
+        g_IFHBenchmark.numFrames += numFlushed;
+        IFHBenchmarkReport("stream off");
+        g_IFHBenchmark.pLock->Unlock();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkCountPacket
+///
+/// @brief  Account for a packet completed synchronously
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkCountPacket()
+{
+    if (TRUE == g_IFHBenchmark.enabled)
+    {
+        g_IFHBenchmark.pLock->Lock();
+        g_IFHBenchmark.numOfflinePackets++;
+        g_IFHBenchmark.pLock->Unlock();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// IFHBenchmarkCountAlloc
+///
+/// @brief  Account for a CSL buffer allocation
+///
+/// @param  bufferSize  Size of the allocation
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID IFHBenchmarkCountAlloc(
+    SIZE_T bufferSize)
+{
+    if (TRUE == g_IFHBenchmark.enabled)
+    {
+        g_IFHBenchmark.pLock->Lock();
+        g_IFHBenchmark.numAllocs++;
+        g_IFHBenchmark.allocBytes += bufferSize;
+        g_IFHBenchmark.pLock->Unlock();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// ConstructMemAlloc
 ///
@@ -299,7 +845,14 @@ static VOID DestructMemAlloc(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult CSLInitializeIFH(void)
 {
-    return CSLInitializeCommon(&g_CSLState, sizeof(CSLState), g_devices, g_pCapabilities);
+    CamxResult result = CSLInitializeCommon(&g_CSLState, sizeof(CSLState), g_devices, g_pCapabilities);
+
+    if (CamxResultSuccess == result)
+    {
+        IFHBenchmarkInitialize();
+    }
+
+    return result;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -307,6 +860,8 @@ CamxResult CSLInitializeIFH(void)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult CSLUninitializeIFH(void)
 {
+    IFHBenchmarkUninitialize();
+
     return CSLUninitializeCommon(&g_CSLState);
 }
 
@@ -586,6 +1141,13 @@ CamxResult CSLStreamOffIFH(
     CAMX_UNREFERENCED_PARAM(phDevices);
     CAMX_UNREFERENCED_PARAM(phLink);
     CAMX_UNREFERENCED_PARAM(mode);
+
+    g_CSLState.CSLLock->Lock();
+    CSLSession* pSession = GetSession(&g_CSLState, hCSL);
+    g_CSLState.CSLLock->Unlock();
+
+    IFHBenchmarkStreamOff(pSession);
+
     return CSLStreamOffCommon(&g_CSLState, hCSL);
 }
 
@@ -684,6 +1246,16 @@ static CamxResult ProcessPacket(
                 }
             }
 
+            // In the benchmark the realtime devices complete their frames at the sensor rate on the frame thread
+            if ((TRUE == g_IFHBenchmark.enabled) &&
+                ((CSLDeviceTypeIFE == pDevice->type) || (CSLDeviceTypeVFE == pDevice->type)))
+            {
+                IFHBenchmarkQueueFrame(pSession, pDevice, pPacket, pIOConfig);
+                break;
+            }
+
+            IFHBenchmarkCountPacket();
+
             // Now assume the HW is done and output buffers are ready.
             for (UINT i = 0; i < pPacket->numBufferIOConfigs; i++)
             {
@@ -880,6 +1452,8 @@ CamxResult CSLAllocIFH(
             {
                 // Copy into user-provided struct
                 *pBufferInfo = *pBuffer;
+
+                IFHBenchmarkCountAlloc(bufferSize);
             }
             else
             {
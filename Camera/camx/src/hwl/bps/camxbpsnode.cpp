@@ -234,6 +234,7 @@ BPSNode::BPSNode()
     , m_OEMStatsSettingEnable(FALSE)
 {
     m_pNodeName                 = "BPS";
+    m_hResourceVoteClient       = ResourceVoteInvalidClient;
     m_OEMStatsSettingEnable     = GetStaticSettings()->IsOEMStatSettingEnable;
     m_BPSHangDumpEnable         = GetStaticSettings()->enableBPSHangDump;
     m_BPSStripeDumpEnable       = GetStaticSettings()->enableBPSStripeDump;
@@ -509,6 +510,16 @@ CamxResult BPSNode::PostPipelineCreate()
     {
         result = CreateBPSIQModules();
 
+        if ((CamxResultSuccess == result) && (TRUE == GetStaticSettings()->enableResourceVotePlanner))
+        {
+            // Not fatal, without a client the node votes its demand directly
+            Titan17xResourceVotePlanner::GetInstance()->RegisterClient(ResourceVoteDevice::BPS,
+                                                                       ICPResourceVoteChannelTypes,
+                                                                       ICPResourceVoteNumChannels,
+                                                                       NodeIdentifierString(),
+                                                                       &m_hResourceVoteClient);
+        }
+
         m_tuningData.noOfSelectionParameter = 1;
         m_tuningData.TuningMode[0].mode     = ChiModeType::Default;
     }
@@ -2603,6 +2614,9 @@ VOID BPSNode::Cleanup()
                                      numberOfMappings);
     }
 
+    Titan17xResourceVotePlanner::GetInstance()->UnregisterClient(m_hResourceVoteClient);
+    m_hResourceVoteClient = ResourceVoteInvalidClient;
+
     // De-allocate all of the IQ modules
     for (count = 0; count < m_numBPSIQModuleEnabled; count++)
     {
@@ -5256,6 +5270,11 @@ VOID BPSNode::CheckAndUpdateClockBW(
     UpdateClock(pExecuteProcessRequestData, pICPClockBandwidthRequest);
     UpdateBandwidth(pExecuteProcessRequestData, pICPClockBandwidthRequest);
 
+    if (ResourceVoteInvalidClient != m_hResourceVoteClient)
+    {
+        Titan17xResourceVotePlanner::GetInstance()->PlanICPVotes(m_hResourceVoteClient, pICPClockBandwidthRequest);
+    }
+
     PacketBuilder::WriteGenericBlobData(pCmdBuffer,
                                         CSLICPGenericBlobCmdBufferClk,
                                         sizeof(CSLICPClockBandwidthRequest),
@@ -25,6 +25,7 @@
 #include "titan170_bps.h"
 #include "camxcslicpdefs.h"
 #include "camxtitan17xcontext.h"
+#include "camxtitan17xresourcevoteplanner.h"
 
 CAMX_NAMESPACE_BEGIN
 
@@ -1328,6 +1329,7 @@ private:
     CSLDeviceHandle       m_hDevice;                                    ///< BPS device handle
     ISPIQModule*          m_pBPSIQModules[MaxBPSIQModules];             ///< List of IQ Modules
     ISPStatsModule*       m_pBPSStatsModules[MaxBPSStatsModules];       ///< List of IQ Modules
+    UINT32                m_hResourceVoteClient;                        ///< Vote planner client, invalid if not planned
     UINT32                m_LUTCnt[BPSProgramIndexMax];                 ///< Number of LUTs for modules
     UINT32                m_LUTOffset[BPSProgramIndexMax];              ///< Array of offsets within DMI Header cmd buffer
     UINT32                m_moduleChromatixEnable[BPSProgramIndexMax];  ///< Indicates if the IQ module is enabled in chromatix
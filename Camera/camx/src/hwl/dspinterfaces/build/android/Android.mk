@@ -39,6 +39,7 @@ SUPPORT_FUNCTION_CALL_TRACE := 1
 include $(CAMX_PATH)/build/infrastructure/android/common.mk
 
 LOCAL_INC_FILES :=              \
+    camxdspoffload.h            \
     camxifedspinterface.h       \
     AEEStdDef.h                 \
     AEEStdErr.h                 \
@@ -48,6 +49,7 @@ LOCAL_INC_FILES :=              \
     remote.h                    \
 
 LOCAL_SRC_FILES :=                       \
+    camxdspoffload.cpp                   \
     camxifedspinterface.cpp              \
     dsp_streamer_callback_skel.c         \
     dsp_streamer_stub.c
@@ -0,0 +1,550 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxdspoffload.cpp
+/// @brief Offload of software processing stages to the DSP, with a CPU reference backend
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "camxdspoffload.h"
+#include "camxhwenvironment.h"
+#include "camxincs.h"
+#include "camxmem.h"
+#include "camxosutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+/// @brief Names of the backends, for logs
+static const CHAR* DSPOffloadBackendNames[DSPOffloadNumBackends] = { "CPU", "DSP" };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::Create
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::Create(
+    ThreadManager* pThreadManager,
+    const CHAR*    pName,
+    DSPOffload**   ppOffload)
+{
+    CamxResult  result   = CamxResultSuccess;
+    DSPOffload* pOffload = NULL;
+
+    if ((NULL == pThreadManager) || (NULL == pName) || (NULL == ppOffload))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "Invalid args %p %p %p", pThreadManager, pName, ppOffload);
+        result = CamxResultEInvalidArg;
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        pOffload = CAMX_NEW DSPOffload();
+
+        if (NULL == pOffload)
+        {
+            result = CamxResultENoMemory;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        result = pOffload->Initialize(pThreadManager, pName);
+
+        if (CamxResultSuccess != result)
+        {
+            pOffload->Destroy();
+            pOffload = NULL;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        *ppOffload = pOffload;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::DSPOffload
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+DSPOffload::DSPOffload()
+    : m_pThreadManager(NULL)
+    , m_hJobFamily(InvalidJobHandle)
+    , m_enableDSP(FALSE)
+    , m_pLock(NULL)
+    , m_numModules(0)
+{
+    Utils::Memset(&m_name[0], 0, sizeof(m_name));
+    Utils::Memset(&m_modules[0], 0, sizeof(m_modules));
+    Utils::Memset(&m_metrics[0], 0, sizeof(m_metrics));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::~DSPOffload
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+DSPOffload::~DSPOffload()
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::Initialize
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::Initialize(
+    ThreadManager* pThreadManager,
+    const CHAR*    pName)
+{
+    CamxResult result = CamxResultSuccess;
+    CHAR       wrapperName[FILENAME_MAX];
+
+    m_pThreadManager = pThreadManager;
+    m_enableDSP      = HwEnvironment::GetInstance()->GetStaticSettings()->enableDSPOffload;
+    OsUtils::StrLCpy(&m_name[0], pName, sizeof(m_name));
+
+    m_pLock = Mutex::Create("DSPOffload");
+
+    if (NULL == m_pLock)
+    {
+        result = CamxResultENoMemory;
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        // Not serialized, the jobs of a client may execute at the same time
+        OsUtils::SNPrintF(&wrapperName[0], sizeof(wrapperName), "DSPOffload%p", this);
+        result = m_pThreadManager->RegisterJobFamily(JobCb,
+                                                     wrapperName,
+                                                     NULL,
+                                                     JobPriority::Normal,
+                                                     FALSE,
+                                                     &m_hJobFamily);
+    }
+
+    if (CamxResultSuccess != result)
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "%s: failed to initialize, result %s", m_name, Utils::CamxResultToString(result));
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::Destroy
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DSPOffload::Destroy()
+{
+    if (InvalidJobHandle != m_hJobFamily)
+    {
+        CHAR wrapperName[FILENAME_MAX];
+
+        m_pThreadManager->FlushJobFamily(m_hJobFamily, this, TRUE);
+
+        OsUtils::SNPrintF(&wrapperName[0], sizeof(wrapperName), "DSPOffload%p", this);
+        m_pThreadManager->UnregisterJobFamily(JobCb, wrapperName, m_hJobFamily);
+        m_hJobFamily = InvalidJobHandle;
+    }
+
+    for (UINT backend = 0; backend < DSPOffloadNumBackends; backend++)
+    {
+        const DSPOffloadMetrics* pMetrics = &m_metrics[backend];
+
+        if ((0 < pMetrics->jobCount) || (0 < pMetrics->fallbackCount))
+        {
+            CAMX_LOG_INFO(CamxLogGroupCore,
+                          "%s %s: %llu jobs, %llu failed, %llu fell back to the CPU, average execute %llu us latency %llu us",
+                          m_name,
+                          DSPOffloadBackendNames[backend],
+                          pMetrics->jobCount,
+                          pMetrics->failCount,
+                          pMetrics->fallbackCount,
+                          (0 < pMetrics->jobCount) ? (pMetrics->executeTimeNs / pMetrics->jobCount) / 1000 : 0,
+                          (0 < pMetrics->jobCount) ? (pMetrics->latencyTimeNs / pMetrics->jobCount) / 1000 : 0);
+        }
+    }
+
+    for (UINT i = 0; i < m_numModules; i++)
+    {
+        if (TRUE == m_modules[i].isAvailable)
+        {
+            remote_handle64_close(m_modules[i].hModule);
+        }
+    }
+    m_numModules = 0;
+
+    if (NULL != m_pLock)
+    {
+        m_pLock->Destroy();
+        m_pLock = NULL;
+    }
+
+    CAMX_DELETE this;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::ValidateJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::ValidateJob(
+    const DSPOffloadJob* pJob)
+{
+    CamxResult result = CamxResultSuccess;
+
+    // Every job has a CPU reference kernel, so that it never depends on the DSP
+    if ((NULL                   == pJob)                                            ||
+        (NULL                   == pJob->pCPUKernel)                                ||
+        (DSPOffloadMaxBuffers   <  pJob->numInputs)                                 ||
+        (DSPOffloadMaxBuffers   <  pJob->numOutputs)                                ||
+        (DSPOffloadMaxParamSize <  pJob->paramSize)                                 ||
+        ((NULL                  == pJob->pParams) && (0 != pJob->paramSize)))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "Invalid job %p", pJob);
+        result = CamxResultEInvalidArg;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::Submit
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::Submit(
+    const DSPOffloadJob* pJob)
+{
+    CamxResult  result      = ValidateJob(pJob);
+    PendingJob* pPendingJob = NULL;
+
+    if (CamxResultSuccess == result)
+    {
+        pPendingJob = static_cast<PendingJob*>(CAMX_CALLOC(sizeof(PendingJob)));
+
+        if (NULL == pPendingJob)
+        {
+            result = CamxResultENoMemory;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        pPendingJob->pOffload     = this;
+        pPendingJob->job          = *pJob;
+        pPendingJob->submitTimeNs = OsUtils::GetNanoSeconds();
+
+        if (0 < pJob->paramSize)
+        {
+            Utils::Memcpy(&pPendingJob->params[0], pJob->pParams, pJob->paramSize);
+        }
+        pPendingJob->job.pParams = &pPendingJob->params[0];
+
+        VOID* pData[] = { pPendingJob, NULL };
+
+        result = m_pThreadManager->PostJob(m_hJobFamily, JobStoppedCb, &pData[0], FALSE, FALSE);
+
+        if (CamxResultSuccess != result)
+        {
+            CAMX_LOG_ERROR(CamxLogGroupCore, "%s: Req[%llu] failed to post job, result %s",
+                           m_name, pJob->requestId, Utils::CamxResultToString(result));
+            CAMX_FREE(pPendingJob);
+            pPendingJob = NULL;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::Execute
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::Execute(
+    const DSPOffloadJob* pJob,
+    DSPOffloadBackend    backend,
+    UINT64*              pTimeNs)
+{
+    CamxResult result = ValidateJob(pJob);
+
+    if (CamxResultSuccess == result)
+    {
+        result = ExecuteKernel(pJob, backend, pTimeNs);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::GetMetrics
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DSPOffload::GetMetrics(
+    DSPOffloadBackend  backend,
+    DSPOffloadMetrics* pMetrics)
+{
+    CAMX_ASSERT(backend < DSPOffloadBackend::Max);
+
+    m_pLock->Lock();
+    *pMetrics = m_metrics[static_cast<UINT>(backend)];
+    m_pLock->Unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::GetModule
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+remote_handle64 DSPOffload::GetModule(
+    const CHAR* pName)
+{
+    remote_handle64   hModule = 0;
+    DSPOffloadModule* pModule = NULL;
+
+    m_pLock->Lock();
+
+    for (UINT i = 0; i < m_numModules; i++)
+    {
+        if (0 == OsUtils::StrCmp(&m_modules[i].name[0], pName))
+        {
+            pModule = &m_modules[i];
+            break;
+        }
+    }
+
+    if ((NULL == pModule) && (DSPOffloadMaxModules > m_numModules))
+    {
+        CHAR uri[FILENAME_MAX];
+
+        pModule = &m_modules[m_numModules++];
+        OsUtils::StrLCpy(&pModule->name[0], pName, sizeof(pModule->name));
+        OsUtils::SNPrintF(&uri[0], sizeof(uri), "file:///lib%s_skel.so?%s_skel_handle_invoke&_modver=1.0&_dom=cdsp",
+                          pName, pName);
+
+        // Opened once per offloader, a module that fails to open keeps its jobs on the CPU
+        pModule->isAvailable = (0 == remote_handle64_open(&uri[0], &pModule->hModule)) ? TRUE : FALSE;
+        CAMX_LOG_INFO(CamxLogGroupCore, "%s: DSP module %s available %d", m_name, pName, pModule->isAvailable);
+    }
+
+    if ((NULL != pModule) && (TRUE == pModule->isAvailable))
+    {
+        hModule = pModule->hModule;
+    }
+
+    m_pLock->Unlock();
+
+    return hModule;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::InvokeDSPKernel
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::InvokeDSPKernel(
+    remote_handle64      hModule,
+    const DSPOffloadJob* pJob)
+{
+    CamxResult result  = CamxResultSuccess;
+    remote_arg args[1 + (2 * DSPOffloadMaxBuffers)];
+    UINT       numArgs = 0;
+    INT        rpcResult;
+
+    args[numArgs].buf.pv   = const_cast<VOID*>(pJob->pParams);
+    args[numArgs].buf.nLen = pJob->paramSize;
+    numArgs++;
+
+    for (UINT i = 0; i < pJob->numInputs; i++)
+    {
+        args[numArgs].buf.pv   = pJob->inputs[i].pVirtualAddr;
+        args[numArgs].buf.nLen = pJob->inputs[i].size;
+        numArgs++;
+    }
+
+    for (UINT i = 0; i < pJob->numOutputs; i++)
+    {
+        args[numArgs].buf.pv   = pJob->outputs[i].pVirtualAddr;
+        args[numArgs].buf.nLen = pJob->outputs[i].size;
+        numArgs++;
+    }
+
+    // Buffers with an fd are mapped into the DSP for the invoke instead of being copied
+    for (UINT i = 1; i < numArgs; i++)
+    {
+        const DSPOffloadBuffer* pBuffer = (i <= pJob->numInputs) ? &pJob->inputs[i - 1] :
+                                                                   &pJob->outputs[i - 1 - pJob->numInputs];
+        if (0 <= pBuffer->fd)
+        {
+            remote_register_buf(pBuffer->pVirtualAddr, static_cast<INT>(pBuffer->size), pBuffer->fd);
+        }
+    }
+
+    rpcResult = remote_handle64_invoke(hModule,
+                                       REMOTE_SCALARS_MAKE(DSPOffloadKernelMethod, 1 + pJob->numInputs, pJob->numOutputs),
+                                       &args[0]);
+
+    for (UINT i = 1; i < numArgs; i++)
+    {
+        const DSPOffloadBuffer* pBuffer = (i <= pJob->numInputs) ? &pJob->inputs[i - 1] :
+                                                                   &pJob->outputs[i - 1 - pJob->numInputs];
+        if (0 <= pBuffer->fd)
+        {
+            remote_register_buf(pBuffer->pVirtualAddr, static_cast<INT>(pBuffer->size), -1);
+        }
+    }
+
+    if (0 != rpcResult)
+    {
+        CAMX_LOG_ERROR(CamxLogGroupCore, "%s: Req[%llu] DSP kernel of %s failed %d",
+                       m_name, pJob->requestId, pJob->pDSPModule, rpcResult);
+        result = CamxResultEFailed;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::ExecuteKernel
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::ExecuteKernel(
+    const DSPOffloadJob* pJob,
+    DSPOffloadBackend    backend,
+    UINT64*              pTimeNs)
+{
+    CamxResult result     = CamxResultEUnsupported;
+    BOOL       isExecuted = FALSE;
+    UINT64     startNs    = OsUtils::GetNanoSeconds();
+    UINT64     timeNs;
+
+    if (DSPOffloadBackend::DSP == backend)
+    {
+        remote_handle64 hModule = (NULL != pJob->pDSPModule) ? GetModule(pJob->pDSPModule) : 0;
+
+        if (0 != hModule)
+        {
+            result     = InvokeDSPKernel(hModule, pJob);
+            isExecuted = TRUE;
+        }
+    }
+    else
+    {
+        result     = pJob->pCPUKernel(pJob->pParams, pJob->paramSize, &pJob->inputs[0], pJob->numInputs,
+                                      const_cast<DSPOffloadBuffer*>(&pJob->outputs[0]), pJob->numOutputs);
+        isExecuted = TRUE;
+    }
+
+    timeNs = OsUtils::GetNanoSeconds() - startNs;
+
+    if (TRUE == isExecuted)
+    {
+        DSPOffloadMetrics* pMetrics = &m_metrics[static_cast<UINT>(backend)];
+
+        m_pLock->Lock();
+        pMetrics->jobCount++;
+        pMetrics->executeTimeNs += timeNs;
+        if (CamxResultSuccess != result)
+        {
+            pMetrics->failCount++;
+        }
+        m_pLock->Unlock();
+    }
+
+    if (NULL != pTimeNs)
+    {
+        *pTimeNs = timeNs;
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::RunJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DSPOffload::RunJob(
+    const DSPOffloadJob* pJob,
+    DSPOffloadBackend*   pBackend)
+{
+    CamxResult result = CamxResultEUnsupported;
+
+    *pBackend = DSPOffloadBackend::CPU;
+
+    if ((TRUE == m_enableDSP) && (NULL != pJob->pDSPModule))
+    {
+        result = ExecuteKernel(pJob, DSPOffloadBackend::DSP, NULL);
+
+        if (CamxResultSuccess == result)
+        {
+            *pBackend = DSPOffloadBackend::DSP;
+        }
+        else
+        {
+            m_pLock->Lock();
+            m_metrics[static_cast<UINT>(DSPOffloadBackend::DSP)].fallbackCount++;
+            m_pLock->Unlock();
+        }
+    }
+
+    if (DSPOffloadBackend::CPU == *pBackend)
+    {
+        result = ExecuteKernel(pJob, DSPOffloadBackend::CPU, NULL);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::CompleteJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DSPOffload::CompleteJob(
+    PendingJob*       pPendingJob,
+    DSPOffloadBackend backend,
+    CamxResult        result)
+{
+    const DSPOffloadJob* pJob = &pPendingJob->job;
+
+    if (CamxResultECancelledRequest != result)
+    {
+        m_pLock->Lock();
+        m_metrics[static_cast<UINT>(backend)].latencyTimeNs += OsUtils::GetNanoSeconds() - pPendingJob->submitTimeNs;
+        m_pLock->Unlock();
+    }
+
+    CAMX_LOG_VERBOSE(CamxLogGroupCore, "%s: Req[%llu] completed on %s, result %s",
+                     m_name, pJob->requestId, DSPOffloadBackendNames[static_cast<UINT>(backend)],
+                     Utils::CamxResultToString(result));
+
+    // The callback first, so the result it records is in place when a node waiting on the fence through the DRQ runs. A
+    // failed fence leaves a DRQ waiter deferred until the next flush, so only a cancelled job fails it and a kernel failure
+    // reaches the waiter through the callback instead.
+    if (NULL != pJob->pCompletionCb)
+    {
+        pJob->pCompletionCb(pJob->pUserData, pJob->requestId, backend, result);
+    }
+
+    if (CSLInvalidFence != pJob->hFence)
+    {
+        CSLFenceSignal(pJob->hFence,
+                       (CamxResultECancelledRequest != result) ? CSLFenceResultSuccess : CSLFenceResultFailed);
+    }
+
+    CAMX_FREE(pPendingJob);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::JobCb
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* DSPOffload::JobCb(
+    VOID* pData)
+{
+    PendingJob*       pPendingJob = static_cast<PendingJob*>(pData);
+    DSPOffload*       pOffload    = pPendingJob->pOffload;
+    DSPOffloadBackend backend;
+    CamxResult        result;
+
+    result = pOffload->RunJob(&pPendingJob->job, &backend);
+    pOffload->CompleteJob(pPendingJob, backend, result);
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DSPOffload::JobStoppedCb
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DSPOffload::JobStoppedCb(
+    VOID* pData)
+{
+    PendingJob* pPendingJob = static_cast<PendingJob*>(pData);
+
+    pPendingJob->pOffload->CompleteJob(pPendingJob, DSPOffloadBackend::CPU, CamxResultECancelledRequest);
+}
+
+CAMX_NAMESPACE_END
@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxdspoffload.h
+/// @brief Offload of software processing stages to the DSP, with a CPU reference backend
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXDSPOFFLOAD_H
+#define CAMXDSPOFFLOAD_H
+
+#include "camxcsl.h"
+#include "camxdefs.h"
+#include "camxthreadmanager.h"
+#include "camxtypes.h"
+#include "remote.h"
+
+CAMX_NAMESPACE_BEGIN
+
+class Mutex;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT   DSPOffloadMaxBuffers       = 4;     ///< Largest number of input or output buffers of a job
+static const SIZE_T DSPOffloadMaxParamSize     = 256;   ///< Largest size of the parameters of a job
+static const UINT   DSPOffloadMaxModules       = 8;     ///< Largest number of DSP modules an offloader opens
+static const UINT   DSPOffloadModuleNameLength = 32;    ///< Length of a DSP module name
+static const UINT32 DSPOffloadKernelMethod     = 2;     ///< FastRPC method of a kernel, after the open and close methods
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Backend a job executes on
+enum class DSPOffloadBackend
+{
+    CPU = 0,    ///< CPU reference implementation of the kernel, always available
+    DSP,        ///< Kernel of a FastRPC module on the CDSP
+    Max         ///< Number of backends
+};
+
+static const UINT DSPOffloadNumBackends = static_cast<UINT>(DSPOffloadBackend::Max);    ///< Number of backends
+
+/// @brief Buffer of a job
+///
+/// The buffer contract between a client and the offloader:
+/// - The buffers stay valid, and are not accessed by the client, from the submit until the completion of the job.
+/// - The client cleans the CPU cache of cached input buffers before the submit and invalidates the CPU cache of cached output
+///   buffers after the completion, as for any other hardware consumer of the buffers.
+/// - A buffer with an fd is registered with FastRPC for the invoke, so the DSP maps it instead of copying it. A buffer
+///   without an fd is copied through the FastRPC transport, which only suits small buffers.
+struct DSPOffloadBuffer
+{
+    VOID*  pVirtualAddr;    ///< CPU mapping of the buffer
+    SIZE_T size;            ///< Size of the buffer in bytes
+    INT    fd;              ///< ION buffer fd, -1 if the buffer has none
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief  CPU reference implementation of a kernel. It has to produce the same outputs as the DSP kernel, so that a job gives
+///         the same result on either backend.
+///
+/// @param  pParams     Parameters of the job
+/// @param  paramSize   Size of the parameters
+/// @param  pInputs     Input buffers
+/// @param  numInputs   Number of input buffers
+/// @param  pOutputs    Output buffers
+/// @param  numOutputs  Number of output buffers
+///
+/// @return CamxResultSuccess if successful
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef CamxResult (*DSPOffloadCPUKernel)(
+    const VOID*             pParams,
+    SIZE_T                  paramSize,
+    const DSPOffloadBuffer* pInputs,
+    UINT                    numInputs,
+    DSPOffloadBuffer*       pOutputs,
+    UINT                    numOutputs);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief  Completion of a job, called on the worker thread that executed it before the job's fence is signaled, so whatever
+///         the callback records is in place once a waiter on the fence runs
+///
+/// @param  pUserData   User data of the job
+/// @param  requestId   Request of the job
+/// @param  backend     Backend the job executed on
+/// @param  result      Result of the kernel
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef VOID (*DSPOffloadCompletionCb)(
+    VOID*             pUserData,
+    UINT64            requestId,
+    DSPOffloadBackend backend,
+    CamxResult        result);
+
+/// @brief Job descriptor
+///
+/// A DSP kernel is method DSPOffloadKernelMethod of the FastRPC module lib<pDSPModule>_skel.so. It is invoked with the raw
+/// remote arguments: the parameters and the input buffers in order as inputs, then the output buffers in order as outputs.
+struct DSPOffloadJob
+{
+    const CHAR*            pDSPModule;                      ///< FastRPC module of the DSP kernel, NULL to run on the CPU only
+    DSPOffloadCPUKernel    pCPUKernel;                      ///< CPU reference implementation of the kernel
+    const VOID*            pParams;                         ///< Parameters, copied at the submit
+    SIZE_T                 paramSize;                       ///< Size of the parameters, at most DSPOffloadMaxParamSize
+    DSPOffloadBuffer       inputs[DSPOffloadMaxBuffers];    ///< Input buffers
+    UINT                   numInputs;                       ///< Number of input buffers
+    DSPOffloadBuffer       outputs[DSPOffloadMaxBuffers];   ///< Output buffers
+    UINT                   numOutputs;                      ///< Number of output buffers
+    UINT64                 requestId;                       ///< Request of the job, for the completion and logs
+    CSLFence               hFence;                          ///< Fence signaled on completion, CSLInvalidFence if none.
+                                                            ///  It signals success once the job executed, whatever the result
+                                                            ///  of the kernel, and fails only for a cancelled job. A node
+                                                            ///  waits for the job through the DRQ by wrapping this fence in
+                                                            ///  an internal ChiFence of its next sequence's dependencies.
+    DSPOffloadCompletionCb pCompletionCb;                   ///< Completion callback, NULL if none
+    VOID*                  pUserData;                       ///< User data of the completion callback
+};
+
+/// @brief Counters of one backend, to compare the backends on a use case
+struct DSPOffloadMetrics
+{
+    UINT64 jobCount;        ///< Jobs executed
+    UINT64 failCount;       ///< Jobs whose kernel failed
+    UINT64 fallbackCount;   ///< Jobs meant for this backend that executed on the CPU instead
+    UINT64 executeTimeNs;   ///< Time spent in the kernels
+    UINT64 latencyTimeNs;   ///< Time from the submits to the completions, including the wait for a worker thread
+};
+
+/// @brief DSP module opened by an offloader
+struct DSPOffloadModule
+{
+    CHAR            name[DSPOffloadModuleNameLength];   ///< Module name
+    remote_handle64 hModule;                            ///< FastRPC handle of the module
+    BOOL            isAvailable;                        ///< The module was opened, else its jobs run on the CPU
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Offloads the jobs of a client to the DSP, or to the CPU reference kernel if the DSP module is not available
+///
+/// Jobs are submitted asynchronously and executed on the client's thread manager, several at a time, and complete through
+/// their fence and callback. A DSP module is opened on its first job. If it cannot be opened, as on a host without a DSP,
+/// or if enableDSPOffload is not set, its jobs run on the CPU reference kernel, so clients never depend on the DSP. The
+/// metrics of both backends are logged when the offloader is destroyed.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DSPOffload
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Create
+    ///
+    /// @brief  Create an offloader
+    ///
+    /// @param  pThreadManager  Thread manager the jobs execute on
+    /// @param  pName           Client name, for logs
+    /// @param  ppOffload       Returned offloader
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CamxResult Create(
+        ThreadManager* pThreadManager,
+        const CHAR*    pName,
+        DSPOffload**   ppOffload);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Destroy
+    ///
+    /// @brief  Cancel the jobs not started yet, wait for the running ones, log the metrics, close the DSP modules and destroy
+    ///         the offloader. Cancelled jobs complete with CamxResultECancelledRequest and a failed fence.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID Destroy();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Submit
+    ///
+    /// @brief  Submit a job for asynchronous execution. The descriptor and the parameters are copied, the buffers are not.
+    ///
+    /// @param  pJob    Job descriptor
+    ///
+    /// @return CamxResultSuccess if the job was submitted; otherwise the job is not executed and its fence is not signaled
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult Submit(
+        const DSPOffloadJob* pJob);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Execute
+    ///
+    /// @brief  Execute a job on the calling thread and on a given backend, to compare the backends on the same job. The fence
+    ///         and the completion callback of the job are not used.
+    ///
+    /// @param  pJob        Job descriptor
+    /// @param  backend     Backend to execute on
+    /// @param  pTimeNs     Returned execution time, may be NULL
+    ///
+    /// @return Result of the kernel, CamxResultEUnsupported if the backend is not available for the job
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult Execute(
+        const DSPOffloadJob* pJob,
+        DSPOffloadBackend    backend,
+        UINT64*              pTimeNs);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetMetrics
+    ///
+    /// @brief  Get the metrics of a backend
+    ///
+    /// @param  backend     Backend
+    /// @param  pMetrics    Returned metrics
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID GetMetrics(
+        DSPOffloadBackend  backend,
+        DSPOffloadMetrics* pMetrics);
+
+private:
+    /// @brief Submitted job
+    struct PendingJob
+    {
+        DSPOffload*    pOffload;                            ///< Offloader of the job
+        DSPOffloadJob  job;                                 ///< Copy of the descriptor
+        BYTE           params[DSPOffloadMaxParamSize];      ///< Copy of the parameters
+        UINT64         submitTimeNs;                        ///< Time of the submit
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DSPOffload
+    ///
+    /// @brief  Constructor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    DSPOffload();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ~DSPOffload
+    ///
+    /// @brief  Destructor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ~DSPOffload();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Initialize
+    ///
+    /// @brief  Create the lock and register the job family
+    ///
+    /// @param  pThreadManager  Thread manager the jobs execute on
+    /// @param  pName           Client name, for logs
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult Initialize(
+        ThreadManager* pThreadManager,
+        const CHAR*    pName);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetModule
+    ///
+    /// @brief  Get a DSP module, opening it on its first use
+    ///
+    /// @param  pName   Module name
+    ///
+    /// @return FastRPC handle of the module, 0 if the module is not available
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    remote_handle64 GetModule(
+        const CHAR* pName);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// InvokeDSPKernel
+    ///
+    /// @brief  Invoke the DSP kernel of a job
+    ///
+    /// @param  hModule     FastRPC handle of the job's module
+    /// @param  pJob        Job descriptor
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult InvokeDSPKernel(
+        remote_handle64      hModule,
+        const DSPOffloadJob* pJob);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ValidateJob
+    ///
+    /// @brief  Check a job descriptor against the limits of the offloader
+    ///
+    /// @param  pJob    Job descriptor
+    ///
+    /// @return CamxResultSuccess if the job is valid, CamxResultEInvalidArg otherwise
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CamxResult ValidateJob(
+        const DSPOffloadJob* pJob);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ExecuteKernel
+    ///
+    /// @brief  Execute the kernel of a job on a backend and update the backend's metrics
+    ///
+    /// @param  pJob        Job descriptor
+    /// @param  backend     Backend to execute on
+    /// @param  pTimeNs     Returned execution time, may be NULL
+    ///
+    /// @return Result of the kernel, CamxResultEUnsupported if the backend is not available for the job
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult ExecuteKernel(
+        const DSPOffloadJob* pJob,
+        DSPOffloadBackend    backend,
+        UINT64*              pTimeNs);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RunJob
+    ///
+    /// @brief  Execute a job on the DSP if it is enabled and the job's module is available, else on the CPU
+    ///
+    /// @param  pJob        Job descriptor
+    /// @param  pBackend    Returned backend the job executed on
+    ///
+    /// @return Result of the kernel
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult RunJob(
+        const DSPOffloadJob* pJob,
+        DSPOffloadBackend*   pBackend);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// CompleteJob
+    ///
+    /// @brief  Call the completion callback of a submitted job, signal its fence and free it
+    ///
+    /// @param  pPendingJob Submitted job
+    /// @param  backend     Backend the job executed on
+    /// @param  result      Result of the kernel
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID CompleteJob(
+        PendingJob*       pPendingJob,
+        DSPOffloadBackend backend,
+        CamxResult        result);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// JobCb
+    ///
+    /// @brief  Thread manager job that executes and completes a submitted job
+    ///
+    /// @param  pData   Submitted job
+    ///
+    /// @return NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* JobCb(
+        VOID* pData);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// JobStoppedCb
+    ///
+    /// @brief  Thread manager callback of a submitted job that is flushed before it started, completes it as cancelled
+    ///
+    /// @param  pData   Submitted job
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID JobStoppedCb(
+        VOID* pData);
+
+    DSPOffload(const DSPOffload&) = delete;
+    DSPOffload& operator=(const DSPOffload&) = delete;
+
+    ThreadManager*    m_pThreadManager;                     ///< Thread manager the jobs execute on
+    JobHandle         m_hJobFamily;                         ///< Job family of the submitted jobs
+    CHAR              m_name[DSPOffloadModuleNameLength];   ///< Client name, for logs
+    BOOL              m_enableDSP;                          ///< DSP modules may be used
+    Mutex*            m_pLock;                              ///< Protects the modules and the metrics
+    DSPOffloadModule  m_modules[DSPOffloadMaxModules];      ///< Opened DSP modules
+    UINT              m_numModules;                         ///< Number of opened DSP modules
+    DSPOffloadMetrics m_metrics[DSPOffloadNumBackends];     ///< Metrics per backend
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXDSPOFFLOAD_H
@@ -884,6 +884,7 @@ IFENode::IFENode()
     m_ISPFrameData.pFrameData   = &m_ISPFramelevelData;
     m_ISPInputSensorData.dGain  = 1.0f;
     m_pNodeName                 = "IFE";
+    m_hResourceVoteClient       = ResourceVoteInvalidClient;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2594,6 +2595,12 @@ CamxResult IFENode::UpdateInitSettings()
             {
                 result = CamxResultENoMemory;
             }
+            if ((CamxResultSuccess == result) &&
+                (TRUE == HwEnvironment::GetInstance()->GetStaticSettings()->enableDualIFEStripingCache))
+            {
+                // Not fatal, without the cache every configuration change runs the striping library
+                m_pStripingCache = static_cast<DualIFEStripingCache*>(CAMX_CALLOC(sizeof(DualIFEStripingCache)));
+            }
             if (CamxResultSuccess == result)
             {
                 // Store bankSelect for interpolation to store mesh_table_l[bankSelect] and mesh_table_r[bankSelect]
@@ -2656,7 +2663,8 @@ CamxResult IFENode::AcquireResources()
                     m_PDAFInfo,
                     m_stripeConfigs,
                     &m_dualIFESplitParams,
-                    m_pPassOut);
+                    m_pPassOut,
+                    m_pStripingCache);
             }
             else
             {
@@ -2848,6 +2856,23 @@ CamxResult IFENode::PostPipelineCreate()
 
     m_highInitialBWCnt = 0;
 
+    if (TRUE == pSettings->enableResourceVotePlanner)
+    {
+        ResourceVoteChannelType channelTypes[IFEResourceVoteNumChannels];
+
+        for (UINT32 channel = 0; channel < IFEResourceVoteNumChannels; channel++)
+        {
+            channelTypes[channel] = ResourceVoteChannelType::Bandwidth;
+        }
+
+        // Not fatal, without a client the node votes its demand directly
+        Titan17xResourceVotePlanner::GetInstance()->RegisterClient(ResourceVoteDevice::IFE,
+                                                                   channelTypes,
+                                                                   IFEResourceVoteNumChannels,
+                                                                   NodeIdentifierString(),
+                                                                   &m_hResourceVoteClient);
+    }
+
     if (FALSE == m_RDIOnlyUseCase)
     {
         // Assemble IFE IQ Modules
@@ -3752,7 +3777,8 @@ CamxResult IFENode::ExecuteProcessRequest(
                                                               m_PDAFInfo,
                                                               m_stripeConfigs,
                                                               &m_dualIFESplitParams,
-                                                              m_pPassOut);
+                                                              m_pPassOut,
+                                                              m_pStripingCache);
                         }
                     }
                     else
@@ -5163,6 +5189,9 @@ CamxResult IFENode::Cleanup()
     UINT        count  = 0;
     CamxResult  result = CamxResultSuccess;
 
+    Titan17xResourceVotePlanner::GetInstance()->UnregisterClient(m_hResourceVoteClient);
+    m_hResourceVoteClient = ResourceVoteInvalidClient;
+
     // De-allocate all of the IQ modules
 
     for (count = 0; count < m_numIFEIQModule; count++)
@@ -5199,6 +5228,17 @@ CamxResult IFENode::Cleanup()
         m_pPassOut = NULL;
     }
 
+    if (NULL != m_pStripingCache)
+    {
+        CAMX_LOG_INFO(CamxLogGroupISP, "IFE:%d dual IFE striping cache: %u hits in %u lookups",
+                      InstanceID(),
+                      m_pStripingCache->hitCount,
+                      m_pStripingCache->lookupCount);
+
+        CAMX_FREE(m_pStripingCache);
+        m_pStripingCache = NULL;
+    }
+
     if (NULL != m_pTuningMetadata)
     {
         CAMX_FREE(m_pTuningMetadata);
@@ -9690,14 +9730,26 @@ void DualIFEUtils::FetchCfgWithStripeOutput(
     IFEPassOutput*      pPassOut,
     ISPStripeConfig*    pStripeConfigs)
 {
-    uint16_t stripeNum = 0;
+    CAMX_ASSERT((NULL != pPassOut) && (NULL != pPassOut->hStripeList.pListHead));
 
-    CAMX_UNREFERENCED_PARAM(pISPInputdata);
+    FetchCfgWithStripes(pISPInputdata,
+                        static_cast<IFEStripeOutput*>(pPassOut->hStripeList.pListHead->pData),
+                        static_cast<IFEStripeOutput*>(pPassOut->hStripeList.pListHead->pNextNode->pData),
+                        pStripeConfigs);
+}
 
-    CAMX_ASSERT((NULL != pPassOut) && (NULL != pPassOut->hStripeList.pListHead));
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// DualIFEUtils::FetchCfgWithStripes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DualIFEUtils::FetchCfgWithStripes(
+    ISPInputData*       pISPInputdata,
+    IFEStripeOutput*    pStripe1,
+    IFEStripeOutput*    pStripe2,
+    ISPStripeConfig*    pStripeConfigs)
+{
+    uint16_t stripeNum = 0;
 
-    IFEStripeOutput* pStripe1 =
-        static_cast<IFEStripeOutput*>(pPassOut->hStripeList.pListHead->pData);
+    CAMX_UNREFERENCED_PARAM(pISPInputdata);
 
     CAMX_ASSERT(NULL != pStripe1);
 
@@ -9716,9 +9768,6 @@ void DualIFEUtils::FetchCfgWithStripeOutput(
     pStripeConfigs[1].AECStatsUpdateData.statsConfig.BEConfig.isStripeValid = FALSE;
     FillCfgFromOneStripe(pISPInputdata, pStripe1, &pStripeConfigs[stripeNum]);
 
-    IFEStripeOutput* pStripe2 =
-        static_cast<IFEStripeOutput*>(pPassOut->hStripeList.pListHead->pNextNode->pData);
-
     CAMX_ASSERT(NULL != pStripe2);
 
     if (1 == pStripe2->edgeStripeLT) // left stripe
@@ -9983,6 +10032,76 @@ VOID DualIFEUtils::GetDefaultDualIFEStatsConfig(
         pStripeConfig[0].AECStatsUpdateData.statsConfig.TintlessBGConfig.horizontalNum;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// DualIFEUtils::GetCachedStripes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+DualIFEStripingCacheEntry* DualIFEUtils::GetCachedStripes(
+    DualIFEStripingCache*         pCache,
+    const stripingInput_titanIFE* pStripingInput)
+{
+    DualIFEStripingCacheEntry* pFound = NULL;
+
+    if (NULL != pCache)
+    {
+        pCache->lookupCount++;
+
+        for (UINT i = 0; i < DualIFEStripingCacheSize; i++)
+        {
+            DualIFEStripingCacheEntry* pEntry = &pCache->entries[i];
+
+            // The striping input is zero initialized and only ever written field by field, so its padding compares equal
+            if ((TRUE == pEntry->valid) &&
+                (0 == Utils::Memcmp(&pEntry->stripingInput, pStripingInput, sizeof(stripingInput_titanIFE))))
+            {
+                pEntry->lastUse = pCache->lookupCount;
+                pCache->hitCount++;
+                pFound          = pEntry;
+                break;
+            }
+        }
+    }
+
+    return pFound;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// DualIFEUtils::AddCachedStripes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DualIFEUtils::AddCachedStripes(
+    DualIFEStripingCache*         pCache,
+    const stripingInput_titanIFE* pStripingInput,
+    const IFEPassOutput*          pPassOut)
+{
+    const ListNode_T* pNode = (NULL != pPassOut) ? pPassOut->hStripeList.pListHead : NULL;
+
+    if ((NULL != pCache) && (NULL != pNode) && (NULL != pNode->pNextNode))
+    {
+        DualIFEStripingCacheEntry* pVictim = &pCache->entries[0];
+
+        for (UINT i = 0; i < DualIFEStripingCacheSize; i++)
+        {
+            DualIFEStripingCacheEntry* pEntry = &pCache->entries[i];
+
+            if (FALSE == pEntry->valid)
+            {
+                pVictim = pEntry;
+                break;
+            }
+
+            if (pEntry->lastUse < pVictim->lastUse)
+            {
+                pVictim = pEntry;
+            }
+        }
+
+        pVictim->stripingInput = *pStripingInput;
+        pVictim->stripes[0]    = *static_cast<const IFEStripeOutput*>(pNode->pData);
+        pVictim->stripes[1]    = *static_cast<const IFEStripeOutput*>(pNode->pNextNode->pData);
+        pVictim->lastUse       = pCache->lookupCount;
+        pVictim->valid         = TRUE;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// DualIFEUtils::ReleaseDualIfePassResult
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -10277,11 +10396,12 @@ VOID DualIFEUtils::PrintDualIfeFrame(
 /// DualIFEUtils::UpdateDualIFEConfig
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult DualIFEUtils::UpdateDualIFEConfig(
-    ISPInputData*       pISPInputdata,
-    IFEPDAFInfo         PDAFInfo,
-    ISPStripeConfig*    pStripeConfig,
-    DualIFESplitParams* pSplitParams,
-    IFEPassOutput*      pPassOut)
+    ISPInputData*         pISPInputdata,
+    IFEPDAFInfo           PDAFInfo,
+    ISPStripeConfig*      pStripeConfig,
+    DualIFESplitParams*   pSplitParams,
+    IFEPassOutput*        pPassOut,
+    DualIFEStripingCache* pStripingCache)
 {
     CamxResult            result                           = CamxResultSuccess;
     const StaticSettings* pSettings                        = HwEnvironment::GetInstance()->GetStaticSettings();
@@ -10324,18 +10444,47 @@ CamxResult DualIFEUtils::UpdateDualIFEConfig(
                 PrintDualIfeInput(&pISPInputdata->pStripingInput->stripingInput);
             }
 
-            stripingInput_titanIFE* pInput = &pISPInputdata->pStripingInput->stripingInput;
-            // Use striping library to get the per stripe configuration
-            result = deriveStriping_titanIFE(pInput, pPassOut);
+            stripingInput_titanIFE*    pInput       = &pISPInputdata->pStripingInput->stripingInput;
+            DualIFEStripingCacheEntry* pCachedEntry = GetCachedStripes(pStripingCache, pInput);
 
-            if (TRUE == pISPInputdata->enableIFEDualStripeLog)
+            if (NULL != pCachedEntry)
+            {
+                // Same striping input as an earlier configuration, the stripe config points into the cache entry
+                if (TRUE == pISPInputdata->enableIFEDualStripeLog)
+                {
+                    PrintDualIfeOutput(&pCachedEntry->stripes[0]);
+                    PrintDualIfeOutput(&pCachedEntry->stripes[1]);
+                }
+            }
+            else
             {
-                PrintDualIfeFrame(pPassOut);
+                // Use striping library to get the per stripe configuration
+                result = deriveStriping_titanIFE(pInput, pPassOut);
+
+                if (TRUE == pISPInputdata->enableIFEDualStripeLog)
+                {
+                    PrintDualIfeFrame(pPassOut);
+                }
+
+                if (CamxResultSuccess == result)
+                {
+                    AddCachedStripes(pStripingCache, pInput, pPassOut);
+                }
             }
 
             if (CamxResultSuccess == result)
             {
-                DualIFEUtils::FetchCfgWithStripeOutput(pISPInputdata, pPassOut, pStripeConfig);
+                if (NULL != pCachedEntry)
+                {
+                    DualIFEUtils::FetchCfgWithStripes(pISPInputdata,
+                                                      &pCachedEntry->stripes[0],
+                                                      &pCachedEntry->stripes[1],
+                                                      pStripeConfig);
+                }
+                else
+                {
+                    DualIFEUtils::FetchCfgWithStripeOutput(pISPInputdata, pPassOut, pStripeConfig);
+                }
                 if (pISPInputdata->HALData.stream[PixelRawOutput].width > 0)
                 {
                     pStripeConfig[0].stream[PixelRawOutput].width     = pSplitParams->splitPoint;
@@ -13296,6 +13445,35 @@ CamxResult IFENode::SetupResourceBWConfig(
         }
     }
 
+    if ((CamxResultSuccess == result) && (ResourceVoteInvalidClient != m_hResourceVoteClient))
+    {
+        // Plan the IB votes of all paths together; the AB votes follow the active use case and are voted as calculated
+        IFEResourceBWVote* pPathVotes[IFEResourceVoteNumPaths] =
+        {
+            &m_pBwResourceConfig->leftPixelVote,
+            &m_pBwResourceConfig->rightPixelVote,
+            &m_pBwResourceConfig->rdiVote[0],
+            &m_pBwResourceConfig->rdiVote[1],
+            &m_pBwResourceConfig->rdiVote[2],
+            &m_pBwResourceConfig->rdiVote[3]
+        };
+        UINT64 votes[IFEResourceVoteNumChannels];
+
+        for (UINT32 path = 0; path < IFEResourceVoteNumPaths; path++)
+        {
+            votes[(2 * path)]     = pPathVotes[path]->camnocBWbytes;
+            votes[(2 * path) + 1] = pPathVotes[path]->externalBWbytes;
+        }
+
+        Titan17xResourceVotePlanner::GetInstance()->PlanVotes(m_hResourceVoteClient, votes, votes);
+
+        for (UINT32 path = 0; path < IFEResourceVoteNumPaths; path++)
+        {
+            pPathVotes[path]->camnocBWbytes   = votes[(2 * path)];
+            pPathVotes[path]->externalBWbytes = votes[(2 * path) + 1];
+        }
+    }
+
     if (CamxResultSuccess == result)
     {
         CAMX_LOG_VERBOSE(CamxLogGroupPower,
@@ -23,6 +23,7 @@
 #include "camxpropertyblob.h"
 #include "camxstatsdebugdatawriter.h"
 #include "camxtitan17xcontext.h"
+#include "camxtitan17xresourcevoteplanner.h"
 
 CAMX_NAMESPACE_BEGIN
 
@@ -97,6 +98,9 @@ static const UINT32 CropRegionsIndex            = 6;
 
 static const UINT32 IFEMinVBI = 32;
 
+static const UINT32 IFEResourceVoteNumPaths    = 6;                            ///< Left, right and 4 RDI bandwidth votes
+static const UINT32 IFEResourceVoteNumChannels = 2 * IFEResourceVoteNumPaths;  ///< CAMNOC and external bandwidth per path
+
 static const UINT IFEMaxOutputVendorTags = CAMX_ARRAY_SIZE(IFEOutputVendorTags);
 
 static const UINT IFETotalMetadataTags   = NumIFEMetadataOutputTags +IFEMaxOutputVendorTags;
@@ -359,6 +363,25 @@ CAMX_STATIC_ASSERT_MESSAGE((sizeof(IFEResourceBWConfigAB) % 8) == 0,    "IFEReso
 
 CAMX_END_PACKED
 
+static const UINT32 DualIFEStripingCacheSize = 4;   ///< Striping library results kept per IFE node
+
+/// @brief Striping library result for one striping input
+struct DualIFEStripingCacheEntry
+{
+    BOOL                    valid;                          ///< Entry holds a result
+    UINT32                  lastUse;                        ///< Lookup count when the entry was last used, for LRU
+    stripingInput_titanIFE  stripingInput;                  ///< Striping library input the result was derived from
+    IFEStripeOutput         stripes[CSLMaxNumIFEStripes];   ///< Stripes in the order of the library's stripe list
+};
+
+/// @brief LRU cache of striping library results, so repeated stream configurations skip the striping library
+struct DualIFEStripingCache
+{
+    UINT32                      lookupCount;                        ///< Number of lookups
+    UINT32                      hitCount;                           ///< Number of lookups that found a result
+    DualIFEStripingCacheEntry   entries[DualIFEStripingCacheSize];  ///< Cached results
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @brief Class that implements the IFE node class
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2174,6 +2197,7 @@ private:
     ISPIQModule*             m_pIFEIQModule[MaxIFEIQModule];        ///< List of IQ Modules
     ISPIQModule*             m_pIFEHVXModule;                       ///< HVX IQ Modules
     ISPStatsModule*          m_pIFEStatsModule[MaxIFEStatsModule];  ///< List of Stats Modules
+    UINT32                   m_hResourceVoteClient;                 ///< Vote planner client, invalid if not planned
     const SensorMode*        m_pSensorModeData;                     ///< Sensor mode related data for the current mode
     const SensorMode*        m_pSensorModeRes0Data;                 ///< Sensor mode related data for FULL SIZE
     const EEPROMOTPData*     m_pOTPData;                            ///< OTP Data read from EEPROM to be used for calibration
@@ -2234,6 +2258,7 @@ private:
     // work as if they always write to a single ISP.
     IFEStripingInput*       m_pStripingInput;                       ///< Striping library input
     IFEPassOutput*          m_pPassOut;                             ///< Striping library's output
+    DualIFEStripingCache*   m_pStripingCache;                       ///< Striping library results of earlier configurations
     ISPInternalData         m_ISPFramelevelData;                    ///< Frame-level data (used for striping)
     ISPStripeConfig         m_stripeConfigs[2];                     ///< ISP input configuration per stripe
     ISPInternalData         m_ISPData[3];                           ///< Data Calculated by IQ Modules (common, left and right)
@@ -2339,6 +2364,54 @@ public:
         IFEPassOutput*      pPassOut,
         ISPStripeConfig*    pStripeConfig);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FetchCfgWithStripes
+    ///
+    /// @brief  Static method to fetch configurations from the two stripes of a striping output
+    ///
+    /// @param  pISPInputdata Pointer to ISP configuration to be used to read frame-level settings
+    /// @param  pStripe1      First stripe of the striping output
+    /// @param  pStripe2      Second stripe of the striping output
+    /// @param  pStripeConfig Pointer to stripe config
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID FetchCfgWithStripes(
+        ISPInputData*       pISPInputdata,
+        IFEStripeOutput*    pStripe1,
+        IFEStripeOutput*    pStripe2,
+        ISPStripeConfig*    pStripeConfig);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetCachedStripes
+    ///
+    /// @brief  Static method to look up the striping library result of a striping input
+    ///
+    /// @param  pCache          Striping cache, may be NULL
+    /// @param  pStripingInput  Striping library input
+    ///
+    /// @return Cache entry holding the result, NULL if there is none
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static DualIFEStripingCacheEntry* GetCachedStripes(
+        DualIFEStripingCache*         pCache,
+        const stripingInput_titanIFE* pStripingInput);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AddCachedStripes
+    ///
+    /// @brief  Static method to store a striping library result, replacing the least recently used one if the cache is full
+    ///
+    /// @param  pCache          Striping cache, may be NULL
+    /// @param  pStripingInput  Striping library input
+    /// @param  pPassOut        Striping library output for pStripingInput
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID AddCachedStripes(
+        DualIFEStripingCache*         pCache,
+        const stripingInput_titanIFE* pStripingInput,
+        const IFEPassOutput*          pPassOut);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// ComputeSplitParams
     ///
@@ -2411,16 +2484,19 @@ public:
     /// @param  PDAFInfo        PDAF Pixel information
     /// @param  pStripeConfig   ISP stripe-level configuration to to be written to
     /// @param  pSplitParams    Split parameters
-    /// @param  pPassOut        Stripe specific parameters used by striping library
+    /// @param  pPassOut        Stripe specific parameters used by striping library, left empty if pStripingCache had the
+    ///                         result
+    /// @param  pStripingCache  Striping library results of earlier configurations, may be NULL
     ///
     /// @return CamxResult
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     static CamxResult UpdateDualIFEConfig(
-        ISPInputData*       pISPInputdata,
-        const IFEPDAFInfo   PDAFInfo,
-        ISPStripeConfig*    pStripeConfig,
-        DualIFESplitParams* pSplitParams,
-        IFEPassOutput*      pPassOut);
+        ISPInputData*         pISPInputdata,
+        const IFEPDAFInfo     PDAFInfo,
+        ISPStripeConfig*      pStripeConfig,
+        DualIFESplitParams*   pSplitParams,
+        IFEPassOutput*        pPassOut,
+        DualIFEStripingCache* pStripingCache);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// GetDefaultDualIFEStatsConfig
@@ -248,6 +248,7 @@ static const UINT CmdBufferGenericBlobSizeInBytes = (
 IPENode::IPENode()
 {
     m_pNodeName                 = "IPE";
+    m_hResourceVoteClient       = ResourceVoteInvalidClient;
     m_OEMStatsSettingEnable     = GetStaticSettings()->IsOEMStatSettingEnable;
     m_enableIPEHangDump         = GetStaticSettings()->enableIPEHangDump;
     m_enableIPEStripeDump       = GetStaticSettings()->enableIPEStripeDump;
@@ -2127,6 +2128,17 @@ CamxResult IPENode::PostPipelineCreate()
     if (CamxResultSuccess == result)
     {
         UpdateIQCmdSize();
+
+        if (TRUE == GetStaticSettings()->enableResourceVotePlanner)
+        {
+            // Not fatal, without a client the node votes its demand directly
+            Titan17xResourceVotePlanner::GetInstance()->RegisterClient(ResourceVoteDevice::IPE,
+                                                                       ICPResourceVoteChannelTypes,
+                                                                       ICPResourceVoteNumChannels,
+                                                                       NodeIdentifierString(),
+                                                                       &m_hResourceVoteClient);
+        }
+
         result = InitializeCmdBufferManagerList(IPECmdBufferMaxIds);
     }
 
@@ -4891,6 +4903,11 @@ VOID IPENode::CheckAndUpdateClockBW(
     UpdateClock(pExecuteProcessRequestData, pICPClockBandwidthRequest);
     UpdateBandwidth(pExecuteProcessRequestData, pICPClockBandwidthRequest);
 
+    if (ResourceVoteInvalidClient != m_hResourceVoteClient)
+    {
+        Titan17xResourceVotePlanner::GetInstance()->PlanICPVotes(m_hResourceVoteClient, pICPClockBandwidthRequest);
+    }
+
     PacketBuilder::WriteGenericBlobData(pCmdBuffer,
                                         CSLICPGenericBlobCmdBufferClk,
                                         sizeof(CSLICPClockBandwidthRequest),
@@ -6604,6 +6621,9 @@ CamxResult IPENode::Cleanup()
                                      numberOfMappings);
     }
 
+    Titan17xResourceVotePlanner::GetInstance()->UnregisterClient(m_hResourceVoteClient);
+    m_hResourceVoteClient = ResourceVoteInvalidClient;
+
     // De-allocate all of the IQ modules
 
     for (count = 0; count < m_numIPEIQModulesEnabled; count++)
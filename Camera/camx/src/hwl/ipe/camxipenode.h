@@ -18,6 +18,7 @@
 #include "camxispiqmodule.h"
 #include "camxmem.h"
 #include "camxnode.h"
+#include "camxtitan17xresourcevoteplanner.h"
 #include "chipinforeaderdefs.h"
 #include "ipeStripingLib.h"
 #include "ipe_data.h"
@@ -2474,6 +2475,7 @@ private:
     INT32                   m_deviceIndex;                                  ///< ICP device index
     CSLDeviceHandle         m_hDevice;                                      ///< IPE device handle
     ISPIQModule*            m_pEnabledIPEIQModule[MaxIPEIQModule];          ///< List of IQ Modules
+    UINT32                  m_hResourceVoteClient;                          ///< Vote planner client, invalid if not planned
     CSLVersion              m_version;                                      ///< IPE Hardware Revision
     IPECapabilityInfo       m_capability;                                   ///< IPE Capability Configuration
     UINT                    m_numIPEIQModulesEnabled;                       ///< Number of IPE IQ Modules
@@ -1250,6 +1250,8 @@ struct ANR10InputData
     BOOL                            validateANRSettings;          ///< Validate ANR register settings
 };
 
+struct LTM13AdrcCurveCache;
+
 /// @brief Input Data to LTM13 IQ Algorithm
 // NOWHINE NC004c: Share code with system team
 struct LTM13InputData
@@ -1273,6 +1275,7 @@ struct LTM13InputData
     INT32*                          pIGammaPrev;                   ///< Ptr to cached version of InverseGamma() output igamma
     FLOAT                           gammaOutput[65];               ///< Gamma ouput from gamma15 module
     ADRCData*                       pAdrcInputData;                ///< Pointer to the input data for adrc algo calculation.
+    LTM13AdrcCurveCache*            pAdrcCurveCache;               ///< Ptr to ADRC LTM curves of a previous request, or NULL
     VOID*                           pInterpolationData;            ///< input memory for interpolation data
 };
 
@@ -1327,6 +1330,8 @@ struct Upscale12InputData
     UINT16                                  chromaRoundingModeH;           ///< Chroma rounding mode horizontal
 };
 
+struct Upscale20ConfigCache;
+
 /// @brief Input Data to Upscale20 and Chroma Upsample IQ Algorithm
 // NOWHINE NC004c : Shared file with system team so uses non-CamX file naming
 struct Upscale20InputData
@@ -1346,6 +1351,7 @@ struct Upscale20InputData
     UINT32                                  ch2InputWidth;      ///< Input image width for channel 2
     UINT32                                  ch2InputHeight;     ///< Input image height for channel 2
     VOID*                                   pInterpolationData; ///< input memory for interpolation data
+    Upscale20ConfigCache*                   pConfigCache;       ///< Calculated configurations, NULL to not cache
 };
 
 /// @brief Input Data to GRA10 IQ Algorithm
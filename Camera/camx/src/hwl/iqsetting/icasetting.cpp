@@ -20,7 +20,29 @@ static const UINT GridAssistRows                       = 16;
 static const UINT GridAssistColumns                    = 16;
 static const UINT GridExtarpolateCornerSize            = 4;
 
-
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RoundGridTable
+///
+/// @brief  Round a chromatix table to its integer register representation. One table per call keeps the loop free of
+///         dependencies across tables, so the compiler vectorizes it instead of walking six tables element by element.
+///
+/// @param  pInput      Chromatix table
+/// @param  pOutput     Rounded table
+/// @param  numEntries  Number of entries
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename TInput, typename TOutput>
+static __inline VOID RoundGridTable(
+    const TInput* pInput,
+    TOutput*      pOutput,
+    UINT          numEntries)
+{
+    for (UINT idx = 0; idx < numEntries; idx++)
+    {
+        pOutput[idx] = static_cast<TOutput>(IQSettingUtils::RoundFLOAT(pInput[idx]));
+    }
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// ICASetting::ValidateContextParams
@@ -127,34 +149,31 @@ BOOL  ICASetting::MapChromatixMod2ICAv10Chromatix(
     pIcaChromatix->opg.opg_invalid_output_treatment_cr        = pReserveData->opg_invalid_output_treatment_cr;
 
     // Add static assert
-    for (UINT idx = 0; idx < ICAInterpolationCoeffSets; idx++)
-    {
-        pIcaChromatix->opg.opg_interpolation_lut_0[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_0_tab.opg_interpolation_lut_0[idx]);
-        pIcaChromatix->opg.opg_interpolation_lut_1[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_1_tab.opg_interpolation_lut_1[idx]);
-        pIcaChromatix->opg.opg_interpolation_lut_2[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_2_tab.opg_interpolation_lut_2[idx]);
-    }
+    RoundGridTable(pData->opg_interpolation_lut_0_tab.opg_interpolation_lut_0,
+                   pIcaChromatix->opg.opg_interpolation_lut_0,
+                   ICAInterpolationCoeffSets);
+    RoundGridTable(pData->opg_interpolation_lut_1_tab.opg_interpolation_lut_1,
+                   pIcaChromatix->opg.opg_interpolation_lut_1,
+                   ICAInterpolationCoeffSets);
+    RoundGridTable(pData->opg_interpolation_lut_2_tab.opg_interpolation_lut_2,
+                   pIcaChromatix->opg.opg_interpolation_lut_2,
+                   ICAInterpolationCoeffSets);
 
     // Add static assert
-    for (UINT idx = 0; idx < ICA10GridRegSize; idx++)
-    {
-        pIcaChromatix->ctc.ctc_grid_x[idx] = IQSettingUtils::RoundFLOAT(pData->ctc_grid_x_tab.ctc_grid_x[idx]);
-        pIcaChromatix->ctc.ctc_grid_y[idx] = IQSettingUtils::RoundFLOAT(pData->ctc_grid_y_tab.ctc_grid_y[idx]);
-        pIcaChromatix->distorted_input_to_undistorted_ldc_grid_x[idx] =
-            IQSettingUtils::RoundFLOAT(
-            pData->distorted_input_to_undistorted_ldc_grid_x_tab.distorted_input_to_undistorted_ldc_grid_x[idx]);
-        pIcaChromatix->distorted_input_to_undistorted_ldc_grid_y[idx] =
-            IQSettingUtils::RoundFLOAT(
-            pData->distorted_input_to_undistorted_ldc_grid_y_tab.distorted_input_to_undistorted_ldc_grid_y[idx]);
-        pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_x[idx] =
-            IQSettingUtils::RoundFLOAT(
-            pData->undistorted_to_lens_distorted_output_ld_grid_x_tab.undistorted_to_lens_distorted_output_ld_grid_x[idx]);
-        pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_y[idx] =
-            IQSettingUtils::RoundFLOAT(
-            pData->undistorted_to_lens_distorted_output_ld_grid_y_tab.undistorted_to_lens_distorted_output_ld_grid_y[idx]);
-    }
+    RoundGridTable(pData->ctc_grid_x_tab.ctc_grid_x, pIcaChromatix->ctc.ctc_grid_x, ICA10GridRegSize);
+    RoundGridTable(pData->ctc_grid_y_tab.ctc_grid_y, pIcaChromatix->ctc.ctc_grid_y, ICA10GridRegSize);
+    RoundGridTable(pData->distorted_input_to_undistorted_ldc_grid_x_tab.distorted_input_to_undistorted_ldc_grid_x,
+                   pIcaChromatix->distorted_input_to_undistorted_ldc_grid_x,
+                   ICA10GridRegSize);
+    RoundGridTable(pData->distorted_input_to_undistorted_ldc_grid_y_tab.distorted_input_to_undistorted_ldc_grid_y,
+                   pIcaChromatix->distorted_input_to_undistorted_ldc_grid_y,
+                   ICA10GridRegSize);
+    RoundGridTable(pData->undistorted_to_lens_distorted_output_ld_grid_x_tab.undistorted_to_lens_distorted_output_ld_grid_x,
+                   pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_x,
+                   ICA10GridRegSize);
+    RoundGridTable(pData->undistorted_to_lens_distorted_output_ld_grid_y_tab.undistorted_to_lens_distorted_output_ld_grid_y,
+                   pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_y,
+                   ICA10GridRegSize);
 
     if (TRUE == pInput->isGridFromChromatixEnabled)
     {
@@ -194,35 +213,31 @@ BOOL  ICASetting::MapChromatixMod2ICAv20Chromatix(
         pReserveData->undistorted_to_lens_distorted_output_ld_grid_valid;
 
     // Add static assert
-    for (UINT idx = 0; idx < ICAInterpolationCoeffSets; idx++)
-    {
-        pIcaChromatix->opg.opg_interpolation_lut_0[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_0_tab.opg_interpolation_lut_0[idx]);
-        pIcaChromatix->opg.opg_interpolation_lut_1[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_1_tab.opg_interpolation_lut_1[idx]);
-        pIcaChromatix->opg.opg_interpolation_lut_2[idx] =
-            IQSettingUtils::RoundFLOAT(pData->opg_interpolation_lut_2_tab.opg_interpolation_lut_2[idx]);
-    }
+    RoundGridTable(pData->opg_interpolation_lut_0_tab.opg_interpolation_lut_0,
+                   pIcaChromatix->opg.opg_interpolation_lut_0,
+                   ICAInterpolationCoeffSets);
+    RoundGridTable(pData->opg_interpolation_lut_1_tab.opg_interpolation_lut_1,
+                   pIcaChromatix->opg.opg_interpolation_lut_1,
+                   ICAInterpolationCoeffSets);
+    RoundGridTable(pData->opg_interpolation_lut_2_tab.opg_interpolation_lut_2,
+                   pIcaChromatix->opg.opg_interpolation_lut_2,
+                   ICAInterpolationCoeffSets);
 
     // Add static assert
-    for (UINT idx = 0; idx < ICA20GridRegSize; idx++)
-    {
-        pIcaChromatix->ctc.ctc_grid_x[idx] = IQSettingUtils::RoundFLOAT(pData->ctc_grid_x_tab.ctc_grid_x[idx]);
-        pIcaChromatix->ctc.ctc_grid_y[idx] = IQSettingUtils::RoundFLOAT(pData->ctc_grid_y_tab.ctc_grid_y[idx]);
-
-        pIcaChromatix->distorted_input_to_undistorted_ldc_grid_x[idx] =
-            IQSettingUtils::RoundFLOAT(
-                pData->distorted_input_to_undistorted_ldc_grid_x_tab.distorted_input_to_undistorted_ldc_grid_x[idx]);
-        pIcaChromatix->distorted_input_to_undistorted_ldc_grid_y[idx] =
-            IQSettingUtils::RoundFLOAT(
-                pData->distorted_input_to_undistorted_ldc_grid_y_tab.distorted_input_to_undistorted_ldc_grid_y[idx]);
-        pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_x[idx] =
-            IQSettingUtils::RoundFLOAT(
-                pData->undistorted_to_lens_distorted_output_ld_grid_x_tab.undistorted_to_lens_distorted_output_ld_grid_x[idx]);
-        pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_y[idx] =
-            IQSettingUtils::RoundFLOAT(
-                pData->undistorted_to_lens_distorted_output_ld_grid_y_tab.undistorted_to_lens_distorted_output_ld_grid_y[idx]);
-    }
+    RoundGridTable(pData->ctc_grid_x_tab.ctc_grid_x, pIcaChromatix->ctc.ctc_grid_x, ICA20GridRegSize);
+    RoundGridTable(pData->ctc_grid_y_tab.ctc_grid_y, pIcaChromatix->ctc.ctc_grid_y, ICA20GridRegSize);
+    RoundGridTable(pData->distorted_input_to_undistorted_ldc_grid_x_tab.distorted_input_to_undistorted_ldc_grid_x,
+                   pIcaChromatix->distorted_input_to_undistorted_ldc_grid_x,
+                   ICA20GridRegSize);
+    RoundGridTable(pData->distorted_input_to_undistorted_ldc_grid_y_tab.distorted_input_to_undistorted_ldc_grid_y,
+                   pIcaChromatix->distorted_input_to_undistorted_ldc_grid_y,
+                   ICA20GridRegSize);
+    RoundGridTable(pData->undistorted_to_lens_distorted_output_ld_grid_x_tab.undistorted_to_lens_distorted_output_ld_grid_x,
+                   pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_x,
+                   ICA20GridRegSize);
+    RoundGridTable(pData->undistorted_to_lens_distorted_output_ld_grid_y_tab.undistorted_to_lens_distorted_output_ld_grid_y,
+                   pIcaChromatix->undistorted_to_lens_distorted_output_ld_grid_y,
+                   ICA20GridRegSize);
 
     if (TRUE == pInput->isGridFromChromatixEnabled)
     {
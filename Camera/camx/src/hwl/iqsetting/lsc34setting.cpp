@@ -440,22 +440,51 @@ VOID LSC34Setting::MeshRolloffScaleRolloff(
     INT*         pMeshH,
     INT*         pMeshV)
 {
-    FLOAT cxm;
-    FLOAT cx0;   ///< Coefficint 0 in x direction for bicubic interpolation
-    FLOAT cx1;   ///< Coefficint 1 in x direction for bicubic interpolation
-    FLOAT cx2;   ///< Coefficint 2 in x direction for bicubic interpolation
+    const FLOAT* ppMeshIn[]  = { pMeshIn };
+    FLOAT*       ppMeshOut[] = { pMeshOut };
+
+    MeshRolloffScaleRolloffChannels(ppMeshIn,
+                                    ppMeshOut,
+                                    1,
+                                    fullWidth,
+                                    fullHeight,
+                                    outputWidth,
+                                    outputHeight,
+                                    offsetX,
+                                    offsetY,
+                                    scaleX,
+                                    scaleY,
+                                    pMeshH,
+                                    pMeshV);
+
+    return;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LSC34Setting::MeshRolloffScaleRolloffChannels
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LSC34Setting::MeshRolloffScaleRolloffChannels(
+    const FLOAT* const* ppMeshIn,
+    FLOAT* const*       ppMeshOut,
+    UINT32              numChannels,
+    INT                 fullWidth,
+    INT                 fullHeight,
+    INT                 outputWidth,
+    INT                 outputHeight,
+    INT                 offsetX,
+    INT                 offsetY,
+    INT                 scaleX,
+    INT                 scaleY,
+    INT*                pMeshH,
+    INT*                pMeshV)
+{
+    FLOAT cxTable[ROLLOFF_MESH_PT_H_V34][4];   ///< Per column bicubic coefficients in x direction (cxm, cx0, cx1, cx2)
+    FLOAT txTable[ROLLOFF_MESH_PT_H_V34];      ///< Per column fractional position for bilinear interpolation
+    INT   ixTable[ROLLOFF_MESH_PT_H_V34];      ///< Per column integer position in the extended mesh
     FLOAT cym;
-    FLOAT cy0;   ///< Coefficint 0 in x direction for bicubic interpolation
+    FLOAT cy0;   ///< Coefficint 0 in Y direction for bicubic interpolation
     FLOAT cy1;   ///< Coefficint 1 in Y direction for bicubic interpolation
     FLOAT cy2;   ///< Coefficint 2 in Y direction for bicubic interpolation
-    FLOAT am;
-    FLOAT a0;
-    FLOAT a1;
-    FLOAT a2;
-    FLOAT bm;
-    FLOAT b0;
-    FLOAT b1;
-    FLOAT b2;
     FLOAT tx;
     FLOAT ty;
     INT   ix;
@@ -479,8 +508,13 @@ VOID LSC34Setting::MeshRolloffScaleRolloff(
     FLOAT gv_full;
     INT   meshHMax;
     INT   meshVMax;
+    INT   extendStride;
     FLOAT extendMesh[(ROLLOFF_MESH_H_V34 + 3)*(ROLLOFF_MESH_V_V34 + 3)];
+    FLOAT extendMeshChannels[(ROLLOFF_MESH_H_V34 + 3)*(ROLLOFF_MESH_V_V34 + 3)][LSC34_MESH_CHANNELS];
+
+    CAMX_ASSERT((0 < numChannels) && (LSC34_MESH_CHANNELS >= numChannels));
 
+    // The grid depends only on the output geometry, so it is shared by all the channels
     InterpGridOptimization(outputWidth, outputHeight, &scale, &dh, &dv, &sgh, &sgv, pMeshH, pMeshV);
     gh = sgh * scale;
     gv = sgv * scale;
@@ -496,77 +530,110 @@ VOID LSC34Setting::MeshRolloffScaleRolloff(
     meshVMax      = ROLLOFF_MESH_V_V34;
     channelWidth  = fullWidth >> 1;  // per-channel image width
     channelHeight = fullHeight >> 1;  // per-channel image height
+    extendStride  = meshHMax + 3;
 
     gh_full = (channelWidth - 1) / static_cast<FLOAT>(meshHMax);
     gv_full = (channelHeight - 1) / static_cast<FLOAT>(meshVMax);
 
-    // outer extend the mesh data 1 block by keeping the same slope
-    MeshExtend1block(pMeshIn, extendMesh, meshHMax + 1, meshVMax + 1);
+    // outer extend the mesh data 1 block by keeping the same slope, and interleave the channels so every tap below is one
+    // 4-wide load. Unused lanes repeat the last channel and are never written out.
+    for (UINT32 channel = 0; channel < LSC34_MESH_CHANNELS; channel++)
+    {
+        if (channel < numChannels)
+        {
+            MeshExtend1block(ppMeshIn[channel], extendMesh, meshHMax + 1, meshVMax + 1);
+        }
+
+        for (INT i = 0; i < (extendStride * (meshVMax + 3)); i++)
+        {
+            extendMeshChannels[i][channel] = extendMesh[i];
+        }
+    }
+
+    // The x position and bicubic weights only depend on the column, compute them once instead of once per point
+    for (hMeshNum = 0; hMeshNum < (*pMeshH + 1); hMeshNum++)
+    {
+        tx = static_cast<FLOAT>(hMeshNum*gh_up - dh_up + offsetX / 2 + gh_full) / gh_full;
+        ix = static_cast<INT>(floor(tx));
+        tx = tx - static_cast<FLOAT>(ix);
+
+        ixTable[hMeshNum] = ix;
+        txTable[hMeshNum] = tx;
+        BicubicF(tx, &cxTable[hMeshNum][0], &cxTable[hMeshNum][1], &cxTable[hMeshNum][2], &cxTable[hMeshNum][3]);
+    }
 
-    //  resample Extended Mesh data onto the roll-off mesh grid
+    //  resample Extended Mesh data onto the roll-off mesh grid, all the channels at once. The per lane arithmetic is in the
+    //  same order as the single channel scalar version so the tables do not change.
     for (vMeshNum = 0; vMeshNum < (*pMeshV + 1); vMeshNum++)
     {
+        ty = static_cast<FLOAT>(vMeshNum*gv_up - dv_up + offsetY / 2 + gv_full) / gv_full;
+        iy = static_cast<INT>(floor(ty));
+        ty = ty - static_cast<FLOAT>(iy);
+
+        BicubicF(ty, &cym, &cy0, &cy1, &cy2);
+
         for (hMeshNum = 0; hMeshNum < (*pMeshH + 1); hMeshNum++)
         {
-            tx = static_cast<FLOAT>(hMeshNum*gh_up - dh_up + offsetX / 2 + gh_full) / gh_full;
-            ix = static_cast<INT>(floor(tx));
-            tx = tx - static_cast<FLOAT>(ix);
+            FLOAT result[LSC34_MESH_CHANNELS];
 
-            ty = static_cast<FLOAT>(vMeshNum*gv_up - dv_up + offsetY / 2 + gv_full) / gv_full;
-            iy = static_cast<INT>(floor(ty));
-            ty = ty - static_cast<FLOAT>(iy);
+            ix = ixTable[hMeshNum];
+            tx = txTable[hMeshNum];
 
             if ((vMeshNum == 0) || (hMeshNum == 0) || (vMeshNum == *pMeshV) || (hMeshNum == *pMeshH))
             {
                 // for boundary points, use bilinear interpolation
-                b1 = (1 - tx)* extendMesh[iy * (meshHMax + 3) + ix] +
-                     tx      * extendMesh[iy * (meshHMax + 3) + ix + 1];
-                b2 = (1 - tx)* extendMesh[(iy + 1)*(meshHMax + 3) + ix] +
-                     tx      * extendMesh[(iy + 1)*(meshHMax + 3) + ix + 1];
-
-                pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum] = ((1.0f - ty)*b1 + ty*b2);
-                pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum] =
-                    IQSettingUtils::MinFLOAT(IQSettingUtils::MaxFLOAT(pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum],
-                                             LSC34_MIN_MESH_VAL),
-                                             LSC34_MAX_MESH_VAL);
+                const FLOAT* pRow0 = extendMeshChannels[iy * extendStride + ix];
+                const FLOAT* pRow1 = extendMeshChannels[(iy + 1) * extendStride + ix];
+
+                for (UINT32 lane = 0; lane < LSC34_MESH_CHANNELS; lane++)
+                {
+                    FLOAT b1 = (1 - tx)* pRow0[lane] +
+                               tx      * pRow0[LSC34_MESH_CHANNELS + lane];
+                    FLOAT b2 = (1 - tx)* pRow1[lane] +
+                               tx      * pRow1[LSC34_MESH_CHANNELS + lane];
+
+                    result[lane] = ((1.0f - ty)*b1 + ty*b2);
+                }
             }
             else
             {
-                // for nonboundary points, use bicubic interpolation
-
-                // get x direction coeff and y direction coeff
-                BicubicF(tx, &cxm, &cx0, &cx1, &cx2);
-                BicubicF(ty, &cym, &cy0, &cy1, &cy2);
-
-                am = extendMesh[(iy - 1) * (meshHMax + 3) + (ix - 1)];
-                a0 = extendMesh[(iy - 1) * (meshHMax + 3) + (ix)];
-                a1 = extendMesh[(iy - 1) * (meshHMax + 3) + (ix + 1)];
-                a2 = extendMesh[(iy - 1) * (meshHMax + 3) + (ix + 2)];
-                bm = ((cxm * am) + (cx0 * a0) + (cx1 * a1) + (cx2 * a2)) * 10;
-
-                am = extendMesh[(iy) * (meshHMax + 3) + (ix - 1)];
-                a0 = extendMesh[(iy) * (meshHMax + 3) + (ix)];
-                a1 = extendMesh[(iy) * (meshHMax + 3) + (ix + 1)];
-                a2 = extendMesh[(iy) * (meshHMax + 3) + (ix + 2)];
-                b0 = ((cxm * am) + (cx0 * a0) + (cx1 * a1) + (cx2 * a2)) * 10;
-
-                am = extendMesh[(iy + 1) * (meshHMax + 3) + (ix - 1)];
-                a0 = extendMesh[(iy + 1) * (meshHMax + 3) + (ix)];
-                a1 = extendMesh[(iy + 1) * (meshHMax + 3) + (ix + 1)];
-                a2 = extendMesh[(iy + 1) * (meshHMax + 3) + (ix + 2)];
-                b1 = ((cxm * am) + (cx0 * a0) + (cx1 * a1) + (cx2 * a2)) * 10;
-
-                am = extendMesh[(iy + 2) * (meshHMax + 3) + (ix - 1)];
-                a0 = extendMesh[(iy + 2) * (meshHMax + 3) + (ix)];
-                a1 = extendMesh[(iy + 2) * (meshHMax + 3) + (ix + 1)];
-                a2 = extendMesh[(iy + 2) * (meshHMax + 3) + (ix + 2)];
-                b2 = ((cxm * am) + (cx0 * a0) + (cx1 * a1) + (cx2 * a2)) * 10;
-
-                pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum] =
-                    ((cym * bm) + (cy0 * b0) + (cy1 * b1) + (cy2 * b2)) * 0.025f;
-                pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum] =
-                    IQSettingUtils::MinFLOAT(IQSettingUtils::MaxFLOAT(pMeshOut[(vMeshNum * (*pMeshH + 1)) + hMeshNum],
-                                             LSC34_MIN_MESH_VAL),
+                // for nonboundary points, use bicubic interpolation over the 4x4 neighbourhood starting at (ix-1, iy-1)
+                const FLOAT  cxm   = cxTable[hMeshNum][0];
+                const FLOAT  cx0   = cxTable[hMeshNum][1];
+                const FLOAT  cx1   = cxTable[hMeshNum][2];
+                const FLOAT  cx2   = cxTable[hMeshNum][3];
+                const FLOAT* pRowm = extendMeshChannels[(iy - 1) * extendStride + (ix - 1)];
+                const FLOAT* pRow0 = extendMeshChannels[(iy) * extendStride + (ix - 1)];
+                const FLOAT* pRow1 = extendMeshChannels[(iy + 1) * extendStride + (ix - 1)];
+                const FLOAT* pRow2 = extendMeshChannels[(iy + 2) * extendStride + (ix - 1)];
+
+                for (UINT32 lane = 0; lane < LSC34_MESH_CHANNELS; lane++)
+                {
+                    FLOAT bm = ((cxm * pRowm[lane]) +
+                                (cx0 * pRowm[LSC34_MESH_CHANNELS + lane]) +
+                                (cx1 * pRowm[(2 * LSC34_MESH_CHANNELS) + lane]) +
+                                (cx2 * pRowm[(3 * LSC34_MESH_CHANNELS) + lane])) * 10;
+                    FLOAT b0 = ((cxm * pRow0[lane]) +
+                                (cx0 * pRow0[LSC34_MESH_CHANNELS + lane]) +
+                                (cx1 * pRow0[(2 * LSC34_MESH_CHANNELS) + lane]) +
+                                (cx2 * pRow0[(3 * LSC34_MESH_CHANNELS) + lane])) * 10;
+                    FLOAT b1 = ((cxm * pRow1[lane]) +
+                                (cx0 * pRow1[LSC34_MESH_CHANNELS + lane]) +
+                                (cx1 * pRow1[(2 * LSC34_MESH_CHANNELS) + lane]) +
+                                (cx2 * pRow1[(3 * LSC34_MESH_CHANNELS) + lane])) * 10;
+                    FLOAT b2 = ((cxm * pRow2[lane]) +
+                                (cx0 * pRow2[LSC34_MESH_CHANNELS + lane]) +
+                                (cx1 * pRow2[(2 * LSC34_MESH_CHANNELS) + lane]) +
+                                (cx2 * pRow2[(3 * LSC34_MESH_CHANNELS) + lane])) * 10;
+
+                    result[lane] = ((cym * bm) + (cy0 * b0) + (cy1 * b1) + (cy2 * b2)) * 0.025f;
+                }
+            }
+
+            for (UINT32 channel = 0; channel < numChannels; channel++)
+            {
+                ppMeshOut[channel][(vMeshNum * (*pMeshH + 1)) + hMeshNum] =
+                    IQSettingUtils::MinFLOAT(IQSettingUtils::MaxFLOAT(result[channel], LSC34_MIN_MESH_VAL),
                                              LSC34_MAX_MESH_VAL);
             }
         }
@@ -622,57 +689,29 @@ VOID LSC34Setting::scaleRolloffTable(
 
     /// @todo (CAMX-1812) sensorstreamwidth/height = raw width/height?
 
-    MeshRolloffScaleRolloff(pData->r_gain_tab.r_gain,
-                            rGain,
-                            fullResWidth,
-                            fullResHeight,
-                            streamInWidth,
-                            streamInHeight,
-                            pInput->offsetX,
-                            pInput->offsetY,
-                            pInput->scalingFactor,
-                            pInput->scalingFactor,
-                            &s_meshHorizontal,
-                            &s_meshVertical);
-
-    MeshRolloffScaleRolloff(pData->gr_gain_tab.gr_gain,
-                            grGain,
-                            fullResWidth,
-                            fullResHeight,
-                            streamInWidth,
-                            streamInHeight,
-                            pInput->offsetX,
-                            pInput->offsetY,
-                            pInput->scalingFactor,
-                            pInput->scalingFactor,
-                            &s_meshHorizontal,
-                            &s_meshVertical);
-
-    MeshRolloffScaleRolloff(pData->gb_gain_tab.gb_gain,
-                            gbGain,
-                            fullResWidth,
-                            fullResHeight,
-                            streamInWidth,
-                            streamInHeight,
-                            pInput->offsetX,
-                            pInput->offsetY,
-                            pInput->scalingFactor,
-                            pInput->scalingFactor,
-                            &s_meshHorizontal,
-                            &s_meshVertical);
-
-    MeshRolloffScaleRolloff(pData->b_gain_tab.b_gain,
-                            bGain,
-                            fullResWidth,
-                            fullResHeight,
-                            streamInWidth,
-                            streamInHeight,
-                            pInput->offsetX,
-                            pInput->offsetY,
-                            pInput->scalingFactor,
-                            pInput->scalingFactor,
-                            &s_meshHorizontal,
-                            &s_meshVertical);
+    // The four Bayer channels share the output geometry, resample them in one pass
+    const FLOAT* ppMeshIn[LSC34_MESH_CHANNELS]  =
+    {
+        pData->r_gain_tab.r_gain,
+        pData->gr_gain_tab.gr_gain,
+        pData->gb_gain_tab.gb_gain,
+        pData->b_gain_tab.b_gain
+    };
+    FLOAT*       ppMeshOut[LSC34_MESH_CHANNELS] = { rGain, grGain, gbGain, bGain };
+
+    MeshRolloffScaleRolloffChannels(ppMeshIn,
+                                    ppMeshOut,
+                                    LSC34_MESH_CHANNELS,
+                                    fullResWidth,
+                                    fullResHeight,
+                                    streamInWidth,
+                                    streamInHeight,
+                                    pInput->offsetX,
+                                    pInput->offsetY,
+                                    pInput->scalingFactor,
+                                    pInput->scalingFactor,
+                                    &s_meshHorizontal,
+                                    &s_meshVertical);
 
     memcpy(pData->r_gain_tab.r_gain, rGain, sizeof(FLOAT)* MESH_ROLLOFF_SIZE);
     memcpy(pData->gr_gain_tab.gr_gain, grGain, sizeof(FLOAT) * MESH_ROLLOFF_SIZE);
@@ -61,6 +61,7 @@ static const UINT32 LSC34_MIN_E_INIT                    = 0;
 static const UINT32 LSC34_MAX_E_INIT                    = IQSettingUtils::MAXUINTBITFIELD(20);
 static const FLOAT  LSC34_MIN_MESH_VAL                  = 1.0f;
 static const FLOAT  LSC34_MAX_MESH_VAL                  = 7.999f;
+static const UINT32 LSC34_MESH_CHANNELS                 = 4;     // R, Gr, Gb and B rolloff meshes
 
 /// @brief LSC34 module unpacked data
 // NOWHINE NC004c: Share code with system team
@@ -258,6 +259,44 @@ public:
         INT*         pMeshH,
         INT*         pMeshV);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// MeshRolloffScaleRolloffChannels
+    ///
+    /// @brief  Resample up to LSC34_MESH_CHANNELS rolloff tables with the same geometry in one pass. The grid and the per
+    ///         column and per row interpolation weights are computed once, and the channels are interleaved so the inner
+    ///         loop works on all of them at once. The output matches MeshRolloffScaleRolloff run on each channel.
+    ///
+    /// @param  ppMeshIn     input ideal Rolloff tables (13x17) at the full sensor, one per channel
+    /// @param  ppMeshOut    output rolloff tables (13x17) at the current output resolution, one per channel
+    /// @param  numChannels  number of tables, 1 to LSC34_MESH_CHANNELS
+    /// @param  fullWidth    full-resolution width
+    /// @param  fullHeight   full-resolution height
+    /// @param  outputWidth  output width
+    /// @param  outputHeight output height
+    /// @param  offsetX      x-index of the top-left corner of output image on the full-resolution sensor
+    /// @param  offsetY      y-index of the top-left corner of output image on the full-resolution sensor
+    /// @param  scaleX       sensor scaling factor in X direction (=binning_factor * digal_sampling_factor)
+    /// @param  scaleY       sensor scaling factor in Y direction (=binning_factor * digal_sampling_factor)
+    /// @param  pMeshH       pMeshH Horizontal Mesh
+    /// @param  pMeshV       pMeshV Vertical Mesh
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID MeshRolloffScaleRolloffChannels(
+        const FLOAT* const* ppMeshIn,
+        FLOAT* const*       ppMeshOut,
+        UINT32              numChannels,
+        INT                 fullWidth,
+        INT                 fullHeight,
+        INT                 outputWidth,
+        INT                 outputHeight,
+        INT                 offsetX,
+        INT                 offsetY,
+        INT                 scaleX,
+        INT                 scaleY,
+        INT*                pMeshH,
+        INT*                pMeshV);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// scaleRolloffTable
     ///
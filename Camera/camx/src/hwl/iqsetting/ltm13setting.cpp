@@ -827,7 +827,12 @@ BOOL LTM13Setting::CalculateHWSetting(
                                                   LTM_SCALE_Q);
             }
 
-            GenerateAdrcLtmCurves(inverseGammaIn, tmcOutLtmGainCurve, pInput->gammaOutput, tmcOutLtmScale, tmcOutLtmCurve);
+            GetAdrcLtmCurves(pInput->pAdrcCurveCache,
+                             inverseGammaIn,
+                             tmcOutLtmGainCurve,
+                             pInput->gammaOutput,
+                             tmcOutLtmScale,
+                             tmcOutLtmCurve);
 
             FLOAT ltmCurveScaleRatio = 1.0f;
 
@@ -1012,3 +1017,56 @@ void LTM13Setting::GenerateAdrcLtmCurves(
 
     return;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// LTM13Setting::GetAdrcLtmCurves
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LTM13Setting::GetAdrcLtmCurves(
+    LTM13AdrcCurveCache* pCache,
+    FLOAT*               pInEqvlnt,
+    FLOAT*               pGain,
+    FLOAT*               pGamma,
+    FLOAT*               pLtmScale,
+    FLOAT*               pLtmCurve)
+{
+    const SIZE_T curveSize = sizeof(FLOAT) * (LTM_LUT_SIZE + 1);
+    BOOL         reuse     = FALSE;
+
+    // The inverse gamma and gamma only change with the gamma tuning, so they have to match exactly. ADRC moves the gain
+    // curve a little on every request, so it is allowed to move up to the tolerance.
+    if ((NULL != pCache)        &&
+        (TRUE == pCache->valid) &&
+        (0 == IQSettingUtils::Memcmp(pCache->inEqvlnt, pInEqvlnt, curveSize)) &&
+        (0 == IQSettingUtils::Memcmp(pCache->gamma, pGamma, curveSize)))
+    {
+        reuse = TRUE;
+
+        for (INT i = 0; (TRUE == reuse) && (i < LTM_LUT_SIZE + 1); i++)
+        {
+            reuse = (IQSettingUtils::AbsoluteFLOAT(pGain[i] - pCache->gain[i]) <=
+                     (pCache->tolerance * IQSettingUtils::AbsoluteFLOAT(pCache->gain[i])));
+        }
+    }
+
+    if (TRUE == reuse)
+    {
+        IQSettingUtils::Memcpy(pLtmScale, pCache->ltmScale, curveSize);
+        IQSettingUtils::Memcpy(pLtmCurve, pCache->ltmCurve, curveSize);
+        pCache->reuseCount++;
+    }
+    else
+    {
+        GenerateAdrcLtmCurves(pInEqvlnt, pGain, pGamma, pLtmScale, pLtmCurve);
+
+        if (NULL != pCache)
+        {
+            IQSettingUtils::Memcpy(pCache->inEqvlnt, pInEqvlnt, curveSize);
+            IQSettingUtils::Memcpy(pCache->gamma, pGamma, curveSize);
+            IQSettingUtils::Memcpy(pCache->gain, pGain, curveSize);
+            IQSettingUtils::Memcpy(pCache->ltmScale, pLtmScale, curveSize);
+            IQSettingUtils::Memcpy(pCache->ltmCurve, pLtmCurve, curveSize);
+            pCache->valid = TRUE;
+            pCache->generateCount++;
+        }
+    }
+}
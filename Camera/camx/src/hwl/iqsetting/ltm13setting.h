@@ -216,6 +216,24 @@ struct LTM13UnpackedField
     LtmGridStruct10b_V13     avg3d[DMIRAM_LTM_AVG3D_LENGTH_V13];          ///< DMI ping-pong buffer of 3D bilateral averages
 };
 
+/// @brief ADRC LTM curves generated for an earlier request. They are reused while the request inputs stay within tolerance
+///        of the inputs they were generated from; the comparison is against those inputs, not the previous request, so a
+///        slow drift cannot accumulate past the tolerance.
+// NOWHINE NC004c: Share code with system team
+struct LTM13AdrcCurveCache
+{
+    BOOL   valid;                      ///< TRUE once curves have been generated
+    FLOAT  tolerance;                  ///< Largest relative change of any ADRC gain curve sample that reuses the curves,
+                                       ///  0 to reuse them only for an identical gain curve
+    FLOAT  inEqvlnt[LTM_LUT_SIZE + 1]; ///< Inverse gamma equivalent the curves were generated from
+    FLOAT  gamma[LTM_LUT_SIZE + 1];    ///< Gamma the curves were generated from
+    FLOAT  gain[LTM_LUT_SIZE + 1];     ///< ADRC gain curve the curves were generated from
+    FLOAT  ltmScale[LTM_LUT_SIZE + 1]; ///< Generated LTM scale
+    FLOAT  ltmCurve[LTM_LUT_SIZE + 1]; ///< Generated LTM curve
+    UINT32 generateCount;              ///< Requests that generated the curves
+    UINT32 reuseCount;                 ///< Requests that reused them
+};
+
 enum LTMDarkBrightRegionState
 {
     LTMRegionIndexInit = 0,  ///< Region Index Init
@@ -300,6 +318,29 @@ public:
         FLOAT*        pGamma,
         FLOAT*        pLtmScale,
         FLOAT*        pLtmCurve);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetAdrcLtmCurves
+    ///
+    /// @brief  Reuse the cached ADRC LTM curves if the inputs are within the cache tolerance, otherwise generate the curves
+    ///         and cache them
+    ///
+    /// @param  pCache      ADRC LTM curve cache, NULL to always generate
+    /// @param  pInEqvlnt   Pointer to inverse gamma equivalent
+    /// @param  pGain       Pointer to ADRC gain curve
+    /// @param  pGamma      Pointer to Gamma module
+    /// @param  pLtmScale   Pointer to LTM Scale
+    /// @param  pLtmCurve   Pointer to LTM Curve
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID GetAdrcLtmCurves(
+        LTM13AdrcCurveCache* pCache,
+        FLOAT*               pInEqvlnt,
+        FLOAT*               pGain,
+        FLOAT*               pGamma,
+        FLOAT*               pLtmScale,
+        FLOAT*               pLtmCurve);
 };
 
 #endif // LTM13SETTING_H
@@ -45,7 +45,17 @@ BOOL Upscale20Setting::CalculateHWSetting(
         result = SetUpscaleSwRegistry(pInput, pReserveData, pUnpackedField);
         if (TRUE == result)
         {
-            result = SetUpscaleHwRegistry(pUnpackedField);
+            // The hardware configuration, including the coefficient LUTs, only depends on the software parameters, so a
+            // request that repeats an earlier set of parameters is a copy
+            if (FALSE == GetCachedConfig(pInput->pConfigCache, pUnpackedField))
+            {
+                result = SetUpscaleHwRegistry(pUnpackedField);
+
+                if (TRUE == result)
+                {
+                    AddCachedConfig(pInput->pConfigCache, pUnpackedField);
+                }
+            }
         }
     }
 
@@ -57,6 +67,107 @@ BOOL Upscale20Setting::CalculateHWSetting(
     return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Upscale20Setting::IsSameSwConfig
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL Upscale20Setting::IsSameSwConfig(
+    const UpscaleSwConfig* pConfig1,
+    const UpscaleSwConfig* pConfig2)
+{
+    BOOL isSame = ((pConfig1->scaleEnable            == pConfig2->scaleEnable)            &&
+                   (pConfig1->detailEnhanceEnable    == pConfig2->detailEnhanceEnable)    &&
+                   (pConfig1->detailEnhanceClipShift == pConfig2->detailEnhanceClipShift) &&
+                   (pConfig1->chromaSite             == pConfig2->chromaSite)             &&
+                   (pConfig1->comp0FilterMethod      == pConfig2->comp0FilterMethod)      &&
+                   (pConfig1->comp1and2FilterMethod  == pConfig2->comp1and2FilterMethod)  &&
+                   (pConfig1->outWidth               == pConfig2->outWidth)               &&
+                   (pConfig1->outHeight              == pConfig2->outHeight)              &&
+                   (pConfig1->bitPrecisionIn         == pConfig2->bitPrecisionIn)         &&
+                   (pConfig1->bitPrecisionOut        == pConfig2->bitPrecisionOut)        &&
+                   (pConfig1->blendFilter            == pConfig2->blendFilter)            &&
+                   (pConfig1->sharpeningStrength1    == pConfig2->sharpeningStrength1)    &&
+                   (pConfig1->sharpeningStrength2    == pConfig2->sharpeningStrength2)    &&
+                   (pConfig1->quietZoneThreshold     == pConfig2->quietZoneThreshold)     &&
+                   (pConfig1->curveRange             == pConfig2->curveRange)             &&
+                   (pConfig1->detailEnhanceCurveT1   == pConfig2->detailEnhanceCurveT1)   &&
+                   (pConfig1->detailEnhanceCurveT2   == pConfig2->detailEnhanceCurveT2)   &&
+                   (pConfig1->detailEnhanceLimiter   == pConfig2->detailEnhanceLimiter));
+
+    for (UINT i = 0; (TRUE == isSame) && (i < MaxYuvChannels); i++)
+    {
+        isSame = ((pConfig1->compROIInWidth[i]  == pConfig2->compROIInWidth[i]) &&
+                  (pConfig1->compROIInHeight[i] == pConfig2->compROIInHeight[i]));
+    }
+
+    return isSame;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Upscale20Setting::GetCachedConfig
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL Upscale20Setting::GetCachedConfig(
+    Upscale20ConfigCache*   pCache,
+    Upscale20UnpackedField* pUnpackedField)
+{
+    BOOL found = FALSE;
+
+    if (NULL != pCache)
+    {
+        pCache->lookupCount++;
+
+        for (UINT i = 0; i < Upscale20ConfigCacheSize; i++)
+        {
+            Upscale20ConfigCacheEntry* pEntry = &pCache->entries[i];
+
+            if ((TRUE == pEntry->valid) &&
+                (pEntry->config.enable == pUnpackedField->enable) &&
+                (TRUE == IsSameSwConfig(&pEntry->config.upscaleSwConfig, &pUnpackedField->upscaleSwConfig)))
+            {
+                *pUnpackedField = pEntry->config;
+                pEntry->lastUse = pCache->lookupCount;
+                pCache->hitCount++;
+                found           = TRUE;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Upscale20Setting::AddCachedConfig
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Upscale20Setting::AddCachedConfig(
+    Upscale20ConfigCache*         pCache,
+    const Upscale20UnpackedField* pUnpackedField)
+{
+    if (NULL != pCache)
+    {
+        Upscale20ConfigCacheEntry* pVictim = &pCache->entries[0];
+
+        for (UINT i = 0; i < Upscale20ConfigCacheSize; i++)
+        {
+            Upscale20ConfigCacheEntry* pEntry = &pCache->entries[i];
+
+            if (FALSE == pEntry->valid)
+            {
+                pVictim = pEntry;
+                break;
+            }
+
+            if (pEntry->lastUse < pVictim->lastUse)
+            {
+                pVictim = pEntry;
+            }
+        }
+
+        pVictim->config  = *pUnpackedField;
+        pVictim->lastUse = pCache->lookupCount;
+        pVictim->valid   = TRUE;
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// Upscale20Setting::CalculateChromaUpHWSetting
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -232,6 +232,26 @@ struct Upscale20UnpackedField
     qseed3Status      status;          ///< status of QSeed3 calculation
 };
 
+static const UINT32 Upscale20ConfigCacheSize = 8;
+
+/// @brief One calculated Upscale20 configuration
+// NOWHINE NC004c: Share code with system team
+struct Upscale20ConfigCacheEntry
+{
+    BOOL                   valid;   ///< Entry holds a configuration
+    UINT32                 lastUse; ///< Lookup count at the last use, the least recently used entry is replaced
+    Upscale20UnpackedField config;  ///< Calculated register data, upscaleSwConfig is the key
+};
+
+/// @brief Least recently used cache of calculated Upscale20 configurations, owned by the caller of CalculateHWSetting
+// NOWHINE NC004c: Share code with system team
+struct Upscale20ConfigCache
+{
+    UINT32                    lookupCount;                        ///< Lookups since creation
+    UINT32                    hitCount;                           ///< Lookups that found a configuration
+    Upscale20ConfigCacheEntry entries[Upscale20ConfigCacheSize];  ///< Cached configurations
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @brief Class that implements Upscale20 module IQ settings calculation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -274,6 +294,48 @@ public:
         ChromaUp20UnpackedField*  pRegCmd);
 
 private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsSameSwConfig
+    ///
+    /// @brief  Compare the software parameters the hardware configuration is derived from
+    ///
+    /// @param  pConfig1 First software configuration
+    /// @param  pConfig2 Second software configuration
+    ///
+    /// @return TRUE if every parameter matches
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static BOOL IsSameSwConfig(
+        const UpscaleSwConfig* pConfig1,
+        const UpscaleSwConfig* pConfig2);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetCachedConfig
+    ///
+    /// @brief  Copy a previously calculated configuration with the same software parameters into the unpacked data
+    ///
+    /// @param  pCache         Configuration cache, may be NULL
+    /// @param  pUnpackedField Input|Output: unpacked data with upscaleSwConfig filled in
+    ///
+    /// @return TRUE if the configuration was found
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static BOOL GetCachedConfig(
+        Upscale20ConfigCache*   pCache,
+        Upscale20UnpackedField* pUnpackedField);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AddCachedConfig
+    ///
+    /// @brief  Store a calculated configuration, replacing the least recently used one when the cache is full
+    ///
+    /// @param  pCache         Configuration cache, may be NULL
+    /// @param  pUnpackedField Calculated unpacked data
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID AddCachedConfig(
+        Upscale20ConfigCache*         pCache,
+        const Upscale20UnpackedField* pUnpackedField);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// ChromaUpsampleSW
     ///
@@ -9,6 +9,7 @@
 /// @brief IPELTM class implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 #include "camxdefs.h"
+#include "camxhwenvironment.h"
 #include "camxipeltm13.h"
 #include "camxiqinterface.h"
 #include "camxispiqmodule.h"
@@ -103,9 +104,11 @@ CamxResult IPELTM13::Initialize()
     m_offsetLUTCmdBuffer[LTMIndexRGamma4]     =
         IPELTMLUTNumEntries[LTMIndexRGamma3] * sizeof(UINT32) + m_offsetLUTCmdBuffer[LTMIndexRGamma3];
 
-    m_dependenceData.pGammaPrev  = m_gammaPrev;
-    m_dependenceData.pIGammaPrev = m_igammaPrev;
-    m_pLUTCmdBufferManager       = NULL;
+    m_dependenceData.pGammaPrev      = m_gammaPrev;
+    m_dependenceData.pIGammaPrev     = m_igammaPrev;
+    m_dependenceData.pAdrcCurveCache = &m_adrcCurveCache;
+    m_adrcCurveCache.tolerance       = HwEnvironment::GetInstance()->GetStaticSettings()->ltmAdrcCurveTolerance;
+    m_pLUTCmdBufferManager           = NULL;
 
     result = AllocateCommonLibraryData();
     if (result != CamxResultSuccess)
@@ -831,6 +834,10 @@ IPELTM13::IPELTM13(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 IPELTM13::~IPELTM13()
 {
+    CAMX_LOG_VERBOSE(CamxLogGroupPProc, "ADRC LTM curves generated %u times, reused %u times",
+                     m_adrcCurveCache.generateCount,
+                     m_adrcCurveCache.reuseCount);
+
     CAMX_FREE(m_pADRCData);
 
     if (NULL != m_pLUTCmdBufferManager)
@@ -346,6 +346,7 @@ private:
     BOOL                 m_useHardcodedGamma;               ///< TRUE to use hardcode Gamma; FALSE to use published Gamma
     INT32                m_gammaPrev[LTM_GAMMA_LUT_SIZE];   ///< Cached version of the InverseGamma() input array gamma
     INT32                m_igammaPrev[LTM_GAMMA_LUT_SIZE];  ///< Cached version of the InverseGamma() output array igamma
+    LTM13AdrcCurveCache  m_adrcCurveCache;                  ///< ADRC LTM curves reused across requests
 
     UINT32*              m_pLTMLUTs;                        ///< Tuning LTM LUTs place holder
     ltm_1_3_0::chromatix_ltm13Type* m_pChromatix;           ///< Pointers to tuning mode data
@@ -16,6 +16,7 @@
 #include "camxtuningdatamanager.h"
 #include "ipe_data.h"
 #include "parametertuningtypes.h"
+#include "upscale20setting.h"
 
 CAMX_NAMESPACE_BEGIN
 
@@ -168,6 +169,12 @@ CamxResult IPEUpscaler20::AllocateCommonLibraryData()
         }
     }
 
+    if ((CamxResultSuccess == result) && (NULL == m_dependenceData.pConfigCache))
+    {
+        // Not fatal, without the cache every change recalculates the configuration
+        m_dependenceData.pConfigCache = static_cast<Upscale20ConfigCache*>(CAMX_CALLOC(sizeof(Upscale20ConfigCache)));
+    }
+
     return result;
 }
 
@@ -561,6 +568,16 @@ VOID IPEUpscaler20::DeallocateCommonLibraryData()
         CAMX_FREE(m_dependenceData.pInterpolationData);
         m_dependenceData.pInterpolationData = NULL;
     }
+
+    if (NULL != m_dependenceData.pConfigCache)
+    {
+        CAMX_LOG_VERBOSE(CamxLogGroupPProc, "Upscale20 configuration cache: %u hits in %u lookups",
+                         m_dependenceData.pConfigCache->hitCount,
+                         m_dependenceData.pConfigCache->lookupCount);
+
+        CAMX_FREE(m_dependenceData.pConfigCache);
+        m_dependenceData.pConfigCache = NULL;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,6 +76,46 @@ static const UINT32 sLRMEPublishList[] =
     PropertyIDLRMEFrameSettings,
 };
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// GetTransformCornerMotion
+///
+/// @brief  Get the largest displacement of the frame corners under a perspective transform
+///
+/// @param  pTransform  Transform published by RANSAC
+///
+/// @return Displacement in pixels of the resolution the transform is defined on
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static FLOAT GetTransformCornerMotion(
+    const IPEICAPerspectiveTransform* pTransform)
+{
+    const FLOAT* pM           = &pTransform->perspectiveTransformArray[0];
+    const FLOAT  width        = static_cast<FLOAT>(pTransform->transformDefinedOnWidth);
+    const FLOAT  height       = static_cast<FLOAT>(pTransform->transformDefinedOnHeight);
+    const FLOAT  corner[4][2] = { { 0.0f, 0.0f }, { width, 0.0f }, { 0.0f, height }, { width, height } };
+    FLOAT        motion       = 0.0f;
+
+    for (UINT i = 0; i < 4; i++)
+    {
+        FLOAT x = corner[i][0];
+        FLOAT y = corner[i][1];
+        FLOAT w = (pM[6] * x) + (pM[7] * y) + pM[8];
+
+        if (0.0f == w)
+        {
+            // Degenerate transform, report it as motion so that the schedule does not skip on it
+            motion = width + height;
+            break;
+        }
+
+        FLOAT dx = static_cast<FLOAT>(Utils::AbsoluteFLOAT((((pM[0] * x) + (pM[1] * y) + pM[2]) / w) - x));
+        FLOAT dy = static_cast<FLOAT>(Utils::AbsoluteFLOAT((((pM[3] * x) + (pM[4] * y) + pM[5]) / w) - y));
+
+        motion = Utils::MaxFLOAT(motion, Utils::MaxFLOAT(dx, dy));
+    }
+
+    return motion;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// LRMENode::LRMENode
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -87,6 +127,12 @@ LRMENode::LRMENode()
     m_state               = LRME_NODE_CREATED;
     m_hDevice             = -1;
     m_resetReferenceInput = FALSE;
+
+    m_adaptiveScheduleEnabled = FALSE;
+    m_adaptiveSkipInterval    = 1;
+    m_lastProcessedRequestId  = 0;
+    m_adaptiveProcessedCount  = 0;
+    m_adaptiveSkippedCount    = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -116,6 +162,16 @@ LRMENode* LRMENode::Create(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 VOID LRMENode::Cleanup()
 {
+    UINT64 numRequests = m_adaptiveProcessedCount + m_adaptiveSkippedCount;
+
+    if ((TRUE == m_adaptiveScheduleEnabled) && (0 < numRequests))
+    {
+        CAMX_LOG_INFO(CamxLogGroupLRME, "Adaptive schedule processed %llu of %llu requests, duty cycle %llu%%",
+                      m_adaptiveProcessedCount, numRequests, (m_adaptiveProcessedCount * 100) / numRequests);
+        m_adaptiveProcessedCount = 0;
+        m_adaptiveSkippedCount   = 0;
+    }
+
     m_state = LRME_NODE_CREATED;
     ReleaseDevice();
     return;
@@ -1031,7 +1087,14 @@ CamxResult LRMENode::ExecuteProcessRequest(
         }
         if (TRUE == IsSkipRequest())
         {
-            result = SkipandSignalLRMEfences(pNodeRequestData, pPerRequestPorts, requestId, isRefValid);
+            result = SkipandSignalLRMEfences(pNodeRequestData, pPerRequestPorts, requestId, isRefValid, FALSE);
+            return result;
+        }
+        if ((TRUE == m_adaptiveScheduleEnabled) &&
+            (1    == numBatchedFrames)          &&
+            (TRUE == IsAdaptiveSkipRequest(requestId)))
+        {
+            result = SkipandSignalLRMEfences(pNodeRequestData, pPerRequestPorts, requestId, isRefValid, TRUE);
             return result;
         }
         // If 1st request and only 1 o/p then there is no ref buffer, just signal the o/p fence in this case.
@@ -1043,7 +1106,7 @@ CamxResult LRMENode::ExecuteProcessRequest(
         {
             if (FirstValidRequestId == requestIdOffsetFromLastFlush)
             {
-                result = SkipandSignalLRMEfences(pNodeRequestData, pPerRequestPorts, requestId, isRefValid);
+                result = SkipandSignalLRMEfences(pNodeRequestData, pPerRequestPorts, requestId, isRefValid, FALSE);
             }
             else
             {
@@ -1294,7 +1357,7 @@ CamxResult LRMENode::ExecuteProcessRequest(
                     }
                     if (CamxResultSuccess == result)
                     {
-                        result = LRMEPostFrameSettings(isRefValid);
+                        result = LRMEPostFrameSettings(isRefValid, FALSE);
                     }
                     if (CamxResultSuccess == result)
                     {
@@ -1337,7 +1400,8 @@ BOOL LRMENode::IsNodeDisabledWithOverride()
 /// LRMENode::LRMEPostFrameSettings
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CamxResult LRMENode::LRMEPostFrameSettings(
-    INT refValid)
+    INT  refValid,
+    BOOL isAdaptiveSkip)
 {
     CAMX_LOG_INFO(CamxLogGroupPProc, "Post frame settings with refValid  = %d", refValid);
 
@@ -1375,6 +1439,7 @@ CamxResult LRMENode::LRMEPostFrameSettings(
     frameSettings.fullHeight               = m_fullInputHeight;
     frameSettings.fullWidth                = m_fullInputWidth;
     frameSettings.alternateSkipProcessing  = m_alternateSkipProcessing;
+    frameSettings.adaptiveSkip             = isAdaptiveSkip;
 
     switch (m_selectedTARPort)
     {
@@ -1483,6 +1548,19 @@ CamxResult LRMENode::PostPipelineCreate()
         m_numPacketBuffer            = GetPipeline()->GetRequestQueueDepth();
         m_alternateSkipProcessing    = IsSkipAlternateLRMEProcessing();
 
+        // The adaptive schedule needs a reference that is written on every request, which LRME's own DS2 output is not
+        if ((TRUE                    == GetStaticSettings()->enableAdaptiveLRMESchedule) &&
+            (FALSE                   == m_alternateSkipProcessing)                       &&
+            (LRMEInputPortREFLRMEDS2 != m_selectedREFPort))
+        {
+            m_adaptiveScheduleEnabled =
+                (CamxResultSuccess == VendorTagManager::QueryVendorTagLocation("org.quic.camera2.ipeicaconfigs",
+                                                                               "ICAReferenceParams",
+                                                                               &m_ICAReferenceParamsTag)) ? TRUE : FALSE;
+        }
+        CAMX_LOG_INFO(CamxLogGroupLRME, "Alternate skip %d, adaptive schedule %d",
+                      m_alternateSkipProcessing, m_adaptiveScheduleEnabled);
+
         if (CamxResultSuccess == result)
         {
             // Command buffer for request packet
@@ -1855,6 +1933,68 @@ BOOL LRMENode::IsSkipAlternateLRMEProcessing()
     return isLRMEUsageLimited;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// LRMENode::IsAdaptiveSkipRequest
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL LRMENode::IsAdaptiveSkipRequest(
+    UINT64 requestId)
+{
+    const StaticSettings* pSettings   = GetStaticSettings();
+    BOOL                  skipRequest = FALSE;
+
+    if ((FirstValidRequestId == GetRequestIdOffsetFromLastFlush(requestId)) ||
+        (TRUE                == m_resetReferenceInput)                      ||
+        (requestId           <= m_lastProcessedRequestId))
+    {
+        // Start again from every request after a flush or a reference failure
+        m_adaptiveSkipInterval = 1;
+    }
+    else
+    {
+        // RANSAC may not have published the previous request yet, the schedule then stays as it is
+        UINT   ransacTags[]  = { m_ICAReferenceParamsTag };
+        VOID*  pData[1]      = { NULL };
+        UINT64 dataOffset[1] = { 1 };
+
+        GetDataList(ransacTags, pData, dataOffset, 1);
+
+        if (NULL != pData[0])
+        {
+            const IPEICAPerspectiveTransform* pTransform = static_cast<IPEICAPerspectiveTransform*>(pData[0]);
+            FLOAT                             motion     = GetTransformCornerMotion(pTransform);
+
+            if ((motion                           >  pSettings->adaptiveLRMEMotionThreshold) ||
+                (pTransform->perspectiveConfidence < pSettings->adaptiveLRMEConfidenceThreshold))
+            {
+                m_adaptiveSkipInterval = 1;
+            }
+            else if (((requestId - 1) == m_lastProcessedRequestId) &&
+                     (m_adaptiveSkipInterval <= pSettings->adaptiveLRMEMaxSkip))
+            {
+                // Only a transform measured on the previous request grows the interval, not one repeated by RANSAC
+                m_adaptiveSkipInterval++;
+            }
+
+            CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Req[%llu] motion %f confidence %u interval %u",
+                             requestId, motion, pTransform->perspectiveConfidence, m_adaptiveSkipInterval);
+        }
+
+        skipRequest = ((requestId - m_lastProcessedRequestId) < m_adaptiveSkipInterval) ? TRUE : FALSE;
+    }
+
+    if (TRUE == skipRequest)
+    {
+        m_adaptiveSkippedCount++;
+    }
+    else
+    {
+        m_lastProcessedRequestId = requestId;
+        m_adaptiveProcessedCount++;
+    }
+
+    return skipRequest;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// LRMENode::SkipandSignalLRMEfences
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1862,7 +2002,8 @@ BOOL LRMENode::SkipandSignalLRMEfences(
     NodeProcessRequestData*    pNodeRequestData,
     PerRequestActivePorts*     pPerRequestPorts,
     UINT64                     requestId,
-    INT                        isRefValid)
+    INT                        isRefValid,
+    BOOL                       isAdaptiveSkip)
 {
     CamxResult                 result                             = CamxResultSuccess;
     pNodeRequestData->numDependencyLists = 0;
@@ -1881,7 +2022,7 @@ BOOL LRMENode::SkipandSignalLRMEfences(
             FillImageResolution(portId, pFormat);
         }
     }
-    result = LRMEPostFrameSettings(isRefValid);
+    result = LRMEPostFrameSettings(isRefValid, isAdaptiveSkip);
     if (CamxResultSuccess == result)
     {
         for (UINT portIndex = 0; portIndex < pPerRequestPorts->numOutputPorts; portIndex++)
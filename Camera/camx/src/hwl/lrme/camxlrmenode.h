@@ -399,12 +399,14 @@ private:
     ///
     /// @brief     Posts LRME meta data to be used by ransac
     ///
-    /// @param     isRefValid If ref post valid or not
+    /// @param     isRefValid      If ref post valid or not
+    /// @param     isAdaptiveSkip  If the request is skipped on the adaptive schedule
     ///
     /// @return    CamxResultSuccess on success else error code
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     CamxResult LRMEPostFrameSettings(
-        INT isRefValid);
+        INT  isRefValid,
+        BOOL isAdaptiveSkip);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// QueryMetadataPublishList
@@ -577,6 +579,21 @@ private:
         return isSkipReq;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsAdaptiveSkipRequest
+    ///
+    /// @brief   Update the adaptive schedule from the transform RANSAC published for the previous request and check if the
+    ///          request is to be skipped. The interval between processed requests grows by one for every processed request
+    ///          of a static scene, up to adaptiveLRMEMaxSkip skipped requests, and goes back to every request on motion or
+    ///          low confidence.
+    ///
+    /// @param   requestId  Request to process
+    ///
+    /// @return  TRUE if the request is to be skipped
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    BOOL IsAdaptiveSkipRequest(
+        UINT64 requestId);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// SkipandSignalLRMEfences
     ///
@@ -586,6 +603,7 @@ private:
     /// @param   pPerRequestPorts  Pointer to struct PerRequestActivePorts that belongs to this node
     /// @param   requestId         Request to process
     /// @param   isRefValid        If ref post valid or not
+    /// @param   isAdaptiveSkip    If the request is skipped on the adaptive schedule
     ///
     /// @return  CamxResultSuccess on success else error code
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -593,7 +611,8 @@ private:
         NodeProcessRequestData*    pNodeRequestData,
         PerRequestActivePorts*     pPerRequestPorts,
         UINT64                     requestId,
-        INT                        isRefValid);
+        INT                        isRefValid,
+        BOOL                       isAdaptiveSkip);
 
     UINT                  m_numInputPorts;                             ///< Number of input ports used by LRME
     UINT                  m_numOutputPorts;                            ///< Number of output ports used by LRME
@@ -618,6 +637,12 @@ private:
     INT32                 m_fullInputWidth;                            ///< Width of full input path
     INT32                 m_fullInputHeight;                           ///< Height of full input path
     BOOL                  m_alternateSkipProcessing;                   ///< Flag to skip the LRME Processing
+    BOOL                  m_adaptiveScheduleEnabled;                   ///< Requests are skipped on the adaptive schedule
+    UINT32                m_ICAReferenceParamsTag;                     ///< Tag of the transform published by RANSAC
+    UINT                  m_adaptiveSkipInterval;                      ///< Requests between processed requests
+    UINT64                m_lastProcessedRequestId;                    ///< Last request processed on the adaptive schedule
+    UINT64                m_adaptiveProcessedCount;                    ///< Requests processed on the adaptive schedule
+    UINT64                m_adaptiveSkippedCount;                      ///< Requests skipped on the adaptive schedule
 };
 
 CAMX_NAMESPACE_END
@@ -14,20 +14,22 @@ SUPPORT_FUNCTION_CALL_TRACE := 1
 # Get definitions common to the CAMX project here
 include $(CAMX_PATH)/build/infrastructure/android/common.mk
 
-LOCAL_SRC_FILES :=                  \
-    camxtitan17xcontext.cpp         \
-    camxtitan17xfactory.cpp         \
-    camxtitan17xhwl.cpp             \
-    camxtitan17xsettingsmanager.cpp \
-    camxtitan17xstatsparser.cpp     \
+LOCAL_SRC_FILES :=                      \
+    camxtitan17xcontext.cpp             \
+    camxtitan17xfactory.cpp             \
+    camxtitan17xhwl.cpp                 \
+    camxtitan17xresourcevoteplanner.cpp \
+    camxtitan17xsettingsmanager.cpp     \
+    camxtitan17xstatsparser.cpp         \
     g_camxtitan17xsettings.cpp
 
-LOCAL_INC_FILES :=                  \
-    camxtitan17xcontext.h           \
-    camxtitan17xdefs.h              \
-    camxtitan17xfactory.h           \
-    camxtitan17xsettingsmanager.h   \
-    camxtitan17xstatsparser.h       \
+LOCAL_INC_FILES :=                      \
+    camxtitan17xcontext.h               \
+    camxtitan17xdefs.h                  \
+    camxtitan17xfactory.h               \
+    camxtitan17xresourcevoteplanner.h   \
+    camxtitan17xsettingsmanager.h       \
+    camxtitan17xstatsparser.h           \
     g_camxtitan17xsettings.h
 
 # Put here any libraries that should be linked by CAMX projects
@@ -0,0 +1,362 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxtitan17xresourcevoteplanner.cpp
+///
+/// @brief Titan17xResourceVotePlanner implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "camxdebugprint.h"
+#include "camxhwenvironment.h"
+#include "camxosutils.h"
+#include "camxtitan17xdefs.h"
+#include "camxtitan17xresourcevoteplanner.h"
+#include "camxtrace.h"
+#include "camxutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+/// @brief Device names for logs and trace counters
+static const CHAR* ResourceVoteDeviceNames[ResourceVoteNumDevices] = { "IFE", "IPE", "BPS" };
+
+/// @brief Divisors to trace the aggregates in MHz and MB/s, which fit the 32 bit trace counters
+static const UINT64 ResourceVoteTraceClockUnit     = 1000000;
+static const UINT64 ResourceVoteTraceBandwidthUnit = 1000000;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::GetInstance
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Titan17xResourceVotePlanner* Titan17xResourceVotePlanner::GetInstance()
+{
+    static Titan17xResourceVotePlanner s_resourceVotePlanner;
+
+    return &s_resourceVotePlanner;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::Titan17xResourceVotePlanner
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Titan17xResourceVotePlanner::Titan17xResourceVotePlanner()
+{
+    Utils::Memset(m_clients, 0, sizeof(m_clients));
+    Utils::Memset(m_aggregateClockHz, 0, sizeof(m_aggregateClockHz));
+    Utils::Memset(m_aggregateBandwidth, 0, sizeof(m_aggregateBandwidth));
+
+    m_pLock = Mutex::Create("ResourceVotePlanner");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::~Titan17xResourceVotePlanner
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Titan17xResourceVotePlanner::~Titan17xResourceVotePlanner()
+{
+    if (NULL != m_pLock)
+    {
+        m_pLock->Destroy();
+        m_pLock = NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::RegisterClient
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult Titan17xResourceVotePlanner::RegisterClient(
+    ResourceVoteDevice              device,
+    const ResourceVoteChannelType*  pChannelTypes,
+    UINT32                          numChannels,
+    const CHAR*                     pName,
+    UINT32*                         phClient)
+{
+    CamxResult result = CamxResultENoMore;
+
+    CAMX_ASSERT(NULL != phClient);
+    CAMX_ASSERT(NULL != pChannelTypes);
+    CAMX_ASSERT(device < ResourceVoteDevice::Max);
+
+    *phClient = ResourceVoteInvalidClient;
+
+    if ((NULL == m_pLock) || (0 == numChannels) || (ResourceVoteMaxChannels < numChannels))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupPower, "Cannot register %s with %u vote channels", pName, numChannels);
+        result = CamxResultEInvalidArg;
+    }
+    else
+    {
+        m_pLock->Lock();
+
+        for (UINT32 i = 0; i < ResourceVoteMaxClients; i++)
+        {
+            ResourceVoteClient* pClient = &m_clients[i];
+
+            if (FALSE == pClient->inUse)
+            {
+                Utils::Memset(pClient, 0, sizeof(ResourceVoteClient));
+                Utils::Memcpy(pClient->channelType, pChannelTypes, sizeof(ResourceVoteChannelType) * numChannels);
+                OsUtils::StrLCpy(pClient->name, pName, sizeof(pClient->name));
+
+                pClient->inUse       = TRUE;
+                pClient->device      = device;
+                pClient->numChannels = numChannels;
+
+                *phClient = i;
+                result    = CamxResultSuccess;
+                break;
+            }
+        }
+
+        m_pLock->Unlock();
+
+        if (CamxResultSuccess != result)
+        {
+            // Not fatal, the client votes its unplanned demand
+            CAMX_LOG_WARN(CamxLogGroupPower, "No vote planner slot left for %s", pName);
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::UnregisterClient
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Titan17xResourceVotePlanner::UnregisterClient(
+    UINT32 hClient)
+{
+    if ((ResourceVoteMaxClients > hClient) && (NULL != m_pLock))
+    {
+        m_pLock->Lock();
+
+        ResourceVoteClient* pClient = &m_clients[hClient];
+
+        if (TRUE == pClient->inUse)
+        {
+            CAMX_LOG_INFO(CamxLogGroupPower,
+                          "%s: %llu requests planned, demand changed %llu times, vote changed %llu times "
+                          "(%llu raises, %llu lowers, %llu clock lowers held by the device aggregate)",
+                          pClient->name,
+                          pClient->metrics.planCount,
+                          pClient->metrics.demandChangeCount,
+                          pClient->metrics.voteChangeCount,
+                          pClient->metrics.raiseCount,
+                          pClient->metrics.lowerCount,
+                          pClient->metrics.aggregateHoldCount);
+
+            pClient->inUse = FALSE;
+            UpdateDeviceAggregate(pClient->device);
+        }
+
+        m_pLock->Unlock();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::PlanVotes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL Titan17xResourceVotePlanner::PlanVotes(
+    UINT32          hClient,
+    const UINT64*   pDemand,
+    UINT64*         pVote)
+{
+    const StaticSettings* pSettings     = HwEnvironment::GetInstance()->GetStaticSettings();
+    const DOUBLE          headroom      = static_cast<DOUBLE>(Utils::MaxFLOAT(pSettings->resourceVoteHeadroom, 0.0f));
+    const UINT32          holdRequests  = pSettings->resourceVoteHoldRequests;
+    const BOOL            simulation    = pSettings->resourceVoteSimulation;
+    BOOL                  demandChanged = FALSE;
+    BOOL                  voteChanged   = FALSE;
+
+    CAMX_ASSERT(ResourceVoteMaxClients > hClient);
+    CAMX_ASSERT(TRUE == m_clients[hClient].inUse);
+
+    m_pLock->Lock();
+
+    ResourceVoteClient* pClient          = &m_clients[hClient];
+    const UINT64        aggregateClockHz = m_aggregateClockHz[static_cast<UINT>(pClient->device)];
+
+    for (UINT32 channel = 0; channel < pClient->numChannels; channel++)
+    {
+        UINT64 demand  = pDemand[channel];
+        UINT64 vote    = pClient->vote[channel];
+
+        if (demand != pClient->demand[channel])
+        {
+            demandChanged = TRUE;
+        }
+        pClient->demand[channel] = demand;
+
+        if (demand > vote)
+        {
+            // Never vote less than the demand, and leave room for the small increases that usually follow
+            vote = demand + static_cast<UINT64>(demand * headroom);
+
+            pClient->holdCount[channel] = 0;
+            pClient->holdPeak[channel]  = 0;
+            pClient->metrics.raiseCount++;
+        }
+        else
+        {
+            UINT64 peak   = Utils::MaxUINT64(pClient->holdPeak[channel], demand);
+            UINT64 target = peak + static_cast<UINT64>(peak * headroom);
+
+            if (target < vote)
+            {
+                pClient->holdPeak[channel] = peak;
+                pClient->holdCount[channel]++;
+
+                if (pClient->holdCount[channel] >= holdRequests)
+                {
+                    if ((ResourceVoteChannelType::Clock == pClient->channelType[channel]) && (aggregateClockHz > vote))
+                    {
+                        // Another client runs the device at a higher clock, lowering this vote would not change the clock.
+                        // Keep the hold expired so the vote is lowered on the first request after the aggregate drops.
+                        pClient->metrics.aggregateHoldCount++;
+                    }
+                    else
+                    {
+                        vote = target;
+
+                        pClient->holdCount[channel] = 0;
+                        pClient->holdPeak[channel]  = 0;
+                        pClient->metrics.lowerCount++;
+                    }
+                }
+            }
+            else
+            {
+                // The demand is back within the headroom of the vote, the vote stays
+                pClient->holdCount[channel] = 0;
+                pClient->holdPeak[channel]  = 0;
+            }
+        }
+
+        if (vote != pClient->vote[channel])
+        {
+            voteChanged = TRUE;
+        }
+        pClient->vote[channel] = vote;
+
+        pVote[channel] = (TRUE == simulation) ? demand : vote;
+    }
+
+    pClient->metrics.planCount++;
+
+    if (TRUE == demandChanged)
+    {
+        pClient->metrics.demandChangeCount++;
+    }
+
+    if (TRUE == voteChanged)
+    {
+        pClient->metrics.voteChangeCount++;
+        UpdateDeviceAggregate(pClient->device);
+
+        CAMX_LOG_VERBOSE(CamxLogGroupPower, "%s: %s votes changed after %llu planned requests, %llu vote changes for %llu "
+                         "demand changes",
+                         pClient->name,
+                         (TRUE == simulation) ? "predicted" : "planned",
+                         pClient->metrics.planCount,
+                         pClient->metrics.voteChangeCount,
+                         pClient->metrics.demandChangeCount);
+    }
+
+    m_pLock->Unlock();
+
+    return (TRUE == simulation) ? demandChanged : voteChanged;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::PlanICPVotes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL Titan17xResourceVotePlanner::PlanICPVotes(
+    UINT32                       hClient,
+    CSLICPClockBandwidthRequest* pICPClockBandwidthRequest)
+{
+    UINT64 budgetNS = Utils::MaxUINT64(pICPClockBandwidthRequest->budgetNS, 1);
+    UINT64 clockHz;
+    UINT64 votes[ICPResourceVoteNumChannels];
+    BOOL   changed;
+
+    // Round the clock up and back so the planned frame cycles never fall below the demand
+    clockHz  = ((static_cast<UINT64>(pICPClockBandwidthRequest->frameCycles) * NanoSecondMult) + budgetNS - 1) / budgetNS;
+    votes[0] = clockHz;
+    votes[1] = pICPClockBandwidthRequest->unCompressedBW;
+    votes[2] = pICPClockBandwidthRequest->compressedBW;
+
+    changed = PlanVotes(hClient, votes, votes);
+
+    if (votes[0] != clockHz)
+    {
+        pICPClockBandwidthRequest->frameCycles =
+            static_cast<UINT32>(Utils::MinUINT64(((votes[0] * budgetNS) + NanoSecondMult - 1) / NanoSecondMult, 0xFFFFFFFF));
+    }
+    pICPClockBandwidthRequest->unCompressedBW = votes[1];
+    pICPClockBandwidthRequest->compressedBW   = votes[2];
+
+    return changed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::GetDeviceAggregate
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Titan17xResourceVotePlanner::GetDeviceAggregate(
+    ResourceVoteDevice  device,
+    UINT64*             pClockHz,
+    UINT64*             pBandwidth)
+{
+    CAMX_ASSERT(device < ResourceVoteDevice::Max);
+
+    m_pLock->Lock();
+    *pClockHz   = m_aggregateClockHz[static_cast<UINT>(device)];
+    *pBandwidth = m_aggregateBandwidth[static_cast<UINT>(device)];
+    m_pLock->Unlock();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Titan17xResourceVotePlanner::UpdateDeviceAggregate
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID Titan17xResourceVotePlanner::UpdateDeviceAggregate(
+    ResourceVoteDevice device)
+{
+    UINT   index     = static_cast<UINT>(device);
+    UINT64 clockHz   = 0;
+    UINT64 bandwidth = 0;
+
+    for (UINT32 i = 0; i < ResourceVoteMaxClients; i++)
+    {
+        const ResourceVoteClient* pClient = &m_clients[i];
+
+        if ((TRUE == pClient->inUse) && (device == pClient->device))
+        {
+            for (UINT32 channel = 0; channel < pClient->numChannels; channel++)
+            {
+                if (ResourceVoteChannelType::Clock == pClient->channelType[channel])
+                {
+                    clockHz = Utils::MaxUINT64(clockHz, pClient->vote[channel]);
+                }
+                else
+                {
+                    bandwidth += pClient->vote[channel];
+                }
+            }
+        }
+    }
+
+    if ((clockHz != m_aggregateClockHz[index]) || (bandwidth != m_aggregateBandwidth[index]))
+    {
+        m_aggregateClockHz[index]   = clockHz;
+        m_aggregateBandwidth[index] = bandwidth;
+
+        CAMX_LOG_VERBOSE(CamxLogGroupPower, "%s aggregate votes: clock %llu Hz, bandwidth %llu bytes",
+                         ResourceVoteDeviceNames[index], clockHz, bandwidth);
+
+        CAMX_TRACE_INT32_F(CamxLogGroupPower, static_cast<INT32>(clockHz / ResourceVoteTraceClockUnit),
+                           "%s: PlannedClockMHz", ResourceVoteDeviceNames[index]);
+        CAMX_TRACE_INT32_F(CamxLogGroupPower, static_cast<INT32>(bandwidth / ResourceVoteTraceBandwidthUnit),
+                           "%s: PlannedBandwidthMBps", ResourceVoteDeviceNames[index]);
+    }
+}
+
+CAMX_NAMESPACE_END
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxtitan17xresourcevoteplanner.h
+///
+/// @brief Clock and bandwidth vote planning shared by the IFE, IPE and BPS nodes
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXTITAN17XRESOURCEVOTEPLANNER_H
+#define CAMXTITAN17XRESOURCEVOTEPLANNER_H
+
+#include "camxcslicpdefs.h"
+#include "camxdefs.h"
+#include "camxtypes.h"
+
+CAMX_NAMESPACE_BEGIN
+
+class Mutex;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 ResourceVoteMaxChannels      = 16;          ///< Largest number of votes a client plans together
+static const UINT32 ResourceVoteMaxClients       = 32;          ///< Largest number of concurrently registered clients
+static const UINT32 ResourceVoteClientNameLength = 64;          ///< Length of a client name
+static const UINT32 ResourceVoteInvalidClient    = 0xFFFFFFFF;  ///< Handle of a client that is not registered
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Device a client votes for, votes are aggregated per device
+enum class ResourceVoteDevice
+{
+    IFE = 0,    ///< IFE, voted through the IFE generic blobs
+    IPE,        ///< IPE, voted through the ICP clock generic blob
+    BPS,        ///< BPS, voted through the ICP clock generic blob
+    Max         ///< Number of devices
+};
+
+static const UINT ResourceVoteNumDevices = static_cast<UINT>(ResourceVoteDevice::Max);   ///< Number of devices
+
+/// @brief What a vote channel is, which decides how it is aggregated across clients
+enum class ResourceVoteChannelType
+{
+    Clock = 0,  ///< Clock rate in Hz, the device aggregate is the largest vote
+    Bandwidth   ///< Bandwidth in bytes per second, the device aggregate is the sum of the votes
+};
+
+static const UINT32 ICPResourceVoteNumChannels = 3;    ///< Clock, uncompressed and compressed bandwidth
+
+/// @brief Vote channels of an IPE or BPS client, in the order PlanICPVotes uses them
+static const ResourceVoteChannelType ICPResourceVoteChannelTypes[ICPResourceVoteNumChannels] =
+{
+    ResourceVoteChannelType::Clock,
+    ResourceVoteChannelType::Bandwidth,
+    ResourceVoteChannelType::Bandwidth
+};
+
+/// @brief Counters of one client, to trace the planner's decisions
+struct ResourceVoteMetrics
+{
+    UINT64  planCount;           ///< Number of planned requests
+    UINT64  demandChangeCount;   ///< Requests whose demand differed from the previous request's demand
+    UINT64  voteChangeCount;     ///< Requests whose vote differed from the previous request's vote
+    UINT64  raiseCount;          ///< Channel votes raised to cover a larger demand
+    UINT64  lowerCount;          ///< Channel votes lowered after the demand stayed low for the hold period
+    UINT64  aggregateHoldCount;  ///< Requests a due clock lower was kept as another client voted the device clock higher
+};
+
+/// @brief State of one registered client
+struct ResourceVoteClient
+{
+    BOOL                    inUse;                                      ///< Slot holds a registered client
+    ResourceVoteDevice      device;                                     ///< Device the client votes for
+    UINT32                  numChannels;                                ///< Number of vote channels
+    ResourceVoteChannelType channelType[ResourceVoteMaxChannels];       ///< Type of each channel
+    UINT64                  demand[ResourceVoteMaxChannels];            ///< Demand of the last planned request
+    UINT64                  vote[ResourceVoteMaxChannels];              ///< Current vote
+    UINT64                  holdPeak[ResourceVoteMaxChannels];          ///< Largest demand while a lower vote is on hold
+    UINT32                  holdCount[ResourceVoteMaxChannels];         ///< Consecutive requests a lower vote has been on hold
+    ResourceVoteMetrics     metrics;                                    ///< Decision counters
+    CHAR                    name[ResourceVoteClientNameLength];         ///< Client name, for logs
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Process wide planner of the clock and bandwidth votes of the IFE, IPE and BPS nodes
+///
+/// Each node computes its demand per request as before and passes it through PlanVotes before writing its vote blob. A
+/// demand above the current vote raises the vote at once, with resourceVoteHeadroom added so that small increases that
+/// follow do not vote again. A demand below the current vote lowers it only after it stayed below for
+/// resourceVoteHoldRequests requests, and then to the largest demand seen during the hold. The votes of all clients of all
+/// sessions are aggregated per device and the aggregate is logged when it changes. The device runs at the largest clock
+/// vote, so a clock vote below the aggregate is not lowered: the lower would not change the clock but cost a vote, and it is
+/// applied once the aggregate drops. With resourceVoteSimulation the planner only predicts: decisions are logged and
+/// counted, but the clients vote their unfiltered demand.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class Titan17xResourceVotePlanner
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetInstance
+    ///
+    /// @brief  Get the process wide planner
+    ///
+    /// @return Pointer to the planner
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static Titan17xResourceVotePlanner* GetInstance();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RegisterClient
+    ///
+    /// @brief  Register a client whose votes are planned together
+    ///
+    /// @param  device          Device the client votes for
+    /// @param  pChannelTypes   Type of each vote channel
+    /// @param  numChannels     Number of vote channels, at most ResourceVoteMaxChannels
+    /// @param  pName           Client name, for logs
+    /// @param  phClient        Returned client handle
+    ///
+    /// @return CamxResultSuccess if successful, CamxResultENoMore if all client slots are in use
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult RegisterClient(
+        ResourceVoteDevice              device,
+        const ResourceVoteChannelType*  pChannelTypes,
+        UINT32                          numChannels,
+        const CHAR*                     pName,
+        UINT32*                         phClient);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// UnregisterClient
+    ///
+    /// @brief  Log the client's metrics and remove its votes from the device aggregate
+    ///
+    /// @param  hClient Client handle, ResourceVoteInvalidClient is ignored
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID UnregisterClient(
+        UINT32 hClient);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// PlanVotes
+    ///
+    /// @brief  Plan the votes of a request from its demand
+    ///
+    /// @param  hClient     Client handle
+    /// @param  pDemand     Demand of each channel
+    /// @param  pVote       Returned vote of each channel, never less than the demand; may be the same array as pDemand
+    ///
+    /// @return TRUE if the returned votes differ from the client's previous votes
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    BOOL PlanVotes(
+        UINT32          hClient,
+        const UINT64*   pDemand,
+        UINT64*         pVote);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// PlanICPVotes
+    ///
+    /// @brief  Plan the clock and bandwidth of an IPE or BPS request in place. The frame cycles are planned as the clock they
+    ///         need within the frame budget, so a change of budget is not mistaken for a change of demand.
+    ///
+    /// @param  hClient                     Client handle, registered with ICPResourceVoteChannelTypes
+    /// @param  pICPClockBandwidthRequest   Clock and bandwidth request with the demand, updated with the planned votes
+    ///
+    /// @return TRUE if the planned votes differ from the client's previous votes
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    BOOL PlanICPVotes(
+        UINT32                       hClient,
+        CSLICPClockBandwidthRequest* pICPClockBandwidthRequest);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetDeviceAggregate
+    ///
+    /// @brief  Get the aggregate of the current votes of all clients of a device
+    ///
+    /// @param  device          Device
+    /// @param  pClockHz        Largest clock vote
+    /// @param  pBandwidth      Sum of the bandwidth votes
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID GetDeviceAggregate(
+        ResourceVoteDevice  device,
+        UINT64*             pClockHz,
+        UINT64*             pBandwidth);
+
+private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Titan17xResourceVotePlanner
+    ///
+    /// @brief  Constructor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    Titan17xResourceVotePlanner();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ~Titan17xResourceVotePlanner
+    ///
+    /// @brief  Destructor
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ~Titan17xResourceVotePlanner();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// UpdateDeviceAggregate
+    ///
+    /// @brief  Recompute the aggregate of a device and log it if it changed, called with the lock held
+    ///
+    /// @param  device  Device
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID UpdateDeviceAggregate(
+        ResourceVoteDevice device);
+
+    Titan17xResourceVotePlanner(const Titan17xResourceVotePlanner&) = delete;
+    Titan17xResourceVotePlanner& operator=(const Titan17xResourceVotePlanner&) = delete;
+
+    Mutex*              m_pLock;                                        ///< Protects all state below
+    ResourceVoteClient  m_clients[ResourceVoteMaxClients];              ///< Client slots
+    UINT64              m_aggregateClockHz[ResourceVoteNumDevices];     ///< Largest clock vote per device
+    UINT64              m_aggregateBandwidth[ResourceVoteNumDevices];   ///< Sum of bandwidth votes per device
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXTITAN17XRESOURCEVOTEPLANNER_H
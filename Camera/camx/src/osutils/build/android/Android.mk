@@ -15,10 +15,12 @@ SUPPORT_FUNCTION_CALL_TRACE := 1
 include $(CAMX_PATH)/build/infrastructure/android/common.mk
 
 LOCAL_SRC_FILES :=                   \
+    camxlockprofiler.cpp             \
     camxmem.cpp                      \
     camxosutils$(CAMX_OS).cpp
 
 LOCAL_INC_FILES :=     \
+    camxlockprofiler.h \
     camxmem.h          \
     camxosutils.h
 
@@ -42,7 +44,8 @@ include $(CAMX_BUILD_STATIC_LIBRARY)
 
 # COPY below headers to out\target\product\<target>\obj\include\camx
 LOCAL_COPY_HEADERS_TO := camx
-LOCAL_COPY_HEADERS :=    camxmem.h          \
+LOCAL_COPY_HEADERS :=    camxlockprofiler.h \
+                         camxmem.h          \
                          camxosutils.h
 
 include $(BUILD_COPY_HEADERS)
@@ -0,0 +1,596 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxlockprofiler.cpp
+/// @brief Lock contention profiler implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if defined (_LINUX)
+#include <dlfcn.h>                  // dladdr for call site names
+#endif // _LINUX
+
+#include "camxatomic.h"
+#include "camxincs.h"
+#include "camxlockprofiler.h"
+#include "camxosutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Local definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 ReporterSleepSliceUs    = 100000;   ///< Reporter checks for shutdown this often
+static const UINT32 MaxReportCount          = 32;       ///< Upper bound of locks listed per report section
+static const UINT32 MaxReportedCallSites    = 3;        ///< Call sites listed per lock
+
+volatile BOOL       LockProfiler::s_enabled           = FALSE;
+UINT32              LockProfiler::s_reportIntervalMs  = LockProfileDefaultReportIntervalMs;
+UINT32              LockProfiler::s_reportCount       = LockProfileDefaultReportCount;
+UINT64              LockProfiler::s_lastReportNs      = 0;
+volatile UINT       LockProfiler::s_numEntries        = 0;
+volatile UINT       LockProfiler::s_numUnregistered   = 0;
+LockProfileEntry    LockProfiler::s_entries[LockProfileMaxEntries];
+
+CAMX_TLS_STATIC_CLASS_DEFINE(LockProfileHeldStack, LockProfiler, m_tHeldStack, LockProfileHeldStack());
+
+/// @brief Serializes Register; the profiler cannot use a Mutex for its own bookkeeping
+static volatile INT s_registryLock = 0;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// SpinLock
+///
+/// @brief  Acquire a spin flag. Only used on rare paths: registration and the first contention of a call site.
+///
+/// @param  pFlag   Flag to acquire
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID SpinLock(
+    volatile INT* pFlag)
+{
+    while (FALSE == CamxAtomicCompareExchange(pFlag, 0, 1))
+    {
+        OsUtils::SleepMicroseconds(0);
+    }
+    CamxFence();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// SpinUnlock
+///
+/// @brief  Release a spin flag
+///
+/// @param  pFlag   Flag to release
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID SpinUnlock(
+    volatile INT* pFlag)
+{
+    CamxFence();
+    CamxAtomicStore(pFlag, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// UpdateMax
+///
+/// @brief  Raise a maximum; a concurrent update may be lost, which is acceptable for profiling
+///
+/// @param  pMax    Maximum to update
+/// @param  value   Candidate value
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static CAMX_INLINE VOID UpdateMax(
+    volatile UINT64*    pMax,
+    UINT64              value)
+{
+    if (value > CamxAtomicLoadU64(pMax))
+    {
+        CamxAtomicStoreU64(pMax, value);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// GetCallerName
+///
+/// @brief  Describe a code address as symbol+offset when the symbol can be resolved
+///
+/// @param  caller      Code address
+/// @param  pName       Output buffer
+/// @param  nameSize    Size of pName
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID GetCallerName(
+    UINT64  caller,
+    CHAR*   pName,
+    SIZE_T  nameSize)
+{
+    const VOID* pCaller = reinterpret_cast<const VOID*>(static_cast<UINTPTR_T>(caller));
+    BOOL        named   = FALSE;
+
+#if defined (_LINUX)
+    Dl_info info;
+
+    if ((0 != dladdr(pCaller, &info)) && (NULL != info.dli_sname))
+    {
+        OsUtils::SNPrintF(pName, nameSize, "%s+0x%zx", info.dli_sname,
+                          static_cast<SIZE_T>(reinterpret_cast<UINTPTR_T>(pCaller) -
+                                              reinterpret_cast<UINTPTR_T>(info.dli_saddr)));
+        named = TRUE;
+    }
+    else if ((0 != dladdr(pCaller, &info)) && (NULL != info.dli_fname))
+    {
+        OsUtils::SNPrintF(pName, nameSize, "%s+0x%zx", OsUtils::GetFileName(info.dli_fname),
+                          static_cast<SIZE_T>(reinterpret_cast<UINTPTR_T>(pCaller) -
+                                              reinterpret_cast<UINTPTR_T>(info.dli_fbase)));
+        named = TRUE;
+    }
+#endif // _LINUX
+
+    if (FALSE == named)
+    {
+        OsUtils::SNPrintF(pName, nameSize, "%p", pCaller);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// GetTypeName
+///
+/// @brief  Short name of a primitive kind for the report
+///
+/// @param  type    Primitive kind
+///
+/// @return Name
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const CHAR* GetTypeName(
+    LockProfileType type)
+{
+    const CHAR* pTypeName;
+
+    switch (type)
+    {
+        case LockProfileType::Mutex:
+            pTypeName = "Mutex";
+            break;
+        case LockProfileType::ReadWriteLock:
+            pTypeName = "RWLock";
+            break;
+        case LockProfileType::Semaphore:
+            pTypeName = "Sem";
+            break;
+        case LockProfileType::Condition:
+        default:
+            pTypeName = "Cond";
+            break;
+    }
+
+    return pTypeName;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::Enable
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult LockProfiler::Enable(
+    UINT32 reportIntervalMs,
+    UINT32 reportCount)
+{
+    CamxResult result = CamxResultSuccess;
+
+    // Profiling stays on for the life of the process once turned on, locks keep their entries until they are destroyed
+    if (FALSE == s_enabled)
+    {
+        OSThreadHandle hReporter;
+
+        s_reportIntervalMs = (0 != reportIntervalMs) ? reportIntervalMs : LockProfileDefaultReportIntervalMs;
+        s_reportCount      = (0 != reportCount)      ? reportCount      : LockProfileDefaultReportCount;
+        s_reportCount      = (MaxReportCount < s_reportCount) ? MaxReportCount : s_reportCount;
+        s_lastReportNs     = OsUtils::GetNanoSeconds();
+        s_enabled          = TRUE;
+
+        result = OsUtils::ThreadCreate(ReporterThread, NULL, &hReporter);
+
+        if (CamxResultSuccess == result)
+        {
+            OsUtils::ThreadSetName(hReporter, "CamXLockProfiler");
+            CAMX_LOG_CONFIG(CamxLogGroupSync, "Lock profiling enabled, report every %u ms", s_reportIntervalMs);
+        }
+        else
+        {
+            CAMX_LOG_ERROR(CamxLogGroupSync, "Lock profiler reporter failed to start: %s", Utils::CamxResultToString(result));
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::Register
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+LockProfileEntry* LockProfiler::Register(
+    LockProfileType type,
+    const CHAR*     pName,
+    const VOID*     pCaller)
+{
+    LockProfileEntry*   pEntry = NULL;
+    CHAR                name[LockProfileMaxNameLength];
+
+    if (TRUE == s_enabled)
+    {
+        if ((NULL == pName) || ('\0' == pName[0]))
+        {
+            // Unnamed primitives are told apart by who created them
+            CHAR callerName[LockProfileMaxNameLength];
+
+            GetCallerName(Utils::VoidPtrToUINT64(const_cast<VOID*>(pCaller)), callerName, sizeof(callerName));
+            OsUtils::SNPrintF(name, sizeof(name), "%s@%s", GetTypeName(type), callerName);
+        }
+        else
+        {
+            OsUtils::StrLCpy(name, pName, sizeof(name));
+        }
+
+        SpinLock(&s_registryLock);
+
+        for (UINT32 i = 0; i < s_numEntries; i++)
+        {
+            if ((type == s_entries[i].type) && (0 == OsUtils::StrCmp(name, s_entries[i].name)))
+            {
+                pEntry = &s_entries[i];
+                break;
+            }
+        }
+
+        if ((NULL == pEntry) && (LockProfileMaxEntries > s_numEntries))
+        {
+            pEntry       = &s_entries[s_numEntries];
+            pEntry->type = type;
+            OsUtils::StrLCpy(pEntry->name, name, sizeof(pEntry->name));
+
+            // The reporter reads entries below s_numEntries without the registry lock
+            CamxFence();
+            CamxAtomicStoreU(&s_numEntries, s_numEntries + 1);
+        }
+
+        SpinUnlock(&s_registryLock);
+
+        if (NULL != pEntry)
+        {
+            CamxAtomicIncU(&pEntry->numInstances);
+        }
+        else
+        {
+            CamxAtomicIncU(&s_numUnregistered);
+        }
+    }
+
+    return pEntry;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::RecordAcquire
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::RecordAcquire(
+    LockProfileEntry*   pEntry,
+    const VOID*         pLock,
+    UINT64              waitNs,
+    UINT64              acquiredNs,
+    const VOID*         pCaller)
+{
+    LockProfileHeldStack* pStack = &m_tHeldStack;
+
+    CamxAtomicAddU64(&pEntry->numAcquires, 1);
+
+    if (0 != waitNs)
+    {
+        AccountWait(pEntry, waitNs, pCaller);
+    }
+
+    // A recursive acquisition extends the outermost hold
+    for (UINT32 i = pStack->numHeld; i > 0; i--)
+    {
+        if (pLock == pStack->held[i - 1].pLock)
+        {
+            pStack->held[i - 1].depth++;
+            pLock = NULL;
+            break;
+        }
+    }
+
+    if ((NULL != pLock) && (LockProfileMaxHeldPerThread > pStack->numHeld))
+    {
+        LockProfileHeld* pHeld = &pStack->held[pStack->numHeld++];
+
+        pHeld->pLock      = pLock;
+        pHeld->pEntry     = pEntry;
+        pHeld->acquiredNs = acquiredNs;
+        pHeld->depth      = 1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::RecordRelease
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::RecordRelease(
+    const VOID* pLock)
+{
+    LockProfileHeldStack* pStack = &m_tHeldStack;
+
+    // Locks are usually released in reverse order, so search from the top
+    for (UINT32 i = pStack->numHeld; i > 0; i--)
+    {
+        LockProfileHeld* pHeld = &pStack->held[i - 1];
+
+        if (pLock == pHeld->pLock)
+        {
+            pHeld->depth--;
+
+            if (0 == pHeld->depth)
+            {
+                UINT64 holdNs = OsUtils::GetNanoSeconds() - pHeld->acquiredNs;
+
+                CamxAtomicAddU64(&pHeld->pEntry->holdNs, holdNs);
+                UpdateMax(&pHeld->pEntry->maxHoldNs, holdNs);
+
+                for (UINT32 j = i; j < pStack->numHeld; j++)
+                {
+                    pStack->held[j - 1] = pStack->held[j];
+                }
+                pStack->numHeld--;
+            }
+            break;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::RecordWait
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::RecordWait(
+    LockProfileEntry*   pEntry,
+    const VOID*         phMutex,
+    UINT64              waitNs,
+    const VOID*         pCaller)
+{
+    if (NULL != pEntry)
+    {
+        CamxAtomicAddU64(&pEntry->numAcquires, 1);
+
+        if (0 != waitNs)
+        {
+            AccountWait(pEntry, waitNs, pCaller);
+        }
+    }
+
+    // The mutex was released for the duration of a Condition wait, so that time is not hold time
+    if (NULL != phMutex)
+    {
+        LockProfileHeldStack* pStack = &m_tHeldStack;
+
+        for (UINT32 i = pStack->numHeld; i > 0; i--)
+        {
+            if (phMutex == pStack->held[i - 1].pLock)
+            {
+                pStack->held[i - 1].acquiredNs += waitNs;
+                break;
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::AccountWait
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::AccountWait(
+    LockProfileEntry*   pEntry,
+    UINT64              waitNs,
+    const VOID*         pCaller)
+{
+    UINT64                  caller      = Utils::VoidPtrToUINT64(const_cast<VOID*>(pCaller));
+    LockProfileCallSite*    pCallSite   = NULL;
+
+    CamxAtomicAddU64(&pEntry->numContended, 1);
+    CamxAtomicAddU64(&pEntry->waitNs, waitNs);
+    UpdateMax(&pEntry->maxWaitNs, waitNs);
+
+    for (UINT32 i = 0; i < LockProfileMaxCallSites; i++)
+    {
+        if (caller == CamxAtomicLoadU64(&pEntry->callSites[i].caller))
+        {
+            pCallSite = &pEntry->callSites[i];
+            break;
+        }
+    }
+
+    if (NULL == pCallSite)
+    {
+        // First contention from this caller, claim a slot
+        SpinLock(&pEntry->callSiteLock);
+        for (UINT32 i = 0; i < LockProfileMaxCallSites; i++)
+        {
+            UINT64 slotCaller = CamxAtomicLoadU64(&pEntry->callSites[i].caller);
+
+            if ((caller == slotCaller) || (0 == slotCaller))
+            {
+                CamxAtomicStoreU64(&pEntry->callSites[i].caller, caller);
+                pCallSite = &pEntry->callSites[i];
+                break;
+            }
+        }
+        SpinUnlock(&pEntry->callSiteLock);
+    }
+
+    if (NULL != pCallSite)
+    {
+        CamxAtomicAddU64(&pCallSite->numContended, 1);
+        CamxAtomicAddU64(&pCallSite->waitNs, waitNs);
+    }
+    else
+    {
+        CamxAtomicAddU64(&pEntry->numOtherCallSiteContended, 1);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::Report
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::Report()
+{
+    LockProfileCounters deltas[LockProfileMaxEntries];
+    UINT32              numEntries  = CamxAtomicLoadU(&s_numEntries);
+    UINT64              nowNs       = OsUtils::GetNanoSeconds();
+
+    CamxFence();
+
+    for (UINT32 i = 0; i < numEntries; i++)
+    {
+        LockProfileEntry*   pEntry = &s_entries[i];
+        LockProfileCounters current;
+
+        current.numAcquires  = CamxAtomicLoadU64(&pEntry->numAcquires);
+        current.numContended = CamxAtomicLoadU64(&pEntry->numContended);
+        current.waitNs       = CamxAtomicLoadU64(&pEntry->waitNs);
+        current.holdNs       = CamxAtomicLoadU64(&pEntry->holdNs);
+
+        deltas[i].numAcquires  = current.numAcquires  - pEntry->lastReported.numAcquires;
+        deltas[i].numContended = current.numContended - pEntry->lastReported.numContended;
+        deltas[i].waitNs       = current.waitNs       - pEntry->lastReported.waitNs;
+        deltas[i].holdNs       = current.holdNs       - pEntry->lastReported.holdNs;
+
+        pEntry->lastReported = current;
+    }
+
+    CAMX_LOG_CONFIG(CamxLogGroupSync, "LockProfiler: %u lock names, %u locks unprofiled, interval %llu ms",
+                    numEntries, CamxAtomicLoadU(&s_numUnregistered), (nowNs - s_lastReportNs) / 1000000);
+
+    ReportSection(TRUE, deltas, numEntries);
+    ReportSection(FALSE, deltas, numEntries);
+
+    s_lastReportNs = nowNs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::ReportSection
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LockProfiler::ReportSection(
+    BOOL                        reportLocks,
+    const LockProfileCounters*  pDeltas,
+    UINT32                      numEntries)
+{
+    UINT32  top[MaxReportCount];
+    UINT32  numTop = 0;
+
+    // Insertion sort of the entries with wait time in this interval, keeping only the top s_reportCount
+    for (UINT32 i = 0; i < numEntries; i++)
+    {
+        BOOL isLock = ((LockProfileType::Mutex == s_entries[i].type) || (LockProfileType::ReadWriteLock == s_entries[i].type));
+
+        if ((reportLocks != isLock) || (0 == pDeltas[i].waitNs))
+        {
+            continue;
+        }
+
+        UINT32 position = numTop;
+
+        while ((0 < position) && (pDeltas[top[position - 1]].waitNs < pDeltas[i].waitNs))
+        {
+            if (position < s_reportCount)
+            {
+                top[position] = top[position - 1];
+            }
+            position--;
+        }
+
+        if (position < s_reportCount)
+        {
+            top[position] = i;
+            numTop        = (numTop < s_reportCount) ? (numTop + 1) : numTop;
+        }
+    }
+
+    CAMX_LOG_CONFIG(CamxLogGroupSync, "LockProfiler: top %u %s by wait time", numTop,
+                    (TRUE == reportLocks) ? "locks" : "semaphore/condition waits");
+
+    for (UINT32 rank = 0; rank < numTop; rank++)
+    {
+        LockProfileEntry*           pEntry = &s_entries[top[rank]];
+        const LockProfileCounters*  pDelta = &pDeltas[top[rank]];
+
+        CAMX_LOG_CONFIG(CamxLogGroupSync,
+                        "  #%u %-6s %-40s x%u acquires %llu contended %llu (%llu%%) wait %llu us (max %llu us) "
+                        "hold %llu us (max %llu us)",
+                        rank + 1, GetTypeName(pEntry->type), pEntry->name, pEntry->numInstances,
+                        pDelta->numAcquires, pDelta->numContended,
+                        (0 != pDelta->numAcquires) ? ((pDelta->numContended * 100) / pDelta->numAcquires) : 0,
+                        pDelta->waitNs / 1000, CamxAtomicLoadU64(&pEntry->maxWaitNs) / 1000,
+                        pDelta->holdNs / 1000, CamxAtomicLoadU64(&pEntry->maxHoldNs) / 1000);
+
+        // Call site totals are cumulative; list the callers that waited longest
+        BOOL reported[LockProfileMaxCallSites] = { FALSE };
+
+        for (UINT32 n = 0; n < MaxReportedCallSites; n++)
+        {
+            INT32 best = -1;
+
+            for (UINT32 i = 0; i < LockProfileMaxCallSites; i++)
+            {
+                if ((FALSE == reported[i]) && (0 != pEntry->callSites[i].caller) &&
+                    ((-1 == best) || (pEntry->callSites[i].waitNs > pEntry->callSites[best].waitNs)))
+                {
+                    best = static_cast<INT32>(i);
+                }
+            }
+
+            if (-1 == best)
+            {
+                break;
+            }
+
+            CHAR callerName[MaxStringLength256];
+
+            reported[best] = TRUE;
+            GetCallerName(pEntry->callSites[best].caller, callerName, sizeof(callerName));
+            CAMX_LOG_CONFIG(CamxLogGroupSync, "      from %s: contended %llu wait %llu us (total)",
+                            callerName, pEntry->callSites[best].numContended, pEntry->callSites[best].waitNs / 1000);
+        }
+
+        if (0 != pEntry->numOtherCallSiteContended)
+        {
+            CAMX_LOG_CONFIG(CamxLogGroupSync, "      from other call sites: contended %llu (total)",
+                            pEntry->numOtherCallSiteContended);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LockProfiler::ReporterThread
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* LockProfiler::ReporterThread(
+    VOID* pArg)
+{
+    CAMX_UNREFERENCED_PARAM(pArg);
+
+    while (TRUE == s_enabled)
+    {
+        UINT64 elapsedUs = (OsUtils::GetNanoSeconds() - s_lastReportNs) / 1000;
+
+        if (elapsedUs >= (static_cast<UINT64>(s_reportIntervalMs) * 1000))
+        {
+            Report();
+        }
+        else
+        {
+            OsUtils::SleepMicroseconds(ReporterSleepSliceUs);
+        }
+    }
+
+    return NULL;
+}
+
+CAMX_NAMESPACE_END
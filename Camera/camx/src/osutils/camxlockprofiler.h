@@ -0,0 +1,274 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxlockprofiler.h
+/// @brief Opt-in contention profiler for the OsUtils Mutex, ReadWriteLock, Semaphore and Condition primitives
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXLOCKPROFILER_H
+#define CAMXLOCKPROFILER_H
+
+#include "camxdefs.h"
+#include "camxosutils.h"
+#include "camxtypes.h"
+
+CAMX_NAMESPACE_BEGIN
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 LockProfileMaxEntries               = 512;      ///< Distinct lock names that can be profiled
+static const UINT32 LockProfileMaxCallSites             = 8;        ///< Contending call sites tracked per lock name
+static const UINT32 LockProfileMaxHeldPerThread         = 16;       ///< Nested locks a thread can hold and be timed
+static const UINT32 LockProfileMaxNameLength            = 64;       ///< Name bytes kept per lock
+static const UINT32 LockProfileDefaultReportIntervalMs  = 5000;     ///< Report period when not configured
+static const UINT32 LockProfileDefaultReportCount       = 10;       ///< Locks listed per report when not configured
+
+/// CAMX_RETURN_ADDRESS gives the address the current function returns to, used to attribute waits to the caller of a lock
+#define CAMX_RETURN_ADDRESS() __builtin_return_address(0)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Kind of primitive a profile entry describes
+enum class LockProfileType : UINT32
+{
+    Mutex,          ///< Mutex, waits are contention
+    ReadWriteLock,  ///< ReadWriteLock, waits are contention
+    Semaphore,      ///< Semaphore, waits are mostly idle time waiting for a signal
+    Condition,      ///< Condition, waits are idle time waiting for a signal
+};
+
+/// @brief Contended acquisitions attributed to one caller
+struct LockProfileCallSite
+{
+    volatile UINT64 caller;         ///< Return address of the Lock/Wait call, 0 if the slot is free
+    volatile UINT64 numContended;   ///< Contended acquisitions from this caller
+    volatile UINT64 waitNs;         ///< Wait time of this caller
+};
+
+/// @brief Counters that are reported per interval
+struct LockProfileCounters
+{
+    UINT64 numAcquires;             ///< Acquisitions, or waits for Semaphore and Condition
+    UINT64 numContended;            ///< Acquisitions that had to block
+    UINT64 waitNs;                  ///< Time spent blocked
+    UINT64 holdNs;                  ///< Time the lock was held, Mutex and ReadWriteLock only
+};
+
+/// @brief Accumulated statistics of all locks sharing one name
+struct LockProfileEntry
+{
+    CHAR                name[LockProfileMaxNameLength];         ///< Resource name of the locks
+    LockProfileType     type;                                   ///< Primitive kind
+    volatile UINT32     numInstances;                           ///< Locks created with this name
+    volatile UINT64     numAcquires;                            ///< See LockProfileCounters
+    volatile UINT64     numContended;                           ///< See LockProfileCounters
+    volatile UINT64     waitNs;                                 ///< See LockProfileCounters
+    volatile UINT64     holdNs;                                 ///< See LockProfileCounters
+    volatile UINT64     maxWaitNs;                              ///< Longest single wait, approximate under races
+    volatile UINT64     maxHoldNs;                              ///< Longest single hold, approximate under races
+    volatile UINT64     numOtherCallSiteContended;              ///< Contended acquisitions once the call site table is full
+    volatile INT        callSiteLock;                           ///< Spin flag for claiming call site slots
+    LockProfileCallSite callSites[LockProfileMaxCallSites];     ///< Contending callers
+    LockProfileCounters lastReported;                           ///< Counters at the previous report, reporter only
+};
+
+/// @brief One lock held by the current thread
+struct LockProfileHeld
+{
+    const VOID*         pLock;          ///< Native handle of the held lock
+    LockProfileEntry*   pEntry;         ///< Profile entry of the lock
+    UINT64              acquiredNs;     ///< Time of the outermost acquisition
+    UINT32              depth;          ///< Recursive acquisition depth
+};
+
+/// @brief Locks held by the current thread
+struct LockProfileHeldStack
+{
+    LockProfileHeld     held[LockProfileMaxHeldPerThread];  ///< Held locks, most recent last
+    UINT32              numHeld;                            ///< Valid entries in held
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Lock contention profiler
+///
+/// When enabled before a lock is created, the lock registers a profile entry by name and reports every acquisition to it.
+/// An acquisition first tries the lock; only if that fails is the wait timed and attributed to the caller's return address.
+/// Hold time runs from the outermost acquisition to the matching release on the same thread and excludes the time a Mutex
+/// is released inside Condition::Wait. A reporter thread periodically logs the locks with the most wait time in the last
+/// interval, together with the call sites that waited the longest.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class LockProfiler
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Enable
+    ///
+    /// @brief  Turn on profiling for locks created from now on and start the reporter
+    ///
+    /// @param  reportIntervalMs    Report period, 0 selects the default
+    /// @param  reportCount         Locks listed per report, 0 selects the default
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CamxResult Enable(
+        UINT32 reportIntervalMs,
+        UINT32 reportCount);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsEnabled
+    ///
+    /// @brief  Check whether newly created locks should register
+    ///
+    /// @return TRUE if profiling is on
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CAMX_INLINE BOOL IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Register
+    ///
+    /// @brief  Get the profile entry of a lock name, creating it on first use
+    ///
+    /// @param  type    Primitive kind
+    /// @param  pName   Resource name, NULL to name the entry after the creator
+    /// @param  pCaller Return address of the Create call
+    ///
+    /// @return Entry or NULL if profiling is off or the table is full
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static LockProfileEntry* Register(
+        LockProfileType type,
+        const CHAR*     pName,
+        const VOID*     pCaller);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RecordAcquire
+    ///
+    /// @brief  Account for an acquisition and start timing the hold
+    ///
+    /// @param  pEntry      Profile entry of the lock
+    /// @param  pLock       Native handle of the lock, matched by RecordRelease
+    /// @param  waitNs      Time blocked, 0 if the lock was free
+    /// @param  acquiredNs  Time the lock was obtained
+    /// @param  pCaller     Return address of the Lock call
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID RecordAcquire(
+        LockProfileEntry*   pEntry,
+        const VOID*         pLock,
+        UINT64              waitNs,
+        UINT64              acquiredNs,
+        const VOID*         pCaller);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RecordRelease
+    ///
+    /// @brief  Stop timing the hold of a lock released by the current thread
+    ///
+    /// @param  pLock       Native handle of the lock
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID RecordRelease(
+        const VOID* pLock);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RecordWait
+    ///
+    /// @brief  Account for a Semaphore or Condition wait
+    ///
+    /// @param  pEntry      Profile entry of the Semaphore or Condition
+    /// @param  phMutex     Mutex released during a Condition wait, NULL for a Semaphore
+    /// @param  waitNs      Time blocked, 0 if the wait did not block
+    /// @param  pCaller     Return address of the Wait call
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID RecordWait(
+        LockProfileEntry*   pEntry,
+        const VOID*         phMutex,
+        UINT64              waitNs,
+        const VOID*         pCaller);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Report
+    ///
+    /// @brief  Log the locks with the most wait time since the previous report
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID Report();
+
+private:
+    LockProfiler()                                  = default;
+    LockProfiler(const LockProfiler&)               = delete;
+    LockProfiler& operator=(const LockProfiler&)    = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AccountWait
+    ///
+    /// @brief  Add a blocking wait to the entry and its call site
+    ///
+    /// @param  pEntry      Profile entry
+    /// @param  waitNs      Time blocked
+    /// @param  pCaller     Return address of the blocking call
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID AccountWait(
+        LockProfileEntry*   pEntry,
+        UINT64              waitNs,
+        const VOID*         pCaller);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ReportSection
+    ///
+    /// @brief  Log the top entries of either the lock or the wait primitives
+    ///
+    /// @param  reportLocks TRUE for Mutex and ReadWriteLock, FALSE for Semaphore and Condition
+    /// @param  pDeltas     Counters of every entry since the previous report
+    /// @param  numEntries  Entries in pDeltas
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID ReportSection(
+        BOOL                        reportLocks,
+        const LockProfileCounters*  pDeltas,
+        UINT32                      numEntries);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ReporterThread
+    ///
+    /// @brief  Reporter thread entry
+    ///
+    /// @param  pArg Unused
+    ///
+    /// @return NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* ReporterThread(
+        VOID* pArg);
+
+    static volatile BOOL        s_enabled;                              ///< New locks register
+    static UINT32               s_reportIntervalMs;                     ///< Report period
+    static UINT32               s_reportCount;                          ///< Locks listed per report
+    static UINT64               s_lastReportNs;                         ///< Time of the previous report
+    static volatile UINT        s_numEntries;                           ///< Valid entries in s_entries
+    static volatile UINT        s_numUnregistered;                      ///< Locks not profiled because the table was full
+    static LockProfileEntry     s_entries[LockProfileMaxEntries];       ///< Profile entries, never removed
+
+    CAMX_TLS_STATIC_CLASS_DECLARE(LockProfileHeldStack, m_tHeldStack);  ///< Locks held by the current thread
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXLOCKPROFILER_H
@@ -42,6 +42,8 @@
 
 CAMX_NAMESPACE_BEGIN
 
+struct LockProfileEntry;
+
 static const INT InvalidNativeFence = -1;   ///< Invalid native hFence
 
 /// Thread entry function type
@@ -1403,6 +1405,7 @@ private:
 #endif // defined(_LINUX)
 
     CHAR                m_pResourceName[Mutex::MaxResourceNameSize];   ///< Name of resource protected
+    LockProfileEntry*   m_pProfile;                                     ///< Contention profile, NULL unless profiling
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1517,6 +1520,7 @@ private:
 
     CHAR                m_pResourceName[Mutex::MaxResourceNameSize];   ///< Name of resource protected
     INT                 m_lockCount;            ///< Number of locks currently held (used for debug tracing)
+    LockProfileEntry*   m_pProfile;             ///< Contention profile, NULL unless profiling
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1602,6 +1606,7 @@ private:
 #else
     HANDLE       m_hSemaphore;       ///< (Windows) Semaphore
 #endif // defined(_LINUX)
+    LockProfileEntry*   m_pProfile;  ///< Wait profile, NULL unless profiling
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1704,6 +1709,7 @@ private:
 #else
     CONDITION_VARIABLE  m_conditionVar;                  ///< (Windows) Underlying conditional variable
 #endif // defined(_LINUX)
+    LockProfileEntry*   m_pProfile;                      ///< Wait profile, NULL unless profiling
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
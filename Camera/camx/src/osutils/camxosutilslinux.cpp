@@ -59,6 +59,7 @@
 #include "camxincs.h"
 #include "camxosutils.h"
 #include "camximageformatutils.h"
+#include "camxlockprofiler.h"
 
 CAMX_NAMESPACE_BEGIN
 
@@ -1400,6 +1401,7 @@ CamxResult Mutex::Initialize(
     CAMX_ASSERT(pResourceName != NULL);
 
     OsUtils::StrLCpy(m_pResourceName, pResourceName, MaxResourceNameSize);
+    m_pProfile = LockProfiler::Register(LockProfileType::Mutex, m_pResourceName, CAMX_RETURN_ADDRESS());
 
     if (pthread_mutexattr_init(&attr) == 0)
     {
@@ -1455,7 +1457,22 @@ VOID Mutex::Destroy()
 VOID Mutex::Lock()
 {
     CAMX_TRACE_SYNC_BEGIN_F(CamxLogGroupSync, "%s: Mutex::Lock", m_pResourceName);
-    pthread_mutex_lock(&m_mutex);
+    if (NULL == m_pProfile)
+    {
+        pthread_mutex_lock(&m_mutex);
+    }
+    else if (0 == pthread_mutex_trylock(&m_mutex))
+    {
+        LockProfiler::RecordAcquire(m_pProfile, &m_mutex, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+    }
+    else
+    {
+        UINT64 startNs = OsUtils::GetNanoSeconds();
+        pthread_mutex_lock(&m_mutex);
+        UINT64 acquiredNs = OsUtils::GetNanoSeconds();
+        LockProfiler::RecordAcquire(m_pProfile, &m_mutex, Utils::MaxUINT64(acquiredNs - startNs, 1), acquiredNs,
+                                    CAMX_RETURN_ADDRESS());
+    }
     CAMX_TRACE_ASYNC_BEGIN_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(GetNativeHandle()), "%s: Mutex Held", m_pResourceName);
     CAMX_TRACE_SYNC_END(CamxLogGroupSync);
 }
@@ -1483,6 +1500,10 @@ CamxResult Mutex::TryLock()
     }
     else
     {
+        if (NULL != m_pProfile)
+        {
+            LockProfiler::RecordAcquire(m_pProfile, &m_mutex, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+        }
         CAMX_TRACE_ASYNC_BEGIN_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(GetNativeHandle()),
                                  "%s: Mutex Held", m_pResourceName);
     }
@@ -1496,6 +1517,10 @@ CamxResult Mutex::TryLock()
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 VOID Mutex::Unlock()
 {
+    if (NULL != m_pProfile)
+    {
+        LockProfiler::RecordRelease(&m_mutex);
+    }
     pthread_mutex_unlock(&m_mutex);
     CAMX_TRACE_ASYNC_END_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(GetNativeHandle()), "%s: Mutex Held", m_pResourceName);
 }
@@ -1549,6 +1574,8 @@ CamxResult ReadWriteLock::Initialize(
         OsUtils::StrLCpy(m_pResourceName, pResourceName, MaxResourceNameSize);
         m_validReadWriteLock    = TRUE;
         m_lockCount             = 0;
+        m_pProfile              = LockProfiler::Register(LockProfileType::ReadWriteLock, m_pResourceName,
+                                                         CAMX_RETURN_ADDRESS());
     }
     else
     {
@@ -1577,7 +1604,22 @@ VOID ReadWriteLock::Destroy()
 VOID ReadWriteLock::ReadLock()
 {
     CAMX_TRACE_SYNC_BEGIN_F(CamxLogGroupSync, "%s: RWLock::ReadLock", m_pResourceName);
-    pthread_rwlock_rdlock(&m_readWriteLock);
+    if (NULL == m_pProfile)
+    {
+        pthread_rwlock_rdlock(&m_readWriteLock);
+    }
+    else if (0 == pthread_rwlock_tryrdlock(&m_readWriteLock))
+    {
+        LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+    }
+    else
+    {
+        UINT64 startNs = OsUtils::GetNanoSeconds();
+        pthread_rwlock_rdlock(&m_readWriteLock);
+        UINT64 acquiredNs = OsUtils::GetNanoSeconds();
+        LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, Utils::MaxUINT64(acquiredNs - startNs, 1), acquiredNs,
+                                    CAMX_RETURN_ADDRESS());
+    }
     INT lockCount = CamxAtomicInc(&m_lockCount);
     CAMX_TRACE_INT32_F(CamxLogGroupSync, lockCount, "%s: RWLock::LockCount" , m_pResourceName);
     CAMX_TRACE_SYNC_END(CamxLogGroupSync);
@@ -1589,7 +1631,22 @@ VOID ReadWriteLock::ReadLock()
 VOID ReadWriteLock::WriteLock()
 {
     CAMX_TRACE_SYNC_BEGIN_F(CamxLogGroupSync, "%s: RWLock::WriteLock", m_pResourceName);
-    pthread_rwlock_wrlock(&m_readWriteLock);
+    if (NULL == m_pProfile)
+    {
+        pthread_rwlock_wrlock(&m_readWriteLock);
+    }
+    else if (0 == pthread_rwlock_trywrlock(&m_readWriteLock))
+    {
+        LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+    }
+    else
+    {
+        UINT64 startNs = OsUtils::GetNanoSeconds();
+        pthread_rwlock_wrlock(&m_readWriteLock);
+        UINT64 acquiredNs = OsUtils::GetNanoSeconds();
+        LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, Utils::MaxUINT64(acquiredNs - startNs, 1), acquiredNs,
+                                    CAMX_RETURN_ADDRESS());
+    }
     INT lockCount = CamxAtomicInc(&m_lockCount);
     CAMX_TRACE_INT32_F(CamxLogGroupSync, lockCount, "%s: RWLock::LockCount" , m_pResourceName);
     CAMX_TRACE_SYNC_END(CamxLogGroupSync);
@@ -1606,6 +1663,10 @@ BOOL ReadWriteLock::TryReadLock()
     if (0 == pthread_rwlock_tryrdlock(&m_readWriteLock))
     {
         isAcquired = TRUE;
+        if (NULL != m_pProfile)
+        {
+            LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+        }
         INT lockCount = CamxAtomicInc(&m_lockCount);
         CAMX_TRACE_INT32_F(CamxLogGroupSync, lockCount, "%s: RWLock::LockCount" , m_pResourceName);
         CAMX_TRACE_MESSAGE_F(CamxLogGroupSync, "%s: Acquired lock", m_pResourceName);
@@ -1627,6 +1688,10 @@ BOOL ReadWriteLock::TryWriteLock()
     if (0 == pthread_rwlock_trywrlock(&m_readWriteLock))
     {
         isAcquired = TRUE;
+        if (NULL != m_pProfile)
+        {
+            LockProfiler::RecordAcquire(m_pProfile, &m_readWriteLock, 0, OsUtils::GetNanoSeconds(), CAMX_RETURN_ADDRESS());
+        }
         INT lockCount = CamxAtomicInc(&m_lockCount);
         CAMX_TRACE_INT32_F(CamxLogGroupSync, lockCount, "%s: RWLock::LockCount" , m_pResourceName);
         CAMX_TRACE_MESSAGE_F(CamxLogGroupSync, "%s: Acquired lock", m_pResourceName);
@@ -1644,6 +1709,10 @@ VOID ReadWriteLock::Unlock()
     INT lockCount = CamxAtomicDec(&m_lockCount);
     CAMX_TRACE_INT32_F(CamxLogGroupSync, lockCount, "%s: RWLock::LockCount" , m_pResourceName);
     CAMX_TRACE_MESSAGE_F(CamxLogGroupSync, "%s: Unlock", m_pResourceName);
+    if (NULL != m_pProfile)
+    {
+        LockProfiler::RecordRelease(&m_readWriteLock);
+    }
     pthread_rwlock_unlock(&m_readWriteLock);
 }
 
@@ -1667,6 +1736,11 @@ Semaphore* Semaphore::Create()
             CAMX_DELETE pSemaphore;
             pSemaphore = NULL;
         }
+        else
+        {
+            // Semaphores have no name, the profile is named after the creator
+            pSemaphore->m_pProfile = LockProfiler::Register(LockProfileType::Semaphore, NULL, CAMX_RETURN_ADDRESS());
+        }
     }
 
     return pSemaphore;
@@ -1714,7 +1788,21 @@ VOID Semaphore::Wait()
     CAMX_ENTRYEXIT_SCOPE_ID(CamxLogGroupSync, SCOPEEventOsUtilsSemaphoreWait, Utils::VoidPtrToUINT64(this));
     if (TRUE == m_validSemaphore)
     {
-        sem_wait(&m_semaphore);
+        if (NULL == m_pProfile)
+        {
+            sem_wait(&m_semaphore);
+        }
+        else if (0 == sem_trywait(&m_semaphore))
+        {
+            LockProfiler::RecordWait(m_pProfile, NULL, 0, CAMX_RETURN_ADDRESS());
+        }
+        else
+        {
+            UINT64 startNs = OsUtils::GetNanoSeconds();
+            sem_wait(&m_semaphore);
+            LockProfiler::RecordWait(m_pProfile, NULL, Utils::MaxUINT64(OsUtils::GetNanoSeconds() - startNs, 1),
+                                     CAMX_RETURN_ADDRESS());
+        }
     }
 }
 
@@ -1750,7 +1838,13 @@ CamxResult Semaphore::TimedWait(
     timeout.tv_sec      += static_cast<INT>(timeoutSeconds);
     timeout.tv_nsec     =  static_cast<INT>(timeoutNanoseconds);
 
+    UINT64 startNs = (NULL != m_pProfile) ? OsUtils::GetNanoSeconds() : 0;
     waitResult = sem_timedwait(&m_semaphore, &timeout);
+    if (NULL != m_pProfile)
+    {
+        LockProfiler::RecordWait(m_pProfile, NULL, Utils::MaxUINT64(OsUtils::GetNanoSeconds() - startNs, 1),
+                                 CAMX_RETURN_ADDRESS());
+    }
     if (waitResult != 0)
     {
         // Check errno for reason for failure
@@ -1814,6 +1908,7 @@ CamxResult Condition::Initialize(
     CamxResult result = CamxResultSuccess;
 
     m_pResource = pResource;
+    m_pProfile  = LockProfiler::Register(LockProfileType::Condition, m_pResource, CAMX_RETURN_ADDRESS());
 
     if (pthread_cond_init(&m_conditionVar, NULL) == 0)
     {
@@ -1839,10 +1934,20 @@ CamxResult Condition::Wait(
     INT         rc      = 0;
     CamxResult  result  = CamxResultEFailed;
 
+    // Time the wait whenever profiling is on so the hold time of a profiled mutex excludes it
+    BOOL    profile = ((NULL != m_pProfile) || (TRUE == LockProfiler::IsEnabled()));
+    UINT64  startNs = (TRUE == profile) ? OsUtils::GetNanoSeconds() : 0;
+
     CAMX_TRACE_ASYNC_END_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(phMutex), "ConditionLock %s", m_pResource);
     rc = pthread_cond_wait(&m_conditionVar, phMutex);
     CAMX_TRACE_ASYNC_BEGIN_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(phMutex), "ConditionLock %s", m_pResource);
 
+    if (TRUE == profile)
+    {
+        LockProfiler::RecordWait(m_pProfile, phMutex, Utils::MaxUINT64(OsUtils::GetNanoSeconds() - startNs, 1),
+                                 CAMX_RETURN_ADDRESS());
+    }
+
     if (0 == rc)
     {
         result = CamxResultSuccess;
@@ -1875,9 +1980,18 @@ CamxResult Condition::TimedWait(
     timeout.tv_sec      += static_cast<INT>(timeoutSeconds);
     timeout.tv_nsec     =  static_cast<INT>(timeoutNanoseconds);
 
+    BOOL    profile = ((NULL != m_pProfile) || (TRUE == LockProfiler::IsEnabled()));
+    UINT64  startNs = (TRUE == profile) ? OsUtils::GetNanoSeconds() : 0;
+
     CAMX_TRACE_ASYNC_END_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(phMutex), "ConditionLock %s", m_pResource);
     waitResult = pthread_cond_timedwait(&m_conditionVar, phMutex, &timeout);
     CAMX_TRACE_ASYNC_BEGIN_F(CamxLogGroupSync, Utils::VoidPtrToUINT64(phMutex), "ConditionLock %s", m_pResource);
+
+    if (TRUE == profile)
+    {
+        LockProfiler::RecordWait(m_pProfile, phMutex, Utils::MaxUINT64(OsUtils::GetNanoSeconds() - startNs, 1),
+                                 CAMX_RETURN_ADDRESS());
+    }
     if (waitResult != 0)
     {
         // Check errno for reason for failure
@@ -1989,7 +1989,10 @@ CDKResult ChiEISV2Node::FillGyroData(
                 }
                 else
                 {
-                    LOG_ERROR(CamxLogGroupChi, "Unable to get gyro sample from iterator");
+                    // Either a bad index or the producer overran the window; keep only the samples read so far
+                    LOG_ERROR(CamxLogGroupChi, "Unable to get gyro sample %u from iterator", i);
+                    dataSize = i;
+                    break;
                 }
             }
             pEIS2Input->gyro_data.num_elements = dataSize;
@@ -3643,19 +3646,17 @@ CDKResult ChiEISV2Node::ConvertICA20GridToICA10Grid(
                 pOutICA10Grid->extrapolateType = EXTRAPOLATION_TYPE_NONE;
             }
 
-            UINT32 indexICA10 = 0;
-            UINT32 indexICA20 = ICA20GridTransformWidth + 1;
+            // The ICA10 grid is the ICA20 grid without its perimeter, so each row is one contiguous copy. The conversion
+            // may be in place; the destination never runs ahead of the source, so rows are moved in order.
+            const SIZE_T rowSize    = ICA10GridTransformWidth * sizeof(pOutICA10Grid->grid[0]);
+            UINT32       indexICA10 = 0;
+            UINT32       indexICA20 = ICA20GridTransformWidth + 1;
 
             for (UINT32 row = 0; row < ICA10GridTransformHeight; row++)
             {
-                for (UINT32 column = 0; column < ICA10GridTransformWidth; column++)
-                {
-                    // optimized indexing
-                    pOutICA10Grid->grid[indexICA10] = pInICA20Grid->grid[indexICA20];
-                    indexICA10++;
-                    indexICA20++;
-                }
-                indexICA20 += 2;
+                memmove(&pOutICA10Grid->grid[indexICA10], &pInICA20Grid->grid[indexICA20], rowSize);
+                indexICA10 += ICA10GridTransformWidth;
+                indexICA20 += ICA10GridTransformWidth + 2;
             }
         }
     }
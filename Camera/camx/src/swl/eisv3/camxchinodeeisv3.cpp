@@ -55,6 +55,8 @@ static const UINT32 EISV3RequestQueueDepth = MaxEISV3FrameDelay + 8; ///< Reques
 static const UINT32 NumSensors             = 1;                      ///< Temp change - Number of camera sensors
 static const UINT32 GYRO_SAMPLES_BUF_SIZE  = 512;                    ///< Max Gyro sample size
 static const FLOAT  EISV3Margin            = 0.2F;                   ///< Default Stabilization margin
+static const UINT32 DefaultGyroWaitTimeMs  = 5;                      ///< Async mode: default wait budget for late gyro
+static const UINT32 GyroPollIntervalUs     = 500;                    ///< Async mode: poll interval while waiting for gyro
 
 ///< max gyro dumps alone per frame * 100 chars per gyro sample line per frame info
 static const UINT32 GyroDumpSize           = static_cast<UINT32>(GYRO_SAMPLES_BUF_SIZE * 103 + 150);
@@ -341,6 +343,23 @@ VOID EISV3GetOverrideSettings(
                 }
                 LOG_INFO(CamxLogGroupChi, "EISv3 operation mode %d", pOverrideSettings->algoOperationMode);
             }
+            else if (0 == strcmp("EISv3FrameDelay", pSettingString))
+            {
+                // Fewer lookahead frames lower the latency of the stabilized output at the cost of smoothing quality
+                UINT32 frameDelay = static_cast<UINT32>(atoi(pValueString));
+                pOverrideSettings->frameDelay = (MaxEISV3FrameDelay < frameDelay) ? MaxEISV3FrameDelay : frameDelay;
+                LOG_INFO(CamxLogGroupChi, "EISv3 frame delay %u", pOverrideSettings->frameDelay);
+            }
+            else if (0 == strcmp("EISv3AsyncExecution", pSettingString))
+            {
+                pOverrideSettings->isAsyncEnabled = (atoi(pValueString) == 1) ? 1 : 0;
+                LOG_INFO(CamxLogGroupChi, "EISv3 async execution %d", pOverrideSettings->isAsyncEnabled);
+            }
+            else if (0 == strcmp("EISv3GyroWaitTimeoutMs", pSettingString))
+            {
+                pOverrideSettings->gyroWaitTimeoutMs = static_cast<UINT32>(atoi(pValueString));
+                LOG_INFO(CamxLogGroupChi, "EISv3 gyro wait timeout %u ms", pOverrideSettings->gyroWaitTimeoutMs);
+            }
         }
 
         ChiNodeUtils::FClose(pEISSettingsTextFile);
@@ -386,6 +405,9 @@ CDKResult EISV3NodeCreate(
         overrideSettings.isLDCGridEnabled       = 0;
         overrideSettings.margins.widthMargin    = EISV3Margin;
         overrideSettings.margins.heightMargin   = EISV3Margin;
+        overrideSettings.frameDelay             = 0;
+        overrideSettings.isAsyncEnabled         = 0;
+        overrideSettings.gyroWaitTimeoutMs      = DefaultGyroWaitTimeMs;
 
 #if !_WINDOWS
         EISV3GetOverrideSettings(&overrideSettings);
@@ -473,6 +495,11 @@ CDKResult EISV3NodeCreate(
         {
             frameDelay = FPS60EISV3FrameDelay;
         }
+
+        if (0 != overrideSettings.frameDelay)
+        {
+            frameDelay = overrideSettings.frameDelay;
+        }
         pNode->SetFrameDelay(frameDelay);
 
         metadataInfo.size       = sizeof(CHIMETADATAINFO);
@@ -683,10 +710,53 @@ static CDKResult EISV3NodeOnStreamOn(CHINODEONSTREAMONINFO* pOnStreamOnInfo)
 static CDKResult EISV3NodeOnStreamOff(CHINODEONSTREAMOFFINFO* pOnStreamOffInfo)
 {
     CDKResult result = CDKResultSuccess;
-    CDK_UNUSED_PARAM(pOnStreamOffInfo);
 
     LOG_VERBOSE(CamxLogGroupChi, "EISv3 stream off: pOnStreamOffInfo: %p", pOnStreamOffInfo);
 
+    if ((NULL == pOnStreamOffInfo) || (NULL == pOnStreamOffInfo->hNodeSession))
+    {
+        result = CDKResultEInvalidPointer;
+        LOG_ERROR(CamxLogGroupChi, "Invalid argument");
+    }
+    else
+    {
+        ChiEISV3Node* pNode = static_cast<ChiEISV3Node*>(pOnStreamOffInfo->hNodeSession);
+        result = pNode->OnStreamOff();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// EISV3NodeFlushRequest
+///
+/// @brief  Implementation of PFNNODEFLUSHREQUEST defined in chinode.h
+///
+/// @param  pFlushRequestInfo   Pointer to a structure that defines the request being flushed
+///
+/// @return CDKResultSuccess if success or appropriate error code.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static CDKResult EISV3NodeFlushRequest(
+    CHINODEFLUSHREQUESTINFO* pFlushRequestInfo)
+{
+    CDKResult result = CDKResultSuccess;
+
+    if ((NULL == pFlushRequestInfo) || (NULL == pFlushRequestInfo->hNodeSession))
+    {
+        result = CDKResultEInvalidPointer;
+        LOG_ERROR(CamxLogGroupChi, "Invalid argument");
+    }
+    else if (pFlushRequestInfo->size < sizeof(CHINODEFLUSHREQUESTINFO))
+    {
+        LOG_ERROR(CamxLogGroupChi, "CHINODEFLUSHREQUESTINFO is smaller than expected");
+        result = CDKResultEFailed;
+    }
+    else
+    {
+        ChiEISV3Node* pNode = static_cast<ChiEISV3Node*>(pFlushRequestInfo->hNodeSession);
+        result = pNode->FlushRequest(pFlushRequestInfo->frameNum);
+    }
+
     return result;
 }
 
@@ -858,6 +928,7 @@ CDK_VISIBILITY_PUBLIC VOID ChiNodeEntry(
             pNodeCallbacks->pPrepareStreamOn         = EISV3NodePrepareStreamOn;
             pNodeCallbacks->pOnStreamOn              = EISV3NodeOnStreamOn;
             pNodeCallbacks->pOnStreamOff             = EISV3NodeOnStreamOff;
+            pNodeCallbacks->pFlushRequest            = EISV3NodeFlushRequest;
         }
         else
         {
@@ -1686,6 +1757,16 @@ CDKResult ChiEISV3Node::Initialize(
         LOG_ERROR(CamxLogGroupChi, "Load EISv3 algo lib failed");
     }
 
+    if ((CDKResultSuccess == result) && (TRUE == m_asyncEnabled))
+    {
+        if (CDKResultSuccess != StartAsyncWorker())
+        {
+            // Not fatal, the algo is executed on the request thread as without async mode
+            LOG_ERROR(CamxLogGroupChi, "Failed to start EISv3 async worker, executing synchronously");
+            m_asyncEnabled = FALSE;
+        }
+    }
+
     return result;
 }
 
@@ -2104,8 +2185,9 @@ CDKResult ChiEISV3Node::GetLDCGridFromICA20Chromatix(
 /// ChiEISV3Node::FillGyroData
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 CDKResult ChiEISV3Node::FillGyroData(
-    UINT64       requestId,
-    is_input_t*  pEIS3Input)
+    UINT64        requestId,
+    is_input_t*   pEIS3Input,
+    gyro_times_t* pGyroInterval)
 {
     CHIDATAHANDLE     hNCSDataHandle  = NULL;
     CHIDATAREQUEST    gyroDataRequest;
@@ -2179,7 +2261,10 @@ CDKResult ChiEISV3Node::FillGyroData(
                 }
                 else
                 {
-                    LOG_ERROR(CamxLogGroupChi, "Unable to get gyro sample from iterator");
+                    // Either a bad index or the producer overran the window; keep only the samples read so far
+                    LOG_ERROR(CamxLogGroupChi, "Unable to get gyro sample %u from iterator", i);
+                    dataSize = i;
+                    break;
                 }
             }
             pEIS3Input->gyro_data.num_elements = dataSize;
@@ -2198,6 +2283,99 @@ CDKResult ChiEISV3Node::FillGyroData(
         result = CDKResultEFailed;
     }
 
+    *pGyroInterval = gyroInterval;
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::FillGyroDataWithPrediction
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CDKResult ChiEISV3Node::FillGyroDataWithPrediction(
+    UINT64       requestId,
+    is_input_t*  pEIS3Input)
+{
+    gyro_times_t      gyroInterval  = { 0 };
+    gyro_sample_t*    pSamples      = pEIS3Input->gyro_data.gyro_data;
+    UINT64            startNs       = CamX::OsUtils::GetNanoSeconds();
+    UINT64            waitedUs      = 0;
+    UINT32            numSamples    = 0;
+    CDKResult         result        = FillGyroData(requestId, pEIS3Input, &gyroInterval);
+
+    // Without the fence dependency the end of the window may not have arrived yet, wait for it within the budget
+    while ((0 != gyroInterval.last_gyro_ts) && (waitedUs < (static_cast<UINT64>(m_gyroWaitTimeoutMs) * 1000)))
+    {
+        numSamples = pEIS3Input->gyro_data.num_elements;
+
+        if ((CDKResultSuccess == result) && (0 < numSamples) && (pSamples[numSamples - 1].ts >= gyroInterval.last_gyro_ts))
+        {
+            break;
+        }
+
+        CamX::OsUtils::SleepMicroseconds(GyroPollIntervalUs);
+        result   = FillGyroData(requestId, pEIS3Input, &gyroInterval);
+        waitedUs = (CamX::OsUtils::GetNanoSeconds() - startNs) / 1000;
+    }
+
+    // The request thread also executes requests when the async queue is full, so it may run this next to the worker
+    m_pAsyncLock->Lock();
+
+    m_asyncMetrics.gyroWaitUs += waitedUs;
+    numSamples                 = (CDKResultSuccess == result) ? pEIS3Input->gyro_data.num_elements : 0;
+
+    if (0 == gyroInterval.last_gyro_ts)
+    {
+        // The window itself is unknown, nothing to predict
+        result = CDKResultEFailed;
+    }
+    else if ((0 == numSamples) && (FALSE == m_lastGyroSampleValid))
+    {
+        LOG_ERROR(CamxLogGroupChi, "No gyro sample received yet, cannot predict request %" PRIu64, requestId);
+        result = CDKResultEFailed;
+    }
+    else
+    {
+        gyro_sample_t lastSample = (0 < numSamples) ? pSamples[numSamples - 1] : m_lastGyroSample;
+
+        if (lastSample.ts < gyroInterval.last_gyro_ts)
+        {
+            // Predict the missing end of the window by holding the last angular rate, one sample per gyro period
+            FLOAT  gyroRate = GetGyroFrequency(m_activeSensorIdx);
+            UINT64 periodUs = static_cast<UINT64>(1000000.0f / ((0.0f < gyroRate) ? gyroRate : GyroSamplingRate));
+
+            // A period of 0, from a rate above 1 MHz, would never advance the predicted timestamps
+            periodUs = (0 < periodUs) ? periodUs : 1;
+
+            UINT64 fromTs = (lastSample.ts > gyroInterval.first_gyro_ts) ? lastSample.ts : gyroInterval.first_gyro_ts;
+            UINT64 ts     = (0 < numSamples) ? (lastSample.ts + periodUs) : fromTs;
+
+            while ((GYRO_SAMPLES_BUF_SIZE > numSamples) && (ts <= gyroInterval.last_gyro_ts))
+            {
+                pSamples[numSamples]    = lastSample;
+                pSamples[numSamples].ts = ts;
+                numSamples++;
+                ts += periodUs;
+            }
+
+            m_asyncMetrics.lateGyroCount++;
+            m_asyncMetrics.predictedGyroUs += gyroInterval.last_gyro_ts - fromTs;
+
+            LOG_INFO(CamxLogGroupChi, "Late gyro for request %" PRIu64 ", predicted %" PRIu64 " us after waiting %"
+                     PRIu64 " us", requestId, gyroInterval.last_gyro_ts - fromTs, waitedUs);
+        }
+
+        pEIS3Input->gyro_data.num_elements = numSamples;
+        result                             = (0 < numSamples) ? CDKResultSuccess : CDKResultEFailed;
+
+        if (CDKResultSuccess == result)
+        {
+            m_lastGyroSample      = pSamples[numSamples - 1];
+            m_lastGyroSampleValid = TRUE;
+        }
+    }
+
+    m_pAsyncLock->Unlock();
+
     return result;
 }
 
@@ -2400,7 +2578,17 @@ CDKResult ChiEISV3Node::ExecuteAlgo(
 
     eis3Input.gyro_data.gyro_data    = &input_gyro_data_t[0];
     eis3Input.gyro_data.num_elements = 0;
-    result = FillGyroData(requestId, &eis3Input);
+
+    if (TRUE == m_asyncEnabled)
+    {
+        result = FillGyroDataWithPrediction(requestId, &eis3Input);
+    }
+    else
+    {
+        gyro_times_t gyroInterval = { 0 };
+
+        result = FillGyroData(requestId, &eis3Input, &gyroInterval);
+    }
 
     if (CDKResultSuccess == result)
     {
@@ -2508,6 +2696,312 @@ BOOL ChiEISV3Node::IsEISv3Disabled(
     return eisDisabled;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::ExecuteAndPublish
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT64 ChiEISV3Node::ExecuteAndPublish(
+    UINT64 requestId,
+    BOOL   runAlgo)
+{
+    CDKResult      result = CDKResultSuccess;
+    UINT64         algoUs = 0;
+    is_output_type eis3Output;
+
+    NcLibPerspTransformSingle perspectiveMatrix[MaxPerspMatrixSize]                               = { { { 0 } } };
+    NcLibWarpGridCoord        perspectiveGrid[ICA20GridTransformWidth * ICA20GridTransformHeight] = { { 0 } };
+    NcLibWarpGridCoord        gridExtrapolateICA10[NumICA10Exterpolate]                           = { { 0 } };
+
+    memset(&eis3Output, 0, sizeof(is_output_type));
+
+    if (TRUE == runAlgo)
+    {
+        //< Initialize output to default matrix
+        eis3Output.stabilizationTransform.matrices.perspMatrices = &perspectiveMatrix[0];
+        eis3Output.stabilizationTransform.grid.grid              = &perspectiveGrid[0];
+        eis3Output.stabilizationTransform.grid.gridExtrapolate   = &gridExtrapolateICA10[0];
+
+        ///< Execute Algo
+        UINT64 startNs = CamX::OsUtils::GetNanoSeconds();
+
+        result = ExecuteAlgo(requestId, &eis3Output);
+        algoUs = (CamX::OsUtils::GetNanoSeconds() - startNs) / 1000;
+
+        if (CDKResultSuccess != result)
+        {
+            LOG_ERROR(CamxLogGroupChi, "EISv3 algo execution failed for request %" PRIu64, requestId);
+            ///< Update metadata with default result
+            eis3Output.has_output = FALSE;
+        }
+        else
+        {
+            eis3Output.has_output = TRUE;
+
+            // convert ICA20 grid to ICA10 if ICA version is 10
+            if (ChiICAVersion::ChiICA10 == m_ICAVersion)
+            {
+                // converting grid inplace
+                result = ConvertICA20GridToICA10Grid(&eis3Output.stabilizationTransform.grid,
+                                                     &eis3Output.stabilizationTransform.grid);
+
+                if (CDKResultSuccess != result)
+                {
+                    LOG_ERROR(CamxLogGroupChi, "Grid conversion failed for request %" PRIu64, requestId);
+                    eis3Output.stabilizationTransform.grid.enable = FALSE;
+                }
+            }
+        }
+    }
+    else
+    {
+        LOG_VERBOSE(CamxLogGroupChi, "EISv3 algo execution disabled %" PRIu64, requestId);
+        ///< Update metadata with default result
+        eis3Output.has_output = FALSE;
+    }
+
+    ///< Update metadata with result
+    UpdateMetaData(requestId, &eis3Output);
+
+    // Send the Request Done for this node in order to not delay the preview buffer
+    CHINODEPROCESSMETADATADONEINFO metadataDoneInfo;
+    metadataDoneInfo.size        = sizeof(metadataDoneInfo);
+    metadataDoneInfo.hChiSession = m_hChiSession;
+    metadataDoneInfo.frameNum    = requestId;
+    metadataDoneInfo.result      = CDKResultSuccess;
+    g_ChiNodeInterface.pProcessMetadataDone(&metadataDoneInfo);
+
+    CHINODEPROCESSREQUESTDONEINFO requestIdDoneInfo;
+    requestIdDoneInfo.size                  = sizeof(requestIdDoneInfo);
+    requestIdDoneInfo.hChiSession           = m_hChiSession;
+    requestIdDoneInfo.frameNum              = requestId;
+    requestIdDoneInfo.result                = CDKResultSuccess;
+    requestIdDoneInfo.isEarlyMetadataDone   = TRUE;
+    g_ChiNodeInterface.pProcessRequestDone(&requestIdDoneInfo);
+
+    return algoUs;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::StartAsyncWorker
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CDKResult ChiEISV3Node::StartAsyncWorker()
+{
+    CDKResult result = CDKResultSuccess;
+
+    m_pAsyncLock      = CamX::Mutex::Create("EISV3AsyncLock");
+    m_pAsyncCondition = CamX::Condition::Create("EISV3AsyncCondition");
+
+    if ((NULL == m_pAsyncLock) || (NULL == m_pAsyncCondition))
+    {
+        result = CDKResultENoMemory;
+    }
+    else if (CamxResultSuccess != CamX::OsUtils::ThreadCreate(AsyncWorkerThread, this, &m_hAsyncThread))
+    {
+        result = CDKResultEFailed;
+    }
+    else
+    {
+        m_asyncThreadCreated = TRUE;
+        CamX::OsUtils::ThreadSetName(m_hAsyncThread, "EISV3Async");
+    }
+
+    if (CDKResultSuccess != result)
+    {
+        StopAsyncWorker();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::StopAsyncWorker
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiEISV3Node::StopAsyncWorker()
+{
+    if (TRUE == m_asyncThreadCreated)
+    {
+        m_pAsyncLock->Lock();
+        m_asyncStop = TRUE;
+        m_pAsyncCondition->Broadcast();
+        m_pAsyncLock->Unlock();
+
+        CamX::OsUtils::ThreadWait(m_hAsyncThread);
+        m_asyncThreadCreated = FALSE;
+
+        LOG_INFO(CamxLogGroupChi,
+                 "EISv3 async: requests %" PRIu64 ", late gyro %" PRIu64 ", gyro wait %" PRIu64 " us, predicted gyro %"
+                 PRIu64 " us, algo off request threads %" PRIu64 " us, stall avoided %" PRIu64 " us",
+                 m_asyncMetrics.requestCount,
+                 m_asyncMetrics.lateGyroCount,
+                 m_asyncMetrics.gyroWaitUs,
+                 m_asyncMetrics.predictedGyroUs,
+                 m_asyncMetrics.offloadedAlgoUs,
+                 m_asyncMetrics.predictedGyroUs + m_asyncMetrics.offloadedAlgoUs);
+    }
+
+    if (NULL != m_pAsyncCondition)
+    {
+        m_pAsyncCondition->Destroy();
+        m_pAsyncCondition = NULL;
+    }
+
+    if (NULL != m_pAsyncLock)
+    {
+        m_pAsyncLock->Destroy();
+        m_pAsyncLock = NULL;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::PostAsyncJob
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CDKResult ChiEISV3Node::PostAsyncJob(
+    UINT64 requestId,
+    BOOL   runAlgo)
+{
+    CDKResult result = CDKResultSuccess;
+
+    m_pAsyncLock->Lock();
+
+    if (EISV3AsyncQueueDepth > m_asyncQueueCount)
+    {
+        EISV3AsyncJob* pJob = &m_asyncQueue[(m_asyncQueueHead + m_asyncQueueCount) % EISV3AsyncQueueDepth];
+
+        pJob->requestId = requestId;
+        pJob->runAlgo   = runAlgo;
+        pJob->isFlushed = FALSE;
+        m_asyncQueueCount++;
+        m_pAsyncCondition->Broadcast();
+    }
+    else
+    {
+        result = CDKResultEFailed;
+    }
+
+    m_pAsyncLock->Unlock();
+
+    if (CDKResultSuccess != result)
+    {
+        // The queued requests run before this one so that the algo still sees requests in order
+        LOG_ERROR(CamxLogGroupChi, "EISv3 async queue full, executing request %" PRIu64 " synchronously", requestId);
+        WaitForAsyncIdle();
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::WaitForAsyncIdle
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID ChiEISV3Node::WaitForAsyncIdle()
+{
+    if (TRUE == m_asyncThreadCreated)
+    {
+        m_pAsyncLock->Lock();
+
+        while ((0 < m_asyncQueueCount) || (TRUE == m_asyncBusy))
+        {
+            m_pAsyncCondition->Wait(m_pAsyncLock->GetNativeHandle());
+        }
+
+        m_pAsyncLock->Unlock();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::OnStreamOff
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CDKResult ChiEISV3Node::OnStreamOff()
+{
+    // Requests still queued were not flushed, they are executed before the session is deactivated or parked
+    WaitForAsyncIdle();
+
+    return CDKResultSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::FlushRequest
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CDKResult ChiEISV3Node::FlushRequest(
+    UINT64 requestId)
+{
+    if (TRUE == m_asyncThreadCreated)
+    {
+        m_pAsyncLock->Lock();
+
+        for (UINT32 i = 0; i < m_asyncQueueCount; i++)
+        {
+            EISV3AsyncJob* pJob = &m_asyncQueue[(m_asyncQueueHead + i) % EISV3AsyncQueueDepth];
+
+            if (requestId == pJob->requestId)
+            {
+                pJob->isFlushed = TRUE;
+            }
+        }
+
+        // The request's results are being published, let the worker finish before the flush completes the request
+        while ((TRUE == m_asyncBusy) && (requestId == m_asyncBusyRequestId))
+        {
+            m_pAsyncCondition->Wait(m_pAsyncLock->GetNativeHandle());
+        }
+
+        m_pAsyncLock->Unlock();
+    }
+
+    return CDKResultSuccess;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ChiEISV3Node::AsyncWorkerThread
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* ChiEISV3Node::AsyncWorkerThread(
+    VOID* pArg)
+{
+    ChiEISV3Node* pNode = static_cast<ChiEISV3Node*>(pArg);
+
+    pNode->m_pAsyncLock->Lock();
+
+    while (TRUE)
+    {
+        while ((0 == pNode->m_asyncQueueCount) && (FALSE == pNode->m_asyncStop))
+        {
+            pNode->m_pAsyncCondition->Wait(pNode->m_pAsyncLock->GetNativeHandle());
+        }
+
+        if (0 == pNode->m_asyncQueueCount)
+        {
+            break;
+        }
+
+        EISV3AsyncJob job = pNode->m_asyncQueue[pNode->m_asyncQueueHead];
+
+        pNode->m_asyncQueueHead = (pNode->m_asyncQueueHead + 1) % EISV3AsyncQueueDepth;
+        pNode->m_asyncQueueCount--;
+
+        if (TRUE == job.isFlushed)
+        {
+            LOG_INFO(CamxLogGroupChi, "EISv3 async: dropping flushed request %" PRIu64, job.requestId);
+            pNode->m_pAsyncCondition->Broadcast();
+            continue;
+        }
+
+        pNode->m_asyncBusy          = TRUE;
+        pNode->m_asyncBusyRequestId = job.requestId;
+        pNode->m_pAsyncLock->Unlock();
+
+        UINT64 algoUs = pNode->ExecuteAndPublish(job.requestId, job.runAlgo);
+
+        pNode->m_pAsyncLock->Lock();
+        pNode->m_asyncMetrics.requestCount++;
+        pNode->m_asyncMetrics.offloadedAlgoUs += algoUs;
+        pNode->m_asyncBusy                     = FALSE;
+        pNode->m_pAsyncCondition->Broadcast();
+    }
+
+    pNode->m_pAsyncLock->Unlock();
+
+    return NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// ChiEISV3Node::ProcessRequest
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -2557,6 +3051,9 @@ CDKResult ChiEISV3Node::ProcessRequest(
             pProcessRequestInfo->isDelayedRequestDone = TRUE;
         }
 
+        // The end of stream results are computed on this thread, the worker must not execute the algo concurrently
+        WaitForAsyncIdle();
+
         m_pEndOfStreamLock->Lock();
 
         if (FALSE == m_endOfStreamOutputArrayFilled)
@@ -2782,7 +3279,15 @@ CDKResult ChiEISV3Node::ProcessRequest(
     if ((1 == sequenceNumber) && (TRUE == hasDependencies))
     {
         LOG_VERBOSE(CamxLogGroupChi, "Seq number %d", sequenceNumber);
-        SetGyroDependency(pProcessRequestInfo);
+        if (TRUE == m_asyncEnabled)
+        {
+            // The worker fetches the gyro data itself and predicts it if it is late, do not wait on the gyro fence
+            sequenceNumber = 2;
+        }
+        else
+        {
+            SetGyroDependency(pProcessRequestInfo);
+        }
         pProcessRequestInfo->pDependency->processSequenceId = 2;
     }
     if ((2 == sequenceNumber) && (TRUE == hasDependencies))
@@ -2810,68 +3315,15 @@ CDKResult ChiEISV3Node::ProcessRequest(
     if ((3 == sequenceNumber) && (TRUE == hasDependencies))
     {
         LOG_VERBOSE(CamxLogGroupChi, "Seq number %d", sequenceNumber);
-        if ((FALSE == isEISv3DisabledDependentRequest) || (FALSE == isEISv3DisabledCurrentRequest))
-        {
-            //< Initialize output to default matrix
-            eis3Output.stabilizationTransform.matrices.perspMatrices = &perspectiveMatrix[0];
-            eis3Output.stabilizationTransform.grid.grid              = &perspectiveGrid[0];
-            eis3Output.stabilizationTransform.grid.gridExtrapolate   = &gridExtrapolateICA10[0];
-
-            ///< Execute Algo
-            result = ExecuteAlgo(pProcessRequestInfo->frameNum, &eis3Output);
-            if (CDKResultSuccess != result)
-            {
-                LOG_ERROR(CamxLogGroupChi, "EISv3 algo execution failed for request %" PRIu64, pProcessRequestInfo->frameNum);
-                ///< Update metadata with default result
-                eis3Output.has_output = FALSE;
-                result                = CDKResultSuccess;
-            }
-            else
-            {
-                eis3Output.has_output = TRUE;
+        BOOL runAlgo = ((FALSE == isEISv3DisabledDependentRequest) || (FALSE == isEISv3DisabledCurrentRequest));
 
-                // convert ICA20 grid to ICA10 if ICA version is 10
-                if (ChiICAVersion::ChiICA10 == m_ICAVersion)
-                {
-                    // converting grid inplace
-                    result = ConvertICA20GridToICA10Grid(&eis3Output.stabilizationTransform.grid,
-                                                         &eis3Output.stabilizationTransform.grid);
-
-                    if (CDKResultSuccess != result)
-                    {
-                        LOG_ERROR(CamxLogGroupChi, "Grid conversion failed for request %" PRIu64,
-                                  pProcessRequestInfo->frameNum);
-                        eis3Output.stabilizationTransform.grid.enable = FALSE;
-                    }
-                }
-            }
-        }
-        else
+        // In async mode the worker publishes the result, which is what the dependencies below and the next request's
+        // sequence 2 wait on, so the request thread is released while the algo executes
+        if ((FALSE == m_asyncEnabled) || (CDKResultSuccess != PostAsyncJob(pProcessRequestInfo->frameNum, runAlgo)))
         {
-            LOG_VERBOSE(CamxLogGroupChi, "EISv3 algo execution disabled %" PRIu64, pProcessRequestInfo->frameNum);
-            ///< Update metadata with default result
-            eis3Output.has_output = FALSE;
+            ExecuteAndPublish(pProcessRequestInfo->frameNum, runAlgo);
         }
 
-        ///< Update metadata with result
-        UpdateMetaData(pProcessRequestInfo->frameNum, &eis3Output);
-
-        // Send the Request Done for this node in order to not delay the preview buffer
-        CHINODEPROCESSMETADATADONEINFO metadataDoneInfo;
-        metadataDoneInfo.size        = sizeof(metadataDoneInfo);
-        metadataDoneInfo.hChiSession = m_hChiSession;
-        metadataDoneInfo.frameNum    = pProcessRequestInfo->frameNum;
-        metadataDoneInfo.result      = CDKResultSuccess;
-        g_ChiNodeInterface.pProcessMetadataDone(&metadataDoneInfo);
-
-        CHINODEPROCESSREQUESTDONEINFO requestIdDoneInfo;
-        requestIdDoneInfo.size                  = sizeof(requestIdDoneInfo);
-        requestIdDoneInfo.hChiSession           = m_hChiSession;
-        requestIdDoneInfo.frameNum              = pProcessRequestInfo->frameNum;
-        requestIdDoneInfo.result                = CDKResultSuccess;
-        requestIdDoneInfo.isEarlyMetadataDone   = TRUE;
-        g_ChiNodeInterface.pProcessRequestDone(&requestIdDoneInfo);
-
         pDependencyInfo = pProcessRequestInfo->pDependency;
         depCount        = 0;
 
@@ -2966,6 +3418,15 @@ ChiEISV3Node::ChiEISV3Node(
     , m_lastEIS3publishedRequest(0)
     , m_pLDCIn2OutGrid(NULL)
     , m_pLDCOut2InGrid(NULL)
+    , m_asyncThreadCreated(FALSE)
+    , m_pAsyncLock(NULL)
+    , m_pAsyncCondition(NULL)
+    , m_asyncQueueHead(0)
+    , m_asyncQueueCount(0)
+    , m_asyncBusy(FALSE)
+    , m_asyncBusyRequestId(0)
+    , m_asyncStop(FALSE)
+    , m_lastGyroSampleValid(FALSE)
 {
     m_lookahead                         = DefaultEISV3FrameDelay;
     m_algoInitialized                   = FALSE;
@@ -2984,7 +3445,11 @@ ChiEISV3Node::ChiEISV3Node(
     m_LDCIn2OutWarpGrid                 = { 0 };
     m_LDCOut2InWarpGrid                 = { 0 };
     m_bIsLDCGridEnabled                 = overrideSettings.isLDCGridEnabled;
+    m_asyncEnabled                      = overrideSettings.isAsyncEnabled;
+    m_gyroWaitTimeoutMs                 = overrideSettings.gyroWaitTimeoutMs;
     memset(&m_hChiDataSource, 0, sizeof(CHIDATASOURCE));
+    memset(&m_asyncMetrics, 0, sizeof(m_asyncMetrics));
+    memset(&m_lastGyroSample, 0, sizeof(m_lastGyroSample));
     memset(&m_perSensorData, 0, sizeof(EISV3PerSensorData));
 }
 
@@ -2995,6 +3460,9 @@ ChiEISV3Node::~ChiEISV3Node()
 {
     CDKResult result = CDKResultSuccess;
 
+    // The worker may still be executing the algo, stop it before the algo goes away
+    StopAsyncWorker();
+
     ///< Deinitialize algo
     if (TRUE == m_algoInitialized)
     {
@@ -4113,19 +4581,17 @@ CDKResult ChiEISV3Node::ConvertICA20GridToICA10Grid(
                 pOutICA10Grid->extrapolateType = EXTRAPOLATION_TYPE_NONE;
             }
 
-            UINT32 indexICA10 = 0;
-            UINT32 indexICA20 = ICA20GridTransformWidth + 1;
+            // The ICA10 grid is the ICA20 grid without its perimeter, so each row is one contiguous copy. The conversion
+            // may be in place; the destination never runs ahead of the source, so rows are moved in order.
+            const SIZE_T rowSize    = ICA10GridTransformWidth * sizeof(pOutICA10Grid->grid[0]);
+            UINT32       indexICA10 = 0;
+            UINT32       indexICA20 = ICA20GridTransformWidth + 1;
 
             for (UINT32 row = 0; row < ICA10GridTransformHeight; row++)
             {
-                for (UINT32 column = 0; column < ICA10GridTransformWidth; column++)
-                {
-                    // optimized indexing
-                    pOutICA10Grid->grid[indexICA10] = pInICA20Grid->grid[indexICA20];
-                    indexICA10++;
-                    indexICA20++;
-                }
-                indexICA20 += 2;
+                memmove(&pOutICA10Grid->grid[indexICA10], &pInICA20Grid->grid[indexICA20], rowSize);
+                indexICA10 += ICA10GridTransformWidth;
+                indexICA20 += ICA10GridTransformWidth + 2;
             }
         }
     }
@@ -77,9 +77,31 @@ struct EISV3OverrideSettings
     cam_is_operation_mode_t     algoOperationMode;  ///< Calibration mode
     BOOL                        isGyroDumpEnabled;  ///< Flag to indicate if Gyro Dump enabled
     BOOL                        isLDCGridEnabled;   ///< Flag for LDC grid enable
+    UINT32                      frameDelay;         ///< Lookahead frames, 0 to select it from the usecase
+    BOOL                        isAsyncEnabled;     ///< Run the algo on a worker thread instead of the request thread
+    UINT32                      gyroWaitTimeoutMs;  ///< Async mode: time to wait for late gyro before predicting it
 };
 
-static const INT    MaxMulticamSensors = 2;
+/// @brief Request handed to the asynchronous EISv3 worker
+struct EISV3AsyncJob
+{
+    UINT64 requestId;   ///< Request to execute
+    BOOL   runAlgo;     ///< FALSE when EISv3 is disabled for the request and its lookahead request
+    BOOL   isFlushed;   ///< Request was flushed while queued, the worker drops it
+};
+
+/// @brief Counters of the asynchronous EISv3 execution
+struct EISV3AsyncMetrics
+{
+    UINT64 requestCount;        ///< Requests executed by the worker
+    UINT64 lateGyroCount;       ///< Requests whose gyro window was still incomplete when the wait budget ran out
+    UINT64 gyroWaitUs;          ///< Time spent waiting for late gyro samples
+    UINT64 predictedGyroUs;     ///< Gyro time filled with predicted motion instead of being waited for
+    UINT64 offloadedAlgoUs;     ///< Algo time spent on the worker instead of the request threads
+};
+
+static const INT    MaxMulticamSensors   = 2;
+static const UINT32 EISV3AsyncQueueDepth = 8;   ///< Requests the asynchronous worker can have pending
 static const UINT64 QtimerFrequency    = 19200000;  ///< QTimer Freq = 19.2 MHz
 
 // NOWHINE FILE NC004c: Things outside the Camx namespace should be prefixed with Camx/CSL
@@ -134,6 +156,28 @@ public:
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     CDKResult PostPipelineCreate();
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// OnStreamOff
+    ///
+    /// @brief  Implementation of PFNNODEONSTREAMOFF defined in chinode.h, executes the requests the worker has pending
+    ///
+    /// @return CDKResultSuccess if success or appropriate error code.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CDKResult OnStreamOff();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FlushRequest
+    ///
+    /// @brief  Implementation of PFNNODEFLUSHREQUEST defined in chinode.h. The request is dropped if the worker has it
+    ///         queued, and waited for if the worker is executing it, so that nothing is published for it once flushed.
+    ///
+    /// @param  requestId   Request Id
+    ///
+    /// @return CDKResultSuccess if success or appropriate error code.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CDKResult FlushRequest(
+        UINT64 requestId);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// GetDataSource
     ///
@@ -417,14 +461,98 @@ private:
     ///
     /// @brief  Get Gyro data required for EIS Algo Input
     ///
-    /// @param  requestId   Request Id
-    /// @param  pEIS2Input  EIS algo input data
+    /// @param  requestId       Request Id
+    /// @param  pEIS2Input      EIS algo input data
+    /// @param  pGyroInterval   Returned gyro window requested by the algo, zero if it could not be queried
     ///
     /// @return CDKResultSuccess if success or appropriate error code.
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     CDKResult FillGyroData(
         UINT64                   requestId,
-        is_input_t*              pEIS3Input);
+        is_input_t*              pEIS3Input,
+        gyro_times_t*            pGyroInterval);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FillGyroDataWithPrediction
+    ///
+    /// @brief  Get the gyro data of a request without a fence dependency. Samples missing at the end of the requested window
+    ///         are waited for up to the gyro wait timeout, then predicted by holding the last angular rate.
+    ///
+    /// @param  requestId   Request Id
+    /// @param  pEIS3Input  EIS algo input data
+    ///
+    /// @return CDKResultSuccess if success or appropriate error code.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CDKResult FillGyroDataWithPrediction(
+        UINT64      requestId,
+        is_input_t* pEIS3Input);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ExecuteAndPublish
+    ///
+    /// @brief  Execute the algo for a request, publish its result and signal metadata and request done
+    ///
+    /// @param  requestId   Request Id
+    /// @param  runAlgo     FALSE to publish the default result without executing the algo
+    ///
+    /// @return Time the algo took to execute, in microseconds, 0 if it did not execute
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    UINT64 ExecuteAndPublish(
+        UINT64 requestId,
+        BOOL   runAlgo);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// StartAsyncWorker
+    ///
+    /// @brief  Create the worker thread that executes the algo in async mode
+    ///
+    /// @return CDKResultSuccess if success or appropriate error code.
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CDKResult StartAsyncWorker();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// StopAsyncWorker
+    ///
+    /// @brief  Execute the pending requests, stop the worker thread and log the async metrics
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID StopAsyncWorker();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// PostAsyncJob
+    ///
+    /// @brief  Queue a request to the worker
+    ///
+    /// @param  requestId   Request Id
+    /// @param  runAlgo     FALSE to publish the default result without executing the algo
+    ///
+    /// @return CDKResultSuccess if queued, CDKResultEFailed if the queue is full
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CDKResult PostAsyncJob(
+        UINT64 requestId,
+        BOOL   runAlgo);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// WaitForAsyncIdle
+    ///
+    /// @brief  Wait until the worker executed all queued requests, so that the algo can be called from the request thread
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID WaitForAsyncIdle();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// AsyncWorkerThread
+    ///
+    /// @brief  Entry of the worker thread, executes queued requests in order
+    ///
+    /// @param  pArg    The node
+    ///
+    /// @return NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* AsyncWorkerThread(
+        VOID* pArg);
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     /// QtimerTicksToQtimerNano
@@ -611,6 +739,21 @@ private:
     NcLibWarpGrid                      m_LDCOut2InWarpGrid;                 ///< LDC out to in warp grid
     NcLibWarpGridCoord*                m_pLDCIn2OutGrid;                    ///< Pointer to LDC in to out grid
     NcLibWarpGridCoord*                m_pLDCOut2InGrid;                    ///< Pointer to LDC out to in grid
+    BOOL                               m_asyncEnabled;                      ///< Execute the algo on m_hAsyncThread
+    UINT32                             m_gyroWaitTimeoutMs;                 ///< Wait budget for late gyro in async mode
+    CamX::OSThreadHandle               m_hAsyncThread;                      ///< Worker thread of the async mode
+    BOOL                               m_asyncThreadCreated;                ///< m_hAsyncThread is running
+    CamX::Mutex*                       m_pAsyncLock;                        ///< Protects the async queue and state
+    CamX::Condition*                   m_pAsyncCondition;                   ///< Signals queue and idle state changes
+    EISV3AsyncJob                      m_asyncQueue[EISV3AsyncQueueDepth];  ///< Pending requests, in request order
+    UINT32                             m_asyncQueueHead;                    ///< Index of the oldest pending request
+    UINT32                             m_asyncQueueCount;                   ///< Number of pending requests
+    BOOL                               m_asyncBusy;                         ///< Worker is executing a request
+    UINT64                             m_asyncBusyRequestId;                ///< Request the worker is executing
+    BOOL                               m_asyncStop;                         ///< Worker should exit once the queue is empty
+    EISV3AsyncMetrics                  m_asyncMetrics;                      ///< Async execution counters
+    gyro_sample_t                      m_lastGyroSample;                    ///< Last gyro sample received, for prediction
+    BOOL                               m_lastGyroSampleValid;               ///< m_lastGyroSample holds a sample
 };
 
 #endif // CAMXCHINODEEISV3_H
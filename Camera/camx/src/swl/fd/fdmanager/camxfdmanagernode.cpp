@@ -3580,8 +3580,15 @@ CamxResult FDManagerNode::PopulateGravityData(
                 }
             }
 
+            // Samples are read in place from the lock-free ring, drop them if the producer lapped the window meanwhile
+            BOOL isValid = pDataObj->IsValid();
+
             m_pNCSSensorHandleGravity->PutBackDataObj(pDataObj);
-            if (index == sampleCount)
+            if (FALSE == isValid)
+            {
+                result = CamxResultEFailed;
+            }
+            else if (index == sampleCount)
             {
                 result = CamxResultSuccess;
             }
@@ -28,6 +28,7 @@ LOCAL_C_INCLUDES := $(CAMX_C_INCLUDES)                                   \
     $(CAMX_PATH)/src/core                                                \
     $(CAMX_PATH)/src/generated/g_parser                                  \
     $(CAMX_PATH)/src/swl/ransac                                          \
+    $(CAMX_PATH)/src/hwl/dspinterfaces                                   \
     $(CAMX_PATH)/src/hwl/titan17x                                        \
     $(CAMX_SYSTEM_PATH)/firmware                                         \
     $(CAMX_SYSTEM_PATH)/nclib/Logic/LRME_helpers                         \
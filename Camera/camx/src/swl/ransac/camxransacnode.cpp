@@ -30,6 +30,9 @@ CAMX_NAMESPACE_BEGIN
 const static UINT g_RANSACMaxInputPorts  = 1;
 const static UINT g_RANSACMaxOutputPorts = 0;
 
+// @brief FastRPC module of the estimate kernel on the CDSP. Without it the estimates run on the CPU reference kernel.
+static const CHAR* g_pRANSACDSPModule = "camxransac";
+
 // @brief list of vendor tags published by Ransac
 static const struct NodeVendorTag g_RANSACOutputVendorTags[] =
 {
@@ -46,6 +49,16 @@ RANSACNode::RANSACNode()
     m_numOutputPorts             = g_RANSACMaxOutputPorts;
     m_derivedNodeHandlesMetaDone = TRUE;
     m_forceIdentityTransform     = 0;
+    m_solveCount                 = 0;
+    m_solveTimeNs                = 0;
+    m_adaptiveSkipCount          = 0;
+    m_pDSPOffload                = NULL;
+
+    for (UINT i = 0; i < MaxRequestQueueDepth; i++)
+    {
+        m_estimates[i].isSubmitted  = FALSE;
+        m_estimates[i].fence.hFence = CSLInvalidFence;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -75,6 +88,34 @@ RANSACNode* RANSACNode::Create(
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 VOID RANSACNode::Cleanup()
 {
+    UINT64 numRequests = m_solveCount + m_adaptiveSkipCount;
+
+    if (NULL != m_pDSPOffload)
+    {
+        // Waits for the running estimates, they write to m_estimates and signal its fences
+        m_pDSPOffload->Destroy();
+        m_pDSPOffload = NULL;
+    }
+
+    for (UINT i = 0; i < MaxRequestQueueDepth; i++)
+    {
+        if (CSLInvalidFence != m_estimates[i].fence.hFence)
+        {
+            CSLReleaseFence(m_estimates[i].fence.hFence);
+            m_estimates[i].fence.hFence = CSLInvalidFence;
+        }
+    }
+
+    if (0 < numRequests)
+    {
+        CAMX_LOG_INFO(CamxLogGroupLRME, "Estimated %llu of %llu transforms, duty cycle %llu%%, average %llu us",
+                      m_solveCount, numRequests, (m_solveCount * 100) / numRequests,
+                      (0 < m_solveCount) ? (m_solveTimeNs / m_solveCount) / 1000 : 0);
+        m_solveCount        = 0;
+        m_solveTimeNs       = 0;
+        m_adaptiveSkipCount = 0;
+    }
+
     return;
 }
 
@@ -113,6 +154,19 @@ CamxResult RANSACNode::ProcessingNodeInitialize(
 
     pCreateOutputData->bufferComposite.hasCompositeMask = FALSE;
 
+    result = DSPOffload::Create(GetThreadManager(), m_pNodeName, &m_pDSPOffload);
+    if (CamxResultSuccess != result)
+    {
+        CAMX_LOG_ERROR(CamxLogGroupLRME, "Failed to create the estimate offloader, result=%d", result);
+    }
+
+    if (TRUE == GetHwContext()->GetStaticSettings()->enableParallelRANSAC)
+    {
+        // The estimates run in parallel, the posting stays in request order through a dependency on the previous request
+        m_parallelProcessRequests = TRUE;
+        CAMX_LOG_INFO(CamxLogGroupLRME, "Parallel estimation enabled");
+    }
+
     return result;
 }
 
@@ -189,7 +243,6 @@ CamxResult RANSACNode::ExecuteProcessRequest(
     PerRequestActivePorts*  pEnabledPorts     = pExecuteProcessRequestData->pEnabledPortsInfo;
     UINT                    numBatchedFrames  = pNodeRequestData->pCaptureRequest->numBatchedFrames;
     UINT64                  requestId         = pNodeRequestData->pCaptureRequest->requestId;
-    UINT                    transformTypeMask = GetHwContext()->GetStaticSettings()->setLRMETransformTypeMask;
     UINT                    dependencyIndex   = 0;
 
     CAMX_ASSERT(NULL != pNodeRequestData);
@@ -233,181 +286,414 @@ CamxResult RANSACNode::ExecuteProcessRequest(
             pNodeRequestData->numDependencyLists = 1;
         }
     }
-    else
+    else if (1 == pNodeRequestData->processSequenceId)
     {
-        CPerspectiveTransform interpolatedTransform;
-        // Get the lrme property
-        VOID*        pPData[1]                    = { 0 };
-        UINT64       pDataOffset[1]               = { 0 };
-        UINT64       requestIdOffsetFromLastFlush = GetRequestIdOffsetFromLastFlush(requestId);
-
-        LRMEPropertyFrameSettings* pFrameSettings;
+        UINT64          requestIdOffsetFromLastFlush = GetRequestIdOffsetFromLastFlush(requestId);
+        RANSACEstimate* pEstimate                    = &m_estimates[requestId % MaxRequestQueueDepth];
 
-        static const UINT PropertiesLRMEFrameSetting[] = { PropertyIDLRMEFrameSettings };
-        result = GetDataList(PropertiesLRMEFrameSetting, pPData, pDataOffset, 1);
+        EstimateTransform(requestId, numBatchedFrames, requestIdOffsetFromLastFlush, pEnabledPorts, pEstimate);
 
-        if (CamxResultSuccess == result)
+        if ((TRUE == pEstimate->isSubmitted) || (FirstValidRequestId < requestIdOffsetFromLastFlush))
         {
-            pFrameSettings = static_cast<LRMEPropertyFrameSettings*>(pPData[0]);
-            if (NULL == pFrameSettings)
+            // The confidence hysteresis and the transforms repeated for skipped requests depend on the previous request, and
+            // estimates complete out of order, so the estimate posts once its job and the previous request completed. The
+            // DRQ holds the request meanwhile, no thread waits.
+            if (FirstValidRequestId < requestIdOffsetFromLastFlush)
+            {
+                pNodeRequestData->dependencyInfo[dependencyIndex].dependencyFlags.hasPropertyDependency = TRUE;
+                pNodeRequestData->dependencyInfo[dependencyIndex].propertyDependency.count              = 1;
+                pNodeRequestData->dependencyInfo[dependencyIndex].propertyDependency.properties[0]      =
+                    GetNodeCompleteProperty();
+                // Always point to the previous request. Should NOT be tied to the pipeline delay!
+                pNodeRequestData->dependencyInfo[dependencyIndex].propertyDependency.offsets[0]         = 1;
+                pNodeRequestData->dependencyInfo[dependencyIndex].propertyDependency.pipelineIds[0]     = GetPipelineId();
+            }
+
+            if (TRUE == pEstimate->isSubmitted)
             {
-                CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Unable to get PropertyIDLRMEFrameSettings", requestId);
-                result = CamxResultEFailed;
+                pNodeRequestData->dependencyInfo[dependencyIndex].dependencyFlags.hasFenceDependency    = TRUE;
+                pNodeRequestData->dependencyInfo[dependencyIndex].chiFenceDependency.chiFenceCount      = 1;
+                pNodeRequestData->dependencyInfo[dependencyIndex].chiFenceDependency.pChiFences[0]      = &pEstimate->fence;
             }
+
+            pNodeRequestData->dependencyInfo[dependencyIndex].processSequenceId                         = 2;
+            pNodeRequestData->numDependencyLists                                                        = 1;
+        }
+        else
+        {
+            result = PostTransform(requestId, numBatchedFrames, requestIdOffsetFromLastFlush, pEstimate);
+        }
+    }
+    else
+    {
+        result = PostTransform(requestId,
+                               numBatchedFrames,
+                               GetRequestIdOffsetFromLastFlush(requestId),
+                               &m_estimates[requestId % MaxRequestQueueDepth]);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RANSACNode::EstimateTransform
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID RANSACNode::EstimateTransform(
+    UINT64                 requestId,
+    UINT                   numBatchedFrames,
+    UINT64                 requestIdOffsetFromLastFlush,
+    PerRequestActivePorts* pEnabledPorts,
+    RANSACEstimate*        pEstimate)
+{
+    CamxResult   result         = CamxResultSuccess;
+    // Get the lrme property
+    VOID*        pPData[1]      = { 0 };
+    UINT64       pDataOffset[1] = { 0 };
+
+    LRMEPropertyFrameSettings* pFrameSettings = NULL;
+
+    pEstimate->isEstimated       = FALSE;
+    pEstimate->isSubmitted       = FALSE;
+    pEstimate->output.confidence = 0;
+    pEstimate->solveTimeNs       = 0;
+    pEstimate->hasFrameSettings  = FALSE;
+
+    static const UINT PropertiesLRMEFrameSetting[] = { PropertyIDLRMEFrameSettings };
+    result = GetDataList(PropertiesLRMEFrameSetting, pPData, pDataOffset, 1);
+
+    if (CamxResultSuccess == result)
+    {
+        pFrameSettings = static_cast<LRMEPropertyFrameSettings*>(pPData[0]);
+        if (NULL == pFrameSettings)
+        {
+            CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Unable to get PropertyIDLRMEFrameSettings", requestId);
+            result = CamxResultEFailed;
         }
+    }
 
-        if (CamxResultSuccess == result)
+    if (CamxResultSuccess == result)
+    {
+        CAMX_LOG_INFO(CamxLogGroupLRME,
+            "Req[%llu] LRME frame setting recv at ransac stepx: %d stepy %d refValid %d resFormat %d"
+            " taroffsetx %d taroffsety %d refoffsetx %d refoffsety %d subpelsearch %d fullw %d fullh %d tarw %d tarh %d"
+            " upscalefactor %d alternate skip %d adaptive skip %d",
+            requestId,
+            pFrameSettings->LRMEStepX, pFrameSettings->LRMEStepY, pFrameSettings->LRMERefValid,
+            pFrameSettings->LRMEresultFormat, pFrameSettings->LRMETarOffsetX, pFrameSettings->LRMETarOffsetY,
+            pFrameSettings->LRMERefOffsetX, pFrameSettings->LRMERefOffsetY, pFrameSettings->LRMEsubpelSearchEnable,
+            pFrameSettings->fullWidth, pFrameSettings->fullHeight, pFrameSettings->LRMETarW, pFrameSettings->LRMETarH,
+            pFrameSettings->LRMEUpscaleFactor, pFrameSettings->alternateSkipProcessing, pFrameSettings->adaptiveSkip);
+
+        pEstimate->frameSettings    = *pFrameSettings;
+        pEstimate->hasFrameSettings = TRUE;
+
+        if ((FirstValidRequestId != requestIdOffsetFromLastFlush) ||
+            ((1 < numBatchedFrames) && (8 != pFrameSettings->LRMEUpscaleFactor)))
         {
-            CAMX_LOG_INFO(CamxLogGroupLRME,
-                "Req[%llu] LRME frame setting recv at ransac stepx: %d stepy %d refValid %d resFormat %d"
-                " taroffsetx %d taroffsety %d refoffsetx %d refoffsety %d subpelsearch %d fullw %d fullh %d tarw %d tarh %d"
-                " upscalefactor %d alternate skip %d",
-                requestId,
-                pFrameSettings->LRMEStepX, pFrameSettings->LRMEStepY, pFrameSettings->LRMERefValid,
-                pFrameSettings->LRMEresultFormat, pFrameSettings->LRMETarOffsetX, pFrameSettings->LRMETarOffsetY,
-                pFrameSettings->LRMERefOffsetX, pFrameSettings->LRMERefOffsetY, pFrameSettings->LRMEsubpelSearchEnable,
-                pFrameSettings->fullWidth, pFrameSettings->fullHeight, pFrameSettings->LRMETarW, pFrameSettings->LRMETarH,
-                pFrameSettings->LRMEUpscaleFactor, pFrameSettings->alternateSkipProcessing);
-            m_alternateSkipProcessing    = pFrameSettings->alternateSkipProcessing;
-            if ((FirstValidRequestId != requestIdOffsetFromLastFlush) ||
-                ((1 < numBatchedFrames) && (8 != pFrameSettings->LRMEUpscaleFactor)))
+            if (TRUE == pFrameSettings->adaptiveSkip)
             {
-                if ((FALSE == m_alternateSkipProcessing) ||
-                    (TRUE == IsPreviewPresent()))
-                {
-                    ChannelType* pAddr = reinterpret_cast<ChannelType*>
-                        (pEnabledPorts->pInputPorts[0].pImageBuffer->GetPlaneVirtualAddr(0, 0));
-                    SIZE_T bufferSize = pEnabledPorts->pInputPorts[0].pImageBuffer->GetPlaneSize(0);
-
-                    // Invalidate the input buffer before accessing it since the buffer
-                    // is configured as cached buffer.
-                    result = pEnabledPorts->pInputPorts[0].pImageBuffer->CacheOps(true, false);
-
-                    CamxTime tv1;
-                    CamxTime tv2;
-                    UINT64   start;
-                    UINT64   end;
-                    if (CAMX_LOG_IS_VERBOSE_ENABLED(CamxLogGroupLRME))
-                    {
-                        CamX::OsUtils::GetTime(&tv1);
-                        start = (tv1.seconds * 1000) + (tv1.nanoSeconds / 1000000);
-                    }
+                // LRME skipped the request, the last transform is repeated for it as the scene is static
+                CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Req[%llu] repeats the last transform", requestId);
+            }
+            else if ((FALSE == pFrameSettings->alternateSkipProcessing) ||
+                     (TRUE == IsPreviewPresent()))
+            {
+                ImageBuffer* pImageBuffer = pEnabledPorts->pInputPorts[0].pImageBuffer;
+                VOID*        pAddr        = pImageBuffer->GetPlaneVirtualAddr(0, 0);
 
-                    if ((CamxResultSuccess != result) ||
-                        (NULL == pAddr) ||
-                        (NULL == pEnabledPorts->pInputPorts[0].pImageBuffer->GetFormat()) ||
-                        (0 != ProcessMeResult(pAddr, bufferSize,
-                            pFrameSettings->fullWidth, pFrameSettings->fullHeight,
-                            pFrameSettings->LRMETarW, pFrameSettings->LRMETarH,
-                            pFrameSettings->LRMETarOffsetX, pFrameSettings->LRMETarOffsetY,
-                            pFrameSettings->LRMERefOffsetX, pFrameSettings->LRMERefOffsetY,
-                            pFrameSettings->LRMEStepX, pFrameSettings->LRMEStepY,
-                            pFrameSettings->LRMEresultFormat,
-                            pFrameSettings->LRMEsubpelSearchEnable, pFrameSettings->LRMEUpscaleFactor,
-                            LRMETransform_method, m_transform, m_confidence)))
-                    {
-                        CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] - Failed, result=%d, pAddr=%p, ", requestId, result, pAddr);
-                        result = CamxResultEFailed;
-                    }
+                // Invalidate the input buffer before accessing it since the buffer
+                // is configured as cached buffer.
+                result = pImageBuffer->CacheOps(true, false);
 
-                    if (CAMX_LOG_IS_VERBOSE_ENABLED(CamxLogGroupLRME))
-                    {
-                        CamX::OsUtils::GetTime(&tv2);
-                        end = (tv2.seconds * 1000) + (tv2.nanoSeconds / 1000000);
-                        CAMX_LOG_VERBOSE(CamxLogGroupLRME, "nclib ransac result %d confidence %d time %llu", result,
-                            m_confidence, end - start);
-                    }
+                pEstimate->isEstimated = TRUE;
+
+                if ((CamxResultSuccess != result) ||
+                    (NULL == pAddr) ||
+                    (NULL == pImageBuffer->GetFormat()) ||
+                    (CamxResultSuccess != SubmitEstimate(requestId, pImageBuffer, pEstimate)))
+                {
+                    CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] - Failed, result=%d, pAddr=%p, ", requestId, result, pAddr);
+                    result = CamxResultEFailed;
                 }
             }
-            else
-            {
-                m_confidence = 0;
-            }
         }
+    }
+
+    // A submitted estimate gets its result on completion, which may already have happened
+    if (FALSE == pEstimate->isSubmitted)
+    {
+        pEstimate->result = result;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RANSACNode::SubmitEstimate
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult RANSACNode::SubmitEstimate(
+    UINT64          requestId,
+    ImageBuffer*    pImageBuffer,
+    RANSACEstimate* pEstimate)
+{
+    CamxResult    result = CamxResultSuccess;
+    DSPOffloadJob job;
+
+    if (NULL == m_pDSPOffload)
+    {
+        result = CamxResultEInvalidState;
+    }
 
-        if (CamxResultSuccess == result)
+    if (CamxResultSuccess == result)
+    {
+        // Fences signal once, the fence of the previous request in this slot completed long ago
+        if (CSLInvalidFence != pEstimate->fence.hFence)
         {
-            CPerspectiveTransform transformUnity;
-            UINT32 transformConfidence = m_confidence;
+            CSLReleaseFence(pEstimate->fence.hFence);
+            pEstimate->fence.hFence = CSLInvalidFence;
+        }
 
-            BOOL regularTransformEnabled          =
-                (0 != (transformTypeMask & (1 << RegularTransform))) ? TRUE : FALSE;
+        result = CSLCreatePrivateFence("RANSACEstimate", &pEstimate->fence.hFence);
+    }
 
-            BOOL hfrInterpolationTransformEnabled =
-                (0 != (transformTypeMask & (1 << HFRInterpolationTransform))) ? TRUE : FALSE;
+    if (CamxResultSuccess == result)
+    {
+        pEstimate->fence.hChiFence   = static_cast<CHIFENCEHANDLE>(&pEstimate->fence);
+        pEstimate->fence.type        = ChiFenceTypeInternal;
+        pEstimate->fence.aRefCount   = 1;
+        pEstimate->fence.resultState = ChiFenceInit;
+
+        Utils::Memset(&job, 0, sizeof(job));
+        job.pDSPModule              = g_pRANSACDSPModule;
+        job.pCPUKernel              = EstimateKernel;
+        job.pParams                 = &pEstimate->frameSettings;
+        job.paramSize               = sizeof(LRMEPropertyFrameSettings);
+        job.inputs[0].pVirtualAddr  = pImageBuffer->GetPlaneVirtualAddr(0, 0);
+        job.inputs[0].size          = pImageBuffer->GetPlaneSize(0);
+        job.inputs[0].fd            = pImageBuffer->GetFileDescriptor();
+        job.numInputs               = 1;
+        job.outputs[0].pVirtualAddr = &pEstimate->output;
+        job.outputs[0].size         = sizeof(RANSACKernelOutput);
+        job.outputs[0].fd           = -1;
+        job.numOutputs              = 1;
+        job.requestId               = requestId;
+        job.hFence                  = pEstimate->fence.hFence;
+        job.pCompletionCb           = EstimateDoneCb;
+        job.pUserData               = pEstimate;
+
+        // Set before the submit, the job may complete before Submit returns
+        pEstimate->result       = CamxResultEFailed;
+        pEstimate->isSubmitted  = TRUE;
+        pEstimate->submitTimeNs = OsUtils::GetNanoSeconds();
+
+        result = m_pDSPOffload->Submit(&job);
 
-            BOOL unityTransformEnabled            =
-                (0 != (transformTypeMask & (1 << UnityTransform))) ? TRUE : FALSE;
+        if (CamxResultSuccess != result)
+        {
+            pEstimate->isSubmitted = FALSE;
+        }
+    }
 
-            if ((TRUE == regularTransformEnabled) || (TRUE == hfrInterpolationTransformEnabled))
+    if (CamxResultSuccess != result)
+    {
+        CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Failed to submit the estimate, result=%d", requestId, result);
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RANSACNode::EstimateKernel
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult RANSACNode::EstimateKernel(
+    const VOID*             pParams,
+    SIZE_T                  paramSize,
+    const DSPOffloadBuffer* pInputs,
+    UINT                    numInputs,
+    DSPOffloadBuffer*       pOutputs,
+    UINT                    numOutputs)
+{
+    CamxResult result = CamxResultSuccess;
+
+    if ((sizeof(LRMEPropertyFrameSettings) != paramSize) ||
+        (1                                  != numInputs) ||
+        (1                                  != numOutputs) ||
+        (sizeof(RANSACKernelOutput)         != pOutputs[0].size))
+    {
+        CAMX_LOG_ERROR(CamxLogGroupLRME, "Invalid estimate job, paramSize %zu inputs %u outputs %u",
+                       paramSize, numInputs, numOutputs);
+        result = CamxResultEInvalidArg;
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        const LRMEPropertyFrameSettings* pFrameSettings = static_cast<const LRMEPropertyFrameSettings*>(pParams);
+        RANSACKernelOutput*              pOutput        = static_cast<RANSACKernelOutput*>(pOutputs[0].pVirtualAddr);
+
+        if (0 != ProcessMeResult(static_cast<ChannelType*>(pInputs[0].pVirtualAddr), pInputs[0].size,
+                                 pFrameSettings->fullWidth, pFrameSettings->fullHeight,
+                                 pFrameSettings->LRMETarW, pFrameSettings->LRMETarH,
+                                 pFrameSettings->LRMETarOffsetX, pFrameSettings->LRMETarOffsetY,
+                                 pFrameSettings->LRMERefOffsetX, pFrameSettings->LRMERefOffsetY,
+                                 pFrameSettings->LRMEStepX, pFrameSettings->LRMEStepY,
+                                 pFrameSettings->LRMEresultFormat,
+                                 pFrameSettings->LRMEsubpelSearchEnable, pFrameSettings->LRMEUpscaleFactor,
+                                 LRMETransform_method, pOutput->transform, pOutput->confidence))
+        {
+            result = CamxResultEFailed;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RANSACNode::EstimateDoneCb
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID RANSACNode::EstimateDoneCb(
+    VOID*             pUserData,
+    UINT64            requestId,
+    DSPOffloadBackend backend,
+    CamxResult        result)
+{
+    RANSACEstimate* pEstimate = static_cast<RANSACEstimate*>(pUserData);
+
+    pEstimate->solveTimeNs = OsUtils::GetNanoSeconds() - pEstimate->submitTimeNs;
+    pEstimate->result      = result;
+
+    if (CamxResultSuccess != result)
+    {
+        CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] - Estimate failed, result=%d", requestId, result);
+    }
+
+    CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Req[%llu] nclib ransac result %d backend %u confidence %d time %llu us",
+                     requestId, result, static_cast<UINT>(backend), pEstimate->output.confidence,
+                     pEstimate->solveTimeNs / 1000);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// RANSACNode::PostTransform
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult RANSACNode::PostTransform(
+    UINT64          requestId,
+    UINT            numBatchedFrames,
+    UINT64          requestIdOffsetFromLastFlush,
+    RANSACEstimate* pEstimate)
+{
+    CamxResult                 result            = pEstimate->result;
+    UINT                       transformTypeMask = GetHwContext()->GetStaticSettings()->setLRMETransformTypeMask;
+    LRMEPropertyFrameSettings* pFrameSettings    = (TRUE == pEstimate->hasFrameSettings) ? &pEstimate->frameSettings : NULL;
+    CPerspectiveTransform      interpolatedTransform;
+
+    if (NULL != pFrameSettings)
+    {
+        m_alternateSkipProcessing = pFrameSettings->alternateSkipProcessing;
+    }
+
+    if (TRUE == pEstimate->isEstimated)
+    {
+        m_solveCount++;
+        m_solveTimeNs += pEstimate->solveTimeNs;
+    }
+    else if ((NULL != pFrameSettings) && (TRUE == pFrameSettings->adaptiveSkip))
+    {
+        m_adaptiveSkipCount++;
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        if (TRUE == pEstimate->isEstimated)
+        {
+            m_transform  = pEstimate->output.transform;
+            m_confidence = pEstimate->output.confidence;
+        }
+        else if ((FirstValidRequestId == requestIdOffsetFromLastFlush) &&
+                 ((1 == numBatchedFrames) || (8 == pFrameSettings->LRMEUpscaleFactor)))
+        {
+            m_confidence = 0;
+        }
+    }
+
+    if (CamxResultSuccess == result)
+    {
+        CPerspectiveTransform transformUnity;
+        UINT32 transformConfidence = m_confidence;
+
+        BOOL regularTransformEnabled          =
+            (0 != (transformTypeMask & (1 << RegularTransform))) ? TRUE : FALSE;
+
+        BOOL hfrInterpolationTransformEnabled =
+            (0 != (transformTypeMask & (1 << HFRInterpolationTransform))) ? TRUE : FALSE;
+
+        BOOL unityTransformEnabled            =
+            (0 != (transformTypeMask & (1 << UnityTransform))) ? TRUE : FALSE;
+
+        if ((TRUE == regularTransformEnabled) || (TRUE == hfrInterpolationTransformEnabled))
+        {
+            result = ConfigureLRMEConfidenceParameter(&transformConfidence, &m_forceIdentityTransform);
+            if (CamxResultSuccess == result)
             {
-                result = ConfigureLRMEConfidenceParameter(&transformConfidence, &m_forceIdentityTransform);
-                if (CamxResultSuccess == result)
-                {
-                    CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Posting for request %llu,ransac confidence %d,"
-                        "transform confidence %d,Identity forced %d, batchframes %d",
-                        requestId, m_confidence, transformConfidence, m_forceIdentityTransform, numBatchedFrames);
+                CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Posting for request %llu,ransac confidence %d,"
+                    "transform confidence %d,Identity forced %d, batchframes %d",
+                    requestId, m_confidence, transformConfidence, m_forceIdentityTransform, numBatchedFrames);
 
-                    // post indentity transform as per m_forceIdentityTransform state for hysteresis implementation
-                    if ((1 == m_forceIdentityTransform) ||
-                        ((1 < numBatchedFrames) && (FALSE == hfrInterpolationTransformEnabled)))
-                    {
-                        result = PostICATransform(&transformUnity, transformConfidence, pFrameSettings);
-                    }
-                    else
+                // post indentity transform as per m_forceIdentityTransform state for hysteresis implementation
+                if ((1 == m_forceIdentityTransform) ||
+                    ((1 < numBatchedFrames) && (FALSE == hfrInterpolationTransformEnabled)))
+                {
+                    result = PostICATransform(&transformUnity, transformConfidence, pFrameSettings);
+                }
+                else
+                {
+                    if (1 < numBatchedFrames)
                     {
-                        if (1 < numBatchedFrames)
+                        // perform transform Interpolation for HFR
+                        if ((FirstValidRequestId == requestIdOffsetFromLastFlush) &&
+                            (8 != pFrameSettings->LRMEUpscaleFactor))
                         {
-                            // perform transform Interpolation for HFR
-                            if ((FirstValidRequestId == requestIdOffsetFromLastFlush) &&
-                                (8 != pFrameSettings->LRMEUpscaleFactor))
-                            {
-                                InterpolateICATransform(m_transform, &interpolatedTransform, numBatchedFrames - 1);
-                            }
-                            else
-                            {
-                                InterpolateICATransform(m_transform, &interpolatedTransform, numBatchedFrames);
-                            }
-
-                            result = PostICATransform(&interpolatedTransform, transformConfidence, pFrameSettings);
-                        }
-                        else if (TRUE == m_alternateSkipProcessing)
-                        {
-                            InterpolateICATransform(m_transform, &interpolatedTransform, 2);
-                            result = PostICATransform(&interpolatedTransform, transformConfidence, pFrameSettings);
+                            InterpolateICATransform(m_transform, &interpolatedTransform, numBatchedFrames - 1);
                         }
                         else
                         {
-                            result = PostICATransform(&m_transform, transformConfidence, pFrameSettings);
+                            InterpolateICATransform(m_transform, &interpolatedTransform, numBatchedFrames);
                         }
+
+                        result = PostICATransform(&interpolatedTransform, transformConfidence, pFrameSettings);
+                    }
+                    else if (TRUE == m_alternateSkipProcessing)
+                    {
+                        InterpolateICATransform(m_transform, &interpolatedTransform, 2);
+                        result = PostICATransform(&interpolatedTransform, transformConfidence, pFrameSettings);
+                    }
+                    else
+                    {
+                        result = PostICATransform(&m_transform, transformConfidence, pFrameSettings);
                     }
-                }
-                else
-                {
-                    CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Failed in Configure LRME Confidence Param, result=%d",
-                                   requestId, result);
                 }
             }
-            else if (TRUE == unityTransformEnabled)
-            {
-                // post unity transform and confidence
-                transformConfidence = 256;
-                result = PostICATransform(&transformUnity, transformConfidence, pFrameSettings);
-            }
             else
             {
-                result = CamxResultEInvalidArg;
-                CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Invalid LRME/Ransac transform type 0x%x", transformTypeMask);
+                CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Failed in Configure LRME Confidence Param, result=%d",
+                               requestId, result);
             }
-
-            CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Posting for request %llu", requestId);
+        }
+        else if (TRUE == unityTransformEnabled)
+        {
+            // post unity transform and confidence
+            transformConfidence = 256;
+            result = PostICATransform(&transformUnity, transformConfidence, pFrameSettings);
+        }
+        else
+        {
+            result = CamxResultEInvalidArg;
+            CAMX_LOG_ERROR(CamxLogGroupLRME, "Req[%llu] Invalid LRME/Ransac transform type 0x%x", transformTypeMask);
         }
 
-        ProcessPartialMetadataDone(requestId);
-        ProcessMetadataDone(requestId);
-        ProcessRequestIdDone(requestId);
+        CAMX_LOG_VERBOSE(CamxLogGroupLRME, "Posting for request %llu", requestId);
     }
 
+    ProcessPartialMetadataDone(requestId);
+    ProcessMetadataDone(requestId);
+    ProcessRequestIdDone(requestId);
+
     return result;
 }
 
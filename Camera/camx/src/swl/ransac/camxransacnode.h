@@ -12,12 +12,36 @@
 #ifndef CAMXRANSACNODE_H
 #define CAMXRANSACNODE_H
 
+#include "camxchi.h"
+#include "camxdspoffload.h"
+#include "camxlrmeproperty.h"
 #include "camxmem.h"
 #include "camxnode.h"
 #include "TransformEstimation.h"
 
 CAMX_NAMESPACE_BEGIN
 
+/// @brief Output of the RANSAC estimate kernel
+struct RANSACKernelOutput
+{
+    CPerspectiveTransform     transform;            ///< Estimated transform
+    INT32                     confidence;           ///< Estimated confidence
+};
+
+/// @brief Transform estimated for a request, held until the request posts in request order
+struct RANSACEstimate
+{
+    CamxResult                result;               ///< Result of reading the frame settings and of the estimate
+    BOOL                      isEstimated;          ///< The transform was estimated for the request
+    BOOL                      isSubmitted;          ///< The estimate job was submitted, result is set on its completion
+    RANSACKernelOutput        output;               ///< Output of the estimate job
+    UINT64                    submitTimeNs;         ///< Time the estimate job was submitted
+    UINT64                    solveTimeNs;          ///< Time from the submit to the completion of the estimate job
+    ChiFence                  fence;                ///< Internal fence of the estimate job, the DRQ holds the post on it
+    BOOL                      hasFrameSettings;     ///< frameSettings was read
+    LRMEPropertyFrameSettings frameSettings;        ///< LRME frame settings of the request, the parameters of the job
+};
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @brief Class that implements the RANSAC node class
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -170,6 +194,102 @@ private:
         UINT32 confidence,
         LRMEPropertyFrameSettings* pFrameSettings);
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// EstimateTransform
+    ///
+    /// @brief     Read the LRME frame settings of a request and submit the estimate of its transform from its LRME vectors,
+    ///            if the request needs one. Only the request's own data is used, so requests may estimate in parallel.
+    ///
+    /// @param     requestId                     Request to estimate
+    /// @param     numBatchedFrames              Number of batched frames of the request
+    /// @param     requestIdOffsetFromLastFlush  Offset of the request from the last flush
+    /// @param     pEnabledPorts                 Active ports of the request
+    /// @param     pEstimate                     Returned estimate, completed asynchronously if isSubmitted is set
+    ///
+    /// @return    None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID EstimateTransform(
+        UINT64                 requestId,
+        UINT                   numBatchedFrames,
+        UINT64                 requestIdOffsetFromLastFlush,
+        PerRequestActivePorts* pEnabledPorts,
+        RANSACEstimate*        pEstimate);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// PostTransform
+    ///
+    /// @brief     Apply the estimate of a request to the confidence hysteresis and post the request's ICA transform. Must be
+    ///            called in request order, as the result depends on the previous request.
+    ///
+    /// @param     requestId                     Request to post
+    /// @param     numBatchedFrames              Number of batched frames of the request
+    /// @param     requestIdOffsetFromLastFlush  Offset of the request from the last flush
+    /// @param     pEstimate                     Estimate of the request
+    ///
+    /// @return    CamxResultSuccess on success else failure code
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult PostTransform(
+        UINT64          requestId,
+        UINT            numBatchedFrames,
+        UINT64          requestIdOffsetFromLastFlush,
+        RANSACEstimate* pEstimate);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// SubmitEstimate
+    ///
+    /// @brief     Submit the estimate job of a request to the offloader, with a new internal fence signaled on its completion
+    ///
+    /// @param     requestId     Request to estimate
+    /// @param     pImageBuffer  LRME vector buffer of the request
+    /// @param     pEstimate     Estimate of the request, with its frame settings
+    ///
+    /// @return    CamxResultSuccess if the job was submitted
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CamxResult SubmitEstimate(
+        UINT64          requestId,
+        ImageBuffer*    pImageBuffer,
+        RANSACEstimate* pEstimate);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// EstimateKernel
+    ///
+    /// @brief     CPU reference kernel of the estimate job. The parameters are the LRME frame settings, the input is the LRME
+    ///            vector buffer and the output a RANSACKernelOutput.
+    ///
+    /// @param     pParams     Parameters of the job
+    /// @param     paramSize   Size of the parameters
+    /// @param     pInputs     Input buffers
+    /// @param     numInputs   Number of input buffers
+    /// @param     pOutputs    Output buffers
+    /// @param     numOutputs  Number of output buffers
+    ///
+    /// @return    CamxResultSuccess on success else failure code
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CamxResult EstimateKernel(
+        const VOID*             pParams,
+        SIZE_T                  paramSize,
+        const DSPOffloadBuffer* pInputs,
+        UINT                    numInputs,
+        DSPOffloadBuffer*       pOutputs,
+        UINT                    numOutputs);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// EstimateDoneCb
+    ///
+    /// @brief     Completion of an estimate job, records its result before the DRQ releases the post of the request
+    ///
+    /// @param     pUserData   Estimate of the request
+    /// @param     requestId   Request of the job
+    /// @param     backend     Backend the job executed on
+    /// @param     result      Result of the kernel
+    ///
+    /// @return    None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID EstimateDoneCb(
+        VOID*             pUserData,
+        UINT64            requestId,
+        DSPOffloadBackend backend,
+        CamxResult        result);
 
     UINT                     m_numInputPorts;                             ///< Number of input ports used by RANSAC
     UINT                     m_numOutputPorts;                            ///< Number of output ports used by RANSAC
@@ -177,6 +297,11 @@ private:
     CPerspectiveTransform    m_transform;                                 ///< Calculated transform
     INT32                    m_confidence = 0;                            ///< Calculated confidence
     BOOL                     m_alternateSkipProcessing;                   ///< Flag to skip the RANSAC Processing
+    UINT64                   m_solveCount;                                ///< Requests the transform was estimated on
+    UINT64                   m_solveTimeNs;                               ///< Time spent estimating the transforms
+    UINT64                   m_adaptiveSkipCount;                         ///< Requests that repeated the last transform
+    RANSACEstimate           m_estimates[MaxRequestQueueDepth];           ///< Estimates waiting to post, by request id
+    DSPOffload*              m_pDSPOffload;                               ///< Runs the estimates on the DSP or the CPU
 };
 
 CAMX_NAMESPACE_END
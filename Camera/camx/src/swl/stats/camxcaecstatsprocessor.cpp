@@ -3850,9 +3850,16 @@ CamxResult CAECGyro::PopulateGyroData(
                 }
             }
 
+            // Samples are read in place from the lock-free ring, drop them if the producer lapped the window meanwhile
+            BOOL isValid = pDataObj->IsValid();
+
             m_pNCSSensorHandleGyro->PutBackDataObj(pDataObj);
 
-            if (index == pGyroInfo->sampleCount)
+            if (FALSE == isValid)
+            {
+                pGyroInfo->enabled = FALSE;
+            }
+            else if (index == pGyroInfo->sampleCount)
             {
                 result = CamxResultSuccess;
             }
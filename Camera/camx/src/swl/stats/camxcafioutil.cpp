@@ -3747,9 +3747,16 @@ CamxResult CAFIOUtil::PopulateGyroData()
                     break;
                 }
             }
+            // Samples are read in place from the lock-free ring, drop them if the producer lapped the window meanwhile
+            BOOL isValid = pDataObj->IsValid();
+
             m_pNCSSensorHandleGyro->PutBackDataObj(pDataObj);
 
-            if (index == m_AFOutputGyroValue.sampleCount)
+            if (FALSE == isValid)
+            {
+                m_AFOutputGyroValue.enabled = FALSE;
+            }
+            else if (index == m_AFOutputGyroValue.sampleCount)
             {
                 m_bGyroErrIndicated = FALSE;
                 result              = CamxResultSuccess;
@@ -3826,8 +3833,15 @@ CamxResult CAFIOUtil::PopulateGravityData()
                 }
             }
 
+            // Samples are read in place from the lock-free ring, drop them if the producer lapped the window meanwhile
+            BOOL isValid = pDataObj->IsValid();
+
             m_pNCSSensorHandleGravity->PutBackDataObj(pDataObj);
-            if (index == m_AFOutputGravityValue.sampleCount)
+            if (FALSE == isValid)
+            {
+                m_AFOutputGravityValue.enabled = FALSE;
+            }
+            else if (index == m_AFOutputGravityValue.sampleCount)
             {
                 result = CamxResultSuccess;
             }
@@ -17,9 +17,11 @@ LOCAL_SRC_FILES :=                  \
     camxatomic.cpp                  \
     camxdebug.cpp                   \
     camxdebugprint.cpp              \
+    camxdeferredlog.cpp             \
     camxhashmap.cpp                 \
     camximagedump.cpp               \
     camximageformatutils.cpp        \
+    camxlatencyhistogram.cpp        \
     camxmemspy.cpp                  \
     camxstabilization.cpp           \
     camxthreadcore.cpp              \
@@ -34,12 +36,14 @@ LOCAL_INC_FILES :=                  \
     camxatomic.h                    \
     camxdebug.h                     \
     camxdebugprint.h                \
+    camxdeferredlog.h               \
     camxdefs.h                      \
     camxformats.h                   \
     camxhashmap.h                   \
     camximagedump.h                 \
     camximageformatutils.h          \
     camxincs.h                      \
+    camxlatencyhistogram.h          \
     camxlist.h                      \
     camxmemspy.h                    \
     camxstabilization.h             \
@@ -80,6 +84,7 @@ LOCAL_COPY_HEADERS :=   camxatomic.h                    \
                         camxhashmap.h                   \
                         camximageformatutils.h          \
                         camxincs.h                      \
+                        camxlatencyhistogram.h          \
                         camxlist.h                      \
                         camxmemspy.h                    \
                         camxthreadcommon.h              \
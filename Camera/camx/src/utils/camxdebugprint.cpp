@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "camxdebugprint.h"
+#include "camxdeferredlog.h"
 #include "camxosutils.h"
 #include "camxtrace.h"
 
@@ -35,6 +36,8 @@ struct DebugLogInfo g_logInfo =
     },
     NULL,               ////< pDebugLogFile
     TRUE,               ////< systemLogEnable
+    FALSE,              ////< deferredLogEnable
+    0,                  ////< deferredLogRecordsPerThread
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +46,12 @@ struct DebugLogInfo g_logInfo =
 VOID Log::UpdateLogInfo(
     DebugLogInfo* pNewLogInfo)
 {
+    // Drain deferred records into the current sinks before they change
+    if (TRUE == DeferredLog::IsEnabled())
+    {
+        DeferredLog::Disable();
+    }
+
     // Update the debug log file
     if (NULL != g_logInfo.pDebugLogFile)
     {
@@ -62,6 +71,16 @@ VOID Log::UpdateLogInfo(
     g_logInfo.groupsEnable[CamxLogReqMap]    = pNewLogInfo->groupsEnable[CamxLogReqMap];
     g_logInfo.pDebugLogFile                  = pNewLogInfo->pDebugLogFile;
     g_logInfo.systemLogEnable                = pNewLogInfo->systemLogEnable;
+    g_logInfo.deferredLogEnable              = pNewLogInfo->deferredLogEnable;
+    g_logInfo.deferredLogRecordsPerThread    = pNewLogInfo->deferredLogRecordsPerThread;
+
+    if (TRUE == g_logInfo.deferredLogEnable)
+    {
+        if (CamxResultSuccess != DeferredLog::Enable(g_logInfo.deferredLogRecordsPerThread))
+        {
+            g_logInfo.deferredLogEnable = FALSE;
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -81,7 +100,18 @@ VOID Log::LogSystem(
     const CHAR* pFormat,
     ...)
 {
-    if ((TRUE == g_logInfo.systemLogEnable) || (NULL != g_logInfo.pDebugLogFile))
+    BOOL deferred = FALSE;
+
+    if (((TRUE == g_logInfo.systemLogEnable) || (NULL != g_logInfo.pDebugLogFile)) && (TRUE == DeferredLog::IsEnabled()))
+    {
+        // Capture the raw arguments only, the flush thread does the formatting
+        va_list args;
+        va_start(args, pFormat);
+        deferred = DeferredLog::Record(level, pFormat, args);
+        va_end(args);
+    }
+
+    if ((FALSE == deferred) && ((TRUE == g_logInfo.systemLogEnable) || (NULL != g_logInfo.pDebugLogFile)))
     {
         CHAR logText[MaxLogLength];
 
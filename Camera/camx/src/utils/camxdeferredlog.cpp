@@ -0,0 +1,894 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxdeferredlog.cpp
+/// @brief Deferred logging backend implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdlib.h>
+
+#include "camxatomic.h"
+#include "camxdebugprint.h"
+#include "camxdeferredlog.h"
+#include "camxmem.h"
+#include "camxutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Local definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 MaxSpecLength           = 32;                   ///< Longest conversion specification handled
+static const UINT64 StringArgNull           = 0xFFFFFFFFFFFFFFFE;   ///< %s argument was NULL
+static const UINT64 StringArgTruncated      = 0xFFFFFFFFFFFFFFFF;   ///< %s argument did not fit into the record
+static const UINT32 CrashFlushLockRetries   = 10;                   ///< Attempts to get the flush lock when crashing
+static const UINT32 CrashFlushLockWaitUs    = 1000;                 ///< Wait between the attempts
+
+/// @brief Argument types a conversion specification consumes, by the type va_arg has to read
+enum class DeferredLogArgKind
+{
+    None,           ///< %% or an unsupported specification
+    Int,            ///< int, and everything promoted to it (char, short, %c, %lc)
+    Long,           ///< long
+    LongLong,       ///< long long
+    IntMax,         ///< intmax_t
+    Size,           ///< size_t
+    PtrDiff,        ///< ptrdiff_t
+    Double,         ///< double, float promoted
+    LongDouble,     ///< long double, captured as double
+    String,         ///< const char*, copied into the record
+    WideString,     ///< wchar_t*, not copied
+    Pointer,        ///< void*
+    Count,          ///< %n, consumed but never written
+};
+
+/// @brief One parsed conversion specification
+struct DeferredLogSpec
+{
+    UINT32              length;         ///< Characters from '%' through the conversion character
+    DeferredLogArgKind  kind;           ///< Argument consumed by the conversion
+    BOOL                widthArg;       ///< Width is given by an int argument ('*')
+    BOOL                precisionArg;   ///< Precision is given by an int argument ('.*')
+    BOOL                valid;          ///< Conversion character was recognized
+};
+
+volatile BOOL               DeferredLog::s_enabled            = FALSE;
+volatile BOOL               DeferredLog::s_stopFlushThread    = FALSE;
+volatile UINT               DeferredLog::s_crashFlushing      = 0;
+BOOL                        DeferredLog::s_flushThreadRunning = FALSE;
+BOOL                        DeferredLog::s_crashHandlersSet   = FALSE;
+UINT32                      DeferredLog::s_recordsPerThread   = DeferredLogDefaultRecordsPerThread;
+UINT32                      DeferredLog::s_numThreadBuffers   = 0;
+DeferredLogThreadBuffer*    DeferredLog::s_pThreadBuffers     = NULL;
+Mutex*                      DeferredLog::s_pRegistryLock      = NULL;
+Mutex*                      DeferredLog::s_pFlushLock         = NULL;
+OSThreadHandle              DeferredLog::s_hFlushThread;
+
+CAMX_TLS_STATIC_CLASS_DEFINE(DeferredLogThreadBuffer*, DeferredLog, m_tpThreadBuffer, NULL);
+CAMX_TLS_STATIC_CLASS_DEFINE(BOOL, DeferredLog, m_tInRecord, FALSE);
+
+#if defined (_LINUX)
+static const INT        CrashSignals[]  = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };    ///< Signals that flush the logs
+static struct sigaction s_previousSignalActions[CAMX_ARRAY_SIZE(CrashSignals)];            ///< Handlers to chain to
+#endif // _LINUX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// ParseSpec
+///
+/// @brief  Parse the conversion specification starting at the '%' of pSpec
+///
+/// @param  pSpec   Specification to parse
+/// @param  pOut    Parsed specification
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID ParseSpec(
+    const CHAR*         pSpec,
+    DeferredLogSpec*    pOut)
+{
+    const CHAR* pCurrent = pSpec + 1;
+    UINT32      longs    = 0;
+    CHAR        modifier = '\0';
+
+    pOut->kind         = DeferredLogArgKind::None;
+    pOut->widthArg     = FALSE;
+    pOut->precisionArg = FALSE;
+    pOut->valid        = TRUE;
+
+    while (('-' == *pCurrent) || ('+' == *pCurrent) || (' ' == *pCurrent) || ('#' == *pCurrent) || ('0' == *pCurrent) ||
+           ('\'' == *pCurrent))
+    {
+        pCurrent++;
+    }
+
+    if ('*' == *pCurrent)
+    {
+        pOut->widthArg = TRUE;
+        pCurrent++;
+    }
+    while (('0' <= *pCurrent) && ('9' >= *pCurrent))
+    {
+        pCurrent++;
+    }
+
+    if ('.' == *pCurrent)
+    {
+        pCurrent++;
+        if ('*' == *pCurrent)
+        {
+            pOut->precisionArg = TRUE;
+            pCurrent++;
+        }
+        while (('0' <= *pCurrent) && ('9' >= *pCurrent))
+        {
+            pCurrent++;
+        }
+    }
+
+    while (('h' == *pCurrent) || ('l' == *pCurrent) || ('q' == *pCurrent) || ('L' == *pCurrent) || ('j' == *pCurrent) ||
+           ('z' == *pCurrent) || ('t' == *pCurrent))
+    {
+        if ('l' == *pCurrent)
+        {
+            longs++;
+        }
+        modifier = *pCurrent;
+        pCurrent++;
+    }
+
+    switch (*pCurrent)
+    {
+        case '%':
+            pOut->kind = DeferredLogArgKind::None;
+            break;
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            if (('q' == modifier) || (1 < longs))
+            {
+                pOut->kind = DeferredLogArgKind::LongLong;
+            }
+            else if (1 == longs)
+            {
+                pOut->kind = DeferredLogArgKind::Long;
+            }
+            else if ('j' == modifier)
+            {
+                pOut->kind = DeferredLogArgKind::IntMax;
+            }
+            else if ('z' == modifier)
+            {
+                pOut->kind = DeferredLogArgKind::Size;
+            }
+            else if ('t' == modifier)
+            {
+                pOut->kind = DeferredLogArgKind::PtrDiff;
+            }
+            else
+            {
+                pOut->kind = DeferredLogArgKind::Int;
+            }
+            break;
+        case 'c':
+            pOut->kind = DeferredLogArgKind::Int;
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            pOut->kind = ('L' == modifier) ? DeferredLogArgKind::LongDouble : DeferredLogArgKind::Double;
+            break;
+        case 's':
+            pOut->kind = (1 == longs) ? DeferredLogArgKind::WideString : DeferredLogArgKind::String;
+            break;
+        case 'p':
+            pOut->kind = DeferredLogArgKind::Pointer;
+            break;
+        case 'n':
+            pOut->kind = DeferredLogArgKind::Count;
+            break;
+        default:
+            pOut->valid = FALSE;
+            break;
+    }
+
+    pOut->length = static_cast<UINT32>(pCurrent - pSpec) + ((TRUE == pOut->valid) ? 1 : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// EmitText
+///
+/// @brief  Send formatted text to the same sinks the synchronous Log::LogSystem path uses
+///
+/// @param  level   CamxLog level
+/// @param  pText   Text to emit
+///
+/// @return None
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static VOID EmitText(
+    UINT32      level,
+    const CHAR* pText)
+{
+    if (TRUE == g_logInfo.systemLogEnable)
+    {
+        OsUtils::LogSystem(level, pText);
+    }
+
+    if (NULL != g_logInfo.pDebugLogFile)
+    {
+        CamxDateTime systemDateTime;
+        OsUtils::GetDateTime(&systemDateTime);
+        OsUtils::FPrintF(g_logInfo.pDebugLogFile, "%02d-%02d %02d:%02d:%02d:%03d %s\n", systemDateTime.month,
+            systemDateTime.dayOfMonth, systemDateTime.hours, systemDateTime.minutes, systemDateTime.seconds,
+            systemDateTime.microseconds / 1000, pText);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::Enable
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+CamxResult DeferredLog::Enable(
+    UINT32 recordsPerThread)
+{
+    CamxResult result = CamxResultSuccess;
+
+    if (FALSE == s_enabled)
+    {
+        UINT32 numRecords = 1;
+
+        if (0 == recordsPerThread)
+        {
+            recordsPerThread = DeferredLogDefaultRecordsPerThread;
+        }
+        while (numRecords < recordsPerThread)
+        {
+            numRecords <<= 1;
+        }
+        s_recordsPerThread = numRecords;
+
+        // The locks and the thread buffers live until the process exits, so late log calls never touch freed memory
+        if (NULL == s_pRegistryLock)
+        {
+            s_pRegistryLock = Mutex::Create("DeferredLogRegistry");
+        }
+        if (NULL == s_pFlushLock)
+        {
+            s_pFlushLock = Mutex::Create("DeferredLogFlush");
+        }
+
+        if ((NULL == s_pRegistryLock) || (NULL == s_pFlushLock))
+        {
+            result = CamxResultENoMemory;
+        }
+
+        if (CamxResultSuccess == result)
+        {
+            s_stopFlushThread = FALSE;
+            result            = OsUtils::ThreadCreate(FlushThread, NULL, &s_hFlushThread);
+        }
+
+        if (CamxResultSuccess == result)
+        {
+            OsUtils::ThreadSetName(s_hFlushThread, "CamXDeferredLog");
+            s_flushThreadRunning = TRUE;
+
+            InstallCrashHandlers();
+
+            s_enabled = TRUE;
+        }
+    }
+
+    return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::Disable
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::Disable()
+{
+    s_enabled = FALSE;
+
+    if (TRUE == s_flushThreadRunning)
+    {
+        s_stopFlushThread = TRUE;
+        OsUtils::ThreadWait(s_hFlushThread);
+        s_flushThreadRunning = FALSE;
+    }
+
+    Flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::Record
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+BOOL DeferredLog::Record(
+    UINT32      level,
+    const CHAR* pFormat,
+    va_list     args)
+{
+    BOOL captured = FALSE;
+
+    // A log call made while recording, e.g. from the allocator or a lock, goes out synchronously
+    if (FALSE == m_tInRecord)
+    {
+        m_tInRecord = TRUE;
+
+        DeferredLogThreadBuffer* pBuffer = GetThreadBuffer();
+
+        if (NULL != pBuffer)
+        {
+            // Only this thread writes writeIndex, so it can be read plainly
+            UINT32 writeIndex = pBuffer->writeIndex;
+            UINT32 readIndex  = CamxAtomicLoadU32(&pBuffer->readIndex);
+
+            if ((writeIndex - readIndex) >= pBuffer->numRecords)
+            {
+                CamxAtomicAddU32(&pBuffer->numDropped, 1);
+            }
+            else
+            {
+                DeferredLogRecord* pRecord = &pBuffer->pRecords[writeIndex & (pBuffer->numRecords - 1)];
+
+                pRecord->pFormat         = pFormat;
+                pRecord->timestampNs     = OsUtils::GetNanoSeconds();
+                pRecord->level           = level;
+                pRecord->numArgs         = 0;
+                pRecord->stringBytesUsed = 0;
+                pRecord->truncated       = FALSE;
+
+                CaptureArgs(pRecord, args);
+
+                // The atomics are relaxed on newer compilers, so order the record before publishing it
+                CamxFence();
+                CamxAtomicStoreU32(&pBuffer->writeIndex, writeIndex + 1);
+            }
+
+            captured = TRUE;
+        }
+
+        m_tInRecord = FALSE;
+    }
+
+    return captured;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::Flush
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::Flush()
+{
+    if (NULL != s_pFlushLock)
+    {
+        s_pFlushLock->Lock();
+        DrainBuffers();
+        s_pFlushLock->Unlock();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::GetThreadBuffer
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+DeferredLogThreadBuffer* DeferredLog::GetThreadBuffer()
+{
+    DeferredLogThreadBuffer* pBuffer = m_tpThreadBuffer;
+
+    if ((NULL == pBuffer) && (NULL != s_pRegistryLock) && (DeferredLogMaxThreadBuffers > s_numThreadBuffers))
+    {
+        s_pRegistryLock->Lock();
+
+        if (DeferredLogMaxThreadBuffers > s_numThreadBuffers)
+        {
+            pBuffer = static_cast<DeferredLogThreadBuffer*>(CAMX_CALLOC_NO_SPY(sizeof(DeferredLogThreadBuffer)));
+
+            if (NULL != pBuffer)
+            {
+                pBuffer->pRecords = static_cast<DeferredLogRecord*>(
+                    CAMX_CALLOC_NO_SPY(sizeof(DeferredLogRecord) * s_recordsPerThread));
+
+                if (NULL != pBuffer->pRecords)
+                {
+                    pBuffer->numRecords = s_recordsPerThread;
+                    pBuffer->threadId   = OsUtils::GetThreadID();
+                    pBuffer->pNext      = s_pThreadBuffers;
+
+                    // Publish after pNext is set; the consumer walks the list without the registry lock
+                    CamxFence();
+                    CamxAtomicStoreP(reinterpret_cast<VOID**>(&s_pThreadBuffers), pBuffer);
+                    s_numThreadBuffers++;
+                }
+                else
+                {
+                    CAMX_FREE_NO_SPY(pBuffer);
+                    pBuffer = NULL;
+                }
+            }
+        }
+
+        s_pRegistryLock->Unlock();
+
+        m_tpThreadBuffer = pBuffer;
+    }
+
+    return pBuffer;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::CaptureArgs
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::CaptureArgs(
+    DeferredLogRecord*  pRecord,
+    va_list             args)
+{
+    const CHAR* pCurrent = pRecord->pFormat;
+
+    while (('\0' != *pCurrent) && (FALSE == pRecord->truncated))
+    {
+        if ('%' != *pCurrent)
+        {
+            pCurrent++;
+            continue;
+        }
+
+        DeferredLogSpec spec;
+        ParseSpec(pCurrent, &spec);
+
+        if (FALSE == spec.valid)
+        {
+            // Nothing after an unknown conversion can be matched to its argument
+            pRecord->truncated = TRUE;
+            break;
+        }
+
+        UINT32 numArgsNeeded = ((TRUE == spec.widthArg) ? 1 : 0) + ((TRUE == spec.precisionArg) ? 1 : 0) +
+                               ((DeferredLogArgKind::None == spec.kind) ? 0 : 1);
+
+        if ((pRecord->numArgs + numArgsNeeded) > DeferredLogMaxArgs)
+        {
+            pRecord->truncated = TRUE;
+            break;
+        }
+
+        if (TRUE == spec.widthArg)
+        {
+            pRecord->args[pRecord->numArgs++] = static_cast<UINT64>(static_cast<INT64>(va_arg(args, INT)));
+        }
+        if (TRUE == spec.precisionArg)
+        {
+            pRecord->args[pRecord->numArgs++] = static_cast<UINT64>(static_cast<INT64>(va_arg(args, INT)));
+        }
+
+        UINT64 value = 0;
+
+        switch (spec.kind)
+        {
+            case DeferredLogArgKind::Int:
+                value = static_cast<UINT64>(static_cast<INT64>(va_arg(args, INT)));
+                break;
+            case DeferredLogArgKind::Long:
+                value = static_cast<UINT64>(static_cast<INT64>(va_arg(args, long)));
+                break;
+            case DeferredLogArgKind::LongLong:
+                value = static_cast<UINT64>(va_arg(args, long long));
+                break;
+            case DeferredLogArgKind::IntMax:
+                value = static_cast<UINT64>(va_arg(args, intmax_t));
+                break;
+            case DeferredLogArgKind::Size:
+                value = static_cast<UINT64>(va_arg(args, size_t));
+                break;
+            case DeferredLogArgKind::PtrDiff:
+                value = static_cast<UINT64>(static_cast<INT64>(va_arg(args, ptrdiff_t)));
+                break;
+            case DeferredLogArgKind::Double:
+            {
+                DOUBLE doubleValue = va_arg(args, DOUBLE);
+                CAMX_STATIC_ASSERT(sizeof(doubleValue) == sizeof(value));
+                Utils::Memcpy(&value, &doubleValue, sizeof(value));
+                break;
+            }
+            case DeferredLogArgKind::LongDouble:
+            {
+                DOUBLE doubleValue = static_cast<DOUBLE>(va_arg(args, long double));
+                Utils::Memcpy(&value, &doubleValue, sizeof(value));
+                break;
+            }
+            case DeferredLogArgKind::String:
+            {
+                const CHAR* pString = va_arg(args, const CHAR*);
+
+                if (NULL == pString)
+                {
+                    value = StringArgNull;
+                }
+                else
+                {
+                    SIZE_T length    = OsUtils::StrLen(pString);
+                    SIZE_T available = DeferredLogStringBytes - pRecord->stringBytesUsed;
+
+                    if ((length + 1) <= available)
+                    {
+                        value = pRecord->stringBytesUsed;
+                        Utils::Memcpy(&pRecord->strings[pRecord->stringBytesUsed], pString, length + 1);
+                        pRecord->stringBytesUsed += static_cast<UINT32>(length + 1);
+                    }
+                    else
+                    {
+                        value = StringArgTruncated;
+                    }
+                }
+                break;
+            }
+            case DeferredLogArgKind::WideString:
+            case DeferredLogArgKind::Pointer:
+            case DeferredLogArgKind::Count:
+                value = static_cast<UINT64>(reinterpret_cast<UINTPTR_T>(va_arg(args, VOID*)));
+                break;
+            case DeferredLogArgKind::None:
+            default:
+                break;
+        }
+
+        if (DeferredLogArgKind::None != spec.kind)
+        {
+            pRecord->args[pRecord->numArgs++] = value;
+        }
+
+        pCurrent += spec.length;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::FormatRecord
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::FormatRecord(
+    const DeferredLogRecord*    pRecord,
+    CHAR*                       pText,
+    SIZE_T                      textSize)
+{
+    const CHAR* pCurrent = pRecord->pFormat;
+    SIZE_T      offset   = 0;
+    UINT32      argIndex = 0;
+
+    while (('\0' != *pCurrent) && ((offset + 1) < textSize))
+    {
+        if ('%' != *pCurrent)
+        {
+            pText[offset++] = *pCurrent++;
+            continue;
+        }
+
+        DeferredLogSpec spec;
+        ParseSpec(pCurrent, &spec);
+
+        UINT32 numArgsNeeded = ((TRUE == spec.widthArg) ? 1 : 0) + ((TRUE == spec.precisionArg) ? 1 : 0) +
+                               ((DeferredLogArgKind::None == spec.kind) ? 0 : 1);
+
+        if ((FALSE == spec.valid) || (MaxSpecLength <= spec.length) || ((argIndex + numArgsNeeded) > pRecord->numArgs))
+        {
+            // The record was cut here
+            OsUtils::SNPrintF(&pText[offset], textSize - offset, "...");
+            offset += OsUtils::StrLen(&pText[offset]);
+            break;
+        }
+
+        // Rebuild the specification with '*' replaced by the captured width and precision
+        CHAR   specText[MaxSpecLength * 2];
+        SIZE_T specOffset = 0;
+
+        for (UINT32 i = 0; i < spec.length; i++)
+        {
+            if ('*' == pCurrent[i])
+            {
+                specOffset += OsUtils::SNPrintF(&specText[specOffset], sizeof(specText) - specOffset, "%d",
+                                                static_cast<INT>(static_cast<INT64>(pRecord->args[argIndex++])));
+            }
+            else
+            {
+                specText[specOffset++] = pCurrent[i];
+            }
+        }
+        specText[specOffset] = '\0';
+
+        CHAR*  pOut    = &pText[offset];
+        SIZE_T outSize = textSize - offset;
+        UINT64 value   = (DeferredLogArgKind::None == spec.kind) ? 0 : pRecord->args[argIndex++];
+        DOUBLE doubleValue;
+
+        switch (spec.kind)
+        {
+            case DeferredLogArgKind::None:
+                OsUtils::SNPrintF(pOut, outSize, "%%");
+                break;
+            case DeferredLogArgKind::Int:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<INT>(static_cast<INT64>(value)));
+                break;
+            case DeferredLogArgKind::Long:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<long>(static_cast<INT64>(value)));
+                break;
+            case DeferredLogArgKind::LongLong:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<long long>(value));
+                break;
+            case DeferredLogArgKind::IntMax:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<intmax_t>(value));
+                break;
+            case DeferredLogArgKind::Size:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<size_t>(value));
+                break;
+            case DeferredLogArgKind::PtrDiff:
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<ptrdiff_t>(static_cast<INT64>(value)));
+                break;
+            case DeferredLogArgKind::Double:
+                Utils::Memcpy(&doubleValue, &value, sizeof(doubleValue));
+                OsUtils::SNPrintF(pOut, outSize, specText, doubleValue);
+                break;
+            case DeferredLogArgKind::LongDouble:
+                Utils::Memcpy(&doubleValue, &value, sizeof(doubleValue));
+                OsUtils::SNPrintF(pOut, outSize, specText, static_cast<long double>(doubleValue));
+                break;
+            case DeferredLogArgKind::String:
+                if (StringArgNull == value)
+                {
+                    OsUtils::SNPrintF(pOut, outSize, "(null)");
+                }
+                else if (StringArgTruncated == value)
+                {
+                    OsUtils::SNPrintF(pOut, outSize, "(string dropped)");
+                }
+                else
+                {
+                    OsUtils::SNPrintF(pOut, outSize, specText, &pRecord->strings[value]);
+                }
+                break;
+            case DeferredLogArgKind::WideString:
+                OsUtils::SNPrintF(pOut, outSize, "(wide string %p)", reinterpret_cast<VOID*>(static_cast<UINTPTR_T>(value)));
+                break;
+            case DeferredLogArgKind::Pointer:
+                OsUtils::SNPrintF(pOut, outSize, specText, reinterpret_cast<VOID*>(static_cast<UINTPTR_T>(value)));
+                break;
+            case DeferredLogArgKind::Count:
+            default:
+                pOut[0] = '\0';
+                break;
+        }
+
+        offset   += OsUtils::StrLen(pOut);
+        pCurrent += spec.length;
+    }
+
+    pText[offset] = '\0';
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::DrainBuffers
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT32 DeferredLog::DrainBuffers()
+{
+    DeferredLogThreadBuffer*    pBuffers[DeferredLogMaxThreadBuffers];
+    UINT32                      endIndex[DeferredLogMaxThreadBuffers];
+    UINT32                      numBuffers = 0;
+    UINT32                      numEmitted = 0;
+    CHAR                        text[Log::MaxLogLength];
+
+    // Snapshot the producers; records written after this are picked up by the next drain
+    DeferredLogThreadBuffer* pBuffer = static_cast<DeferredLogThreadBuffer*>(
+        CamxAtomicLoadP(reinterpret_cast<VOID**>(&s_pThreadBuffers)));
+
+    while ((NULL != pBuffer) && (DeferredLogMaxThreadBuffers > numBuffers))
+    {
+        pBuffers[numBuffers] = pBuffer;
+        endIndex[numBuffers] = CamxAtomicLoadU32(&pBuffer->writeIndex);
+        numBuffers++;
+        pBuffer = pBuffer->pNext;
+    }
+
+    // Pairs with the fence before the producers publish writeIndex
+    CamxFence();
+
+    // Merge the per thread rings by capture time so the output reads in the order the calls were made
+    while (TRUE)
+    {
+        DeferredLogThreadBuffer*    pOldest      = NULL;
+        const DeferredLogRecord*    pOldestEntry = NULL;
+
+        for (UINT32 i = 0; i < numBuffers; i++)
+        {
+            if (pBuffers[i]->readIndex != endIndex[i])
+            {
+                const DeferredLogRecord* pEntry =
+                    &pBuffers[i]->pRecords[pBuffers[i]->readIndex & (pBuffers[i]->numRecords - 1)];
+
+                if ((NULL == pOldestEntry) || (pEntry->timestampNs < pOldestEntry->timestampNs))
+                {
+                    pOldest      = pBuffers[i];
+                    pOldestEntry = pEntry;
+                }
+            }
+        }
+
+        if (NULL == pOldest)
+        {
+            break;
+        }
+
+        INT prefixLength = OsUtils::SNPrintF(text, sizeof(text), "[T%u %llu.%06llu] ", pOldest->threadId,
+                                             pOldestEntry->timestampNs / NanoSecondsPerSecond,
+                                             (pOldestEntry->timestampNs % NanoSecondsPerSecond) / 1000);
+
+        FormatRecord(pOldestEntry, &text[prefixLength], sizeof(text) - prefixLength);
+        EmitText(pOldestEntry->level, text);
+
+        // Hand the slot back to the producer only after it has been formatted
+        CamxFence();
+        CamxAtomicStoreU32(&pOldest->readIndex, pOldest->readIndex + 1);
+        numEmitted++;
+    }
+
+    for (UINT32 i = 0; i < numBuffers; i++)
+    {
+        UINT32 numDropped = CamxAtomicLoadU32(&pBuffers[i]->numDropped);
+
+        if (numDropped != pBuffers[i]->numDroppedReported)
+        {
+            OsUtils::SNPrintF(text, sizeof(text), "[T%u] DeferredLog: %u log records dropped, buffer of %u records full",
+                              pBuffers[i]->threadId, numDropped - pBuffers[i]->numDroppedReported, pBuffers[i]->numRecords);
+            EmitText(CamxLogWarning, text);
+
+            pBuffers[i]->numDroppedReported = numDropped;
+        }
+    }
+
+    return numEmitted;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::FlushThread
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID* DeferredLog::FlushThread(
+    VOID* pArg)
+{
+    CAMX_UNREFERENCED_PARAM(pArg);
+
+    while (FALSE == s_stopFlushThread)
+    {
+        s_pFlushLock->Lock();
+        UINT32 numEmitted = DrainBuffers();
+        s_pFlushLock->Unlock();
+
+        if (0 == numEmitted)
+        {
+            OsUtils::SleepMicroseconds(DeferredLogFlushPeriodUs);
+        }
+    }
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::InstallCrashHandlers
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::InstallCrashHandlers()
+{
+    if (FALSE == s_crashHandlersSet)
+    {
+        s_crashHandlersSet = TRUE;
+
+        atexit(ExitHandler);
+
+#if defined (_LINUX)
+        struct sigaction action;
+
+        Utils::Memset(&action, 0, sizeof(action));
+        action.sa_sigaction = SignalHandler;
+        action.sa_flags     = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+
+        for (UINT32 i = 0; i < CAMX_ARRAY_SIZE(CrashSignals); i++)
+        {
+            sigaction(CrashSignals[i], &action, &s_previousSignalActions[i]);
+        }
+#endif // _LINUX
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::CrashFlush
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::CrashFlush()
+{
+    // Only the first crashing thread flushes
+    if ((NULL != s_pFlushLock) && (TRUE == CamxAtomicCompareExchangeU(&s_crashFlushing, 0, 1)))
+    {
+        BOOL locked = FALSE;
+
+        // The crashing thread may itself hold the flush lock, so never block on it
+        for (UINT32 i = 0; (i < CrashFlushLockRetries) && (FALSE == locked); i++)
+        {
+            if (CamxResultSuccess == s_pFlushLock->TryLock())
+            {
+                locked = TRUE;
+            }
+            else
+            {
+                OsUtils::SleepMicroseconds(CrashFlushLockWaitUs);
+            }
+        }
+
+        // Without the lock the flush thread may be draining, and a second consumer would corrupt the thread buffers
+        if (TRUE == locked)
+        {
+            DrainBuffers();
+            s_pFlushLock->Unlock();
+        }
+    }
+}
+
+#if defined (_LINUX)
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::SignalHandler
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::SignalHandler(
+    INT        signalNumber,
+    siginfo_t* pSignalInfo,
+    VOID*      pContext)
+{
+    const struct sigaction* pPrevious = NULL;
+
+    CrashFlush();
+
+    for (UINT32 i = 0; i < CAMX_ARRAY_SIZE(CrashSignals); i++)
+    {
+        if (CrashSignals[i] == signalNumber)
+        {
+            pPrevious = &s_previousSignalActions[i];
+            break;
+        }
+    }
+
+    // Hand the signal to whoever handled it before us, e.g. the debuggerd tombstone handler, with the original siginfo
+    if (NULL == pPrevious)
+    {
+        signal(signalNumber, SIG_DFL);
+        raise(signalNumber);
+    }
+    else if ((0 != (pPrevious->sa_flags & SA_SIGINFO)) && (NULL != pPrevious->sa_sigaction))
+    {
+        pPrevious->sa_sigaction(signalNumber, pSignalInfo, pContext);
+    }
+    else if ((SIG_DFL != pPrevious->sa_handler) && (SIG_IGN != pPrevious->sa_handler))
+    {
+        pPrevious->sa_handler(signalNumber);
+    }
+    else
+    {
+        sigaction(signalNumber, pPrevious, NULL);
+
+        // A fault re-triggers when the handler returns, a signal sent by a process does not and is raised again
+        if ((NULL != pSignalInfo) && (SI_USER >= pSignalInfo->si_code))
+        {
+            raise(signalNumber);
+        }
+    }
+}
+#endif // _LINUX
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DeferredLog::ExitHandler
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID DeferredLog::ExitHandler()
+{
+    CrashFlush();
+}
+
+CAMX_NAMESPACE_END
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxdeferredlog.h
+/// @brief Deferred logging backend. Log calls capture the format pointer and raw arguments into per thread buffers and a
+///        background thread formats and emits them.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXDEFERREDLOG_H
+#define CAMXDEFERREDLOG_H
+
+#include <stdarg.h>
+
+#include "camxdefs.h"
+#include "camxosutils.h"
+#include "camxtypes.h"
+
+CAMX_NAMESPACE_BEGIN
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 DeferredLogMaxArgs                  = 24;       ///< Arguments captured per record, '*' included
+static const UINT32 DeferredLogStringBytes              = 192;      ///< Inline bytes per record for copied %s arguments
+static const UINT32 DeferredLogDefaultRecordsPerThread  = 256;      ///< Records per thread buffer when not configured
+static const UINT32 DeferredLogMaxThreadBuffers         = 64;       ///< Threads beyond this log synchronously
+static const UINT32 DeferredLogFlushPeriodUs            = 5000;     ///< Sleep of the flush thread between drains
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief One captured log call. The format pointer refers to a string literal so only the arguments are copied.
+struct DeferredLogRecord
+{
+    const CHAR* pFormat;                            ///< Format string of the log call
+    UINT64      timestampNs;                        ///< Capture time
+    UINT32      level;                              ///< CamxLog level
+    UINT32      numArgs;                            ///< Valid entries in args
+    UINT32      stringBytesUsed;                    ///< Used bytes of strings
+    BOOL        truncated;                          ///< Arguments did not fit and the tail of the record was cut
+    UINT64      args[DeferredLogMaxArgs];           ///< Raw argument bits; for %s the offset into strings
+    CHAR        strings[DeferredLogStringBytes];    ///< Copied %s arguments, NUL terminated
+};
+
+/// @brief Single producer, single consumer ring of records owned by one logging thread
+struct DeferredLogThreadBuffer
+{
+    DeferredLogRecord*          pRecords;           ///< Record storage
+    UINT32                      numRecords;         ///< Capacity, a power of two
+    UINT32                      threadId;           ///< Owning thread
+    volatile UINT32             writeIndex;         ///< Free running producer index
+    volatile UINT32             readIndex;          ///< Free running consumer index
+    volatile UINT32             numDropped;         ///< Records dropped because the ring was full
+    UINT32                      numDroppedReported; ///< Drops already reported by the consumer
+    DeferredLogThreadBuffer*    pNext;              ///< Next buffer in the registry
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Deferred logging backend for Log::LogSystem
+///
+/// When enabled, Log::LogSystem hands its arguments to Record instead of formatting them. Record walks the format string once
+/// to pull each argument off the va_list with its real type and stores the raw bits, copying %s strings inline, into a
+/// lock-free ring that only the calling thread writes. Group and level filtering still happens in the CAMX_LOG_* macros before
+/// Log::LogSystem is reached. A flush thread drains all rings, formats the records and emits them the same way the
+/// synchronous path does. A full ring drops the new record and counts it; the count is logged once the ring drains. Fatal
+/// signals and process exit flush whatever is still buffered.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class DeferredLog
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Enable
+    ///
+    /// @brief  Turn on deferred logging and start the flush thread
+    ///
+    /// @param  recordsPerThread    Capacity of each thread buffer, rounded up to a power of two. 0 selects the default.
+    ///
+    /// @return CamxResultSuccess if successful
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CamxResult Enable(
+        UINT32 recordsPerThread);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Disable
+    ///
+    /// @brief  Turn off deferred logging, drain all buffers and stop the flush thread. Thread buffers are kept for reuse.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID Disable();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// IsEnabled
+    ///
+    /// @brief  Check if log calls should go to Record
+    ///
+    /// @return TRUE if deferred logging is on
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static CAMX_INLINE BOOL IsEnabled()
+    {
+        return s_enabled;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Record
+    ///
+    /// @brief  Capture one log call into the calling thread's buffer
+    ///
+    /// @param  level   CamxLog level of the call
+    /// @param  pFormat Format string, must outlive the flush (a string literal)
+    /// @param  args    Arguments of the call
+    ///
+    /// @return TRUE if the call was captured or dropped, FALSE if the caller has to log it synchronously
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static BOOL Record(
+        UINT32      level,
+        const CHAR* pFormat,
+        va_list     args);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Flush
+    ///
+    /// @brief  Format and emit everything buffered so far on the calling thread
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID Flush();
+
+private:
+    DeferredLog()                                   = default;
+    DeferredLog(const DeferredLog&)                 = delete;
+    DeferredLog& operator=(const DeferredLog&)      = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetThreadBuffer
+    ///
+    /// @brief  Get the calling thread's buffer, registering one on first use
+    ///
+    /// @return Buffer or NULL if none could be provided
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static DeferredLogThreadBuffer* GetThreadBuffer();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// CaptureArgs
+    ///
+    /// @brief  Walk the conversion specifications of pFormat and store each argument into pRecord
+    ///
+    /// @param  pRecord Record to fill, pFormat and level already set
+    /// @param  args    Arguments of the call
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID CaptureArgs(
+        DeferredLogRecord*  pRecord,
+        va_list             args);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FormatRecord
+    ///
+    /// @brief  Rebuild the text of a record, formatting one conversion specification at a time
+    ///
+    /// @param  pRecord     Record to format
+    /// @param  pText       Output buffer
+    /// @param  textSize    Size of pText
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID FormatRecord(
+        const DeferredLogRecord*    pRecord,
+        CHAR*                       pText,
+        SIZE_T                      textSize);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DrainBuffers
+    ///
+    /// @brief  Emit all records currently in the thread buffers, oldest buffer position first per thread
+    ///
+    /// @return Number of records emitted
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static UINT32 DrainBuffers();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FlushThread
+    ///
+    /// @brief  Flush thread entry
+    ///
+    /// @param  pArg Unused
+    ///
+    /// @return NULL
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID* FlushThread(
+        VOID* pArg);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// InstallCrashHandlers
+    ///
+    /// @brief  Hook process exit and fatal signals so buffered records are flushed before the process goes away
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID InstallCrashHandlers();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// CrashFlush
+    ///
+    /// @brief  Best effort flush from a fatal signal or exit; does not wait for the flush lock, and skips the flush if the
+    ///         lock stays taken, as the thread buffers must not be drained by two consumers
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID CrashFlush();
+
+#if defined (_LINUX)
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// SignalHandler
+    ///
+    /// @brief  Fatal signal handler; flushes, then chains to the previous handler with the original signal information. A
+    ///         default previous handler is restored and the faulting instruction re-executed, so the fault address is kept.
+    ///
+    /// @param  signalNumber    Signal being handled
+    /// @param  pSignalInfo     Signal information
+    /// @param  pContext        Context of the interrupted thread
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID SignalHandler(
+        INT        signalNumber,
+        siginfo_t* pSignalInfo,
+        VOID*      pContext);
+#endif // _LINUX
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// ExitHandler
+    ///
+    /// @brief  atexit hook
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID ExitHandler();
+
+    static volatile BOOL            s_enabled;              ///< Log::LogSystem routes to Record
+    static volatile BOOL            s_stopFlushThread;      ///< Tells the flush thread to exit
+    static volatile UINT            s_crashFlushing;        ///< Set once a crash flush has started
+    static BOOL                     s_flushThreadRunning;   ///< The flush thread has been created
+    static BOOL                     s_crashHandlersSet;     ///< Exit and signal hooks are installed
+    static UINT32                   s_recordsPerThread;     ///< Capacity of new thread buffers
+    static UINT32                   s_numThreadBuffers;     ///< Buffers in the registry
+    static DeferredLogThreadBuffer* s_pThreadBuffers;       ///< Registry of all thread buffers, append only
+    static Mutex*                   s_pRegistryLock;        ///< Serializes registration
+    static Mutex*                   s_pFlushLock;           ///< Serializes the consumers of the thread buffers
+    static OSThreadHandle           s_hFlushThread;         ///< Flush thread
+
+    CAMX_TLS_STATIC_CLASS_DECLARE(DeferredLogThreadBuffer*, m_tpThreadBuffer);    ///< Buffer of the calling thread
+    CAMX_TLS_STATIC_CLASS_DECLARE(BOOL, m_tInRecord);                              ///< Guards against reentrant logging
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXDEFERREDLOG_H
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxlatencyhistogram.cpp
+/// @brief Latency histogram implementation
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "camxatomic.h"
+#include "camxdebugprint.h"
+#include "camxlatencyhistogram.h"
+#include "camxosutils.h"
+#include "camxutils.h"
+
+CAMX_NAMESPACE_BEGIN
+
+/// @brief Largest value that gets its own bucket; anything above lands in the last bucket
+static const UINT64 LatencyHistogramMaxValueUs = ((static_cast<UINT64>(1) << LatencyHistogramMaxValueBits) - 1);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::GetBucketIndex
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT32 LatencyHistogram::GetBucketIndex(
+    UINT64 valueUs)
+{
+    UINT32 value = static_cast<UINT32>((valueUs > LatencyHistogramMaxValueUs) ? LatencyHistogramMaxValueUs : valueUs);
+    UINT32 index = value;
+
+    if (value >= LatencyHistogramSubBucketCount)
+    {
+        UINT32 msb = 0;
+
+        Utils::BitScanReverse(value, &msb);
+
+        // Keep the top SubBucketBits bits of the value; (value >> shift) is then in [SubBucketHalf, SubBucketCount)
+        UINT32 shift = msb - (LatencyHistogramSubBucketBits - 1);
+
+        index = (shift * LatencyHistogramSubBucketHalf) + (value >> shift);
+    }
+
+    return index;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::GetBucketHighestValue
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT64 LatencyHistogram::GetBucketHighestValue(
+    UINT32 bucketIndex)
+{
+    UINT64 value = bucketIndex;
+
+    if (bucketIndex >= LatencyHistogramSubBucketCount)
+    {
+        UINT32 shift    = (bucketIndex / LatencyHistogramSubBucketHalf) - 1;
+        UINT64 subIndex = bucketIndex - (shift * LatencyHistogramSubBucketHalf);
+
+        value = ((subIndex + 1) << shift) - 1;
+    }
+
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::Record
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::Record(
+    UINT64 latencyNs)
+{
+    UINT64 valueUs = latencyNs / 1000;
+
+    CamxAtomicAddU32(&m_buckets[GetBucketIndex(valueUs)], 1);
+    CamxAtomicAddU64(&m_sumUs, valueUs);
+
+    if (valueUs > CamxAtomicLoadU64(&m_maxUs))
+    {
+        CamxAtomicStoreU64(&m_maxUs, valueUs);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::Reset
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::Reset()
+{
+    for (UINT32 i = 0; i < LatencyHistogramNumBuckets; i++)
+    {
+        CamxAtomicStoreU32(&m_buckets[i], 0);
+    }
+
+    CamxAtomicStoreU64(&m_sumUs, 0);
+    CamxAtomicStoreU64(&m_maxUs, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::GetSnapshot
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::GetSnapshot(
+    LatencyHistogramSnapshot* pSnapshot) const
+{
+    CAMX_ASSERT(NULL != pSnapshot);
+
+    // The count is taken from the copied buckets so percentiles are always consistent with them
+    pSnapshot->count = 0;
+
+    for (UINT32 i = 0; i < LatencyHistogramNumBuckets; i++)
+    {
+        pSnapshot->buckets[i]  = CamxAtomicLoadU32(const_cast<volatile UINT32*>(&m_buckets[i]));
+        pSnapshot->count      += pSnapshot->buckets[i];
+    }
+
+    pSnapshot->sumUs = CamxAtomicLoadU64(const_cast<volatile UINT64*>(&m_sumUs));
+    pSnapshot->maxUs = CamxAtomicLoadU64(const_cast<volatile UINT64*>(&m_maxUs));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::GetSummary
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::GetSummary(
+    LatencyHistogramSummary* pSummary) const
+{
+    LatencyHistogramSnapshot snapshot;
+
+    GetSnapshot(&snapshot);
+    Summarize(&snapshot, pSummary);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::GetValueAtPercentile
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+UINT64 LatencyHistogram::GetValueAtPercentile(
+    const LatencyHistogramSnapshot* pSnapshot,
+    FLOAT                           percentile)
+{
+    CAMX_ASSERT(NULL != pSnapshot);
+
+    UINT64 value = 0;
+
+    if (0 < pSnapshot->count)
+    {
+        // Rank of the sample at the percentile, at least the first sample
+        UINT64 rank = static_cast<UINT64>((static_cast<DOUBLE>(percentile) / 100.0) * pSnapshot->count + 0.5);
+        UINT64 seen = 0;
+
+        rank = Utils::MaxUINT64(rank, 1);
+
+        for (UINT32 i = 0; i < LatencyHistogramNumBuckets; i++)
+        {
+            seen += pSnapshot->buckets[i];
+
+            if (seen >= rank)
+            {
+                value = GetBucketHighestValue(i);
+                break;
+            }
+        }
+
+        // The largest sample is exact, never report past it
+        if ((0 != pSnapshot->maxUs) && (value > pSnapshot->maxUs))
+        {
+            value = pSnapshot->maxUs;
+        }
+    }
+
+    return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::Summarize
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::Summarize(
+    const LatencyHistogramSnapshot* pSnapshot,
+    LatencyHistogramSummary*        pSummary)
+{
+    CAMX_ASSERT(NULL != pSnapshot);
+    CAMX_ASSERT(NULL != pSummary);
+
+    pSummary->count  = pSnapshot->count;
+    pSummary->meanUs = (0 < pSnapshot->count) ? (pSnapshot->sumUs / pSnapshot->count) : 0;
+    pSummary->maxUs  = pSnapshot->maxUs;
+    pSummary->p50Us  = GetValueAtPercentile(pSnapshot, 50.0f);
+    pSummary->p95Us  = GetValueAtPercentile(pSnapshot, 95.0f);
+    pSummary->p99Us  = GetValueAtPercentile(pSnapshot, 99.0f);
+    pSummary->p999Us = GetValueAtPercentile(pSnapshot, 99.9f);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::FormatJSON
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::FormatJSON(
+    const CHAR*                     pName,
+    const LatencyHistogramSummary*  pSummary,
+    CHAR*                           pBuffer,
+    SIZE_T                          bufferSize)
+{
+    CAMX_ASSERT(NULL != pName);
+    CAMX_ASSERT(NULL != pSummary);
+    CAMX_ASSERT(NULL != pBuffer);
+
+    OsUtils::SNPrintF(pBuffer, bufferSize,
+                      "{\"name\":\"%s\",\"count\":%llu,\"meanUs\":%llu,\"maxUs\":%llu,"
+                      "\"p50Us\":%llu,\"p95Us\":%llu,\"p99Us\":%llu,\"p999Us\":%llu}",
+                      pName,
+                      pSummary->count,
+                      pSummary->meanUs,
+                      pSummary->maxUs,
+                      pSummary->p50Us,
+                      pSummary->p95Us,
+                      pSummary->p99Us,
+                      pSummary->p999Us);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LatencyHistogram::DumpState
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID LatencyHistogram::DumpState(
+    INT         fd,
+    UINT32      indent,
+    const CHAR* pName) const
+{
+    LatencyHistogramSummary summary;
+    CHAR                    json[LatencyHistogramJSONLength];
+
+    GetSummary(&summary);
+
+    if (0 < summary.count)
+    {
+        FormatJSON(pName, &summary, json, sizeof(json));
+        CAMX_LOG_TO_FILE(fd, indent, "%s", json);
+    }
+}
+
+CAMX_NAMESPACE_END
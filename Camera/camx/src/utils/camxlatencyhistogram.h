@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2019 Qualcomm Technologies, Inc.
+// All Rights Reserved.
+// Confidential and Proprietary - Qualcomm Technologies, Inc.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file  camxlatencyhistogram.h
+/// @brief Fixed size log-linear latency histogram with lock-free recording and percentile queries
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CAMXLATENCYHISTOGRAM_H
+#define CAMXLATENCYHISTOGRAM_H
+
+#include "camxdefs.h"
+#include "camxtypes.h"
+
+CAMX_NAMESPACE_BEGIN
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Constant definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+static const UINT32 LatencyHistogramSubBucketBits   = 5;                                    ///< Precision bits per power of two
+static const UINT32 LatencyHistogramSubBucketCount  = (1 << LatencyHistogramSubBucketBits); ///< Linear buckets below 2^5 us
+static const UINT32 LatencyHistogramSubBucketHalf   = (LatencyHistogramSubBucketCount / 2); ///< Buckets per further power of two
+static const UINT32 LatencyHistogramMaxValueBits    = 32;                                   ///< Largest recordable value 2^32 us
+static const UINT32 LatencyHistogramNumBuckets      =
+    ((LatencyHistogramMaxValueBits - LatencyHistogramSubBucketBits + 1) * LatencyHistogramSubBucketHalf); ///< Bucket count
+static const UINT32 LatencyHistogramJSONLength      = 256;                                  ///< Buffer size for FormatJSON
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Type definitions
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Point in time copy of a histogram, cheap to take and safe to hand out or merge
+struct LatencyHistogramSnapshot
+{
+    UINT64 count;                                   ///< Samples in buckets
+    UINT64 sumUs;                                   ///< Sum of all samples
+    UINT64 maxUs;                                   ///< Largest sample
+    UINT32 buckets[LatencyHistogramNumBuckets];     ///< Samples per bucket
+};
+
+/// @brief Common percentiles of a snapshot
+struct LatencyHistogramSummary
+{
+    UINT64 count;                                   ///< Samples
+    UINT64 meanUs;                                  ///< Mean
+    UINT64 maxUs;                                   ///< Largest sample
+    UINT64 p50Us;                                   ///< 50th percentile
+    UINT64 p95Us;                                   ///< 95th percentile
+    UINT64 p99Us;                                   ///< 99th percentile
+    UINT64 p999Us;                                  ///< 99.9th percentile
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Latency histogram
+///
+/// Samples are kept in microseconds. Values below 32 us get a bucket each; above that every power of two is split into 16
+/// buckets, so a reported percentile is within about 6% of the true value, as in an HDR histogram with two significant
+/// digits. Recording is a bucket lookup and a few relaxed atomic adds, cheap enough to leave on for every request. Values
+/// of 2^32 us or more land in the last bucket.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+class LatencyHistogram
+{
+public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Record
+    ///
+    /// @brief  Add one sample; safe to call from any thread
+    ///
+    /// @param  latencyNs   Latency in nanoseconds
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID Record(
+        UINT64 latencyNs);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// RecordInterval
+    ///
+    /// @brief  Add the time between two GetNanoSeconds timestamps, ignoring the sample if either is missing
+    ///
+    /// @param  startNs     Start of the interval, 0 if not captured
+    /// @param  endNs       End of the interval, 0 if not captured
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    CAMX_INLINE VOID RecordInterval(
+        UINT64 startNs,
+        UINT64 endNs)
+    {
+        if ((0 != startNs) && (endNs >= startNs))
+        {
+            Record(endNs - startNs);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Reset
+    ///
+    /// @brief  Drop all samples. Samples recorded concurrently may be partially kept.
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID Reset();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetSnapshot
+    ///
+    /// @brief  Copy the current state without stopping recorders
+    ///
+    /// @param  pSnapshot   Output snapshot
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID GetSnapshot(
+        LatencyHistogramSnapshot* pSnapshot) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetSummary
+    ///
+    /// @brief  Snapshot the histogram and compute the common percentiles
+    ///
+    /// @param  pSummary    Output summary
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID GetSummary(
+        LatencyHistogramSummary* pSummary) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetValueAtPercentile
+    ///
+    /// @brief  Find the latency below which the given percentage of samples fall
+    ///
+    /// @param  pSnapshot   Snapshot to query
+    /// @param  percentile  Percentile, 0.0 to 100.0
+    ///
+    /// @return Highest value of the bucket holding the percentile, in microseconds, capped at the largest sample
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static UINT64 GetValueAtPercentile(
+        const LatencyHistogramSnapshot* pSnapshot,
+        FLOAT                           percentile);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Summarize
+    ///
+    /// @brief  Compute the common percentiles of a snapshot
+    ///
+    /// @param  pSnapshot   Snapshot to summarize
+    /// @param  pSummary    Output summary
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID Summarize(
+        const LatencyHistogramSnapshot* pSnapshot,
+        LatencyHistogramSummary*        pSummary);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// FormatJSON
+    ///
+    /// @brief  Write a summary as a single line JSON object
+    ///
+    /// @param  pName       Value of the "name" member
+    /// @param  pSummary    Summary to write
+    /// @param  pBuffer     Output buffer, LatencyHistogramJSONLength bytes is enough for names up to 64 characters
+    /// @param  bufferSize  Size of pBuffer
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static VOID FormatJSON(
+        const CHAR*                     pName,
+        const LatencyHistogramSummary*  pSummary,
+        CHAR*                           pBuffer,
+        SIZE_T                          bufferSize);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// DumpState
+    ///
+    /// @brief  Dump the summary of the histogram as JSON to a file descriptor
+    ///
+    /// @param  fd      File descriptor
+    /// @param  indent  Indent spaces
+    /// @param  pName   Name of the histogram
+    ///
+    /// @return None
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    VOID DumpState(
+        INT         fd,
+        UINT32      indent,
+        const CHAR* pName) const;
+
+private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetBucketIndex
+    ///
+    /// @brief  Map a value to its bucket
+    ///
+    /// @param  valueUs Value in microseconds
+    ///
+    /// @return Bucket index
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static UINT32 GetBucketIndex(
+        UINT64 valueUs);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// GetBucketHighestValue
+    ///
+    /// @brief  Largest value that maps to a bucket
+    ///
+    /// @param  bucketIndex Bucket index
+    ///
+    /// @return Value in microseconds
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    static UINT64 GetBucketHighestValue(
+        UINT32 bucketIndex);
+
+    volatile UINT32 m_buckets[LatencyHistogramNumBuckets];  ///< Samples per bucket
+    volatile UINT64 m_sumUs;                                ///< Sum of all samples
+    volatile UINT64 m_maxUs;                                ///< Largest sample, approximate under races
+};
+
+CAMX_NAMESPACE_END
+
+#endif // CAMXLATENCYHISTOGRAM_H
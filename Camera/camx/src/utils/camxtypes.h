@@ -278,6 +278,8 @@ struct DebugLogInfo
     CamxLogGroup    groupsEnable[CamxLogMax];               ///< Logging groups enable bits per log level
     FILE*           pDebugLogFile;                          ///< Debug log filehandle or NULL when disabled
     BOOL            systemLogEnable;                        ///< Global logging enable flag
+    BOOL            deferredLogEnable;                      ///< Capture log calls and format them on a background thread
+    UINT32          deferredLogRecordsPerThread;            ///< Records buffered per thread in deferred mode, 0 for default
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////